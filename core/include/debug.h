@@ -47,8 +47,15 @@ extern "C" {
  * implementation file, all usages of ::DEBUG_PRINT will print the given
  * information to stdout after verifying the stack is big enough. If `DEVELHELP`
  * is not set, this check is not performed. (CPU exception may occur)
+ *
+ * With the module `log_binary` and `LOG_BINARY_DEBUG` defined, e.g. with
+ * `CFLAGS += -DLOG_BINARY_DEBUG`, the information is stored as a binary record
+ * and formatted on the host instead, see @ref sys_log_binary.
  */
-#ifdef DEVELHELP
+#if defined(MODULE_LOG_BINARY) && defined(LOG_BINARY_DEBUG)
+#include "log.h"
+#define DEBUG_PRINT(...) log_binary_write(LOG_DEBUG, __VA_ARGS__)
+#elif defined(DEVELHELP)
 #include "cpu_conf.h"
 #define DEBUG_PRINT(...) \
     do { \
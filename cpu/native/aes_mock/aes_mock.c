@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_aes_mock
+ * @{
+ *
+ * @file
+ * @brief       Mock AES accelerator implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#include "aes_mock.h"
+
+#if CIPHER_MAX_CONTEXT_SIZE < AES_KEY_SIZE
+#error "aes_mock: cipher contexts are too small, define CRYPTO_AES"
+#endif
+
+/* the pending asynchronous operation, like the registers of a DMA channel */
+typedef struct {
+    const uint8_t *input;
+    uint8_t *output;
+    size_t num;
+    bool decrypt;
+    cipher_cb_t cb;
+    void *arg;
+} _dma_t;
+
+static int _init(cipher_context_t *ctx, const uint8_t *key, uint8_t key_size);
+static int _encrypt(const cipher_context_t *ctx, const uint8_t *input,
+                    uint8_t *output);
+static int _decrypt(const cipher_context_t *ctx, const uint8_t *input,
+                    uint8_t *output);
+static int _encrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t num);
+static int _decrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t num);
+static int _encrypt_blocks_async(const cipher_context_t *ctx,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t num, cipher_cb_t cb, void *arg);
+static int _decrypt_blocks_async(const cipher_context_t *ctx,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t num, cipher_cb_t cb, void *arg);
+
+static const cipher_interface_t _interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    _init,
+    _encrypt,
+    _decrypt,
+    _encrypt_blocks,
+    _decrypt_blocks,
+    _encrypt_blocks_async,
+    _decrypt_blocks_async
+};
+
+static cipher_hw_t _backend;
+static bool _enabled;
+static aes_mock_stats_t _stats;
+
+/* held while the engine is in use, an asynchronous operation releases it
+ * from the interrupt that signals its end */
+static mutex_t _lock = MUTEX_INIT;
+/* the key in the engine and its expanded form */
+static uint8_t _key[AES_KEY_SIZE];
+static bool _key_loaded;
+static cipher_context_t _key_ctx;
+static _dma_t _dma;
+static xtimer_t _dma_timer;
+
+static void _load_key(const cipher_context_t *ctx)
+{
+    if (!_key_loaded || (memcmp(_key, ctx->context, AES_KEY_SIZE) != 0)) {
+        memcpy(_key, ctx->context, AES_KEY_SIZE);
+        aes_init(&_key_ctx, _key, AES_KEY_SIZE);
+        _key_loaded = true;
+        _stats.key_loads++;
+    }
+}
+
+static int _run(const uint8_t *input, uint8_t *output, size_t num,
+                bool decrypt)
+{
+    _stats.blocks += num;
+    if (decrypt) {
+        return aes_decrypt_blocks(&_key_ctx, input, output, num);
+    }
+    return aes_encrypt_blocks(&_key_ctx, input, output, num);
+}
+
+static int _crypt(const cipher_context_t *ctx, const uint8_t *input,
+                  uint8_t *output, size_t num, bool decrypt)
+{
+    int res;
+
+    mutex_lock(&_lock);
+    _load_key(ctx);
+    res = _run(input, output, num, decrypt);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static void _dma_done(void *arg)
+{
+    _dma_t *dma = arg;
+    int res = _run(dma->input, dma->output, dma->num, dma->decrypt);
+
+    mutex_unlock(&_lock);
+    dma->cb(dma->arg, res);
+}
+
+static int _crypt_async(const cipher_context_t *ctx, const uint8_t *input,
+                        uint8_t *output, size_t num, bool decrypt,
+                        cipher_cb_t cb, void *arg)
+{
+    mutex_lock(&_lock);
+    _load_key(ctx);
+    _dma.input = input;
+    _dma.output = output;
+    _dma.num = num;
+    _dma.decrypt = decrypt;
+    _dma.cb = cb;
+    _dma.arg = arg;
+    _stats.async_ops++;
+    _dma_timer.callback = _dma_done;
+    _dma_timer.arg = &_dma;
+    xtimer_set(&_dma_timer, AES_MOCK_DELAY);
+    return 0;
+}
+
+static int _init(cipher_context_t *ctx, const uint8_t *key, uint8_t key_size)
+{
+    if (!_enabled) {
+        return -ENODEV;
+    }
+    if (key_size != AES_KEY_SIZE) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+    /* the context only holds the key, it is expanded by the engine */
+    memcpy(ctx->context, key, AES_KEY_SIZE);
+    return 1;
+}
+
+static int _encrypt(const cipher_context_t *ctx, const uint8_t *input,
+                    uint8_t *output)
+{
+    return _crypt(ctx, input, output, 1, false);
+}
+
+static int _decrypt(const cipher_context_t *ctx, const uint8_t *input,
+                    uint8_t *output)
+{
+    return _crypt(ctx, input, output, 1, true);
+}
+
+static int _encrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t num)
+{
+    return _crypt(ctx, input, output, num, false);
+}
+
+static int _decrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t num)
+{
+    return _crypt(ctx, input, output, num, true);
+}
+
+static int _encrypt_blocks_async(const cipher_context_t *ctx,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t num, cipher_cb_t cb, void *arg)
+{
+    return _crypt_async(ctx, input, output, num, false, cb, arg);
+}
+
+static int _decrypt_blocks_async(const cipher_context_t *ctx,
+                                 const uint8_t *input, uint8_t *output,
+                                 size_t num, cipher_cb_t cb, void *arg)
+{
+    return _crypt_async(ctx, input, output, num, true, cb, arg);
+}
+
+void aes_mock_init(void)
+{
+    _enabled = true;
+    _backend.cipher = CIPHER_AES_128;
+    _backend.interface = &_interface;
+    cipher_hw_register(&_backend);
+}
+
+void aes_mock_enable(bool enable)
+{
+    _enabled = enable;
+}
+
+void aes_mock_get_stats(aes_mock_stats_t *stats)
+{
+    mutex_lock(&_lock);
+    *stats = _stats;
+    mutex_unlock(&_lock);
+}
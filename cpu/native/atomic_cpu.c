@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Atomic compare and swap for the native port
+ *
+ * Interrupts of native are signals delivered to the same process, which can
+ * not interrupt a single atomic instruction of the host. The generic
+ * implementation masks the signals instead, which takes two system calls.
+ *
+ * @}
+ */
+
+#include "atomic.h"
+
+int atomic_cas(atomic_int_t *var, int old, int now)
+{
+    return __sync_bool_compare_and_swap(&ATOMIC_VALUE(*var), old, now);
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_i2c_mock
+ * @{
+ *
+ * @file
+ * @brief       Mock I2C bus implementation
+ *
+ * @}
+ */
+
+#include <stddef.h>
+
+#include "mutex.h"
+#include "periph/i2c.h"
+#include "xtimer.h"
+
+#include "i2c_mock.h"
+
+/* bits per byte on the wire, including the acknowledge bit */
+#define BITS_PER_BYTE   (9U)
+
+typedef struct {
+    uint8_t address;
+    uint8_t ptr;
+    i2c_mock_dev_t dev;
+    void *arg;
+} _dev_t;
+
+static mutex_t _lock = MUTEX_INIT;
+static _dev_t _devs[I2C_MOCK_DEVS];
+static unsigned _devs_numof;
+static i2c_mock_stats_t _stats;
+
+/* bus time per byte in ns and the bus time not spent yet */
+static uint32_t _byte_ns;
+static uint32_t _owed_ns;
+
+static const uint32_t _speeds[] = {
+    [I2C_SPEED_LOW] = 10000LU,
+    [I2C_SPEED_NORMAL] = 100000LU,
+    [I2C_SPEED_FAST] = 400000LU,
+    [I2C_SPEED_FAST_PLUS] = 1000000LU,
+    [I2C_SPEED_HIGH] = 3400000LU,
+};
+
+static _dev_t *_find(uint8_t address)
+{
+    for (unsigned i = 0; i < _devs_numof; i++) {
+        if (_devs[i].address == address) {
+            return &_devs[i];
+        }
+    }
+    return NULL;
+}
+
+/* spends the bus time of a transaction of length bytes */
+static void _transaction(unsigned length)
+{
+    uint64_t ns = ((uint64_t)length * _byte_ns) + _owed_ns;
+
+    _stats.transactions++;
+    _stats.bytes += length;
+    _owed_ns = ns % 1000;
+    xtimer_spin((uint32_t)(ns / 1000));
+}
+
+static int _read(uint8_t address, char *data, int length, unsigned extra)
+{
+    _dev_t *dev = _find(address);
+
+    /* the address byte is sent in any case, but not acknowledged */
+    if (dev == NULL) {
+        _transaction(1);
+        return -1;
+    }
+    for (int i = 0; i < length; i++) {
+        data[i] = (char)dev->dev(dev->arg, dev->ptr++, 0, 0);
+    }
+    _transaction(extra + 1 + length);
+    return length;
+}
+
+static int _write(uint8_t address, const char *data, int length)
+{
+    _dev_t *dev = _find(address);
+
+    if (dev == NULL) {
+        _transaction(1);
+        return -1;
+    }
+    if (length > 0) {
+        dev->ptr = (uint8_t)data[0];
+    }
+    for (int i = 1; i < length; i++) {
+        dev->dev(dev->arg, dev->ptr++, 1, (uint8_t)data[i]);
+    }
+    _transaction(1 + length);
+    return length;
+}
+
+int i2c_mock_attach(uint8_t address, i2c_mock_dev_t dev, void *arg)
+{
+    if (_devs_numof == I2C_MOCK_DEVS) {
+        return -1;
+    }
+    _devs[_devs_numof].address = address;
+    _devs[_devs_numof].ptr = 0;
+    _devs[_devs_numof].dev = dev;
+    _devs[_devs_numof].arg = arg;
+    _devs_numof++;
+    return 0;
+}
+
+void i2c_mock_get_stats(i2c_mock_stats_t *stats)
+{
+    *stats = _stats;
+}
+
+int i2c_init_master(i2c_t dev, i2c_speed_t speed)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    if ((unsigned)speed >= (sizeof(_speeds) / sizeof(_speeds[0]))) {
+        return -2;
+    }
+    _byte_ns = (BITS_PER_BYTE * 1000000000LU) / _speeds[speed];
+    return 0;
+}
+
+int i2c_acquire(i2c_t dev)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    mutex_lock(&_lock);
+    _stats.acquires++;
+    return 0;
+}
+
+int i2c_release(i2c_t dev)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+int i2c_read_byte(i2c_t dev, uint8_t address, char *data)
+{
+    return i2c_read_bytes(dev, address, data, 1);
+}
+
+int i2c_read_bytes(i2c_t dev, uint8_t address, char *data, int length)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    return _read(address, data, length, 0);
+}
+
+int i2c_read_reg(i2c_t dev, uint8_t address, uint8_t reg, char *data)
+{
+    return i2c_read_regs(dev, address, reg, data, 1);
+}
+
+int i2c_read_regs(i2c_t dev, uint8_t address, uint8_t reg,
+                  char *data, int length)
+{
+    _dev_t *d = _find(address);
+
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    if (d != NULL) {
+        d->ptr = reg;
+    }
+    /* address and register, then a repeated start with the address, in one
+     * transaction */
+    return _read(address, data, length, 2);
+}
+
+int i2c_write_byte(i2c_t dev, uint8_t address, char data)
+{
+    return i2c_write_bytes(dev, address, &data, 1);
+}
+
+int i2c_write_bytes(i2c_t dev, uint8_t address, char *data, int length)
+{
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    return _write(address, data, length);
+}
+
+int i2c_write_reg(i2c_t dev, uint8_t address, uint8_t reg, char data)
+{
+    return i2c_write_regs(dev, address, reg, &data, 1);
+}
+
+int i2c_write_regs(i2c_t dev, uint8_t address, uint8_t reg,
+                   char *data, int length)
+{
+    _dev_t *d = _find(address);
+
+    if (dev >= I2C_NUMOF) {
+        return -1;
+    }
+    if (d == NULL) {
+        _transaction(1);
+        return -1;
+    }
+    d->ptr = reg;
+    for (int i = 0; i < length; i++) {
+        d->dev(d->arg, d->ptr++, 1, (uint8_t)data[i]);
+    }
+    _transaction(2 + length);
+    return length;
+}
+
+void i2c_poweron(i2c_t dev)
+{
+    (void)dev;
+}
+
+void i2c_poweroff(i2c_t dev)
+{
+    (void)dev;
+}
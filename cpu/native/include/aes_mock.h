@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @defgroup    native_aes_mock Mock AES accelerator
+ * @brief       AES-128 hardware backend of the cipher API for native
+ *
+ * The mock behaves like the AES engines of MCUs: it holds one key at a time
+ * that is loaded when a cipher with a different key uses it, and it processes
+ * asynchronous operations in the background and signals their end from
+ * interrupt context. The blocks themselves are encrypted by the software
+ * AES implementation.
+ *
+ * It allows to run the tests of the cipher API and the modes of operation
+ * through the same code paths as a hardware driver without the hardware.
+ * The cipher contexts need room for an AES key, so CRYPTO_AES has to be
+ * defined.
+ * @{
+ *
+ * @file
+ * @brief       Mock AES accelerator interface
+ */
+#ifndef AES_MOCK_H
+#define AES_MOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Time in microseconds until an asynchronous operation is finished
+ */
+#ifndef AES_MOCK_DELAY
+#define AES_MOCK_DELAY      (100U)
+#endif
+
+/**
+ * @brief   Statistics of the engine
+ */
+typedef struct {
+    uint32_t blocks;        /**< blocks processed */
+    uint32_t key_loads;     /**< keys loaded into the engine */
+    uint32_t async_ops;     /**< asynchronous operations started */
+} aes_mock_stats_t;
+
+/**
+ * @brief   Registers the mock as backend of CIPHER_AES_128
+ */
+void aes_mock_init(void);
+
+/**
+ * @brief   Enables or disables the engine
+ *
+ * A disabled engine refuses to initialize ciphers, so cipher_init() falls
+ * back to the software implementation. It is enabled after aes_mock_init().
+ *
+ * @param[in] enable    true to enable the engine
+ */
+void aes_mock_enable(bool enable);
+
+/**
+ * @brief   Gets the statistics of the engine
+ *
+ * @param[out] stats    the statistics
+ */
+void aes_mock_get_stats(aes_mock_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AES_MOCK_H */
+/** @} */
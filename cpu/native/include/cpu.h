@@ -26,6 +26,12 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   native has an atomic_cas() without masking signals in
+ *          atomic_cpu.c
+ */
+#define ARCH_HAS_ATOMIC_COMPARE_AND_SWAP 1
+
 /**
  * @brief   Prints the address the callee will return to
  */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @defgroup    native_i2c_mock Mock I2C bus
+ * @brief       I2C_0 for native, with models of the devices on the bus
+ *
+ * With `USEMODULE += i2c_mock`, native provides I2C_0. The devices on the
+ * bus are functions attached to a bus address, which read and write one
+ * register at a time. Like most devices, the mock keeps a register pointer
+ * per device, which is set by the first byte written and incremented by
+ * every byte read or written after it.
+ *
+ * Transactions take as long as on the wire at the speed given to
+ * i2c_init_master(), including the address byte and, for register reads,
+ * the repeated start. The statistics count bus acquisitions, transactions
+ * and bytes, so the bus traffic of a driver can be compared without
+ * hardware.
+ * @{
+ *
+ * @file
+ * @brief       Mock I2C bus interface
+ */
+#ifndef I2C_MOCK_H
+#define I2C_MOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of devices on the bus
+ */
+#ifndef I2C_MOCK_DEVS
+#define I2C_MOCK_DEVS       (4U)
+#endif
+
+/**
+ * @brief   Model of a device on the bus
+ *
+ * @param[in] arg       argument given to i2c_mock_attach()
+ * @param[in] reg       register to access
+ * @param[in] write     1 to write @p value to @p reg, 0 to read @p reg
+ * @param[in] value     value to write
+ *
+ * @return      the value of @p reg when reading
+ */
+typedef uint8_t (*i2c_mock_dev_t)(void *arg, uint8_t reg, int write,
+                                  uint8_t value);
+
+/**
+ * @brief   Statistics of the bus
+ */
+typedef struct {
+    uint32_t acquires;      /**< calls of i2c_acquire() */
+    uint32_t transactions;  /**< transactions from start to stop condition */
+    uint32_t bytes;         /**< bytes on the bus, including addresses */
+} i2c_mock_stats_t;
+
+/**
+ * @brief   Attaches the model of a device to the bus
+ *
+ * @param[in] address   7-bit bus address of the device
+ * @param[in] dev       model of the device
+ * @param[in] arg       argument passed to @p dev
+ *
+ * @return      0 on success
+ * @return      -1 if there are @ref I2C_MOCK_DEVS devices already
+ */
+int i2c_mock_attach(uint8_t address, i2c_mock_dev_t dev, void *arg);
+
+/**
+ * @brief   Gets the statistics of the bus
+ *
+ * @param[out] stats    the statistics
+ */
+void i2c_mock_get_stats(i2c_mock_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_MOCK_H */
+/** @} */
@@ -72,6 +72,26 @@
 #endif
 /** @} */
 
+/**
+ * @brief SPI configuration, provided by the spi_mock module
+ * @{
+ */
+#ifdef MODULE_SPI_MOCK
+#define SPI_NUMOF (1U)
+#define SPI_0_EN  (1)
+#endif
+/** @} */
+
+/**
+ * @brief I2C configuration, provided by the i2c_mock module
+ * @{
+ */
+#ifdef MODULE_I2C_MOCK
+#define I2C_NUMOF (1U)
+#define I2C_0_EN  (1)
+#endif
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
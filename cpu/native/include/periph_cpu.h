@@ -32,6 +32,23 @@ extern "C" {
 #define CPUID_LEN           (4U)
 #endif
 
+/**
+ * @brief   The UART emulation implements uart_write_async()
+ */
+#define PERIPH_UART_HAS_WRITE_ASYNC
+
+#ifdef MODULE_SPI_MOCK
+/**
+ * @brief   Declare needed generic SPI functions, the mock SPI bus transfers
+ *          segments asynchronously
+ * @{
+ */
+#define PERIPH_SPI_NEEDS_TRANSFER_REG
+#define PERIPH_SPI_NEEDS_TRANSFER_REGS
+#define PERIPH_SPI_HAS_SEGS_ASYNC
+/** @} */
+#endif
+
 #ifdef __cplusplus
 }
 #endif
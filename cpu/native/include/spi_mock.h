@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @defgroup    native_spi_mock Mock SPI bus
+ * @brief       SPI_0 for native, with models of the devices on the bus
+ *
+ * With `USEMODULE += spi_mock`, native provides SPI_0. The devices on the
+ * bus are functions attached to a chip select pin, which exchange one byte
+ * with the master at a time. gpio_clear() and gpio_set() of native select
+ * and deselect them.
+ *
+ * Transfers take as long as on the wire at the speed given to
+ * spi_init_master(): blocking ones spin for that time, the ones of
+ * spi_transfer_segs_async() signal their end from interrupt context like a
+ * DMA controller. This allows to run spi_queue() and the drivers using it
+ * through the same code paths as on hardware and to compare the time their
+ * callers block for.
+ * @{
+ *
+ * @file
+ * @brief       Mock SPI bus interface
+ */
+#ifndef SPI_MOCK_H
+#define SPI_MOCK_H
+
+#include <stdint.h>
+
+#include "periph/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of devices on the bus
+ */
+#ifndef SPI_MOCK_DEVS
+#define SPI_MOCK_DEVS       (4U)
+#endif
+
+/**
+ * @brief   Model of a device on the bus
+ *
+ * @param[in] arg       argument given to spi_mock_attach()
+ * @param[in] pos       number of bytes exchanged since the device was
+ *                      selected
+ * @param[in] out       byte sent by the master
+ *
+ * @return      the byte the device sends to the master
+ */
+typedef uint8_t (*spi_mock_dev_t)(void *arg, unsigned pos, uint8_t out);
+
+/**
+ * @brief   Statistics of the bus
+ */
+typedef struct {
+    uint32_t transfers;     /**< transfer operations */
+    uint32_t bytes;         /**< bytes transferred */
+    uint32_t async_ops;     /**< asynchronous operations started */
+} spi_mock_stats_t;
+
+/**
+ * @brief   Attaches the model of a device to the bus
+ *
+ * @param[in] cs        chip select of the device
+ * @param[in] dev       model of the device
+ * @param[in] arg       argument passed to @p dev
+ *
+ * @return      0 on success
+ * @return      -1 if there are @ref SPI_MOCK_DEVS devices already
+ */
+int spi_mock_attach(gpio_t cs, spi_mock_dev_t dev, void *arg);
+
+/**
+ * @brief   Gets the statistics of the bus
+ *
+ * @param[out] stats    the statistics
+ */
+void spi_mock_get_stats(spi_mock_stats_t *stats);
+
+/**
+ * @brief   Selects or deselects the device with the given chip select
+ *
+ * Called by gpio_clear() and gpio_set().
+ *
+ * @param[in] cs        chip select pin
+ * @param[in] select    1 to select the device, 0 to deselect it
+ */
+void spi_mock_cs(gpio_t cs, int select);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_MOCK_H */
+/** @} */
@@ -18,6 +18,10 @@
 
 #include "periph/gpio.h"
 
+#ifdef MODULE_SPI_MOCK
+#include "spi_mock.h"
+#endif
+
 int gpio_init(gpio_t pin, gpio_mode_t mode) {
   (void) pin;
   (void) mode;
@@ -51,11 +55,19 @@ int gpio_read(gpio_t pin) {
 }
 
 void gpio_set(gpio_t pin) {
+#ifdef MODULE_SPI_MOCK
+  spi_mock_cs(pin, 0);
+#else
   (void) pin;
+#endif
 }
 
 void gpio_clear(gpio_t pin) {
+#ifdef MODULE_SPI_MOCK
+  spi_mock_cs(pin, 1);
+#else
   (void) pin;
+#endif
 }
 
 void gpio_toggle(gpio_t pin) {
@@ -63,7 +75,11 @@ void gpio_toggle(gpio_t pin) {
 }
 
 void gpio_write(gpio_t pin, int value) {
+#ifdef MODULE_SPI_MOCK
+  spi_mock_cs(pin, !value);
+#else
   (void) pin;
   (void) value;
+#endif
 }
 /** @} */
@@ -13,16 +13,26 @@
  * @file
  * @brief       UART implementation based on /dev/tty devices on host
  *
+ * Writes take as long as the transmission at the configured baudrate would
+ * take on the wire, so the time callers block for is comparable to the one
+ * on real hardware. uart_write_async() completes by a POSIX timer that
+ * expires at the end of the modelled transmission. Without POSIX timers,
+ * i.e. on OS X, writes return right away.
+ *
  * @author      Takuo Yonezawa <Yonezawa-T2@mail.dnp.co.jp>
  */
 
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <signal.h>
+#include <stdint.h>
 #include <string.h>
 #include <termios.h>
+#include <time.h>
 #include <fcntl.h>
 
+#include "irq.h"
 #include "thread.h"
 #include "periph/uart.h"
 #include "native_internal.h"
@@ -46,6 +56,76 @@ static char *tty_device_filenames[UART_NUMOF];
  */
 static int tty_fds[UART_NUMOF];
 
+/**
+ * @brief completion callbacks of asynchronous writes, NULL if none is in
+ *        flight
+ */
+static uart_tx_cb_t tx_cb[UART_NUMOF];
+static void *tx_arg[UART_NUMOF];
+
+#ifndef __MACH__
+/**
+ * @brief signal of the timers completing asynchronous writes
+ */
+#define TX_SIGNAL   (SIGRTMIN)
+
+#define NS_PER_SEC  (1000000000LL)
+
+/**
+ * @brief nanoseconds per character at the configured baudrate
+ */
+static uint32_t char_ns[UART_NUMOF];
+
+/**
+ * @brief end of the modelled transmission on the wire, nanoseconds
+ */
+static int64_t tx_end[UART_NUMOF];
+
+/**
+ * @brief timers completing asynchronous writes
+ */
+static timer_t tx_timer[UART_NUMOF];
+static int tx_timer_used[UART_NUMOF];
+
+static int64_t now_ns(void)
+{
+    struct timespec t;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((int64_t)t.tv_sec * NS_PER_SEC) + t.tv_nsec;
+}
+
+/**
+ * @brief models the transmission of len bytes after the ones on the wire
+ *
+ * @return  the end of the transmission
+ */
+static int64_t tx_schedule(uart_t uart, size_t len)
+{
+    int64_t start = now_ns();
+
+    if (tx_end[uart] > start) {
+        start = tx_end[uart];
+    }
+    tx_end[uart] = start + ((int64_t)len * char_ns[uart]);
+    return tx_end[uart];
+}
+
+static void tx_signal_handler(void)
+{
+    int64_t now = now_ns();
+
+    for (uart_t uart = 0; uart < UART_NUMOF; uart++) {
+        if ((tx_cb[uart] != NULL) && (now >= tx_end[uart])) {
+            uart_tx_cb_t cb = tx_cb[uart];
+
+            tx_cb[uart] = NULL;
+            cb(tx_arg[uart]);
+        }
+    }
+}
+#endif
+
 void tty_uart_setup(uart_t uart, const char *filename)
 {
     tty_device_filenames[uart] = strndup(filename, PATH_MAX - 1);
@@ -140,6 +220,25 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     cfsetospeed(&termios, speed);
     cfsetispeed(&termios, speed);
 
+#ifndef __MACH__
+    /* start, 8 data and stop bit */
+    char_ns[uart] = (baudrate) ? (uint32_t)((10 * NS_PER_SEC) / baudrate) : 0;
+    tx_end[uart] = 0;
+
+    if (!tx_timer_used[uart]) {
+        struct sigevent sev;
+
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = TX_SIGNAL;
+        if (timer_create(CLOCK_MONOTONIC, &sev, &tx_timer[uart]) != 0) {
+            return -3;
+        }
+        tx_timer_used[uart] = 1;
+        register_interrupt(TX_SIGNAL, tx_signal_handler);
+    }
+#endif
+
     tty_fds[uart] = real_open(tty_device_filenames[uart], O_RDWR | O_NONBLOCK);
 
     if (tty_fds[uart] < 0) {
@@ -173,6 +272,59 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
     DEBUG("\n");
 
     _native_write(tty_fds[uart], data, len);
+
+#ifndef __MACH__
+    struct timespec end;
+    int64_t end_ns = tx_schedule(uart, len);
+
+    if (irq_is_in()) {
+        /* interrupts are not served meanwhile, don't stall them */
+        return;
+    }
+    end.tv_sec = end_ns / NS_PER_SEC;
+    end.tv_nsec = end_ns % NS_PER_SEC;
+    /* interrupted by signals, which are served in between */
+    do {
+        _native_syscall_enter();
+        int res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &end, NULL);
+        _native_syscall_leave();
+        if (res != EINTR) {
+            break;
+        }
+    } while (1);
+#endif
+}
+
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_cb_t cb, void *arg)
+{
+    unsigned state = irq_disable();
+
+    if (tx_cb[uart] != NULL) {
+        irq_restore(state);
+        return -EBUSY;
+    }
+    DEBUG("writing %u bytes asynchronously to serial port\n", (unsigned)len);
+
+    _native_write(tty_fds[uart], data, len);
+
+#ifdef __MACH__
+    irq_restore(state);
+    cb(arg);
+#else
+    struct itimerspec its;
+    int64_t end_ns = tx_schedule(uart, len);
+
+    tx_cb[uart] = cb;
+    tx_arg[uart] = arg;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = end_ns / NS_PER_SEC;
+    its.it_value.tv_nsec = end_ns % NS_PER_SEC;
+    timer_settime(tx_timer[uart], TIMER_ABSTIME, &its, NULL);
+    irq_restore(state);
+#endif
+
+    return 0;
 }
 
 void uart_cleanup(void) {
@@ -182,7 +334,16 @@ void uart_cleanup(void) {
         if (uart_config[uart].rx_cb != NULL) {
             real_close(tty_fds[uart]);
         }
+#ifndef __MACH__
+        if (tx_timer_used[uart]) {
+            timer_delete(tx_timer[uart]);
+            tx_timer_used[uart] = 0;
+        }
+#endif
     }
+#ifndef __MACH__
+    unregister_interrupt(TX_SIGNAL);
+#endif
 }
 
 /** @} */
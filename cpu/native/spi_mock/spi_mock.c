@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_spi_mock
+ * @{
+ *
+ * @file
+ * @brief       Mock SPI bus implementation
+ *
+ * @}
+ */
+
+#include <stddef.h>
+
+#include "mutex.h"
+#include "periph/spi.h"
+#include "xtimer.h"
+
+#include "spi_mock.h"
+
+/* value of MISO if no device drives it */
+#define IDLE_BYTE       (0xff)
+
+typedef struct {
+    gpio_t cs;
+    spi_mock_dev_t dev;
+    void *arg;
+    unsigned pos;
+} _dev_t;
+
+/* the pending asynchronous operation, like the registers of a DMA channel */
+typedef struct {
+    const spi_seg_t *segs;
+    unsigned int numof;
+    void (*cb)(void *arg);
+    void *arg;
+} _dma_t;
+
+static mutex_t _lock = MUTEX_INIT;
+static _dev_t _devs[SPI_MOCK_DEVS];
+static unsigned _devs_numof;
+static _dev_t *_selected;
+static spi_mock_stats_t _stats;
+
+/* bus time per byte in ns and the bus time not spent yet */
+static uint32_t _byte_ns;
+static uint32_t _owed_ns;
+
+static _dma_t _dma;
+static xtimer_t _dma_timer;
+
+static const uint32_t _speeds[] = {
+    [SPI_SPEED_100KHZ] = 100000LU,
+    [SPI_SPEED_400KHZ] = 400000LU,
+    [SPI_SPEED_1MHZ] = 1000000LU,
+    [SPI_SPEED_5MHZ] = 5000000LU,
+    [SPI_SPEED_10MHZ] = 10000000LU,
+};
+
+static uint8_t _exchange(uint8_t out)
+{
+    if (_selected == NULL) {
+        return IDLE_BYTE;
+    }
+    return _selected->dev(_selected->arg, _selected->pos++, out);
+}
+
+static void _transfer(const char *out, char *in, unsigned int length)
+{
+    for (unsigned int i = 0; i < length; i++) {
+        uint8_t byte = _exchange((out) ? (uint8_t)out[i] : 0);
+        if (in) {
+            in[i] = (char)byte;
+        }
+    }
+    _stats.bytes += length;
+}
+
+/* returns the bus time of length bytes in microseconds */
+static uint32_t _bus_time(unsigned int length)
+{
+    uint64_t ns = ((uint64_t)length * _byte_ns) + _owed_ns;
+
+    _owed_ns = ns % 1000;
+    return (uint32_t)(ns / 1000);
+}
+
+static void _dma_done(void *arg)
+{
+    _dma_t *dma = arg;
+
+    for (unsigned int i = 0; i < dma->numof; i++) {
+        _transfer(dma->segs[i].out, dma->segs[i].in, dma->segs[i].length);
+    }
+    dma->cb(dma->arg);
+}
+
+int spi_mock_attach(gpio_t cs, spi_mock_dev_t dev, void *arg)
+{
+    if (_devs_numof == SPI_MOCK_DEVS) {
+        return -1;
+    }
+    _devs[_devs_numof].cs = cs;
+    _devs[_devs_numof].dev = dev;
+    _devs[_devs_numof].arg = arg;
+    _devs_numof++;
+    return 0;
+}
+
+void spi_mock_get_stats(spi_mock_stats_t *stats)
+{
+    *stats = _stats;
+}
+
+void spi_mock_cs(gpio_t cs, int select)
+{
+    for (unsigned i = 0; i < _devs_numof; i++) {
+        if (_devs[i].cs == cs) {
+            _devs[i].pos = 0;
+            if (select) {
+                _selected = &_devs[i];
+            }
+            else if (_selected == &_devs[i]) {
+                _selected = NULL;
+            }
+            return;
+        }
+    }
+}
+
+int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
+{
+    (void)dev;
+    (void)conf;
+
+    if ((unsigned)speed >= (sizeof(_speeds) / sizeof(_speeds[0]))) {
+        return -1;
+    }
+    _byte_ns = (8 * 1000000000LU) / _speeds[speed];
+    return 0;
+}
+
+int spi_init_slave(spi_t dev, spi_conf_t conf, char (*cb)(char data))
+{
+    (void)dev;
+    (void)conf;
+    (void)cb;
+
+    return -1;
+}
+
+int spi_conf_pins(spi_t dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+int spi_acquire(spi_t dev)
+{
+    (void)dev;
+
+    mutex_lock(&_lock);
+    return 0;
+}
+
+int spi_release(spi_t dev)
+{
+    (void)dev;
+
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+int spi_transfer_byte(spi_t dev, char out, char *in)
+{
+    return spi_transfer_bytes(dev, &out, in, 1);
+}
+
+int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length)
+{
+    (void)dev;
+
+    _stats.transfers++;
+    _transfer(out, in, length);
+    xtimer_spin(_bus_time(length));
+    return length;
+}
+
+int spi_transfer_segs_async(spi_t dev, const spi_seg_t *segs,
+                            unsigned int numof, void (*cb)(void *arg),
+                            void *arg)
+{
+    unsigned int length = 0;
+
+    (void)dev;
+
+    for (unsigned int i = 0; i < numof; i++) {
+        length += segs[i].length;
+    }
+    _dma.segs = segs;
+    _dma.numof = numof;
+    _dma.cb = cb;
+    _dma.arg = arg;
+    _stats.transfers++;
+    _stats.async_ops++;
+    _dma_timer.callback = _dma_done;
+    _dma_timer.arg = &_dma;
+    xtimer_set(&_dma_timer, _bus_time(length));
+    return 0;
+}
+
+void spi_transmission_begin(spi_t dev, char reset_val)
+{
+    (void)dev;
+    (void)reset_val;
+}
+
+void spi_poweron(spi_t dev)
+{
+    (void)dev;
+}
+
+void spi_poweroff(spi_t dev)
+{
+    (void)dev;
+}
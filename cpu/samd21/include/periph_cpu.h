@@ -44,6 +44,11 @@ enum {
  */
 #define GPIO_MODE(pr, ie, pe)   (pr | (ie << 1) | (pe << 2))
 
+/**
+ * @brief   The UART driver sends asynchronously, interrupt driven
+ */
+#define PERIPH_UART_HAS_WRITE_ASYNC
+
 #ifndef DOXYGEN
 /**
  * @brief   Override GPIO modes
@@ -20,6 +20,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "cpu.h"
 #include "sched.h"
 #include "thread.h"
@@ -32,6 +34,17 @@
  */
 static uart_isr_ctx_t uart_ctx[UART_NUMOF];
 
+/**
+ * @brief   State of the asynchronous transmissions, fed by the data register
+ *          empty interrupt
+ */
+static struct {
+    const uint8_t *data;    /**< next byte to send */
+    volatile size_t left;   /**< number of bytes left, 0 if idle */
+    uart_tx_cb_t cb;        /**< completion callback */
+    void *arg;              /**< argument to the callback */
+} _tx[UART_NUMOF];
+
 /**
  * @brief   Get the pointer to the base register of the given UART device
  *
@@ -106,12 +119,30 @@ static int init_base(uart_t uart, uint32_t baudrate)
 
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
+    /* let an asynchronous transmission finish first */
+    while (_tx[uart].left) {}
+
     for (size_t i = 0; i < len; i++) {
         while (!(_uart(uart)->INTFLAG.reg & SERCOM_USART_INTFLAG_DRE)) {}
         _uart(uart)->DATA.reg = data[i];
     }
 }
 
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_cb_t cb, void *arg)
+{
+    if (_tx[uart].left) {
+        return -EBUSY;
+    }
+    _tx[uart].data = data;
+    _tx[uart].cb = cb;
+    _tx[uart].arg = arg;
+    _tx[uart].left = len;
+    /* the interrupt fires right away, as the data register is empty */
+    _uart(uart)->INTENSET.reg = SERCOM_USART_INTENSET_DRE;
+    return 0;
+}
+
 void uart_poweron(uart_t uart)
 {
     PM->APBCMASK.reg |= (PM_APBCMASK_SERCOM0 << _sercom_id(_uart(uart)));
@@ -142,6 +173,15 @@ static inline void irq_handler(int dev)
         /* clear error flag */
         uart->INTFLAG.reg = SERCOM_USART_INTFLAG_ERROR;
     }
+    if ((uart->INTENSET.reg & SERCOM_USART_INTENSET_DRE) &&
+        (uart->INTFLAG.reg & SERCOM_USART_INTFLAG_DRE)) {
+        /* interrupt flag is cleared by writing the data register */
+        uart->DATA.reg = *(_tx[dev].data++);
+        if (--_tx[dev].left == 0) {
+            uart->INTENCLR.reg = SERCOM_USART_INTENCLR_DRE;
+            _tx[dev].cb(_tx[dev].arg);
+        }
+    }
     if (sched_context_switch_request) {
         thread_yield();
     }
@@ -43,6 +43,11 @@ extern "C" {
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
 /** @} */
 
+/**
+ * @brief   The UART driver sends asynchronously by DMA
+ */
+#define PERIPH_UART_HAS_WRITE_ASYNC
+
 #ifndef DOXYGEN
 /**
  * @brief   Override the ADC resolution configuration
@@ -19,6 +19,8 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "cpu.h"
 #include "thread.h"
 #include "sched.h"
@@ -45,6 +47,21 @@ static inline USART_TypeDef *_dev(uart_t uart)
 static mutex_t _tx_dma_sync[UART_NUMOF];
 static mutex_t _tx_lock[UART_NUMOF];
 
+/**
+ * @brief   Completion callbacks of asynchronous transmissions, NULL for
+ *          blocking ones
+ */
+static uart_tx_cb_t _tx_cb[UART_NUMOF];
+static void *_tx_arg[UART_NUMOF];
+
+static inline void _dma_start(uart_t uart, const uint8_t *data, size_t len)
+{
+    DMA_Stream_TypeDef *stream = dma_stream(uart_config[uart].dma_stream);
+    stream->M0AR = (uint32_t)data;
+    stream->NDTR = (uint16_t)len;
+    stream->CR |= DMA_SxCR_EN;
+}
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     USART_TypeDef *dev;
@@ -120,17 +137,27 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
     }
     else {
         mutex_lock(&_tx_lock[uart]);
-        DMA_Stream_TypeDef *stream = dma_stream(uart_config[uart].dma_stream);
         /* configure and start DMA transfer */
-        stream->M0AR = (uint32_t)data;
-        stream->NDTR = (uint16_t)len;
-        stream->CR |= DMA_SxCR_EN;
+        _dma_start(uart, data, len);
         /* wait for transfer to complete */
         mutex_lock(&_tx_dma_sync[uart]);
         mutex_unlock(&_tx_lock[uart]);
     }
 }
 
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_cb_t cb, void *arg)
+{
+    /* the lock is released by the DMA interrupt */
+    if (!mutex_trylock(&_tx_lock[uart])) {
+        return -EBUSY;
+    }
+    _tx_cb[uart] = cb;
+    _tx_arg[uart] = arg;
+    _dma_start(uart, data, len);
+    return 0;
+}
+
 void uart_poweron(uart_t uart)
 {
     periph_clk_en(uart_config[uart].bus, uart_config[uart].rcc_mask);
@@ -156,7 +183,15 @@ static inline void dma_handler(int uart, int stream)
 {
     /* clear DMA done flag */
     dma_base(stream)->IFCR[dma_hl(stream)] = dma_ifc(stream);
-    mutex_unlock(&_tx_dma_sync[uart]);
+    if (_tx_cb[uart] != NULL) {
+        uart_tx_cb_t cb = _tx_cb[uart];
+        _tx_cb[uart] = NULL;
+        mutex_unlock(&_tx_lock[uart]);
+        cb(_tx_arg[uart]);
+    }
+    else {
+        mutex_unlock(&_tx_dma_sync[uart]);
+    }
     if (sched_context_switch_request) {
         thread_yield();
     }
@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2016 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Compile a schema of fixed records into CBOR encoders and decoders.
+
+usage: cborgen.py <schema.json> <header.h>
+
+See README.md for the format of the schema.
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import re
+import sys
+
+MAJOR_UINT = 0
+MAJOR_BYTES = 2
+MAJOR_ARRAY = 4
+MAJOR_MAP = 5
+
+# head and number of bytes of the argument of fixed width integers
+INTEGERS = {
+    'uint8': (0x18, 1), 'uint16': (0x19, 2),
+    'uint32': (0x1a, 4), 'uint64': (0x1b, 8),
+    'int8': (0x18, 1), 'int16': (0x19, 2),
+    'int32': (0x1a, 4), 'int64': (0x1b, 8),
+}
+CBORGEN_NEGATIVE = 0x20
+CBORGEN_FALSE = 0xf4
+CBORGEN_FLOAT32 = 0xfa
+
+LINE_MAX = 80
+
+
+class SchemaError(Exception):
+    pass
+
+
+def head(major, val):
+    """Returns the shortest head of an item, as used for the constant ones."""
+    if val < 24:
+        return [(major << 5) | val]
+    if val < 0x100:
+        return [(major << 5) | 24, val]
+    if val < 0x10000:
+        return [(major << 5) | 25, val >> 8, val & 0xff]
+    raise SchemaError('%d is too large for a container or a key' % val)
+
+
+def signature(prefix, params):
+    """Wraps the parameters of a function like the rest of RIOT does."""
+    line = '%s(%s)' % (prefix, ', '.join(params))
+    if len(line) <= LINE_MAX:
+        return [line]
+    lines = []
+    line = prefix + '(' + params[0]
+    indent = ' ' * (len(prefix) + 1)
+    for param in params[1:]:
+        if len(line) + len(param) + 3 > LINE_MAX:
+            lines.append(line + ',')
+            line = indent + param
+        else:
+            line += ', ' + param
+    lines.append(line + ')')
+    return lines
+
+
+class Codec(object):
+    """The layout of one record, collected as lines of C code."""
+
+    def __init__(self):
+        self.offset = 0
+        self.encode = []
+        self.checks = []
+        self.decode = []
+
+    def const(self, data):
+        for byte in data:
+            self.encode.append('buf[%d] = 0x%02x;' % (self.offset, byte))
+            self.checks.append('(buf[%d] != 0x%02x)' % (self.offset, byte))
+            self.offset += 1
+
+
+class Generator(object):
+
+    def __init__(self, schema):
+        self.includes = schema.get('include', [])
+        self.records = []
+        self.by_name = {}
+        for record in schema['records']:
+            name = record['name']
+            if not re.match(r'^[a-z_][a-z0-9_]*$', name):
+                raise SchemaError('invalid record name "%s"' % name)
+            if name in self.by_name:
+                raise SchemaError('record "%s" defined twice' % name)
+            if not record.get('fields'):
+                raise SchemaError('record "%s" has no fields' % name)
+            self.records.append(record)
+            self.by_name[name] = record
+
+    def ctype(self, record):
+        return record.get('type', '%s_t' % record['name'])
+
+    def field_ctype(self, field):
+        kind = field['type']
+        if kind in INTEGERS:
+            return '%s_t' % kind
+        if kind in ('bool', 'float'):
+            return kind
+        if kind == 'bytes':
+            return 'uint8_t'
+        if kind in self.by_name:
+            return self.ctype(self.by_name[kind])
+        raise SchemaError('unknown type "%s"' % kind)
+
+    def layout(self, codec, record, member, seen=()):
+        if record['name'] in seen:
+            raise SchemaError('record "%s" contains itself' % record['name'])
+        fields = record['fields']
+        keys = [f for f in fields if 'key' in f]
+        if keys and len(keys) != len(fields):
+            raise SchemaError('either all or no fields of "%s" need a key' %
+                              record['name'])
+        codec.const(head(MAJOR_MAP if keys else MAJOR_ARRAY, len(fields)))
+        for field in fields:
+            if keys:
+                codec.const(head(MAJOR_UINT, field['key']))
+            name = member + field['name']
+            if 'count' in field:
+                codec.const(head(MAJOR_ARRAY, field['count']))
+                for i in range(field['count']):
+                    self.value(codec, field, '%s[%d]' % (name, i),
+                               seen + (record['name'],))
+            else:
+                self.value(codec, field, name, seen + (record['name'],))
+
+    def value(self, codec, field, member, seen):
+        kind = field['type']
+        off = codec.offset
+        if kind in INTEGERS:
+            initial, size = INTEGERS[kind]
+            codec.encode.append('cborgen_put_%s(&buf[%d], in->%s);' %
+                                (kind, off, member))
+            codec.decode.append('out->%s = cborgen_get_%s(&buf[%d]);' %
+                                (member, kind, off))
+            if kind.startswith('u'):
+                codec.checks.append('(buf[%d] != 0x%02x)' % (off, initial))
+            else:
+                codec.checks.append('((buf[%d] & 0x%02x) != 0x%02x)' %
+                                    (off, ~CBORGEN_NEGATIVE & 0xff, initial))
+                # the argument must fit into the signed type
+                codec.checks.append('(buf[%d] & 0x80)' % (off + 1))
+            codec.offset += 1 + size
+        elif kind == 'bool':
+            codec.encode.append('buf[%d] = 0x%02x | (in->%s != 0);' %
+                                (off, CBORGEN_FALSE, member))
+            codec.decode.append('out->%s = buf[%d] & 0x01;' % (member, off))
+            codec.checks.append('((buf[%d] & 0xfe) != 0x%02x)' %
+                                (off, CBORGEN_FALSE))
+            codec.offset += 1
+        elif kind == 'float':
+            codec.encode.append('cborgen_put_float(&buf[%d], in->%s);' %
+                                (off, member))
+            codec.decode.append('out->%s = cborgen_get_float(&buf[%d]);' %
+                                (member, off))
+            codec.checks.append('(buf[%d] != 0x%02x)' % (off, CBORGEN_FLOAT32))
+            codec.offset += 5
+        elif kind == 'bytes':
+            size = field.get('size', 0)
+            if size <= 0:
+                raise SchemaError('bytes field "%s" needs a size' % member)
+            codec.const(head(MAJOR_BYTES, size))
+            off = codec.offset
+            codec.encode.append('memcpy(&buf[%d], in->%s, %d);' %
+                                (off, member, size))
+            codec.decode.append('memcpy(out->%s, &buf[%d], %d);' %
+                                (member, off, size))
+            codec.offset += size
+        elif kind in self.by_name:
+            self.layout(codec, self.by_name[kind], member + '.', seen)
+        else:
+            raise SchemaError('unknown type "%s"' % kind)
+
+    def typedef(self, record):
+        lines = ['typedef struct {']
+        for field in record['fields']:
+            ctype = self.field_ctype(field)
+            name = field['name']
+            if 'count' in field:
+                name += '[%d]' % field['count']
+            if field['type'] == 'bytes':
+                name += '[%d]' % field['size']
+            lines.append('    %s %s;' % (ctype, name))
+        lines.append('} %s;' % self.ctype(record))
+        return lines
+
+    def functions(self, record):
+        codec = Codec()
+        self.layout(codec, record, '')
+        name = record['name']
+        ctype = self.ctype(record)
+        size = '%s_CBOR_SIZE' % name.upper()
+
+        lines = ['#define %s (%dU)' % (size, codec.offset), '']
+
+        lines += signature('static inline size_t %s_cbor_encode' % name,
+                           ['const %s *in' % ctype, 'uint8_t *buf',
+                            'size_t len'])
+        lines.append('{')
+        lines.append('    if (len < %s) {' % size)
+        lines.append('        return 0;')
+        lines.append('    }')
+        lines += ['    ' + line for line in codec.encode]
+        lines.append('    return %s;' % size)
+        lines.append('}')
+        lines.append('')
+
+        lines += signature('static inline size_t %s_cbor_decode' % name,
+                           ['%s *out' % ctype, 'const uint8_t *buf',
+                            'size_t len'])
+        lines.append('{')
+        # pack the checks of the heads into as few lines as possible
+        line = '    if ((len < %s)' % size
+        for check in codec.checks:
+            if len(line) + len(check) + 7 > LINE_MAX:
+                lines.append(line + ' ||')
+                line = '        ' + check
+            else:
+                line += ' || ' + check
+        lines.append(line + ') {')
+        lines.append('        return 0;')
+        lines.append('    }')
+        lines += ['    ' + line for line in codec.decode]
+        lines.append('    return %s;' % size)
+        lines.append('}')
+        return lines
+
+    def header(self, schema_name, guard):
+        lines = [
+            '/*',
+            ' * Generated by dist/tools/cborgen/cborgen.py from %s.' %
+            schema_name,
+            ' * Do not edit, change the schema instead.',
+            ' */',
+            '',
+            '#ifndef %s' % guard,
+            '#define %s' % guard,
+            '',
+            '#include <stdbool.h>',
+            '#include <stddef.h>',
+            '#include <stdint.h>',
+            '#include <string.h>',
+            '',
+            '#include "cborgen.h"',
+        ]
+        lines += ['#include "%s"' % inc for inc in self.includes]
+        lines += ['', '#ifdef __cplusplus', 'extern "C" {', '#endif']
+        for record in self.records:
+            lines.append('')
+            if 'type' not in record:
+                lines += self.typedef(record)
+                lines.append('')
+            lines += self.functions(record)
+        lines += ['', '#ifdef __cplusplus', '}', '#endif', '',
+                  '#endif /* %s */' % guard]
+        return '\n'.join(lines) + '\n'
+
+
+def main(argv):
+    if len(argv) != 3:
+        print('usage: %s <schema.json> <header.h>' % argv[0], file=sys.stderr)
+        return 1
+
+    try:
+        with open(argv[1]) as f:
+            schema = json.load(f)
+        base = os.path.splitext(os.path.basename(argv[2]))[0]
+        guard = re.sub(r'[^A-Z0-9]', '_', base.upper()) + '_H'
+        text = Generator(schema).header(os.path.basename(argv[1]), guard)
+    except KeyError as e:
+        print('%s: %s: missing %s' % (argv[0], argv[1], e), file=sys.stderr)
+        return 1
+    except (ValueError, SchemaError) as e:
+        print('%s: %s: %s' % (argv[0], argv[1], e), file=sys.stderr)
+        return 1
+
+    with open(argv[2], 'w') as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
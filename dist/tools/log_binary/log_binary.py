@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2016 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Format the records of the log_binary module.
+
+usage: log_binary.py <app.elf> [<input>]
+
+Reads the output of an application from <input> or stdin, formats the log
+records with the format strings from <app.elf> and passes all other output
+through. See README.md.
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LOG = 0xa5
+LOST = 0xa6
+HDR = 0xa7
+MARKERS = (LOG, LOST, HDR)
+TRUNCATED = 0x80
+
+SHF_ALLOC = 0x2
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+
+CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?'
+                        r'(hh|h|ll|l|j|z|t|L)?(.)')
+
+
+class Elf(object):
+    """The allocated sections and the symbols of an ELF file."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is no ELF file' % path)
+        is64 = bytearray(self.data)[4] == 2
+        self.order = '>' if bytearray(self.data)[5] == 2 else '<'
+        if is64:
+            shoff, = self._unpack('Q', 0x28)
+            shentsize, shnum, shstrndx = self._unpack('HHH', 0x3a)
+            shfmt = 'IIQQQQIIQQ'
+        else:
+            shoff, = self._unpack('I', 0x20)
+            shentsize, shnum, shstrndx = self._unpack('HHH', 0x2e)
+            shfmt = 'IIIIIIIIII'
+        self.sections = [self._unpack(shfmt, shoff + (i * shentsize))
+                         for i in range(shnum)]
+        self.symbols = {}
+        for sec in self.sections:
+            if sec[1] == SHT_SYMTAB:
+                self._read_symbols(sec, is64)
+
+    def _unpack(self, fmt, offset):
+        return struct.unpack_from(self.order + fmt, self.data, offset)
+
+    def _cstring(self, offset):
+        end = self.data.find(b'\0', offset)
+        return self.data[offset:end].decode('utf-8', 'replace')
+
+    def _read_symbols(self, symtab, is64):
+        strtab = self.sections[symtab[6]]
+        size, fmt = (24, 'IBBHQQ') if is64 else (16, 'IIIBBH')
+        for offset in range(symtab[4], symtab[4] + symtab[5], size):
+            sym = self._unpack(fmt, offset)
+            value = sym[4] if is64 else sym[1]
+            if sym[0]:
+                self.symbols[self._cstring(strtab[4] + sym[0])] = value
+
+    def string(self, addr):
+        """Returns the string at addr in the image, None if there is none."""
+        for sec in self.sections:
+            if ((sec[2] & SHF_ALLOC) and (sec[1] != SHT_NOBITS) and
+                    (sec[3] <= addr < sec[3] + sec[5])):
+                return self._cstring(sec[4] + addr - sec[3])
+        return None
+
+
+class Decoder(object):
+    """Splits a stream into text and records and formats the records."""
+
+    def __init__(self, elf, out):
+        self.elf = elf
+        self.out = out
+        self.buf = bytearray()
+        self.order = '<'
+        self.sizes = {'int': 4, 'long': 4, 'size_t': 4, 'ptr': 4,
+                      'double': 8}
+        self.offset = 0
+
+    def feed(self, data):
+        self.buf += data
+        pos = 0
+        while pos < len(self.buf):
+            start = pos
+            while (pos < len(self.buf)) and (self.buf[pos] not in MARKERS):
+                pos += 1
+            self._text(self.buf[start:pos])
+            if (pos + 2) > len(self.buf):
+                break
+            end = pos + 2 + self.buf[pos + 1]
+            if end > len(self.buf):
+                break
+            rec = self.buf[pos:end]
+            if self._record(rec):
+                pos = end
+            else:
+                self._text(rec[:1])
+                pos += 1
+        del self.buf[:pos]
+
+    def _text(self, data):
+        # passed through as is, multibyte characters may contain markers
+        self.out.write(bytes(data))
+
+    def _write(self, text):
+        self.out.write(text.encode('utf-8'))
+        self.out.flush()
+
+    def _unpack(self, fmt, data, pos):
+        return struct.unpack_from(self.order + fmt, bytes(data), pos)[0]
+
+    def _int(self, size, signed, data, pos):
+        fmt = {1: 'b', 2: 'h', 4: 'i', 8: 'q'}[size]
+        return self._unpack(fmt if signed else fmt.upper(), data, pos)
+
+    def _record(self, rec):
+        if rec[0] == HDR:
+            if (len(rec) < 12) or (rec[2:4] != b'RL'):
+                return False
+            self.order = '>' if (rec[5] & 1) else '<'
+            self.sizes = {'int': rec[6], 'long': rec[7], 'size_t': rec[8],
+                          'ptr': rec[9], 'double': rec[10]}
+            anchor = self.elf.symbols.get('log_binary_anchor')
+            if anchor is not None:
+                self.offset = (self._int(rec[9], False, rec, 11) -
+                               anchor) & ((1 << (8 * rec[9])) - 1)
+            return True
+        if rec[0] == LOST:
+            if len(rec) != 4:
+                return False
+            self._write('[%u log records lost]\n' %
+                        self._int(2, False, rec, 2))
+            return True
+        ptr = self.sizes['ptr']
+        if len(rec) < (3 + ptr):
+            return False
+        addr = (self._int(ptr, False, rec, 3) - self.offset) & \
+            ((1 << (8 * ptr)) - 1)
+        fmt = self.elf.string(addr)
+        if fmt is None:
+            return False
+        self._write(self._format(fmt, rec[3 + ptr:], rec[2] & TRUNCATED))
+        return True
+
+    def _format(self, fmt, args, truncated):
+        res = []
+        pos = 0
+        last = 0
+        try:
+            for conv in CONVERSION.finditer(fmt):
+                flags, width, prec, length, spec = conv.groups()
+                res.append(fmt[last:conv.start()])
+                last = conv.end()
+                if width == '*':
+                    width = str(self._int(self.sizes['int'], True, args, pos))
+                    pos += self.sizes['int']
+                if prec == '*':
+                    prec = str(self._int(self.sizes['int'], True, args, pos))
+                    pos += self.sizes['int']
+                py = '%' + flags + (width or '') + \
+                    ('.' + prec if prec is not None else '')
+                text, pos = self._convert(py, length, spec, args, pos)
+                if text is None:
+                    raise IndexError(spec)
+                res.append(text)
+        except (IndexError, struct.error):
+            truncated = True
+            last = len(fmt.rstrip('\n'))
+        res.append(fmt[last:])
+        text = ''.join(res)
+        if truncated:
+            # mark the message, but keep its line break
+            stripped = text.rstrip('\n')
+            text = stripped + ' [...]' + text[len(stripped):]
+        return text
+
+    def _convert(self, py, length, spec, args, pos):
+        if spec == '%':
+            return '%', pos
+        if spec == 'n':
+            return '', pos
+        if spec in 'diouxX':
+            size = {'l': 'long', 'j': None, 'll': None, 'z': 'size_t',
+                    't': 'size_t'}.get(length, 'int')
+            size = self.sizes[size] if size else 8
+            val = self._int(size, spec in 'di', args, pos)
+            return (py + ('d' if spec == 'u' else spec)) % val, pos + size
+        if spec in 'eEfFgGaA':
+            size = self.sizes['double']
+            val = self._unpack('d' if size == 8 else 'f', args, pos)
+            if spec in 'aA':
+                return float.hex(val), pos + size
+            return (py + spec) % val, pos + size
+        if spec == 'p':
+            size = self.sizes['ptr']
+            return '0x%x' % self._int(size, False, args, pos), pos + size
+        if spec == 'c':
+            return (py + 'c') % chr(args[pos]), pos + 1
+        if spec == 's':
+            n = args[pos]
+            if n == 0xff:
+                return (py + 's') % '(null)', pos + 1
+            if (pos + 1 + n) > len(args):
+                raise IndexError(spec)
+            text = bytes(args[pos + 1:pos + 1 + n]).decode('utf-8', 'replace')
+            return (py + 's') % text, pos + 1 + n
+        return None, pos
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('elf', help='ELF file of the application')
+    parser.add_argument('input', nargs='?',
+                        help='file or tty to read, stdin if omitted')
+    args = parser.parse_args()
+
+    out = getattr(sys.stdout, 'buffer', sys.stdout)
+    decoder = Decoder(Elf(args.elf), out)
+    fd = os.open(args.input, os.O_RDONLY) if args.input else \
+        sys.stdin.fileno()
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            decoder.feed(bytearray(data))
+    except KeyboardInterrupt:
+        pass
+    out.flush()
+
+
+if __name__ == '__main__':
+    main()
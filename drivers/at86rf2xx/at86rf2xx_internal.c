@@ -61,14 +61,14 @@ void at86rf2xx_sram_read(const at86rf2xx_t *dev,
                          uint8_t *data,
                          const size_t len)
 {
-    spi_acquire(dev->params.spi);
-    gpio_clear(dev->params.cs_pin);
-    spi_transfer_reg(dev->params.spi,
-                     AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_READ,
-                     (char)offset, NULL);
-    spi_transfer_bytes(dev->params.spi, NULL, (char *)data, len);
-    gpio_set(dev->params.cs_pin);
-    spi_release(dev->params.spi);
+    const char cmd[] = { AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_READ,
+                         (char)offset };
+    const spi_seg_t segs[] = {
+        { .out = cmd, .in = NULL, .length = sizeof(cmd) },
+        { .out = NULL, .in = (char *)data, .length = len },
+    };
+
+    spi_transfer_segs(dev->params.spi, dev->params.cs_pin, segs, 2);
 }
 
 void at86rf2xx_sram_write(const at86rf2xx_t *dev,
@@ -76,14 +76,14 @@ void at86rf2xx_sram_write(const at86rf2xx_t *dev,
                           const uint8_t *data,
                           const size_t len)
 {
-    spi_acquire(dev->params.spi);
-    gpio_clear(dev->params.cs_pin);
-    spi_transfer_reg(dev->params.spi,
-                     AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_WRITE,
-                     (char)offset, NULL);
-    spi_transfer_bytes(dev->params.spi, (char *)data, NULL, len);
-    gpio_set(dev->params.cs_pin);
-    spi_release(dev->params.spi);
+    const char cmd[] = { AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_WRITE,
+                         (char)offset };
+    const spi_seg_t segs[] = {
+        { .out = cmd, .in = NULL, .length = sizeof(cmd) },
+        { .out = (const char *)data, .in = NULL, .length = len },
+    };
+
+    spi_transfer_segs(dev->params.spi, dev->params.cs_pin, segs, 2);
 }
 
 void at86rf2xx_fb_start(const at86rf2xx_t *dev)
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_i2c_shadow
+ * @{
+ *
+ * @file
+ * @brief       I2C register shadow implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "i2c_shadow.h"
+
+/* returns the index of reg in the shadow, -1 if it is not shadowed */
+static int _index(const i2c_shadow_t *shadow, uint8_t reg)
+{
+    if ((reg < shadow->first) || (reg >= (shadow->first + shadow->numof))) {
+        return -1;
+    }
+    return reg - shadow->first;
+}
+
+void i2c_shadow_init(i2c_shadow_t *shadow, i2c_t i2c, uint8_t address,
+                     uint8_t first, uint8_t *regs, uint8_t numof)
+{
+    assert(numof <= I2C_SHADOW_MAX);
+
+    shadow->i2c = i2c;
+    shadow->address = address;
+    shadow->first = first;
+    shadow->numof = numof;
+    shadow->valid = 0;
+    shadow->regs = regs;
+}
+
+int i2c_shadow_read(i2c_shadow_t *shadow, uint8_t reg, char *data)
+{
+    int i = _index(shadow, reg);
+
+    if (i < 0) {
+        return -1;
+    }
+    if (!(shadow->valid & (1UL << i))) {
+        if (i2c_read_reg(shadow->i2c, shadow->address, reg, data) != 1) {
+            return -1;
+        }
+        shadow->regs[i] = (uint8_t)*data;
+        shadow->valid |= (1UL << i);
+    }
+    *data = (char)shadow->regs[i];
+    return 1;
+}
+
+int i2c_shadow_write(i2c_shadow_t *shadow, uint8_t reg, char data)
+{
+    int i = _index(shadow, reg);
+
+    if (i < 0) {
+        return -1;
+    }
+    if ((shadow->valid & (1UL << i)) && (shadow->regs[i] == (uint8_t)data)) {
+        return 1;
+    }
+    if (i2c_write_reg(shadow->i2c, shadow->address, reg, data) != 1) {
+        /* the register may or may not have been written */
+        shadow->valid &= ~(1UL << i);
+        return -1;
+    }
+    shadow->regs[i] = (uint8_t)data;
+    shadow->valid |= (1UL << i);
+    return 1;
+}
+
+int i2c_shadow_update(i2c_shadow_t *shadow, uint8_t reg, char mask,
+                      char value)
+{
+    char data;
+
+    if (i2c_shadow_read(shadow, reg, &data) != 1) {
+        return -1;
+    }
+    data = (data & ~mask) | (value & mask);
+    return i2c_shadow_write(shadow, reg, data);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_i2c_shadow I2C register shadow
+ * @ingroup     drivers
+ * @brief       Write-through cache of the configuration registers of I2C
+ *              devices
+ *
+ * Drivers often read a configuration register before they change some of
+ * its bits, although its value only changes when the driver writes it. The
+ * shadow keeps a copy of a range of such registers: reads are answered from
+ * the copy once the value is known, writes go to the device and to the copy,
+ * and writes of the value the register holds already are skipped.
+ *
+ * Only shadow registers that are not changed by the device itself and have
+ * no side effects when written. After a reset of the device, call
+ * i2c_shadow_invalidate().
+ *
+ * The functions do not acquire the bus, the caller must have acquired it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       I2C register shadow interface
+ */
+
+#ifndef I2C_SHADOW_H
+#define I2C_SHADOW_H
+
+#include <stdint.h>
+
+#include "periph/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of registers of a shadow
+ */
+#define I2C_SHADOW_MAX      (32U)
+
+/**
+ * @brief   Shadow of a range of registers
+ */
+typedef struct {
+    i2c_t i2c;              /**< bus the device is connected to */
+    uint8_t address;        /**< bus address of the device */
+    uint8_t first;          /**< first shadowed register */
+    uint8_t numof;          /**< number of shadowed registers */
+    uint32_t valid;         /**< registers with a known value, bit per
+                             *   register */
+    uint8_t *regs;          /**< copy of the registers */
+} i2c_shadow_t;
+
+/**
+ * @brief   Initializes a shadow, the values of all registers are unknown
+ *
+ * @param[out] shadow       shadow to initialize
+ * @param[in]  i2c          bus the device is connected to
+ * @param[in]  address      bus address of the device
+ * @param[in]  first        first register to shadow
+ * @param[in]  regs         memory for the copy, @p numof bytes
+ * @param[in]  numof        number of registers to shadow, at most
+ *                          @ref I2C_SHADOW_MAX
+ */
+void i2c_shadow_init(i2c_shadow_t *shadow, i2c_t i2c, uint8_t address,
+                     uint8_t first, uint8_t *regs, uint8_t numof);
+
+/**
+ * @brief   Marks the values of all registers as unknown, e.g. after a reset
+ *
+ * @param[in] shadow        shadow to invalidate
+ */
+static inline void i2c_shadow_invalidate(i2c_shadow_t *shadow)
+{
+    shadow->valid = 0;
+}
+
+/**
+ * @brief   Reads a register, from the device only if its value is unknown
+ *
+ * @param[in]  shadow       shadow of the register
+ * @param[in]  reg          register to read
+ * @param[out] data         value of the register
+ *
+ * @return                  1 on success
+ * @return                  -1 if @p reg is not shadowed or on bus errors
+ */
+int i2c_shadow_read(i2c_shadow_t *shadow, uint8_t reg, char *data);
+
+/**
+ * @brief   Writes a register, unless it holds @p data already
+ *
+ * @param[in] shadow        shadow of the register
+ * @param[in] reg           register to write
+ * @param[in] data          value to write
+ *
+ * @return                  1 on success
+ * @return                  -1 if @p reg is not shadowed or on bus errors
+ */
+int i2c_shadow_write(i2c_shadow_t *shadow, uint8_t reg, char data);
+
+/**
+ * @brief   Changes the bits of a register selected by @p mask to @p value
+ *
+ * @param[in] shadow        shadow of the register
+ * @param[in] reg           register to change
+ * @param[in] mask          bits to change
+ * @param[in] value         new value of the bits in @p mask
+ *
+ * @return                  1 on success
+ * @return                  -1 if @p reg is not shadowed or on bus errors
+ */
+int i2c_shadow_update(i2c_shadow_t *shadow, uint8_t reg, char mask,
+                      char value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_SHADOW_H */
+/** @} */
@@ -22,6 +22,7 @@
 #define MPU9150_H_
 
 #include "periph/i2c.h"
+#include "i2c_shadow.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,12 @@ extern "C" {
 #define MPU9150_MAX_COMP_SMPL_RATE  (100)
 /** @} */
 
+/**
+ * @brief Number of registers the driver shadows, from user control to power
+ *        management 2
+ */
+#define MPU9150_SHADOW_REGS         (3)
+
 /**
  * @name Power Management 1 register macros
  * @{
@@ -167,6 +174,8 @@ typedef struct {
     uint8_t hw_addr;            /**< Hardware address of the MPU-9150 */
     uint8_t comp_addr;          /**< Address of the MPU-9150s compass */
     mpu9150_status_t conf;      /**< Device configuration */
+    i2c_shadow_t shadow;        /**< Shadow of the control registers */
+    uint8_t shadow_regs[MPU9150_SHADOW_REGS];   /**< Memory of the shadow */
 } mpu9150_t;
 
 /**
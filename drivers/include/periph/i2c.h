@@ -265,6 +265,39 @@ int i2c_write_reg(i2c_t dev, uint8_t address, uint8_t reg, char data);
 int i2c_write_regs(i2c_t dev, uint8_t address, uint8_t reg,
                    char *data, int length);
 
+/**
+ * @brief   Register access of a batch
+ */
+typedef struct {
+    uint8_t address;        /**< bus address of the target device */
+    uint8_t reg;            /**< first register to access */
+    uint8_t flags;          /**< I2C_FLAG_READ or I2C_FLAG_WRITE */
+    char *data;             /**< bytes to write or buffer to read to */
+    int length;             /**< number of bytes to access */
+} i2c_reg_op_t;
+
+/**
+ * @brief   Access a list of registers while holding the bus once
+ *
+ * Acquires the bus, accesses the registers in the given order with
+ * i2c_read_regs() and i2c_write_regs() and releases the bus again. Drivers
+ * use this to e.g. configure a device or to read several values that are
+ * not in consecutive registers, instead of acquiring the bus for every
+ * register.
+ *
+ * Must not be called with the bus acquired. The batch stops at the first
+ * access that fails.
+ *
+ * @param[in] dev           I2C peripheral device
+ * @param[in] ops           register accesses
+ * @param[in] numof         number of register accesses
+ *
+ * @return                  the number of bytes that were read and written
+ * @return                  -1 on undefined device given or if an access
+ *                          failed
+ */
+int i2c_batch(i2c_t dev, const i2c_reg_op_t *ops, unsigned int numof);
+
 /**
  * @brief   Power on the given I2C peripheral
  *
@@ -11,9 +11,19 @@
  * @ingroup     drivers_periph
  * @brief       Low-level SPI peripheral driver
  *
- * The current design of this interface targets implementations that use the SPI in blocking mode.
- *
- * TODO: add means for asynchronous SPI usage
+ * The transfer functions block until the data is transferred. For devices
+ * that access the bus with one command and its payload, e.g. register or
+ * frame buffer reads of radios, spi_transfer_segs() transfers several
+ * segments while the chip select stays asserted.
+ *
+ * spi_queue() adds such transfers as transactions to a queue per bus and
+ * returns right away, a callback signals their end. The queue acquires the
+ * bus like any other user, so blocking users and the transactions of several
+ * devices take turns on it. CPUs that define `PERIPH_SPI_HAS_SEGS_ASYNC` in
+ * their `periph_cpu.h` transfer all segments of a transaction in one
+ * operation in the background, e.g. by DMA. On all others the thread that
+ * finds the queue idle transfers the queued transactions before spi_queue()
+ * returns.
  *
  * @{
  * @file
@@ -29,6 +39,7 @@
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
+#include "periph/gpio.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -236,6 +247,96 @@ int spi_transfer_reg(spi_t dev, uint8_t reg, char out, char *in);
  */
 int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int length);
 
+/**
+ * @brief Segment of a transfer
+ */
+typedef struct {
+    const char *out;        /**< bytes to send, NULL if only receiving */
+    char *in;               /**< buffer to receive to, NULL if only sending */
+    unsigned int length;    /**< number of bytes to transfer */
+} spi_seg_t;
+
+/**
+ * @brief Signature of the callback signalling the end of a transaction
+ *
+ * @param[in] arg       argument of the transaction
+ * @param[in] res       number of bytes transferred, -1 on error
+ */
+typedef void (*spi_trans_cb_t)(void *arg, int res);
+
+/**
+ * @brief Transaction of spi_queue()
+ *
+ * The transaction, its segments and their buffers must stay valid until the
+ * callback was called.
+ */
+typedef struct spi_trans {
+    struct spi_trans *next;     /**< next queued transaction, used internally */
+    gpio_t cs;                  /**< chip select, GPIO_UNDEF for none */
+    const spi_seg_t *segs;      /**< segments to transfer */
+    unsigned int segs_numof;    /**< number of segments */
+    spi_trans_cb_t cb;          /**< called once the transaction is done */
+    void *arg;                  /**< argument to @p cb */
+} spi_trans_t;
+
+/**
+ * @brief Transfer a number of segments while the chip select is asserted
+ *
+ * Acquires the bus, asserts (clears) @p cs, transfers the segments, releases
+ * (sets) @p cs and releases the bus.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] cs        chip select of the slave, GPIO_UNDEF for none
+ * @param[in] segs      segments to transfer
+ * @param[in] numof     number of segments
+ *
+ * @return              Number of bytes that were transfered
+ * @return              -1 on error
+ */
+int spi_transfer_segs(spi_t dev, gpio_t cs, const spi_seg_t *segs,
+                      unsigned int numof);
+
+/**
+ * @brief Queue a transaction on the given SPI bus
+ *
+ * The transaction is started right away if the queue is idle, after the ones
+ * queued before otherwise. The callback is called in interrupt context on
+ * CPUs with `PERIPH_SPI_HAS_SEGS_ASYNC`, unless the transfer completed right
+ * away, in the context of the thread that found the queue idle otherwise. It
+ * may queue further transactions.
+ *
+ * Must be called from thread context, unless the queue is busy, e.g. from
+ * the callback of a transaction.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] trans     transaction to queue
+ */
+void spi_queue(spi_t dev, spi_trans_t *trans);
+
+#if defined(PERIPH_SPI_HAS_SEGS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Start transferring a number of segments in one operation
+ *
+ * Implemented by CPUs that define `PERIPH_SPI_HAS_SEGS_ASYNC`, used by
+ * spi_queue(), which has acquired the bus and asserted the chip select
+ * before.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] segs      segments to transfer
+ * @param[in] numof     number of segments
+ * @param[in] cb        called once all segments are transferred, usually in
+ *                      interrupt context, but it may be called before this
+ *                      function returns, e.g. for short transfers
+ * @param[in] arg       argument to @p cb
+ *
+ * @return              0 if the transfer was started
+ * @return              -1 on error
+ */
+int spi_transfer_segs_async(spi_t dev, const spi_seg_t *segs,
+                            unsigned int numof, void (*cb)(void *arg),
+                            void *arg);
+#endif
+
 /**
  * @brief Tell the SPI driver that a new transaction was started. Call only when SPI in slave mode!
  *
@@ -35,6 +35,12 @@
  * in RIOT which is used for standard input/output functions like `printf()` or
  * `puts()`.
  *
+ * Besides the blocking uart_write(), uart_write_async() starts a transmission
+ * and returns right away, a callback signals when the buffer may be reused.
+ * CPUs that define `PERIPH_UART_HAS_WRITE_ASYNC` in their `periph_cpu.h`
+ * implement it with DMA or a TX interrupt, for all others an inline fallback
+ * sends the data blocking before it returns.
+ *
  * @file
  * @brief       Low-level UART peripheral driver interface definition
  *
@@ -101,6 +107,13 @@ typedef unsigned int uart_t;
  */
 typedef void(*uart_rx_cb_t)(void *arg, uint8_t data);
 
+/**
+ * @brief   Signature for the callback signalling a completed transmission
+ *
+ * @param[in] arg           context to the callback (optional)
+ */
+typedef void(*uart_tx_cb_t)(void *arg);
+
 /**
  * @brief   Interrupt context for a UART device
  * @{
@@ -149,6 +162,41 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
  */
 void uart_write(uart_t uart, const uint8_t *data, size_t len);
 
+/**
+ * @brief   Start writing data from the given buffer to the specified UART
+ *          device without waiting for its transmission
+ *
+ * The buffer must stay valid and unchanged until @p cb was called. @p cb is
+ * called once the last byte was handed to the hardware. This is usually done
+ * in interrupt context, but with the inline fallback (see
+ * `PERIPH_UART_HAS_WRITE_ASYNC`) it is called before this function returns.
+ * @p cb may start the next transmission.
+ *
+ * Only one asynchronous transmission per device can be in flight. Calling
+ * uart_write() meanwhile is not supported.
+ *
+ * @param[in] uart          UART device to use for transmission
+ * @param[in] data          data buffer to send
+ * @param[in] len           number of bytes to send, must not be 0
+ * @param[in] cb            callback signalling the completion
+ * @param[in] arg           optional context passed to @p cb
+ *
+ * @return                  0 if the transmission was started
+ * @return                  -EBUSY if a transmission is still in flight
+ */
+#if defined(PERIPH_UART_HAS_WRITE_ASYNC) || defined(DOXYGEN)
+int uart_write_async(uart_t uart, const uint8_t *data, size_t len,
+                     uart_tx_cb_t cb, void *arg);
+#else
+static inline int uart_write_async(uart_t uart, const uint8_t *data,
+                                   size_t len, uart_tx_cb_t cb, void *arg)
+{
+    uart_write(uart, data, len);
+    cb(arg);
+    return 0;
+}
+#endif
+
 /**
  * @brief   Power on the given UART device
  *
@@ -44,6 +44,11 @@ extern "C" {
 #define LSM303DLHC_REG_OUT_Z_H_A            (0x2d)
 /** @} */
 
+/**
+ * @brief Flag for accessing multiple accelerometer registers at once
+ */
+#define LSM303DLHC_AUTOINC_A                (0x80)
+
 /**
  * @name Masks for the LSM303DLHC CTRL1_A register
  * @{
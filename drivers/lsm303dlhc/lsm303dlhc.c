@@ -34,7 +34,31 @@ int lsm303dlhc_init(lsm303dlhc_t *dev, i2c_t i2c, gpio_t acc_pin, gpio_t mag_pin
                     lsm303dlhc_mag_gain_t mag_gain)
 {
     int res;
-    char tmp;
+    char boot = (char)LSM303DLHC_REG_CTRL5_A_BOOT;
+    /* enable all three axis and set sample rate */
+    char ctrl1 = (LSM303DLHC_CTRL1_A_XEN
+                  | LSM303DLHC_CTRL1_A_YEN
+                  | LSM303DLHC_CTRL1_A_ZEN
+                  | acc_sample_rate);
+    /* update on read, MSB @ low address, scale and high-resolution */
+    char ctrl4 = (acc_scale | LSM303DLHC_CTRL4_A_HR);
+    /* no interrupt generation */
+    char ctrl3 = LSM303DLHC_CTRL3_A_I1_NONE;
+    /* enable temperature output and set sample rate */
+    char cra = LSM303DLHC_TEMP_EN | mag_sample_rate;
+    /* configure z-axis gain */
+    char crb = mag_gain;
+    /* set continuous mode */
+    char mr = LSM303DLHC_MAG_MODE_CONTINUOUS;
+    const i2c_reg_op_t ops[] = {
+        { acc_address, LSM303DLHC_REG_CTRL5_A, I2C_FLAG_WRITE, &boot, 1 },
+        { acc_address, LSM303DLHC_REG_CTRL1_A, I2C_FLAG_WRITE, &ctrl1, 1 },
+        { acc_address, LSM303DLHC_REG_CTRL4_A, I2C_FLAG_WRITE, &ctrl4, 1 },
+        { acc_address, LSM303DLHC_REG_CTRL3_A, I2C_FLAG_WRITE, &ctrl3, 1 },
+        { mag_address, LSM303DLHC_REG_CRA_M, I2C_FLAG_WRITE, &cra, 1 },
+        { mag_address, LSM303DLHC_REG_CRB_M, I2C_FLAG_WRITE, &crb, 1 },
+        { mag_address, LSM303DLHC_REG_MR_M, I2C_FLAG_WRITE, &mr, 1 },
+    };
 
     dev->i2c = i2c;
     dev->acc_address = acc_address;
@@ -44,49 +68,16 @@ int lsm303dlhc_init(lsm303dlhc_t *dev, i2c_t i2c, gpio_t acc_pin, gpio_t mag_pin
     dev->acc_scale   = acc_scale;
     dev->mag_gain    = mag_gain;
 
-    /* Acquire exclusive access to the bus. */
-    i2c_acquire(dev->i2c);
     i2c_init_master(i2c, I2C_SPEED_NORMAL);
 
-    DEBUG("lsm303dlhc reboot ");
-    res = i2c_write_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_CTRL5_A, LSM303DLHC_REG_CTRL5_A_BOOT);
-    /* Release the bus for other threads. */
-    i2c_release(dev->i2c);
-    DEBUG("[OK]");
+    /* reboot and configure accelerometer, magnetometer and temperature
+     * sensor while holding the bus once */
+    DEBUG("lsm303dlhc reboot and configure ");
+    res = i2c_batch(dev->i2c, ops, sizeof(ops) / sizeof(ops[0]));
+    DEBUG("[%s]\n", (res < 7) ? "failed" : "OK");
 
-    /* configure accelerometer */
-    /* enable all three axis and set sample rate */
-    tmp = (LSM303DLHC_CTRL1_A_XEN
-          | LSM303DLHC_CTRL1_A_YEN
-          | LSM303DLHC_CTRL1_A_ZEN
-          | acc_sample_rate);
-    i2c_acquire(dev->i2c);
-    res += i2c_write_reg(dev->i2c, dev->acc_address,
-                         LSM303DLHC_REG_CTRL1_A, tmp);
-    /* update on read, MSB @ low address, scale and high-resolution */
-    tmp = (acc_scale | LSM303DLHC_CTRL4_A_HR);
-    res += i2c_write_reg(dev->i2c, dev->acc_address,
-                         LSM303DLHC_REG_CTRL4_A, tmp);
-    /* no interrupt generation */
-    res += i2c_write_reg(dev->i2c, dev->acc_address,
-                         LSM303DLHC_REG_CTRL3_A, LSM303DLHC_CTRL3_A_I1_NONE);
-    /* configure acc data ready pin */
+    /* configure data ready pins */
     gpio_init(acc_pin, GPIO_IN);
-
-    /* configure magnetometer and temperature */
-    /* enable temperature output and set sample rate */
-    tmp = LSM303DLHC_TEMP_EN | mag_sample_rate;
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                         LSM303DLHC_REG_CRA_M, tmp);
-    /* configure z-axis gain */
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                         LSM303DLHC_REG_CRB_M, mag_gain);
-    /* set continuous mode */
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                         LSM303DLHC_REG_MR_M, LSM303DLHC_MAG_MODE_CONTINUOUS);
-    i2c_release(dev->i2c);
-    /* configure mag data ready pin */
     gpio_init(mag_pin, GPIO_IN);
 
     return (res < 7) ? -1 : 0;
@@ -95,42 +86,26 @@ int lsm303dlhc_init(lsm303dlhc_t *dev, i2c_t i2c, gpio_t acc_pin, gpio_t mag_pin
 int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
 {
     int res;
-    char tmp;
+    /* status register, followed by the values of the three axis */
+    uint8_t buf[7];
+
+    DEBUG("lsm303dlhc: read acc values ... ");
 
     i2c_acquire(dev->i2c);
-    i2c_read_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_STATUS_A, &tmp);
-    DEBUG("lsm303dlhc status: %x\n", tmp);
-    DEBUG("lsm303dlhc: wait for acc values ... ");
-
-    res = i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_X_L_A, &tmp);
-    data->x_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_X_H_A, &tmp);
-    data->x_axis |= tmp<<8;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_Y_L_A, &tmp);
-    data->y_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_Y_H_A, &tmp);
-    data->y_axis |= tmp<<8;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_Z_L_A, &tmp);
-    data->z_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_Z_H_A, &tmp);
-    data->z_axis |= tmp<<8;
+    res = i2c_read_regs(dev->i2c, dev->acc_address,
+                        LSM303DLHC_REG_STATUS_A | LSM303DLHC_AUTOINC_A,
+                        (char *)buf, sizeof(buf));
     i2c_release(dev->i2c);
-    DEBUG("read ... ");
+    DEBUG("status: %x ... ", buf[0]);
 
-    data->x_axis = data->x_axis>>4;
-    data->y_axis = data->y_axis>>4;
-    data->z_axis = data->z_axis>>4;
-
-    if (res < 6) {
+    if (res < (int)sizeof(buf)) {
         DEBUG("[!!failed!!]\n");
         return -1;
     }
+
+    data->x_axis = (int16_t)(buf[1] | (buf[2] << 8)) >> 4;
+    data->y_axis = (int16_t)(buf[3] | (buf[4] << 8)) >> 4;
+    data->z_axis = (int16_t)(buf[5] | (buf[6] << 8)) >> 4;
     DEBUG("[done]\n");
 
     return 0;
@@ -191,15 +166,16 @@ int lsm303dlhc_read_temp(lsm303dlhc_t *dev, int16_t *value)
 int lsm303dlhc_disable(lsm303dlhc_t *dev)
 {
     int res;
+    char ctrl1 = LSM303DLHC_CTRL1_A_POWEROFF;
+    char mr = LSM303DLHC_MAG_MODE_SLEEP;
+    char cra = LSM303DLHC_TEMP_DIS;
+    const i2c_reg_op_t ops[] = {
+        { dev->acc_address, LSM303DLHC_REG_CTRL1_A, I2C_FLAG_WRITE, &ctrl1, 1 },
+        { dev->mag_address, LSM303DLHC_REG_MR_M, I2C_FLAG_WRITE, &mr, 1 },
+        { dev->mag_address, LSM303DLHC_REG_CRA_M, I2C_FLAG_WRITE, &cra, 1 },
+    };
 
-    i2c_acquire(dev->i2c);
-    res = i2c_write_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_CTRL1_A, LSM303DLHC_CTRL1_A_POWEROFF);
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                        LSM303DLHC_REG_MR_M, LSM303DLHC_MAG_MODE_SLEEP);
-    res += i2c_write_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_CRA_M, LSM303DLHC_TEMP_DIS);
-    i2c_release(dev->i2c);
+    res = i2c_batch(dev->i2c, ops, sizeof(ops) / sizeof(ops[0]));
 
     return (res < 3) ? -1 : 0;
 }
@@ -207,28 +183,28 @@ int lsm303dlhc_disable(lsm303dlhc_t *dev)
 int lsm303dlhc_enable(lsm303dlhc_t *dev)
 {
     int res;
-    char tmp = (LSM303DLHC_CTRL1_A_XEN
-                | LSM303DLHC_CTRL1_A_YEN
-                | LSM303DLHC_CTRL1_A_ZEN
-                | LSM303DLHC_CTRL1_A_N1344HZ_L5376HZ);
-    i2c_acquire(dev->i2c);
-    res = i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_CTRL1_A, tmp);
+    char ctrl1 = (LSM303DLHC_CTRL1_A_XEN
+                  | LSM303DLHC_CTRL1_A_YEN
+                  | LSM303DLHC_CTRL1_A_ZEN
+                  | LSM303DLHC_CTRL1_A_N1344HZ_L5376HZ);
+    char ctrl4 = (LSM303DLHC_CTRL4_A_BDU | LSM303DLHC_CTRL4_A_SCALE_2G
+                  | LSM303DLHC_CTRL4_A_HR);
+    char ctrl3 = LSM303DLHC_CTRL3_A_I1_DRDY1;
+    char cra = LSM303DLHC_TEMP_EN | LSM303DLHC_TEMP_SAMPLE_75HZ;
+    char crb = LSM303DLHC_GAIN_5;
+    char mr = LSM303DLHC_MAG_MODE_CONTINUOUS;
+    const i2c_reg_op_t ops[] = {
+        { dev->acc_address, LSM303DLHC_REG_CTRL1_A, I2C_FLAG_WRITE, &ctrl1, 1 },
+        { dev->acc_address, LSM303DLHC_REG_CTRL4_A, I2C_FLAG_WRITE, &ctrl4, 1 },
+        { dev->acc_address, LSM303DLHC_REG_CTRL3_A, I2C_FLAG_WRITE, &ctrl3, 1 },
+        { dev->mag_address, LSM303DLHC_REG_CRA_M, I2C_FLAG_WRITE, &cra, 1 },
+        { dev->mag_address, LSM303DLHC_REG_CRB_M, I2C_FLAG_WRITE, &crb, 1 },
+        { dev->mag_address, LSM303DLHC_REG_MR_M, I2C_FLAG_WRITE, &mr, 1 },
+    };
+
+    res = i2c_batch(dev->i2c, ops, sizeof(ops) / sizeof(ops[0]));
 
-    tmp = (LSM303DLHC_CTRL4_A_BDU| LSM303DLHC_CTRL4_A_SCALE_2G | LSM303DLHC_CTRL4_A_HR);
-    res += i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_CTRL4_A, tmp);
-    res += i2c_write_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_CTRL3_A, LSM303DLHC_CTRL3_A_I1_DRDY1);
     gpio_init(dev->acc_pin, GPIO_IN);
-
-    tmp = LSM303DLHC_TEMP_EN | LSM303DLHC_TEMP_SAMPLE_75HZ;
-    res += i2c_write_reg(dev->i2c, dev->mag_address, LSM303DLHC_REG_CRA_M, tmp);
-
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                        LSM303DLHC_REG_CRB_M, LSM303DLHC_GAIN_5);
-
-    res += i2c_write_reg(dev->i2c, dev->mag_address,
-                        LSM303DLHC_REG_MR_M, LSM303DLHC_MAG_MODE_CONTINUOUS);
-    i2c_release(dev->i2c);
-
     gpio_init(dev->mag_pin, GPIO_IN);
 
     return (res < 6) ? -1 : 0;
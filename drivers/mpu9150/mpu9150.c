@@ -55,12 +55,12 @@ static void conf_lpf(mpu9150_t *dev, uint16_t rate);
 int mpu9150_init(mpu9150_t *dev, i2c_t i2c, mpu9150_hw_addr_t hw_addr,
         mpu9150_comp_addr_t comp_addr)
 {
-    char temp;
-
     dev->i2c_dev = i2c;
     dev->hw_addr = hw_addr;
     dev->comp_addr = comp_addr;
     dev->conf = DEFAULT_STATUS;
+    i2c_shadow_init(&dev->shadow, i2c, hw_addr, MPU9150_USER_CTRL_REG,
+                    dev->shadow_regs, MPU9150_SHADOW_REGS);
 
     /* Initialize I2C interface */
     if (i2c_init_master(dev->i2c_dev, I2C_SPEED_FAST)) {
@@ -73,8 +73,9 @@ int mpu9150_init(mpu9150_t *dev, i2c_t i2c, mpu9150_hw_addr_t hw_addr,
 
     /* Reset MPU9150 registers and afterwards wake up the chip */
     i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_RESET);
+    i2c_shadow_invalidate(&dev->shadow);
     xtimer_usleep(MPU9150_RESET_SLEEP_US);
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_WAKEUP);
+    i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_WAKEUP);
 
     /* Release the bus, it is acquired again inside each function */
     i2c_release(dev->i2c_dev);
@@ -98,10 +99,9 @@ int mpu9150_init(mpu9150_t *dev, i2c_t i2c, mpu9150_hw_addr_t hw_addr,
     mpu9150_set_compass_sample_rate(dev, 10);
     /* Enable all sensors */
     i2c_acquire(dev->i2c_dev);
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_PLL);
-    i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, &temp);
-    temp &= ~(MPU9150_PWR_ACCEL | MPU9150_PWR_GYRO);
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, temp);
+    i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_PLL);
+    i2c_shadow_update(&dev->shadow, MPU9150_PWR_MGMT_2_REG,
+                      (MPU9150_PWR_ACCEL | MPU9150_PWR_GYRO), 0);
     i2c_release(dev->i2c_dev);
     xtimer_usleep(MPU9150_PWR_CHANGE_SLEEP_US);
 
@@ -122,7 +122,7 @@ int mpu9150_set_accel_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
     }
 
     /* Read current power management 2 configuration */
-    i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, &pwr_2_setting);
+    i2c_shadow_read(&dev->shadow, MPU9150_PWR_MGMT_2_REG, &pwr_2_setting);
     /* Prepare power register settings */
     if (pwr_conf == MPU9150_SENSOR_PWR_ON) {
         pwr_1_setting = MPU9150_PWR_WAKEUP;
@@ -135,10 +135,10 @@ int mpu9150_set_accel_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
     /* Configure power management 1 register if needed */
     if ((dev->conf.gyro_pwr == MPU9150_SENSOR_PWR_OFF)
             && (dev->conf.compass_pwr == MPU9150_SENSOR_PWR_OFF)) {
-        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, pwr_1_setting);
+        i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_1_REG, pwr_1_setting);
     }
     /* Enable/disable accelerometer standby in power management 2 register */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, pwr_2_setting);
+    i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_2_REG, pwr_2_setting);
 
     /* Release the bus */
     i2c_release(dev->i2c_dev);
@@ -163,11 +163,11 @@ int mpu9150_set_gyro_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
     }
 
     /* Read current power management 2 configuration */
-    i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, &pwr_2_setting);
+    i2c_shadow_read(&dev->shadow, MPU9150_PWR_MGMT_2_REG, &pwr_2_setting);
     /* Prepare power register settings */
     if (pwr_conf == MPU9150_SENSOR_PWR_ON) {
         /* Set clock to pll */
-        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_PLL);
+        i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_PLL);
         pwr_2_setting &= ~(MPU9150_PWR_GYRO);
     }
     else {
@@ -175,18 +175,18 @@ int mpu9150_set_gyro_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
         if ((dev->conf.accel_pwr == MPU9150_SENSOR_PWR_OFF)
                 && (dev->conf.compass_pwr == MPU9150_SENSOR_PWR_OFF)) {
             /* All sensors turned off, put the MPU-9150 to sleep */
-            i2c_write_reg(dev->i2c_dev, dev->hw_addr,
+            i2c_shadow_write(&dev->shadow,
                     MPU9150_PWR_MGMT_1_REG, BIT_PWR_MGMT1_SLEEP);
         }
         else {
             /* Reset clock to internal oscillator */
-            i2c_write_reg(dev->i2c_dev, dev->hw_addr,
+            i2c_shadow_write(&dev->shadow,
                     MPU9150_PWR_MGMT_1_REG, MPU9150_PWR_WAKEUP);
         }
         pwr_2_setting |= MPU9150_PWR_GYRO;
     }
     /* Enable/disable gyroscope standby in power management 2 register */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_2_REG, pwr_2_setting);
+    i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_2_REG, pwr_2_setting);
 
     /* Release the bus */
     i2c_release(dev->i2c_dev);
@@ -211,7 +211,7 @@ int mpu9150_set_compass_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
     }
 
     /* Read current user control configuration */
-    i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, &usr_ctrl_setting);
+    i2c_shadow_read(&dev->shadow, MPU9150_USER_CTRL_REG, &usr_ctrl_setting);
     /* Prepare power register settings */
     if (pwr_conf == MPU9150_SENSOR_PWR_ON) {
         pwr_1_setting = MPU9150_PWR_WAKEUP;
@@ -226,12 +226,12 @@ int mpu9150_set_compass_power(mpu9150_t *dev, mpu9150_pwr_t pwr_conf)
     /* Configure power management 1 register if needed */
     if ((dev->conf.gyro_pwr == MPU9150_SENSOR_PWR_OFF)
             && (dev->conf.accel_pwr == MPU9150_SENSOR_PWR_OFF)) {
-        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_PWR_MGMT_1_REG, pwr_1_setting);
+        i2c_shadow_write(&dev->shadow, MPU9150_PWR_MGMT_1_REG, pwr_1_setting);
     }
     /* Configure mode writing by slave line 1 */
     i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE1_DATA_OUT_REG, s1_do_setting);
     /* Enable/disable I2C master mode */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, usr_ctrl_setting);
+    i2c_shadow_write(&dev->shadow, MPU9150_USER_CTRL_REG, usr_ctrl_setting);
 
     /* Release the bus */
     i2c_release(dev->i2c_dev);
@@ -501,6 +501,7 @@ int mpu9150_set_compass_sample_rate(mpu9150_t *dev, uint8_t rate)
 static int compass_init(mpu9150_t *dev)
 {
     char data[3];
+    char data_slaves[6];
 
     /* Enable Bypass Mode to speak to compass directly */
     conf_bypass(dev, 1);
@@ -533,22 +534,17 @@ static int compass_init(mpu9150_t *dev)
     /* Configure MPU9150 for single master mode */
     i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_I2C_MST_REG, BIT_WAIT_FOR_ES);
 
-    /* Set up slave line 0 */
-    /* Slave line 0 reads the compass data */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr,
-            MPU9150_SLAVE0_ADDR_REG, (BIT_SLAVE_RW | dev->comp_addr));
-    /* Slave line 0 read starts at compass data register */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE0_REG_REG, COMPASS_DATA_START_REG);
-    /* Enable slave line 0 and configure read length to 6 consecutive registers */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE0_CTRL_REG, (BIT_SLAVE_EN | 0x06));
-
-    /* Set up slave line 1 */
-    /* Slave line 1 writes to the compass */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE1_ADDR_REG, dev->comp_addr);
-    /* Slave line 1 write starts at compass control register */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE1_REG_REG, COMPASS_CNTL_REG);
-    /* Enable slave line 1 and configure write length to 1 register */
-    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE1_CTRL_REG, (BIT_SLAVE_EN | 0x01));
+    /* Set up slave lines 0 and 1, their registers are consecutive */
+    /* Slave line 0 reads 6 consecutive registers starting at the compass
+     * data register, slave line 1 writes the compass control register */
+    data_slaves[0] = (char)(BIT_SLAVE_RW | dev->comp_addr);
+    data_slaves[1] = COMPASS_DATA_START_REG;
+    data_slaves[2] = (char)(BIT_SLAVE_EN | 0x06);
+    data_slaves[3] = dev->comp_addr;
+    data_slaves[4] = COMPASS_CNTL_REG;
+    data_slaves[5] = (char)(BIT_SLAVE_EN | 0x01);
+    i2c_write_regs(dev->i2c_dev, dev->hw_addr, MPU9150_SLAVE0_ADDR_REG,
+            data_slaves, sizeof(data_slaves));
     /* Configure data which is written by slave line 1 to compass control */
     i2c_write_reg(dev->i2c_dev, dev->hw_addr,
             MPU9150_SLAVE1_DATA_OUT_REG, MPU9150_COMP_SINGLE_MEASURE);
@@ -570,17 +566,17 @@ static int compass_init(mpu9150_t *dev)
 static void conf_bypass(mpu9150_t *dev, uint8_t bypass_enable)
 {
    char data;
-   i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, &data);
+   i2c_shadow_read(&dev->shadow, MPU9150_USER_CTRL_REG, &data);
 
    if (bypass_enable) {
        data &= ~(BIT_I2C_MST_EN);
-       i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, data);
+       i2c_shadow_write(&dev->shadow, MPU9150_USER_CTRL_REG, data);
        xtimer_usleep(MPU9150_BYPASS_SLEEP_US);
        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_INT_PIN_CFG_REG, BIT_I2C_BYPASS_EN);
    }
    else {
        data |= BIT_I2C_MST_EN;
-       i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, data);
+       i2c_shadow_write(&dev->shadow, MPU9150_USER_CTRL_REG, data);
        xtimer_usleep(MPU9150_BYPASS_SLEEP_US);
        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_INT_PIN_CFG_REG, REG_RESET);
    }
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup drivers
+ * @{
+ *
+ * @file
+ * @brief       common I2C functions
+ *
+ * @}
+ */
+#include <stddef.h>
+
+#include "board.h"
+#include "cpu.h"
+#include "periph/i2c.h"
+#include "periph_conf.h"
+
+#if I2C_NUMOF
+
+int i2c_batch(i2c_t dev, const i2c_reg_op_t *ops, unsigned int numof)
+{
+    int res = 0;
+
+    if (i2c_acquire(dev) != 0) {
+        return -1;
+    }
+    for (unsigned int i = 0; i < numof; i++) {
+        int n;
+
+        if (ops[i].flags & I2C_FLAG_READ) {
+            n = i2c_read_regs(dev, ops[i].address, ops[i].reg,
+                              ops[i].data, ops[i].length);
+        }
+        else {
+            n = i2c_write_regs(dev, ops[i].address, ops[i].reg,
+                               ops[i].data, ops[i].length);
+        }
+        if (n < ops[i].length) {
+            res = -1;
+            break;
+        }
+        res += n;
+    }
+    i2c_release(dev);
+
+    return res;
+}
+
+#endif /* I2C_NUMOF */
@@ -11,21 +11,37 @@
  * @{
  *
  * @file
- * @brief       common SPI function fallback implementations
+ * @brief       common SPI function fallback implementations and the
+ *              transaction queue
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 #include <stddef.h>
+#include <stdint.h>
 
 #include "board.h"
 #include "cpu.h"
+#include "irq.h"
 #include "periph/spi.h"
 #include "periph_cpu.h"
 
 #if SPI_NUMOF
 
+/**
+ * @brief Transaction queue of a bus, it holds the bus while busy
+ */
+typedef struct {
+    spi_trans_t *head;          /**< next transaction to start */
+    spi_trans_t *tail;          /**< last queued transaction */
+    spi_trans_t *volatile cur;  /**< transaction in flight */
+    volatile int busy;          /**< the queue is being processed */
+    volatile int starting;      /**< a transaction is being started */
+} spi_queue_t;
+
+static spi_queue_t _queues[SPI_NUMOF];
+
 #ifdef PERIPH_SPI_NEEDS_TRANSFER_BYTES
 int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length)
 {
@@ -88,4 +104,139 @@ int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int
 }
 #endif
 
+static int _transfer_segs(spi_t dev, const spi_seg_t *segs,
+                          unsigned int numof)
+{
+    int res = 0;
+
+    for (unsigned int i = 0; i < numof; i++) {
+        int n = spi_transfer_bytes(dev, (char *)segs[i].out, segs[i].in,
+                                   segs[i].length);
+        if (n < 0) {
+            return -1;
+        }
+        res += n;
+    }
+    return res;
+}
+
+int spi_transfer_segs(spi_t dev, gpio_t cs, const spi_seg_t *segs,
+                      unsigned int numof)
+{
+    int res;
+
+    spi_acquire(dev);
+    if (cs != GPIO_UNDEF) {
+        gpio_clear(cs);
+    }
+    res = _transfer_segs(dev, segs, numof);
+    if (cs != GPIO_UNDEF) {
+        gpio_set(cs);
+    }
+    spi_release(dev);
+    return res;
+}
+
+#ifdef PERIPH_SPI_HAS_SEGS_ASYNC
+static void _run(spi_t dev);
+
+/* called in interrupt context at the end of the transaction in flight */
+static void _trans_done(void *arg)
+{
+    spi_t dev = (spi_t)(uintptr_t)arg;
+    spi_trans_t *trans = _queues[dev].cur;
+    int res = 0;
+
+    if (trans->cs != GPIO_UNDEF) {
+        gpio_set(trans->cs);
+    }
+    for (unsigned int i = 0; i < trans->segs_numof; i++) {
+        res += trans->segs[i].length;
+    }
+    _queues[dev].cur = NULL;
+    trans->cb(trans->arg, res);
+    if (!_queues[dev].starting) {
+        _run(dev);
+    }
+}
+#endif
+
+/* transfers the queued transactions, the bus is acquired */
+static void _run(spi_t dev)
+{
+    spi_queue_t *queue = &_queues[dev];
+
+    while (1) {
+        unsigned state = irq_disable();
+        spi_trans_t *trans = queue->head;
+
+        if (trans == NULL) {
+            queue->busy = 0;
+            irq_restore(state);
+            spi_release(dev);
+            return;
+        }
+        queue->head = trans->next;
+        irq_restore(state);
+
+        if (trans->cs != GPIO_UNDEF) {
+            gpio_clear(trans->cs);
+        }
+#ifdef PERIPH_SPI_HAS_SEGS_ASYNC
+        queue->cur = trans;
+        queue->starting = 1;
+        if (spi_transfer_segs_async(dev, trans->segs, trans->segs_numof,
+                                    _trans_done, (void *)(uintptr_t)dev) == 0) {
+            state = irq_disable();
+            queue->starting = 0;
+            if (queue->cur != NULL) {
+                /* continued by _trans_done() */
+                irq_restore(state);
+                return;
+            }
+            /* done already, continued here to not recurse */
+            irq_restore(state);
+            continue;
+        }
+        queue->starting = 0;
+        queue->cur = NULL;
+        if (trans->cs != GPIO_UNDEF) {
+            gpio_set(trans->cs);
+        }
+        trans->cb(trans->arg, -1);
+#else
+        int res = _transfer_segs(dev, trans->segs, trans->segs_numof);
+        if (trans->cs != GPIO_UNDEF) {
+            gpio_set(trans->cs);
+        }
+        trans->cb(trans->arg, res);
+#endif
+    }
+}
+
+void spi_queue(spi_t dev, spi_trans_t *trans)
+{
+    spi_queue_t *queue = &_queues[dev];
+    unsigned state = irq_disable();
+
+    trans->next = NULL;
+    if (queue->head == NULL) {
+        queue->head = trans;
+    }
+    else {
+        queue->tail->next = trans;
+    }
+    queue->tail = trans;
+    if (queue->busy) {
+        irq_restore(state);
+        return;
+    }
+    queue->busy = 1;
+    irq_restore(state);
+
+    /* blocking users and the queue take turns on the bus */
+    spi_acquire(dev);
+    _run(dev);
+}
+
 #endif /* SPI_NUMOF */
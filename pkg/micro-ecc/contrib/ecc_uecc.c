@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       micro-ecc backend of the ECC interface
+ *
+ * micro-ecc already uses the encodings of the interface. It has no
+ * fixed-base multiplication, so public keys are not precomputed.
+ *
+ * @}
+ */
+
+#include "crypto/ecc.h"
+#include "uECC.h"
+
+static uECC_Curve _curve(ecc_curve_t curve)
+{
+    switch (curve) {
+        case ECC_SECP192R1:
+            return uECC_secp192r1();
+        case ECC_SECP224R1:
+            return uECC_secp224r1();
+        case ECC_SECP256R1:
+            return uECC_secp256r1();
+        case ECC_SECP256K1:
+            return uECC_secp256k1();
+        default:
+            return NULL;
+    }
+}
+
+static int _make_key(ecc_curve_t curve, uint8_t *pub, uint8_t *priv)
+{
+    uECC_Curve c = _curve(curve);
+
+    if (c == NULL) {
+        return -ENOTSUP;
+    }
+    return uECC_make_key(pub, priv, c) ? 0 : -EIO;
+}
+
+static int _shared_secret(ecc_curve_t curve, const uint8_t *pub,
+                          const uint8_t *priv, uint8_t *secret)
+{
+    uECC_Curve c = _curve(curve);
+
+    if (c == NULL) {
+        return -ENOTSUP;
+    }
+    return uECC_shared_secret(pub, priv, secret, c) ? 0 : -EINVAL;
+}
+
+static int _sign(ecc_curve_t curve, const uint8_t *priv, const uint8_t *hash,
+                 size_t hash_len, uint8_t *sig)
+{
+    uECC_Curve c = _curve(curve);
+
+    if (c == NULL) {
+        return -ENOTSUP;
+    }
+    return uECC_sign(priv, hash, hash_len, sig, c) ? 0 : -EIO;
+}
+
+static int _verify(ecc_curve_t curve, const uint8_t *pub, const uint8_t *hash,
+                   size_t hash_len, const uint8_t *sig)
+{
+    uECC_Curve c = _curve(curve);
+
+    if (c == NULL) {
+        return -ENOTSUP;
+    }
+    return uECC_verify(pub, hash, hash_len, sig, c) ? 0 : -EBADMSG;
+}
+
+const ecc_backend_t ecc_uecc = {
+    .name = "micro-ecc",
+    .make_key = _make_key,
+    .shared_secret = _shared_secret,
+    .sign = _sign,
+    .verify = _verify,
+    .precompute = NULL,
+    .verify_pre = NULL,
+    .release = NULL,
+};
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       relic backend of the ECC interface
+ *
+ * relic keeps the curve parameters in a global context, so the operations
+ * are serialized by a mutex and switch the curve when needed. The generator
+ * table of the current curve is kept by relic itself.
+ *
+ * A verification computes u1 * G + u2 * Q. With a precomputed table of the
+ * public key Q, both multiplications are fixed-base multiplications.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "crypto/ecc.h"
+#include "mutex.h"
+#include "relic.h"
+
+typedef struct {
+    ep_t table[EP_TABLE];
+    bool used;
+} _pre_t;
+
+static const int _params[] = { NIST_P192, NIST_P224, NIST_P256, SECG_K256 };
+
+static mutex_t _lock = MUTEX_INIT;
+static bool _initialized;
+static _pre_t _pre[ECC_RELIC_PRE_NUMOF];
+
+/* locks relic and selects the curve, unlocks again on failure */
+static int _lock_curve(ecc_curve_t curve)
+{
+    if ((curve >= ECC_CURVE_NUMOF) || ((ecc_curve_size(curve) * 8) != FP_PRIME)) {
+        return -ENOTSUP;
+    }
+    mutex_lock(&_lock);
+    if (!_initialized) {
+        if (core_init() != STS_OK) {
+            mutex_unlock(&_lock);
+            return -EIO;
+        }
+        _initialized = true;
+    }
+    if (ep_param_get() != _params[curve]) {
+        ep_param_set(_params[curve]);
+        /* relic leaves out curves its configuration has no support for,
+         * e.g. SECG_K256 without EP_ENDOM */
+        if (ep_param_get() != _params[curve]) {
+            mutex_unlock(&_lock);
+            return -ENOTSUP;
+        }
+    }
+    return 0;
+}
+
+static int _read_point(ep_t p, ecc_curve_t curve, const uint8_t *pub)
+{
+    /* relic expects the prefix of uncompressed points */
+    uint8_t buf[1 + ECC_PUBLIC_KEY_SIZE_MAX];
+    size_t size = ecc_curve_size(curve);
+
+    buf[0] = 0x04;
+    memcpy(buf + 1, pub, 2 * size);
+    ep_read_bin(p, buf, 1 + (2 * size));
+    return ep_is_valid(p) ? 0 : -EINVAL;
+}
+
+/* reads a hash that is truncated to the bit length of the order n */
+static void _read_hash(bn_t e, const bn_t n, const uint8_t *hash,
+                       size_t hash_len)
+{
+    int bits = bn_bits(n);
+
+    if ((int)(8 * hash_len) > bits) {
+        hash_len = (bits + 7) / 8;
+        bn_read_bin(e, hash, hash_len);
+        bn_rsh(e, e, (8 * hash_len) - bits);
+    }
+    else {
+        bn_read_bin(e, hash, hash_len);
+    }
+}
+
+static int _make_key(ecc_curve_t curve, uint8_t *pub, uint8_t *priv)
+{
+    uint8_t buf[1 + ECC_PUBLIC_KEY_SIZE_MAX];
+    size_t size = ecc_curve_size(curve);
+    int res = _lock_curve(curve);
+    bn_t d;
+    ep_t q;
+
+    if (res < 0) {
+        return res;
+    }
+    bn_null(d);
+    ep_null(q);
+    bn_new(d);
+    ep_new(q);
+    if (cp_ecdsa_gen(d, q) == STS_OK) {
+        bn_write_bin(priv, size, d);
+        ep_write_bin(buf, 1 + (2 * size), q, 0);
+        memcpy(pub, buf + 1, 2 * size);
+    }
+    else {
+        res = -EIO;
+    }
+    bn_free(d);
+    ep_free(q);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static int _shared_secret(ecc_curve_t curve, const uint8_t *pub,
+                          const uint8_t *priv, uint8_t *secret)
+{
+    size_t size = ecc_curve_size(curve);
+    int res = _lock_curve(curve);
+    bn_t d, x;
+    ep_t q;
+
+    if (res < 0) {
+        return res;
+    }
+    bn_null(d);
+    bn_null(x);
+    ep_null(q);
+    bn_new(d);
+    bn_new(x);
+    ep_new(q);
+    /* the raw X coordinate, cp_ecdh_key() would apply a KDF */
+    res = _read_point(q, curve, pub);
+    if (res == 0) {
+        bn_read_bin(d, priv, size);
+        ep_mul(q, q, d);
+        ep_norm(q, q);
+        fp_prime_back(x, q->x);
+        bn_write_bin(secret, size, x);
+    }
+    bn_free(d);
+    bn_free(x);
+    ep_free(q);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static int _sign(ecc_curve_t curve, const uint8_t *priv, const uint8_t *hash,
+                 size_t hash_len, uint8_t *sig)
+{
+    size_t size = ecc_curve_size(curve);
+    int res = _lock_curve(curve);
+    bn_t d, r, s;
+
+    if (res < 0) {
+        return res;
+    }
+    bn_null(d);
+    bn_null(r);
+    bn_null(s);
+    bn_new(d);
+    bn_new(r);
+    bn_new(s);
+    bn_read_bin(d, priv, size);
+    /* the last but one argument tells relic that the message is hashed */
+    if (cp_ecdsa_sig(r, s, (uint8_t *)hash, hash_len, 1, d) == STS_OK) {
+        bn_write_bin(sig, size, r);
+        bn_write_bin(sig + size, size, s);
+    }
+    else {
+        res = -EIO;
+    }
+    bn_free(d);
+    bn_free(r);
+    bn_free(s);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static int _verify(ecc_curve_t curve, const uint8_t *pub, const uint8_t *hash,
+                   size_t hash_len, const uint8_t *sig)
+{
+    size_t size = ecc_curve_size(curve);
+    int res = _lock_curve(curve);
+    bn_t r, s;
+    ep_t q;
+
+    if (res < 0) {
+        return res;
+    }
+    bn_null(r);
+    bn_null(s);
+    ep_null(q);
+    bn_new(r);
+    bn_new(s);
+    ep_new(q);
+    res = _read_point(q, curve, pub);
+    if (res == 0) {
+        bn_read_bin(r, sig, size);
+        bn_read_bin(s, sig + size, size);
+        if (!cp_ecdsa_ver(r, s, (uint8_t *)hash, hash_len, 1, q)) {
+            res = -EBADMSG;
+        }
+    }
+    bn_free(r);
+    bn_free(s);
+    ep_free(q);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static int _precompute(ecc_pubkey_t *key)
+{
+    _pre_t *pre = NULL;
+    int res = _lock_curve(key->curve);
+    ep_t q;
+
+    if (res < 0) {
+        return res;
+    }
+    for (unsigned i = 0; i < ECC_RELIC_PRE_NUMOF; i++) {
+        if (!_pre[i].used) {
+            pre = &_pre[i];
+            break;
+        }
+    }
+    if (pre == NULL) {
+        mutex_unlock(&_lock);
+        return -ENOMEM;
+    }
+    ep_null(q);
+    ep_new(q);
+    res = _read_point(q, key->curve, key->pub);
+    if (res == 0) {
+        for (unsigned i = 0; i < EP_TABLE; i++) {
+            ep_null(pre->table[i]);
+            ep_new(pre->table[i]);
+        }
+        ep_mul_pre(pre->table, q);
+        pre->used = true;
+        key->pre = pre;
+    }
+    ep_free(q);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static int _verify_pre(const ecc_pubkey_t *key, const uint8_t *hash,
+                       size_t hash_len, const uint8_t *sig)
+{
+    const _pre_t *pre = key->pre;
+    size_t size = ecc_curve_size(key->curve);
+    int res = _lock_curve(key->curve);
+    bn_t n, r, s, e, w;
+    ep_t p, t;
+
+    if (res < 0) {
+        return res;
+    }
+    bn_null(n);
+    bn_null(r);
+    bn_null(s);
+    bn_null(e);
+    bn_null(w);
+    ep_null(p);
+    ep_null(t);
+    bn_new(n);
+    bn_new(r);
+    bn_new(s);
+    bn_new(e);
+    bn_new(w);
+    ep_new(p);
+    ep_new(t);
+
+    ep_curve_get_ord(n);
+    bn_read_bin(r, sig, size);
+    bn_read_bin(s, sig + size, size);
+    res = -EBADMSG;
+    if (bn_is_zero(r) || bn_is_zero(s) || (bn_cmp(r, n) != CMP_LT) ||
+        (bn_cmp(s, n) != CMP_LT)) {
+        goto out;
+    }
+
+    /* w = s^-1 mod n, e takes the gcd before it takes the hash */
+    bn_gcd_ext(e, w, NULL, s, n);
+    if (bn_sign(w) == BN_NEG) {
+        bn_add(w, w, n);
+    }
+    _read_hash(e, n, hash, hash_len);
+    /* u1 = e * w mod n, u2 = r * w mod n */
+    bn_mul(e, e, w);
+    bn_mod(e, e, n);
+    bn_mul(w, r, w);
+    bn_mod(w, w, n);
+
+    ep_mul_gen(p, e);
+    ep_mul_fix(t, (const ep_t *)pre->table, w);
+    ep_add(p, p, t);
+    ep_norm(p, p);
+    if (ep_is_infty(p)) {
+        goto out;
+    }
+    fp_prime_back(e, p->x);
+    bn_mod(e, e, n);
+    if (bn_cmp(e, r) == CMP_EQ) {
+        res = 0;
+    }
+
+out:
+    bn_free(n);
+    bn_free(r);
+    bn_free(s);
+    bn_free(e);
+    bn_free(w);
+    ep_free(p);
+    ep_free(t);
+    mutex_unlock(&_lock);
+    return res;
+}
+
+static void _release(ecc_pubkey_t *key)
+{
+    _pre_t *pre = key->pre;
+
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < EP_TABLE; i++) {
+        ep_free(pre->table[i]);
+    }
+    pre->used = false;
+    mutex_unlock(&_lock);
+}
+
+const ecc_backend_t ecc_relic = {
+    .name = "relic",
+    .make_key = _make_key,
+    .shared_secret = _shared_secret,
+    .sign = _sign,
+    .verify = _verify,
+    .precompute = _precompute,
+    .verify_pre = _verify_pre,
+    .release = _release,
+};
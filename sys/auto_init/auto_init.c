@@ -92,6 +92,14 @@
 #include "random.h"
 #endif
 
+#ifdef MODULE_AES_MOCK
+#include "aes_mock.h"
+#endif
+
+#ifdef MODULE_LOG_BINARY
+#include "log_binary.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -132,6 +140,14 @@ void auto_init(void)
     DEBUG("Auto init mci module.\n");
     mci_initialize();
 #endif
+#ifdef MODULE_AES_MOCK
+    DEBUG("Auto init mock AES accelerator.\n");
+    aes_mock_init();
+#endif
+#ifdef MODULE_LOG_BINARY
+    DEBUG("Auto init log_binary module.\n");
+    log_binary_init();
+#endif
 #ifdef MODULE_PROFILING
     extern void profiling_init(void);
     profiling_init();
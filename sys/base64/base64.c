@@ -18,49 +18,217 @@
  *
  */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "base64.h"
 
-#define BASE64_CAPITAL_UPPER_BOUND     (25)     /**< base64 'Z'           */
-#define BASE64_SMALL_UPPER_BOUND       (51)     /**< base64 'z'           */
-#define BASE64_NUMBER_UPPER_BOUND      (61)     /**< base64 '9'           */
-#define BASE64_PLUS                    (62)     /**< base64 '+'           */
-#define BASE64_SLASH                   (63)     /**< base64 '/'           */
-#define BASE64_EQUALS                  (0xFE)   /**< no base64 symbol '=' */
 #define BASE64_NOT_DEFINED             (0xFF)   /**< no base64 symbol     */
 
+static const char _alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const char _alphabet_url[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/*
+ * the base64 and the base64url code of each ASCII symbol, BASE64_NOT_DEFINED for symbols that
+ * are ignored, e.g. line breaks and '='. The symbols of the other alphabet
+ * are not defined, so a decoder only accepts its own.
+ */
+static const uint8_t _codes[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b,
+    0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+    0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+    0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t _codes_url[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b,
+    0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+    0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0x3f,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+    0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
 /*
- * returns the corresponding ascii symbol value for the given base64 code
+ * returns the base64 code of a symbol, or a value with bit 7 set if it is
+ * not defined. There is no branch on the symbol.
  */
-static char getsymbol(unsigned char code)
+static inline unsigned _getcode(const uint8_t *codes, unsigned char symbol)
+{
+    return codes[symbol & 0x7f] | (symbol & 0x80);
+}
+
+static inline const char *_get_alphabet(const base64_ctx_t *ctx)
+{
+    return ctx->url ? _alphabet_url : _alphabet;
+}
+
+/* writes the four symbols of the 24 bits in n */
+static inline unsigned char *_put4(const char *alphabet, uint32_t n,
+                                   unsigned char *out)
+{
+    out[0] = alphabet[(n >> 18) & 0x3f];
+    out[1] = alphabet[(n >> 12) & 0x3f];
+    out[2] = alphabet[(n >> 6) & 0x3f];
+    out[3] = alphabet[n & 0x3f];
+    return out + 4;
+}
+
+/* writes the three bytes of the 24 bits in n */
+static inline unsigned char *_put3(uint32_t n, unsigned char *out)
+{
+    out[0] = (unsigned char)(n >> 16);
+    out[1] = (unsigned char)(n >> 8);
+    out[2] = (unsigned char)n;
+    return out + 3;
+}
+
+static size_t _encoded_size(size_t size, bool url)
+{
+    /* base64url is not padded */
+    return url ? (((4 * size) + 2) / 3) : (4 * ((size + 2) / 3));
+}
+
+static unsigned char *_encode(base64_ctx_t *ctx, const unsigned char *in,
+                              size_t size, unsigned char *out)
 {
-    if (code == BASE64_SLASH) {
-        return '/';
+    const char *alphabet = _get_alphabet(ctx);
+
+    /* complete the pending group */
+    for (; (ctx->num > 0) && (size > 0); size--) {
+        ctx->acc = (ctx->acc << 8) | *in++;
+        if (++ctx->num == 3) {
+            out = _put4(alphabet, ctx->acc, out);
+            ctx->acc = 0;
+            ctx->num = 0;
+        }
     }
 
-    if (code == BASE64_PLUS) {
-        return '+';
+    for (; size >= 3; size -= 3) {
+        uint32_t n = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+
+        out = _put4(alphabet, n, out);
+        in += 3;
     }
 
-    if (code <= BASE64_CAPITAL_UPPER_BOUND) {
-        return (code + 'A');
+    for (; size > 0; size--) {
+        ctx->acc = (ctx->acc << 8) | *in++;
+        ctx->num++;
     }
+    return out;
+}
 
-    if (code <= BASE64_SMALL_UPPER_BOUND) {
-        return (code + ('z' - BASE64_SMALL_UPPER_BOUND));
+static unsigned char *_encode_finish(base64_ctx_t *ctx, unsigned char *out)
+{
+    const char *alphabet = _get_alphabet(ctx);
+    unsigned num = ctx->num;
+    uint32_t n = ctx->acc << (8 * (3 - num));
+
+    if (num == 0) {
+        return out;
+    }
+    *out++ = alphabet[(n >> 18) & 0x3f];
+    *out++ = alphabet[(n >> 12) & 0x3f];
+    if (num == 2) {
+        *out++ = alphabet[(n >> 6) & 0x3f];
+    }
+    if (!ctx->url) {
+        /* we append '=' for the required dividability */
+        for (; num < 3; num++) {
+            *out++ = '=';
+        }
     }
+    ctx->acc = 0;
+    ctx->num = 0;
+    return out;
+}
 
-    if (code <= BASE64_NUMBER_UPPER_BOUND) {
-        return (code + ('9' - BASE64_NUMBER_UPPER_BOUND));
+static unsigned char *_decode(base64_ctx_t *ctx, const unsigned char *in,
+                              size_t size, unsigned char *out)
+{
+    const uint8_t *codes = ctx->url ? _codes_url : _codes;
+
+    while (size > 0) {
+        /* whole groups of valid symbols */
+        while ((ctx->num == 0) && (size >= 4)) {
+            unsigned a = _getcode(codes, in[0]);
+            unsigned b = _getcode(codes, in[1]);
+            unsigned c = _getcode(codes, in[2]);
+            unsigned d = _getcode(codes, in[3]);
+
+            if ((a | b | c | d) & 0x80) {
+                break;
+            }
+            out = _put3(((uint32_t)a << 18) | ((uint32_t)b << 12) | (c << 6) | d, out);
+            in += 4;
+            size -= 4;
+        }
+        if (size == 0) {
+            break;
+        }
+
+        /* a single symbol, symbols that are not defined are ignored */
+        unsigned code = _getcode(codes, *in++);
+        size--;
+        if (code & 0x80) {
+            continue;
+        }
+        ctx->acc = (ctx->acc << 6) | code;
+        if (++ctx->num == 4) {
+            out = _put3(ctx->acc, out);
+            ctx->acc = 0;
+            ctx->num = 0;
+        }
     }
+    return out;
+}
 
-    return (char)BASE64_NOT_DEFINED;
+static unsigned char *_decode_finish(base64_ctx_t *ctx, unsigned char *out)
+{
+    /* a single remaining symbol holds less than a byte and is dropped */
+    if (ctx->num == 2) {
+        *out++ = (unsigned char)(ctx->acc >> 4);
+    }
+    else if (ctx->num == 3) {
+        *out++ = (unsigned char)(ctx->acc >> 10);
+        *out++ = (unsigned char)(ctx->acc >> 2);
+    }
+    ctx->acc = 0;
+    ctx->num = 0;
+    return out;
 }
 
-int base64_encode(unsigned char *data_in, size_t data_in_size, \
-                  unsigned char *base64_out, size_t *base64_out_size)
+static int _encode_all(bool url, unsigned char *data_in, size_t data_in_size,
+                       unsigned char *base64_out, size_t *base64_out_size)
 {
-    size_t padding_bytes = ((data_in_size % 3) ? (3 - (data_in_size % 3)) : 0);
-    size_t required_size = (4 * (data_in_size + 2 - ((data_in_size + 2) % 3)) / 3) + padding_bytes;
+    size_t required_size = _encoded_size(data_in_size, url);
+    base64_ctx_t ctx;
+    unsigned char *out;
 
     if (data_in == NULL) {
         return BASE64_ERROR_DATA_IN;
@@ -79,98 +247,150 @@ int base64_encode(unsigned char *data_in, size_t data_in_size, \
         return BASE64_ERROR_BUFFER_OUT;
     }
 
-    int iterate_base64_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = 0;
-    int njump = 0;
-
-    for (int i = 0; i < (int)(data_in_size); ++i) {
-        unsigned char tmpval;
-        njump++;
-        tmpval = *(data_in + i);
+    ctx.acc = 0;
+    ctx.num = 0;
+    ctx.url = url;
+    out = _encode(&ctx, data_in, data_in_size, base64_out);
+    out = _encode_finish(&ctx, out);
+    *base64_out_size = out - base64_out;
 
-        nNum = (tmpval >> (2 * njump));
+    return BASE64_SUCCESS;
+}
 
-        if (njump == 4) {
-            nNum = nLst << (8 - 2 * njump);
-            njump = 0;
-            nLst = 0;
-            --i;
-        }
-        else {
-            nNum += nLst << (8 - 2 * njump);
-            nLst =  tmpval & ((1 << njump * 2) - 1);
-        }
+static int _decode_all(bool url, size_t min_size, unsigned char *base64_in,
+                       size_t base64_in_size, unsigned char *data_out,
+                       size_t *data_out_size)
+{
+    /* four symbols are three bytes, it is less if some are not defined */
+    size_t required_size = (base64_in_size * 3) / 4;
+    base64_ctx_t ctx;
+    unsigned char *out;
 
-        base64_out[iterate_base64_buffer++] = getsymbol(nNum);
+    if (base64_in == NULL) {
+        return BASE64_ERROR_DATA_IN;
     }
 
-    /* The last character is not finished yet */
-    njump++;
+    if (base64_in_size < min_size) {
+        return BASE64_ERROR_DATA_IN_SIZE;
+    }
 
-    nNum = nLst << (8 - 2 * njump);
-    base64_out[iterate_base64_buffer++] = getsymbol(nNum);
+    if (*data_out_size < required_size) {
+        *data_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
+    }
 
-    /* if required we append '=' for the required dividability */
-    while (iterate_base64_buffer % 4) {
-        base64_out[iterate_base64_buffer++] = '=';
+    if (data_out == NULL) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    *base64_out_size = iterate_base64_buffer;
+    base64_decode_init(&ctx);
+    ctx.url = url;
+    out = _decode(&ctx, base64_in, base64_in_size, data_out);
+    out = _decode_finish(&ctx, out);
+    *data_out_size = out - data_out;
 
     return BASE64_SUCCESS;
 }
 
-/*
- *  returns the corresponding base64 code for the given ascii symbol
- */
-static int getcode(char symbol)
+int base64_encode(unsigned char *data_in, size_t data_in_size, \
+                  unsigned char *base64_out, size_t *base64_out_size)
 {
-    if (symbol == '/') {
-        return BASE64_SLASH;
-    }
+    return _encode_all(false, data_in, data_in_size, base64_out, base64_out_size);
+}
 
-    if (symbol == '+') {
-        return BASE64_PLUS;
-    }
+int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
+                  unsigned char *data_out, size_t *data_out_size)
+{
+    return _decode_all(false, 4, base64_in, base64_in_size, data_out, data_out_size);
+}
+
+int base64url_encode(unsigned char *data_in, size_t data_in_size, \
+                     unsigned char *base64_out, size_t *base64_out_size)
+{
+    return _encode_all(true, data_in, data_in_size, base64_out, base64_out_size);
+}
+
+int base64url_decode(unsigned char *base64_in, size_t base64_in_size, \
+                     unsigned char *data_out, size_t *data_out_size)
+{
+    return _decode_all(true, 2, base64_in, base64_in_size, data_out, data_out_size);
+}
+
+void base64_encode_init(base64_ctx_t *ctx)
+{
+    ctx->acc = 0;
+    ctx->num = 0;
+    ctx->url = false;
+}
 
-    if (symbol == '=') {
-        /* indicates a padded base64 end */
-        return BASE64_EQUALS;
+void base64url_encode_init(base64_ctx_t *ctx)
+{
+    base64_encode_init(ctx);
+    ctx->url = true;
+}
+
+int base64_encode_update(base64_ctx_t *ctx, const unsigned char *data_in,
+                         size_t data_in_size, unsigned char *base64_out,
+                         size_t *base64_out_size)
+{
+    size_t required_size = 4 * ((ctx->num + data_in_size) / 3);
+
+    if ((data_in == NULL) && (data_in_size > 0)) {
+        return BASE64_ERROR_DATA_IN;
     }
 
-    if (symbol < '0') {
-        /* indicates that the given symbol is not base64 and should be ignored */
-        return BASE64_NOT_DEFINED;
+    if (*base64_out_size < required_size) {
+        *base64_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (symbol <= '9' && symbol >= '0') {
-        return (symbol + (BASE64_NUMBER_UPPER_BOUND - '9'));
+    if ((base64_out == NULL) && (required_size > 0)) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    if (symbol <= 'Z' && symbol >= 'A') {
-        return (symbol - 'A');
+    *base64_out_size = _encode(ctx, data_in, data_in_size, base64_out) - base64_out;
+    return BASE64_SUCCESS;
+}
+
+int base64_encode_finish(base64_ctx_t *ctx, unsigned char *base64_out,
+                         size_t *base64_out_size)
+{
+    size_t required_size = _encoded_size(ctx->num, ctx->url);
+
+    if (*base64_out_size < required_size) {
+        *base64_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (symbol <= 'z' && symbol >= 'a') {
-        return (symbol + (BASE64_SMALL_UPPER_BOUND - 'z'));
+    if ((base64_out == NULL) && (required_size > 0)) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    /* indicates that the given symbol is not base64 and should be ignored */
-    return BASE64_NOT_DEFINED;
+    *base64_out_size = _encode_finish(ctx, base64_out) - base64_out;
+    return BASE64_SUCCESS;
 }
 
-int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
-                  unsigned char *data_out, size_t *data_out_size)
+void base64_decode_init(base64_ctx_t *ctx)
+{
+    ctx->acc = 0;
+    ctx->num = 0;
+    ctx->url = false;
+}
+
+void base64url_decode_init(base64_ctx_t *ctx)
 {
-    size_t required_size = ((base64_in_size / 4) * 3);
+    base64_decode_init(ctx);
+    ctx->url = true;
+}
 
-    if (base64_in == NULL) {
-        return BASE64_ERROR_DATA_IN;
-    }
+int base64_decode_update(base64_ctx_t *ctx, const unsigned char *base64_in,
+                         size_t base64_in_size, unsigned char *data_out,
+                         size_t *data_out_size)
+{
+    size_t required_size = 3 * ((ctx->num + base64_in_size) / 4);
 
-    if (base64_in_size < 4) {
-        return BASE64_ERROR_DATA_IN_SIZE;
+    if ((base64_in == NULL) && (base64_in_size > 0)) {
+        return BASE64_ERROR_DATA_IN;
     }
 
     if (*data_out_size < required_size) {
@@ -178,38 +398,28 @@ int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
         return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (data_out == NULL) {
+    if ((data_out == NULL) && (required_size > 0)) {
         return BASE64_ERROR_BUFFER_OUT;
     }
 
-    int iterate_data_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = getcode(base64_in[0]) << 2;
-    int code = 0;
-
-    int mask = 2;
-
-    for (int i = 1; i < (int)(base64_in_size); i++) {
-        code = getcode(base64_in[i]);
-
-        if (code == BASE64_NOT_DEFINED || code == BASE64_EQUALS) {
-            continue;
-        }
-
-        int nm = (0xFF << (2 * mask));
+    *data_out_size = _decode(ctx, base64_in, base64_in_size, data_out) - data_out;
+    return BASE64_SUCCESS;
+}
 
-        nNum = nLst + ((code & (0xFF & nm)) >> (2 * mask));
-        nLst = (code & (0xFF & ~nm)) << (8 - (2 * mask));
+int base64_decode_finish(base64_ctx_t *ctx, unsigned char *data_out,
+                         size_t *data_out_size)
+{
+    size_t required_size = (ctx->num * 3) / 4;
 
-        (mask != 3) ? data_out[iterate_data_buffer++] = nNum : nNum;
-        (mask == 0) ? mask = 3 : mask--;
+    if (*data_out_size < required_size) {
+        *data_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (code == BASE64_EQUALS) {
-        /* add the last character to the data_out buffer */
-        data_out[iterate_data_buffer] = nNum;
+    if ((data_out == NULL) && (required_size > 0)) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    *data_out_size = iterate_data_buffer;
+    *data_out_size = _decode_finish(ctx, data_out) - data_out;
     return BASE64_SUCCESS;
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Bit indices and 4 bit cells shared by the Bloom filter variants
+ *
+ * @}
+ */
+
+#ifndef BLOOM_INTERNAL_H_
+#define BLOOM_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bloom.h"
+#include "hashes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* seeds of the two base hashes of double hashing */
+#define BLOOM_SEED1     (0x00000000UL)
+#define BLOOM_SEED2     (0x9e3779b9UL)
+
+/* state of the computation of the indices of an element */
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    hashfp_t *hash;
+    size_t m;
+    size_t n;
+    size_t idx;
+    size_t step;
+} bloom_index_t;
+
+/*
+ * Enhanced double hashing (Dillinger, Manolios: "Bloom Filters in
+ * Probabilistic Verification"): the indices are derived from two base hashes
+ * h1 and h2 as idx(n) = h1 + n * h2 + n * (n - 1) * (n - 2) / 6 mod m, so
+ * the key is hashed only once. Unlike plain double hashing (h1 + n * h2)
+ * it also spreads the indices if h2 shares factors with m, e.g. for a
+ * power of 2.
+ */
+static inline void bloom_index_init(bloom_index_t *index, size_t m,
+                                    hashfp_t *hash, const uint8_t *buf,
+                                    size_t len)
+{
+    index->buf = buf;
+    index->len = len;
+    index->hash = hash;
+    index->m = m;
+    index->n = 0;
+    index->idx = 0;
+    index->step = 0;
+
+    if (hash == NULL) {
+        const uint32_t seeds[2] = { BLOOM_SEED1, BLOOM_SEED2 };
+        uint32_t h[2];
+
+        murmur3_hash_x2(buf, len, seeds, h);
+        index->idx = h[0] % m;
+        index->step = h[1] % m;
+        /* a step of 0 would map the first indices to the same bit */
+        if (index->step == 0) {
+            index->step = 1;
+        }
+    }
+}
+
+static inline size_t _bloom_add_mod(size_t a, size_t b, size_t m)
+{
+    /* both summands are less than m, this saves a division */
+    a += b;
+    return (a >= m) ? (a - m) : a;
+}
+
+/* returns the next index, call it k times */
+static inline size_t bloom_index_next(bloom_index_t *index)
+{
+    size_t n = index->n++;
+
+    if (index->hash == NULL) {
+        size_t idx = index->idx;
+
+        index->idx = _bloom_add_mod(idx, index->step, index->m);
+        /* n reaches m if there are more hashes than bits */
+        index->step = _bloom_add_mod(index->step, n % index->m, index->m);
+        return idx;
+    }
+    return index->hash[n](index->buf, index->len) % index->m;
+}
+
+/* the 4 bit cells of the counting and the rotating filter, two per byte */
+static inline unsigned bloom_cell_get(const uint8_t *cells, size_t idx)
+{
+    return (cells[idx / 2] >> ((idx & 1) * 4)) & 0xf;
+}
+
+static inline void bloom_cell_set(uint8_t *cells, size_t idx, unsigned val)
+{
+    unsigned shift = (idx & 1) * 4;
+
+    cells[idx / 2] = (cells[idx / 2] & ~(0xf << shift)) | (val << shift);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOOM_INTERNAL_H_ */
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 
 #include "bloom.h"
+#include "bloom-internal.h"
 #include "bitfield.h"
 #include "string.h"
 
@@ -44,18 +45,21 @@ void bloom_del(bloom_t *bloom)
 
 void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    bloom_index_t index;
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
     for (size_t n = 0; n < bloom->k; n++) {
-        uint32_t hash = bloom->hash[n](buf, len);
-        bf_set(bloom->a, (hash % bloom->m));
+        bf_set(bloom->a, bloom_index_next(&index));
     }
 }
 
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
-    for (size_t n = 0; n < bloom->k; n++) {
-        uint32_t hash = bloom->hash[n](buf, len);
+    bloom_index_t index;
 
-        if (!(bf_isset(bloom->a, (hash % bloom->m)))) {
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!(bf_isset(bloom->a, bloom_index_next(&index)))) {
             return false;
         }
     }
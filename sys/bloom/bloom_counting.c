@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Counting Bloom filter implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "bloom.h"
+#include "bloom-internal.h"
+
+void bloom_counting_init(bloom_counting_t *bloom, size_t size, uint8_t *cells,
+                         hashfp_t *hashes, int hashes_numof)
+{
+    bloom->m = size;
+    bloom->k = hashes_numof;
+    bloom->cells = cells;
+    bloom->hash = hashes;
+    memset(cells, 0, BLOOM_CELLS_SIZE(size));
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    bloom_index_t index;
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = bloom_index_next(&index);
+        unsigned count = bloom_cell_get(bloom->cells, idx);
+
+        if (count < BLOOM_COUNTER_MAX) {
+            bloom_cell_set(bloom->cells, idx, count + 1);
+        }
+    }
+}
+
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    bloom_index_t index;
+
+    if (!bloom_counting_check(bloom, buf, len)) {
+        return -ENOENT;
+    }
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = bloom_index_next(&index);
+        unsigned count = bloom_cell_get(bloom->cells, idx);
+
+        /* the true count of an overflowed counter is unknown */
+        if ((count > 0) && (count < BLOOM_COUNTER_MAX)) {
+            bloom_cell_set(bloom->cells, idx, count - 1);
+        }
+    }
+    return 0;
+}
+
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    bloom_index_t index;
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (bloom_cell_get(bloom->cells, bloom_index_next(&index)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
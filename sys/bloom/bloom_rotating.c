@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Rotating Bloom filter implementation
+ *
+ * A cell holds the generation in which it was set last, 1 to 15, or 0 if it
+ * is empty. A cell is set if it was set in one of the last gens generations.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bloom.h"
+#include "bloom-internal.h"
+
+#define GEN_NUMOF       (15U)
+
+/* number of rotations since the cell was set last */
+static inline unsigned _age(const bloom_rotating_t *bloom, unsigned cell)
+{
+    return (bloom->gen + GEN_NUMOF - cell) % GEN_NUMOF;
+}
+
+static inline bool _is_set(const bloom_rotating_t *bloom, unsigned cell)
+{
+    return (cell != 0) && (_age(bloom, cell) < bloom->gens);
+}
+
+void bloom_rotating_init(bloom_rotating_t *bloom, size_t size, uint8_t *cells,
+                         hashfp_t *hashes, int hashes_numof, unsigned gens)
+{
+    assert((gens > 0) && (gens <= BLOOM_ROTATING_GENS_MAX));
+
+    bloom->m = size;
+    bloom->k = hashes_numof;
+    bloom->cells = cells;
+    bloom->hash = hashes;
+    bloom->sweep = 0;
+    bloom->gens = gens;
+    bloom->gen = 1;
+    memset(cells, 0, BLOOM_CELLS_SIZE(size));
+}
+
+void bloom_rotating_add(bloom_rotating_t *bloom, const uint8_t *buf, size_t len)
+{
+    bloom_index_t index;
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        bloom_cell_set(bloom->cells, bloom_index_next(&index), bloom->gen);
+    }
+}
+
+bool bloom_rotating_check(const bloom_rotating_t *bloom, const uint8_t *buf, size_t len)
+{
+    bloom_index_t index;
+
+    bloom_index_init(&index, bloom->m, bloom->hash, buf, len);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!_is_set(bloom, bloom_cell_get(bloom->cells, bloom_index_next(&index)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bloom_rotating_rotate(bloom_rotating_t *bloom)
+{
+    /* A cell expires gens rotations after it was set last and would look
+     * set again after GEN_NUMOF rotations. In between, the sweep visits all
+     * cells once and clears the expired ones. */
+    unsigned rounds = GEN_NUMOF - bloom->gens;
+    size_t size = BLOOM_CELLS_SIZE(bloom->m);
+    size_t num = (size + rounds - 1) / rounds;
+
+    bloom->gen = (bloom->gen % GEN_NUMOF) + 1;
+
+    /* two cells at a time */
+    for (size_t i = 0; i < num; i++) {
+        uint8_t *cells = &bloom->cells[bloom->sweep];
+
+        if (*cells != 0) {
+            unsigned lo = *cells & 0xf;
+            unsigned hi = *cells >> 4;
+
+            lo = _is_set(bloom, lo) ? lo : 0;
+            hi = _is_set(bloom, hi) ? hi : 0;
+            *cells = (uint8_t)((hi << 4) | lo);
+        }
+        bloom->sweep = (bloom->sweep + 1 < size) ? (bloom->sweep + 1) : 0;
+    }
+}
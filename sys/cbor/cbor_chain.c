@@ -0,0 +1,616 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cbor
+ * @{
+ *
+ * @file
+ * @brief       CBOR reader and writer for chains of buffers
+ *
+ * A failed call has no effect: functions that may cross buffers work on a
+ * copy of the cursor and only store it on success.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#ifndef CBOR_NO_FLOAT
+#include <math.h>
+#endif
+
+#include "cbor_chain.h"
+
+#define INFO_UINT8              (24U)   /* first info with bytes following */
+#define INFO_UINT64             (27U)   /* last info with bytes following */
+#define INFO_FALSE              (20U)
+#define INFO_TRUE               (21U)
+#define INFO_FLOAT16            (25U)
+#define INFO_FLOAT32            (26U)
+#define INFO_FLOAT64            (27U)
+
+#define HEAD_SIZE_MAX           (9U)
+
+/* what the reader functions accept as the next item */
+enum {
+    ACCEPT_ANY,
+    ACCEPT_UINT,
+    ACCEPT_INT,
+    ACCEPT_STRING,
+    ACCEPT_BOOL,
+    ACCEPT_FLOAT,
+};
+
+/* items left at a level of cbor_reader_skip() for indefinite containers */
+#define LEFT_INDEFINITE         (UINT64_MAX)
+
+/* moves the cursor to the next buffer, if there is one */
+static bool _advance(cbor_cursor_t *cur)
+{
+    uint8_t *data;
+    size_t len;
+
+#ifdef MODULE_GNRC_PKT
+    if (cur->pkt) {
+        const gnrc_pktsnip_t *next = ((const gnrc_pktsnip_t *)cur->buf)->next;
+
+        if (next == NULL) {
+            return false;
+        }
+        cur->buf = next;
+        data = next->data;
+        len = next->size;
+    }
+    else
+#endif
+    {
+        const struct iovec *next = cur->buf;
+
+        if (next >= cur->vec_end) {
+            return false;
+        }
+        cur->buf = next + 1;
+        data = next->iov_base;
+        len = next->iov_len;
+    }
+    cur->pos = data;
+    cur->end = data + len;
+    return true;
+}
+
+static void _init(cbor_cursor_t *cur, const struct iovec *vec, size_t count)
+{
+    cur->buf = vec;
+    cur->vec_end = vec + count;
+    cur->pos = NULL;
+    cur->end = NULL;
+    cur->pkt = false;
+}
+
+#ifdef MODULE_GNRC_PKT
+static void _init_pkt(cbor_cursor_t *cur, const gnrc_pktsnip_t *pkt)
+{
+    cur->buf = pkt;
+    cur->vec_end = NULL;
+    cur->pos = pkt->data;
+    cur->end = cur->pos + pkt->size;
+    cur->pkt = true;
+}
+#endif
+
+/* reads len bytes into out, or skips them if out is NULL */
+static int _get(cbor_cursor_t *cur, uint8_t *out, size_t len)
+{
+    while (len > 0) {
+        size_t num = cur->end - cur->pos;
+
+        if (num == 0) {
+            if (!_advance(cur)) {
+                return -EAGAIN;
+            }
+            continue;
+        }
+        if (num > len) {
+            num = len;
+        }
+        if (out != NULL) {
+            memcpy(out, cur->pos, num);
+            out += num;
+        }
+        cur->pos += num;
+        len -= num;
+    }
+    return 0;
+}
+
+static void _put(cbor_cursor_t *cur, const uint8_t *in, size_t len)
+{
+    while (len > 0) {
+        size_t num = cur->end - cur->pos;
+
+        if (num == 0) {
+            /* the caller checked the free space */
+            _advance(cur);
+            continue;
+        }
+        if (num > len) {
+            num = len;
+        }
+        memcpy(cur->pos, in, num);
+        in += num;
+        cur->pos += num;
+        len -= num;
+    }
+}
+
+/* checks whether a reader function accepts the item */
+static int _check(const cbor_item_t *item, unsigned what)
+{
+    bool ok;
+
+    switch (what) {
+        case ACCEPT_UINT:
+            ok = (item->type == CBOR_MAJOR_UINT);
+            break;
+        case ACCEPT_INT:
+            if ((item->type != CBOR_MAJOR_UINT) &&
+                (item->type != CBOR_MAJOR_NEGINT)) {
+                return -EBADMSG;
+            }
+            return (item->val > INT64_MAX) ? -ERANGE : 0;
+        case ACCEPT_STRING:
+            ok = ((item->type == CBOR_MAJOR_BYTES) ||
+                  (item->type == CBOR_MAJOR_TEXT)) &&
+                 (item->info != CBOR_INFO_INDEFINITE);
+            break;
+        case ACCEPT_BOOL:
+            ok = (item->type == CBOR_MAJOR_SIMPLE) &&
+                 ((item->info == INFO_FALSE) || (item->info == INFO_TRUE));
+            break;
+        case ACCEPT_FLOAT:
+            ok = (item->type == CBOR_MAJOR_SIMPLE) &&
+                 (item->info >= INFO_FLOAT16) && (item->info <= INFO_FLOAT64);
+            break;
+        default:
+            ok = true;
+            break;
+    }
+    return ok ? 0 : -EBADMSG;
+}
+
+/* decodes a head that may be split across buffers, on a copy of the cursor */
+static int _head_split(cbor_cursor_t *cur, cbor_item_t *item, unsigned what)
+{
+    cbor_cursor_t tmp = *cur;
+    uint8_t buf[HEAD_SIZE_MAX - 1];
+    unsigned follow;
+    uint8_t initial;
+    int res;
+
+    if (_get(&tmp, &initial, 1) < 0) {
+        return -EAGAIN;
+    }
+    item->type = initial >> 5;
+    item->info = initial & 0x1f;
+    item->val = item->info;
+    if (item->info > INFO_UINT64) {
+        /* integers and tags have no indefinite length */
+        if ((item->info != CBOR_INFO_INDEFINITE) ||
+            (item->type < CBOR_MAJOR_BYTES) || (item->type == CBOR_MAJOR_TAG)) {
+            return -EBADMSG;
+        }
+        item->val = 0;
+    }
+    else if (item->info >= INFO_UINT8) {
+        follow = 1U << (item->info - INFO_UINT8);
+        if (_get(&tmp, buf, follow) < 0) {
+            return -EAGAIN;
+        }
+        item->val = 0;
+        for (unsigned i = 0; i < follow; i++) {
+            item->val = (item->val << 8) | buf[i];
+        }
+    }
+    res = _check(item, what);
+    if (res == 0) {
+        *cur = tmp;
+    }
+    return res;
+}
+
+/*
+ * Gets the head of the next item and moves the cursor past it if it is
+ * accepted. Heads within the current buffer only move the position, so the
+ * cursor is not copied then.
+ */
+static inline int _head(cbor_cursor_t *cur, cbor_item_t *item, unsigned what)
+{
+    const uint8_t *pos = cur->pos;
+    unsigned follow = 0;
+    uint64_t num;
+    uint8_t info;
+    int res;
+
+    if (pos >= cur->end) {
+        return _head_split(cur, item, what);
+    }
+    info = *pos & 0x1f;
+    num = info;
+    if (info >= INFO_UINT8) {
+        if ((info > INFO_UINT64) ||
+            ((size_t)(cur->end - pos) <= (1U << (info - INFO_UINT8)))) {
+            return _head_split(cur, item, what);
+        }
+        follow = 1U << (info - INFO_UINT8);
+        num = 0;
+        for (unsigned i = 1; i <= follow; i++) {
+            num = (num << 8) | pos[i];
+        }
+    }
+    item->type = *pos >> 5;
+    item->info = info;
+    item->val = num;
+    res = _check(item, what);
+    if (res == 0) {
+        cur->pos += 1 + follow;
+    }
+    return res;
+}
+
+void cbor_reader_init(cbor_reader_t *reader, const struct iovec *vec,
+                      size_t count)
+{
+    _init(&reader->cur, vec, count);
+}
+
+#ifdef MODULE_GNRC_PKT
+void cbor_reader_init_pkt(cbor_reader_t *reader, const gnrc_pktsnip_t *pkt)
+{
+    _init_pkt(&reader->cur, pkt);
+}
+#endif
+
+void cbor_reader_feed(cbor_reader_t *reader, size_t count)
+{
+    if (!reader->cur.pkt) {
+        reader->cur.vec_end += count;
+    }
+}
+
+int cbor_reader_peek(const cbor_reader_t *reader, cbor_item_t *item)
+{
+    cbor_cursor_t cur = reader->cur;
+
+    return _head(&cur, item, ACCEPT_ANY);
+}
+
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item)
+{
+    return _head(&reader->cur, item, ACCEPT_ANY);
+}
+
+int cbor_reader_read(cbor_reader_t *reader, void *buf, size_t len)
+{
+    cbor_cursor_t cur = reader->cur;
+    int res = _get(&cur, buf, len);
+
+    if (res == 0) {
+        reader->cur = cur;
+    }
+    return res;
+}
+
+int cbor_reader_skip(cbor_reader_t *reader)
+{
+    cbor_cursor_t cur = reader->cur;
+    uint64_t left[CBOR_CHAIN_DEPTH_MAX + 1];
+    unsigned depth = 1;
+
+    left[0] = 1;
+    while (depth > 0) {
+        cbor_item_t item;
+        uint64_t items;
+        int res;
+
+        if (left[depth - 1] == 0) {
+            depth--;
+            continue;
+        }
+        res = _head(&cur, &item, ACCEPT_ANY);
+        if (res < 0) {
+            return res;
+        }
+        if ((item.type == CBOR_MAJOR_SIMPLE) &&
+            (item.info == CBOR_INFO_INDEFINITE)) {
+            if (left[depth - 1] != LEFT_INDEFINITE) {
+                return -EBADMSG;
+            }
+            depth--;
+            continue;
+        }
+        if (left[depth - 1] != LEFT_INDEFINITE) {
+            left[depth - 1]--;
+        }
+
+        if (item.info == CBOR_INFO_INDEFINITE) {
+            /* chunks of a string or items of a container up to a break */
+            items = LEFT_INDEFINITE;
+        }
+        else {
+            switch (item.type) {
+                case CBOR_MAJOR_BYTES:
+                case CBOR_MAJOR_TEXT:
+                    if (item.val > SIZE_MAX) {
+                        return -EBADMSG;
+                    }
+                    res = _get(&cur, NULL, (size_t)item.val);
+                    if (res < 0) {
+                        return res;
+                    }
+                    continue;
+                case CBOR_MAJOR_ARRAY:
+                    items = item.val;
+                    break;
+                case CBOR_MAJOR_MAP:
+                    if (item.val >= (LEFT_INDEFINITE / 2)) {
+                        return -EBADMSG;
+                    }
+                    items = 2 * item.val;
+                    break;
+                case CBOR_MAJOR_TAG:
+                    items = 1;
+                    break;
+                default:
+                    continue;
+            }
+        }
+        if (items == 0) {
+            continue;
+        }
+        if (depth > CBOR_CHAIN_DEPTH_MAX) {
+            return -ENOTSUP;
+        }
+        left[depth++] = items;
+    }
+
+    reader->cur = cur;
+    return 0;
+}
+
+int cbor_reader_uint(cbor_reader_t *reader, uint64_t *val)
+{
+    cbor_item_t item;
+    int res = _head(&reader->cur, &item, ACCEPT_UINT);
+
+    if (res == 0) {
+        *val = item.val;
+    }
+    return res;
+}
+
+int cbor_reader_int(cbor_reader_t *reader, int64_t *val)
+{
+    cbor_item_t item;
+    int res = _head(&reader->cur, &item, ACCEPT_INT);
+
+    if (res == 0) {
+        *val = (item.type == CBOR_MAJOR_UINT) ? (int64_t)item.val
+                                              : (-1 - (int64_t)item.val);
+    }
+    return res;
+}
+
+int cbor_reader_string(cbor_reader_t *reader, void *buf, size_t *len)
+{
+    cbor_cursor_t cur = reader->cur;
+    cbor_item_t item;
+    int res = _head(&cur, &item, ACCEPT_STRING);
+
+    if (res < 0) {
+        return res;
+    }
+    if (item.val > *len) {
+        return -ENOBUFS;
+    }
+    res = _get(&cur, buf, (size_t)item.val);
+    if (res == 0) {
+        *len = (size_t)item.val;
+        reader->cur = cur;
+    }
+    return res;
+}
+
+int cbor_reader_bool(cbor_reader_t *reader, bool *val)
+{
+    cbor_item_t item;
+    int res = _head(&reader->cur, &item, ACCEPT_BOOL);
+
+    if (res == 0) {
+        *val = (item.info == INFO_TRUE);
+    }
+    return res;
+}
+
+#ifndef CBOR_NO_FLOAT
+static double _half(uint16_t half)
+{
+    int exp = (half >> 10) & 0x1f;
+    int mant = half & 0x3ff;
+    double val;
+
+    if (exp == 0) {
+        val = ldexp(mant, -24);
+    }
+    else if (exp != 31) {
+        val = ldexp(mant + 1024, exp - 25);
+    }
+    else {
+        val = (mant == 0) ? INFINITY : NAN;
+    }
+    return (half & 0x8000) ? -val : val;
+}
+
+int cbor_reader_double(cbor_reader_t *reader, double *val)
+{
+    cbor_item_t item;
+    int res = _head(&reader->cur, &item, ACCEPT_FLOAT);
+
+    if (res < 0) {
+        return res;
+    }
+    if (item.info == INFO_FLOAT16) {
+        *val = _half((uint16_t)item.val);
+    }
+    else if (item.info == INFO_FLOAT32) {
+        uint32_t bits = (uint32_t)item.val;
+        float f;
+
+        memcpy(&f, &bits, sizeof(f));
+        *val = f;
+    }
+    else {
+        memcpy(val, &item.val, sizeof(*val));
+    }
+    return 0;
+}
+#endif /* CBOR_NO_FLOAT */
+
+void cbor_writer_init(cbor_writer_t *writer, const struct iovec *vec,
+                      size_t count)
+{
+    _init(&writer->cur, vec, count);
+    writer->avail = 0;
+    writer->len = 0;
+    for (size_t i = 0; i < count; i++) {
+        writer->avail += vec[i].iov_len;
+    }
+}
+
+#ifdef MODULE_GNRC_PKT
+void cbor_writer_init_pkt(cbor_writer_t *writer, gnrc_pktsnip_t *pkt)
+{
+    _init_pkt(&writer->cur, pkt);
+    writer->avail = gnrc_pkt_len(pkt);
+    writer->len = 0;
+}
+#endif
+
+/* encodes a head with the given additional information into buf */
+static size_t _encode(uint8_t *buf, uint8_t type, uint8_t info, uint64_t val)
+{
+    size_t follow = (info < INFO_UINT8) ? 0 : (1U << (info - INFO_UINT8));
+
+    buf[0] = (type << 5) | info;
+    for (size_t i = follow; i > 0; i--) {
+        buf[i] = (uint8_t)val;
+        val >>= 8;
+    }
+    return follow + 1;
+}
+
+static uint8_t _info(uint64_t val)
+{
+    if (val < INFO_UINT8) {
+        return (uint8_t)val;
+    }
+    if (val <= UINT8_MAX) {
+        return INFO_UINT8;
+    }
+    if (val <= UINT16_MAX) {
+        return INFO_UINT8 + 1;
+    }
+    if (val <= UINT32_MAX) {
+        return INFO_UINT8 + 2;
+    }
+    return INFO_UINT64;
+}
+
+static int _write(cbor_writer_t *writer, const uint8_t *head, size_t head_len,
+                  const void *buf, size_t len)
+{
+    if ((writer->avail < head_len) || ((writer->avail - head_len) < len)) {
+        return -ENOBUFS;
+    }
+    if ((size_t)(writer->cur.end - writer->cur.pos) >= (head_len + len)) {
+        /* the item fits into the current buffer */
+        memcpy(writer->cur.pos, head, head_len);
+        if (len > 0) {
+            memcpy(writer->cur.pos + head_len, buf, len);
+        }
+        writer->cur.pos += head_len + len;
+    }
+    else {
+        _put(&writer->cur, head, head_len);
+        _put(&writer->cur, buf, len);
+    }
+    writer->avail -= head_len + len;
+    writer->len += head_len + len;
+    return 0;
+}
+
+int cbor_writer_head(cbor_writer_t *writer, uint8_t type, uint64_t val)
+{
+    uint8_t head[HEAD_SIZE_MAX];
+    size_t head_len;
+
+    if ((size_t)(writer->cur.end - writer->cur.pos) >= HEAD_SIZE_MAX) {
+        /* encode in place, the free space is at least that of the buffer */
+        head_len = _encode(writer->cur.pos, type, _info(val), val);
+        writer->cur.pos += head_len;
+        writer->avail -= head_len;
+        writer->len += head_len;
+        return 0;
+    }
+    head_len = _encode(head, type, _info(val), val);
+    return _write(writer, head, head_len, NULL, 0);
+}
+
+int cbor_writer_indefinite(cbor_writer_t *writer, uint8_t type)
+{
+    uint8_t head = (type << 5) | CBOR_INFO_INDEFINITE;
+
+    return _write(writer, &head, 1, NULL, 0);
+}
+
+int cbor_writer_break(cbor_writer_t *writer)
+{
+    return cbor_writer_indefinite(writer, CBOR_MAJOR_SIMPLE);
+}
+
+int cbor_writer_string(cbor_writer_t *writer, uint8_t type, const void *buf,
+                       size_t len)
+{
+    uint8_t head[HEAD_SIZE_MAX];
+    size_t head_len = _encode(head, type, _info(len), len);
+
+    return _write(writer, head, head_len, buf, len);
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_writer_float(cbor_writer_t *writer, float val)
+{
+    uint8_t head[HEAD_SIZE_MAX];
+    uint32_t bits;
+
+    memcpy(&bits, &val, sizeof(bits));
+    return _write(writer, head,
+                  _encode(head, CBOR_MAJOR_SIMPLE, INFO_FLOAT32, bits), NULL, 0);
+}
+
+int cbor_writer_double(cbor_writer_t *writer, double val)
+{
+    uint8_t head[HEAD_SIZE_MAX];
+    uint64_t bits;
+
+    memcpy(&bits, &val, sizeof(bits));
+    return _write(writer, head,
+                  _encode(head, CBOR_MAJOR_SIMPLE, INFO_FLOAT64, bits), NULL, 0);
+}
+#endif /* CBOR_NO_FLOAT */
@@ -20,21 +20,32 @@
 
 #include "checksum/fletcher16.h"
 
+/* Maximum number of bytes before the 32 bit sums may overflow, like
+ * NMAX in zlib's adler32 */
+#define BLOCK_MAX   (5802U)
+
 uint16_t fletcher16(const uint8_t *data, size_t bytes)
 {
-    uint16_t sum1 = 0xff, sum2 = 0xff;
+    uint32_t sum1 = 0xff, sum2 = 0xff;
 
     while (bytes) {
-        size_t tlen = bytes > 20 ? 20 : bytes;
+        size_t tlen = bytes > BLOCK_MAX ? BLOCK_MAX : bytes;
         bytes -= tlen;
-        do {
+        for (; tlen >= 4; tlen -= 4) {
+            sum2 += sum1 += data[0];
+            sum2 += sum1 += data[1];
+            sum2 += sum1 += data[2];
+            sum2 += sum1 += data[3];
+            data += 4;
+        }
+        while (tlen--) {
             sum2 += sum1 += *data++;
-        } while (--tlen);
-        sum1 = (sum1 & 0xff) + (sum1 >> 8);
-        sum2 = (sum2 & 0xff) + (sum2 >> 8);
+        }
+        sum1 %= 0xff;
+        sum2 %= 0xff;
     }
-    /* Second reduction step to reduce sums to 8 bits */
-    sum1 = (sum1 & 0xff) + (sum1 >> 8);
-    sum2 = (sum2 & 0xff) + (sum2 >> 8);
+    /* the sums are never 0, 0xff is used instead */
+    sum1 = sum1 ? sum1 : 0xff;
+    sum2 = sum2 ? sum2 : 0xff;
     return (sum2 << 8) | sum1;
 }
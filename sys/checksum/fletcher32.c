@@ -27,9 +27,16 @@ uint32_t fletcher32(const uint16_t *data, size_t words)
     while (words) {
         unsigned tlen = words > 359 ? 359 : words;
         words -= tlen;
-        do {
+        for (; tlen >= 4; tlen -= 4) {
+            sum2 += sum1 += data[0];
+            sum2 += sum1 += data[1];
+            sum2 += sum1 += data[2];
+            sum2 += sum1 += data[3];
+            data += 4;
+        }
+        while (tlen--) {
             sum2 += sum1 += *data++;
-        } while (--tlen);
+        }
         sum1 = (sum1 & 0xffff) + (sum1 >> 16);
         sum2 = (sum2 & 0xffff) + (sum2 >> 16);
     }
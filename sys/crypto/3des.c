@@ -52,7 +52,11 @@ static const cipher_interface_t tripledes_interface = {
     THREEDES_MAX_KEY_SIZE,
     tripledes_init,
     tripledes_encrypt,
-    tripledes_decrypt
+    tripledes_decrypt,
+    NULL,
+    NULL,
+    NULL,
+    NULL
 };
 const cipher_id_t CIPHER_3DES = &tripledes_interface;
 
@@ -45,10 +45,19 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks,
+    NULL,
+    NULL
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
+static int aes_set_encrypt_key(const unsigned char *userKey, const int bits,
+                               AES_KEY *key);
+static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
+                               AES_KEY *key);
+
 static const u32 Te0[256] = {
     0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
     0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
@@ -730,6 +739,33 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
         return 0;
     }
 
+#ifdef CRYPTO_AES_KEY_SCHEDULE
+    // expand the key only once instead of for every block
+    aes_key_schedule_t *schedule = (aes_key_schedule_t *)context->context;
+    uint8_t user_key[AES_KEY_SIZE];
+    AES_KEY aeskey;
+    int res;
+
+    if (CIPHER_MAX_CONTEXT_SIZE < sizeof(aes_key_schedule_t)) {
+        return 0;
+    }
+
+    for (i = 0; i < AES_KEY_SIZE; i++) {
+        user_key[i] = key[(i % keySize)];
+    }
+    if ((res = aes_set_encrypt_key(user_key, AES_KEY_SIZE * 8, &aeskey)) == 0) {
+        memcpy(schedule->enc, aeskey.rd_key, sizeof(schedule->enc));
+        if ((res = aes_set_decrypt_key(user_key, AES_KEY_SIZE * 8, &aeskey)) == 0) {
+            memcpy(schedule->dec, aeskey.rd_key, sizeof(schedule->dec));
+        }
+    }
+    // do not leave copies of the key on the stack
+    memset(&aeskey, 0, sizeof(aeskey));
+    memset(user_key, 0, sizeof(user_key));
+
+    return (res == 0) ? 1 : res;
+#else
+
     //key must be at least CIPHERS_MAX_KEY_SIZE Bytes long
     if (keySize < CIPHERS_MAX_KEY_SIZE) {
         //fill up by concatenating key to as long as needed
@@ -744,6 +780,7 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
     }
 
     return 1;
+#endif
 }
 
 /**
@@ -933,30 +970,17 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 
 #ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with the expanded key rk
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void aes_encrypt_block(const u32 *rk, int rounds, const uint8_t *plainBlock,
+                              uint8_t *cipherBlock)
 {
-    //setup AES_KEY
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                                   AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
-    const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
     int r;
 #endif /* ?FULL_UNROLL */
 
-    rk = key->rd_key;
-
     /*
      * map byte array block to cipher state
      * and add initial round key:
@@ -1048,7 +1072,7 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
     t3 = Te0[s3 >> 24] ^ Te1[(s0 >> 16) & 0xff] ^ Te2[(s1 >>  8) & 0xff] ^
          Te3[s2 & 0xff] ^ rk[39];
 
-    if (key->rounds > 10) {
+    if (rounds > 10) {
         /* round 10: */
         s0 = Te0[t0 >> 24] ^ Te1[(t1 >> 16) & 0xff] ^ Te2[(t2 >>  8) & 0xff] ^
              Te3[t3 & 0xff] ^ rk[40];
@@ -1068,7 +1092,7 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         t3 = Te0[s3 >> 24] ^ Te1[(s0 >> 16) & 0xff] ^ Te2[(s1 >>  8) & 0xff] ^
              Te3[s2 & 0xff] ^ rk[47];
 
-        if (key->rounds > 12) {
+        if (rounds > 12) {
             /* round 12: */
             s0 = Te0[t0 >> 24] ^ Te1[(t1 >> 16) & 0xff] ^ Te2[(t2 >>  8) &
                     0xff] ^ Te3[t3 & 0xff] ^ rk[48];
@@ -1090,12 +1114,12 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         }
     }
 
-    rk += key->rounds << 2;
+    rk += rounds << 2;
 #else  /* !FULL_UNROLL */
     /*
      * Nr - 1 full rounds:
      */
-    r = key->rounds >> 1;
+    r = rounds >> 1;
 
     while (1) {
         t0 =
@@ -1188,35 +1212,64 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4[(t2) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
 /*
- * Decrypt a single block
+ * Encrypt num consecutive blocks
  * in and out can overlap
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plainBlocks,
+                       uint8_t *cipherBlocks, size_t num)
 {
-    //setup AES_KEY
+    const u32 *rk;
+    int rounds;
+#ifdef CRYPTO_AES_KEY_SCHEDULE
+    rk = ((const aes_key_schedule_t *)context->context)->enc;
+    rounds = AES_ROUNDS;
+#else
+    /* expand the key only once for all blocks */
     int res;
     AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_decrypt_key((unsigned char *)context->context,
+    res = aes_set_encrypt_key((unsigned char *)context->context,
                               AES_KEY_SIZE * 8, &aeskey);
 
     if (res < 0) {
         return res;
     }
+    rk = aeskey.rd_key;
+    rounds = aeskey.rounds;
+#endif
+
+    for (; num > 0; num--) {
+        aes_encrypt_block(rk, rounds, plainBlocks, cipherBlocks);
+        plainBlocks += AES_BLOCK_SIZE;
+        cipherBlocks += AES_BLOCK_SIZE;
+    }
+    return 1;
+}
 
-    const u32 *rk;
+/*
+ * Encrypt a single block
+ * in and out can overlap
+ */
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+/*
+ * Decrypt a single block with the expanded key rk
+ * in and out can overlap
+ */
+static void aes_decrypt_block(const u32 *rk, int rounds, const uint8_t *cipherBlock,
+                              uint8_t *plainBlock)
+{
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
     int r;
 #endif /* ?FULL_UNROLL */
 
-    rk = key->rd_key;
-
     /*
      * map byte array block to cipher state
      * and add initial round key:
@@ -1308,7 +1361,7 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
     t3 = Td0[s3 >> 24] ^ Td1[(s2 >> 16) & 0xff] ^ Td2[(s1 >>  8) & 0xff] ^
          Td3[s0 & 0xff] ^ rk[39];
 
-    if (key->rounds > 10) {
+    if (rounds > 10) {
         /* round 10: */
         s0 = Td0[t0 >> 24] ^ Td1[(t3 >> 16) & 0xff] ^ Td2[(t2 >>  8) & 0xff] ^
              Td3[t1 & 0xff] ^ rk[40];
@@ -1328,7 +1381,7 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         t3 = Td0[s3 >> 24] ^ Td1[(s2 >> 16) & 0xff] ^ Td2[(s1 >>  8) & 0xff] ^
              Td3[s0 & 0xff] ^ rk[47];
 
-        if (key->rounds > 12) {
+        if (rounds > 12) {
             /* round 12: */
             s0 = Td0[t0 >> 24] ^ Td1[(t3 >> 16) & 0xff] ^ Td2[(t2 >>  8) & 0xff]
                  ^ Td3[t1 & 0xff] ^ rk[48];
@@ -1350,12 +1403,12 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         }
     }
 
-    rk += key->rounds << 2;
+    rk += rounds << 2;
 #else  /* !FULL_UNROLL */
     /*
      * Nr - 1 full rounds:
      */
-    r = key->rounds >> 1;
+    r = rounds >> 1;
 
     while (1) {
         t0 =
@@ -1448,7 +1501,50 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4[(t0) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+/*
+ * Decrypt num consecutive blocks
+ * in and out can overlap
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *cipherBlocks,
+                       uint8_t *plainBlocks, size_t num)
+{
+    const u32 *rk;
+    int rounds;
+#ifdef CRYPTO_AES_KEY_SCHEDULE
+    rk = ((const aes_key_schedule_t *)context->context)->dec;
+    rounds = AES_ROUNDS;
+#else
+    /* expand the key only once for all blocks */
+    int res;
+    AES_KEY aeskey;
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+    rk = aeskey.rd_key;
+    rounds = aeskey.rounds;
+#endif
+
+    for (; num > 0; num--) {
+        aes_decrypt_block(rk, rounds, cipherBlocks, plainBlocks);
+        cipherBlocks += AES_BLOCK_SIZE;
+        plainBlocks += AES_BLOCK_SIZE;
+    }
     return 1;
 }
 
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
 #endif /* AES_ASM */
@@ -28,6 +28,8 @@
  *  - It is implemented for little code and data size, but will likely be
  *    slower than the refenrence implementation. Optimized implementation will
  *    out-perform the code even more.
+ *  - On native with SSE2, chacha_keystream_blocks() computes four blocks in
+ *    parallel.
  */
 
 #include "crypto/chacha.h"
@@ -39,35 +41,117 @@
 
 #include <string.h>
 
-static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
+#ifdef CHACHA_SSE2
+#include <emmintrin.h>
+#endif
+
+#define ROTL(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d)                            \
+    do {                                                    \
+        a += b; d ^= a; d = ROTL(d, 16);                    \
+        c += d; b ^= c; b = ROTL(b, 12);                    \
+        a += b; d ^= a; d = ROTL(d, 8);                     \
+        c += d; b ^= c; b = ROTL(b, 7);                     \
+    } while (0)
+
+/* one block, the indices are constant so x is kept in registers */
+static void _block(uint32_t output[16], const uint32_t input[16], uint8_t rounds)
 {
-    *a += *b;
-    uint32_t tmp = *a ^ *d;
-    *d = (tmp << c) | (tmp >> (32 - c));
+    uint32_t x[16];
+
+    memcpy(x, input, 64);
+
+    for (unsigned i = 0; i < rounds; i += 2) {
+        QUARTERROUND(x[0], x[4], x[8], x[12]);
+        QUARTERROUND(x[1], x[5], x[9], x[13]);
+        QUARTERROUND(x[2], x[6], x[10], x[14]);
+        QUARTERROUND(x[3], x[7], x[11], x[15]);
+        QUARTERROUND(x[0], x[5], x[10], x[15]);
+        QUARTERROUND(x[1], x[6], x[11], x[12]);
+        QUARTERROUND(x[2], x[7], x[8], x[13]);
+        QUARTERROUND(x[3], x[4], x[9], x[14]);
+    }
+
+    for (unsigned i = 0; i < 16; ++i) {
+        output[i] = x[i] + input[i];
+    }
 }
 
-static void _doubleround(void *output_, const uint32_t input[16], uint8_t rounds)
+static void _increment(chacha_ctx *ctx)
 {
-    uint32_t *output = (uint32_t *) output_;
-    memcpy(output, input, 64);
+    ++ctx->state[12];
+    if (ctx->state[12] == 0) {
+        ++ctx->state[13];
+    }
+}
+
+#ifdef CHACHA_SSE2
+#define ROTL_V(x, n)    _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
 
-    rounds *= 4;
-    for (unsigned i = 0; i < rounds; ++i) {
-        uint32_t *a = &output[((i + ((i & 4) ? 0 : 0)) & 3) + (4 * 0)];
-        uint32_t *b = &output[((i + ((i & 4) ? 1 : 0)) & 3) + (4 * 1)];
-        uint32_t *c = &output[((i + ((i & 4) ? 2 : 0)) & 3) + (4 * 2)];
-        uint32_t *d = &output[((i + ((i & 4) ? 3 : 0)) & 3) + (4 * 3)];
+#define QUARTERROUND_V(a, b, c, d)                                      \
+    do {                                                                \
+        a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTL_V(d, 16); \
+        c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTL_V(b, 12); \
+        a = _mm_add_epi32(a, b); d = _mm_xor_si128(d, a); d = ROTL_V(d, 8);  \
+        c = _mm_add_epi32(c, d); b = _mm_xor_si128(b, c); b = ROTL_V(b, 7);  \
+    } while (0)
 
-        _r(d, a, b, 16);
-        _r(b, c, d, 12);
-        _r(d, a, b,  8);
-        _r(b, c, d,  7);
+/* Stores word i to i + 3 of the four blocks, v[i] holds word i of all
+ * blocks */
+static void _store4(uint8_t *out, const __m128i *v, unsigned i)
+{
+    __m128i t0 = _mm_unpacklo_epi32(v[i], v[i + 1]);
+    __m128i t1 = _mm_unpacklo_epi32(v[i + 2], v[i + 3]);
+    __m128i t2 = _mm_unpackhi_epi32(v[i], v[i + 1]);
+    __m128i t3 = _mm_unpackhi_epi32(v[i + 2], v[i + 3]);
+
+    out += 4 * i;
+    _mm_storeu_si128((__m128i *)(out + 0 * 64), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(out + 1 * 64), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(out + 2 * 64), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i *)(out + 3 * 64), _mm_unpackhi_epi64(t2, t3));
+}
+
+/* four consecutive blocks, one in each 32 bit lane */
+static void _blocks4(chacha_ctx *ctx, uint8_t *output)
+{
+    __m128i in[16], x[16];
+    uint32_t counter[2][4];
+
+    for (unsigned i = 0; i < 4; i++) {
+        counter[0][i] = ctx->state[12];
+        counter[1][i] = ctx->state[13];
+        _increment(ctx);
     }
 
-    for (unsigned i = 0; i < 16; ++i) {
-        output[i] += input[i];
+    for (unsigned i = 0; i < 16; i++) {
+        in[i] = _mm_set1_epi32(ctx->state[i]);
+    }
+    in[12] = _mm_loadu_si128((const __m128i *)counter[0]);
+    in[13] = _mm_loadu_si128((const __m128i *)counter[1]);
+    memcpy(x, in, sizeof(x));
+
+    for (unsigned i = 0; i < ctx->rounds; i += 2) {
+        QUARTERROUND_V(x[0], x[4], x[8], x[12]);
+        QUARTERROUND_V(x[1], x[5], x[9], x[13]);
+        QUARTERROUND_V(x[2], x[6], x[10], x[14]);
+        QUARTERROUND_V(x[3], x[7], x[11], x[15]);
+        QUARTERROUND_V(x[0], x[5], x[10], x[15]);
+        QUARTERROUND_V(x[1], x[6], x[11], x[12]);
+        QUARTERROUND_V(x[2], x[7], x[8], x[13]);
+        QUARTERROUND_V(x[3], x[4], x[9], x[14]);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+        x[i] = _mm_add_epi32(x[i], in[i]);
+    }
+
+    for (unsigned i = 0; i < 16; i += 4) {
+        _store4(output, x, i);
     }
 }
+#endif /* CHACHA_SSE2 */
 
 int chacha_init(chacha_ctx *ctx,
                 unsigned rounds,
@@ -102,11 +186,27 @@ int chacha_init(chacha_ctx *ctx,
 
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
 {
-    _doubleround(x, ctx->state, ctx->rounds);
+    uint32_t block[16];
 
-    ++ctx->state[12];
-    if (ctx->state[12] == 0) {
-        ++ctx->state[13];
+    _block(block, ctx->state, ctx->rounds);
+    memcpy(x, block, 64);
+    _increment(ctx);
+}
+
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t num)
+{
+    uint8_t *out = x;
+
+#ifdef CHACHA_SSE2
+    for (; num >= 4; num -= 4) {
+        _blocks4(ctx, out);
+        out += 4 * 64;
+    }
+#endif
+
+    while (num--) {
+        chacha_keystream_bytes(ctx, out);
+        out += 64;
     }
 }
 
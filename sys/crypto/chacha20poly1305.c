@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 AEAD implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/helper.h"
+#include "crypto/poly1305.h"
+
+static const uint8_t _zeros[16];
+
+/* sets up ChaCha20 with the nonce of RFC 7539 and derives the Poly1305 key
+ * from the first block, the data is encrypted from the second block on */
+static void _init(chacha_ctx *chacha, poly1305_ctx_t *poly,
+                  const uint8_t *key, const uint8_t *nonce)
+{
+    uint32_t block[16];
+
+    chacha_init(chacha, 20, key, CHACHA20POLY1305_KEY_SIZE, _zeros);
+    memcpy(&chacha->state[13], nonce, CHACHA20POLY1305_NONCE_SIZE);
+
+    chacha_keystream_bytes(chacha, block);
+    poly1305_init(poly, (const uint8_t *)block);
+    memset(block, 0, sizeof(block));
+}
+
+static void _crypt(chacha_ctx *chacha, uint8_t *out, const uint8_t *in,
+                   size_t len)
+{
+    uint32_t stream[16 * CHACHA_BATCH_BLOCKS];
+
+    while (len) {
+        size_t n = (len < sizeof(stream)) ? len : sizeof(stream);
+
+        chacha_keystream_blocks(chacha, stream, (n + 63) / 64);
+        crypto_block_xor(out, in, (const uint8_t *)stream, n);
+        in += n;
+        out += n;
+        len -= n;
+    }
+    memset(stream, 0, sizeof(stream));
+}
+
+static void _pad16(poly1305_ctx_t *poly, size_t len)
+{
+    if (len & 15) {
+        poly1305_update(poly, _zeros, 16 - (len & 15));
+    }
+}
+
+static void _tag(poly1305_ctx_t *poly, const uint8_t *aad, size_t aad_len,
+                 const uint8_t *cipher, size_t cipher_len, uint8_t *tag)
+{
+    uint8_t lens[16];
+    uint64_t l[2] = { aad_len, cipher_len };
+
+    poly1305_update(poly, aad, aad_len);
+    _pad16(poly, aad_len);
+    poly1305_update(poly, cipher, cipher_len);
+    _pad16(poly, cipher_len);
+
+    /* both lengths as 64 bit little-endian */
+    for (unsigned i = 0; i < 16; i++) {
+        lens[i] = (uint8_t)(l[i / 8] >> (8 * (i % 8)));
+    }
+    poly1305_update(poly, lens, sizeof(lens));
+    poly1305_finish(poly, tag);
+}
+
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msg_len, const uint8_t *aad,
+                              size_t aad_len, const uint8_t *key,
+                              const uint8_t *nonce)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+
+    _init(&chacha, &poly, key, nonce);
+    _crypt(&chacha, cipher, msg, msg_len);
+    _tag(&poly, aad, aad_len, cipher, msg_len, cipher + msg_len);
+    memset(&chacha, 0, sizeof(chacha));
+}
+
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipher_len,
+                             uint8_t *msg, size_t *msg_len,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *key, const uint8_t *nonce)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+    uint8_t tag[CHACHA20POLY1305_TAG_SIZE];
+    int res = 0;
+
+    if (cipher_len < CHACHA20POLY1305_TAG_SIZE) {
+        return 0;
+    }
+    *msg_len = cipher_len - CHACHA20POLY1305_TAG_SIZE;
+
+    _init(&chacha, &poly, key, nonce);
+    _tag(&poly, aad, aad_len, cipher, *msg_len, tag);
+    if (crypto_equals(tag, (uint8_t *)cipher + *msg_len, sizeof(tag))) {
+        _crypt(&chacha, msg, cipher, *msg_len);
+        res = 1;
+    }
+    memset(&chacha, 0, sizeof(chacha));
+    return res;
+}
@@ -54,8 +54,10 @@ uint32_t chacha_prng_next(void)
     mutex_lock(&_chacha_prng_mutex);
 
     if (--_chacha_prng_pos < 0) {
-        _chacha_prng_pos = 15;
-        chacha_keystream_bytes(&_chacha_prng_ctx, _chacha_prng_data);
+        /* the buffer holds four blocks of the keystream */
+        _chacha_prng_pos = (sizeof(_chacha_prng_data) / sizeof(uint32_t)) - 1;
+        chacha_keystream_blocks(&_chacha_prng_ctx, _chacha_prng_data,
+                                sizeof(_chacha_prng_data) / 64);
     }
     uint32_t result = _chacha_prng_data[_chacha_prng_pos];
 
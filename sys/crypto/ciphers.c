@@ -19,6 +19,31 @@
 #include "crypto/ciphers.h"
 
 
+/* registered hardware backends, the most recently registered one first */
+static cipher_hw_t* _hw_backends;
+
+
+void cipher_hw_register(cipher_hw_t* hw)
+{
+    hw->next = _hw_backends;
+    _hw_backends = hw;
+}
+
+
+void cipher_hw_unregister(cipher_hw_t* hw)
+{
+    cipher_hw_t** prev = &_hw_backends;
+
+    while (*prev != NULL) {
+        if (*prev == hw) {
+            *prev = hw->next;
+            return;
+        }
+        prev = &(*prev)->next;
+    }
+}
+
+
 int cipher_init(cipher_t* cipher, cipher_id_t cipher_id, const uint8_t* key,
                 uint8_t key_size)
 {
@@ -26,6 +51,14 @@ int cipher_init(cipher_t* cipher, cipher_id_t cipher_id, const uint8_t* key,
         return CIPHER_ERR_INVALID_KEY_SIZE;
     }
 
+    for (cipher_hw_t* hw = _hw_backends; hw != NULL; hw = hw->next) {
+        if ((hw->cipher == cipher_id) && (key_size <= hw->interface->max_key_size) &&
+            (hw->interface->init(&cipher->context, key, key_size) == 1)) {
+            cipher->interface = hw->interface;
+            return 1;
+        }
+    }
+
     cipher->interface = cipher_id;
     return cipher->interface->init(&cipher->context, key, key_size);
 
@@ -44,6 +77,78 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t num)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->encrypt_blocks != NULL) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, num);
+    }
+
+    for (; num > 0; num--) {
+        int res = cipher->interface->encrypt(&cipher->context, input, output);
+        if (res != 1) {
+            return res;
+        }
+        input += block_size;
+        output += block_size;
+    }
+    return 1;
+}
+
+
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t num)
+{
+    uint8_t block_size = cipher->interface->block_size;
+
+    if (cipher->interface->decrypt_blocks != NULL) {
+        return cipher->interface->decrypt_blocks(&cipher->context, input,
+                                                 output, num);
+    }
+
+    for (; num > 0; num--) {
+        int res = cipher->interface->decrypt(&cipher->context, input, output);
+        if (res != 1) {
+            return res;
+        }
+        input += block_size;
+        output += block_size;
+    }
+    return 1;
+}
+
+
+int cipher_encrypt_blocks_async(const cipher_t* cipher, const uint8_t* input,
+                                uint8_t* output, size_t num, cipher_cb_t cb,
+                                void* arg)
+{
+    if (cipher->interface->encrypt_blocks_async != NULL) {
+        return cipher->interface->encrypt_blocks_async(&cipher->context, input,
+                                                       output, num, cb, arg);
+    }
+
+    cb(arg, cipher_encrypt_blocks(cipher, input, output, num));
+    return 0;
+}
+
+
+int cipher_decrypt_blocks_async(const cipher_t* cipher, const uint8_t* input,
+                                uint8_t* output, size_t num, cipher_cb_t cb,
+                                void* arg)
+{
+    if (cipher->interface->decrypt_blocks_async != NULL) {
+        return cipher->interface->decrypt_blocks_async(&cipher->context, input,
+                                                       output, num, cb, arg);
+    }
+
+    cb(arg, cipher_decrypt_blocks(cipher, input, output, num));
+    return 0;
+}
+
+
 int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
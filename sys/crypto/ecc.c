@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Public keys for repeated ECDSA verifications
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/ecc.h"
+
+int ecc_pubkey_init(ecc_pubkey_t *key, const ecc_backend_t *backend,
+                    ecc_curve_t curve, const uint8_t *pub)
+{
+    key->backend = backend;
+    key->curve = curve;
+    key->pre = NULL;
+    memcpy(key->pub, pub, 2 * ecc_curve_size(curve));
+    if (backend->precompute == NULL) {
+        return 0;
+    }
+    return backend->precompute(key);
+}
+
+int ecc_pubkey_verify(const ecc_pubkey_t *key, const uint8_t *hash,
+                      size_t hash_len, const uint8_t *sig)
+{
+    if (key->pre != NULL) {
+        return key->backend->verify_pre(key, hash, hash_len, sig);
+    }
+    return key->backend->verify(key->curve, key->pub, hash, hash_len, sig);
+}
+
+void ecc_pubkey_release(ecc_pubkey_t *key)
+{
+    if (key->pre != NULL) {
+        key->backend->release(key);
+        key->pre = NULL;
+    }
+}
@@ -20,6 +20,7 @@
 
 
 #include <string.h>
+#include "crypto/helper.h"
 #include "crypto/modes/cbc.h"
 
 int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
@@ -37,10 +38,8 @@ int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
     output_block_last = iv;
     do {
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        memcpy(input_block, input + offset, block_size);
-        for (int i = 0; i < block_size; ++i) {
-            input_block[i] ^= output_block_last[i];
-        }
+        crypto_block_xor(input_block, input + offset, output_block_last,
+                         block_size);
 
         if (cipher_encrypt(cipher, input_block, output + offset) != 1) {
             return CIPHER_ERR_ENC_FAILED;
@@ -76,9 +75,8 @@ int cipher_decrypt_cbc(cipher_t* cipher, uint8_t iv[16],
         }
 
         /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (uint8_t i = 0; i < block_size; ++i) {
-            output_block[i] ^= input_block_last[i];
-        }
+        crypto_block_xor(output_block, output_block, input_block_last,
+                         block_size);
 
         input_block_last = input_block;
         offset += block_size;
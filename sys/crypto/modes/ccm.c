@@ -18,10 +18,10 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
-#include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
 
 static inline int min(int a, int b)
@@ -37,7 +37,8 @@ static inline int min(int a, int b)
 int ccm_compute_cbc_mac(cipher_t* cipher, uint8_t iv[16],
                         uint8_t* input, size_t length, uint8_t* mac)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
+    size_t offset;
+    uint8_t block_size, mac_enc[16] = {0};
 
     block_size = cipher_get_block_size(cipher);
     memmove(mac, iv, 16);
@@ -83,7 +84,7 @@ int ccm_create_mac_iv(cipher_t* cipher, uint8_t auth_data_len, uint8_t M,
     memcpy(&X1[1], nonce, min(nonce_len, 15 - L));
 
     /* write plaintext_len to B[15..16-L] */
-    for (uint8_t i = 15; i > 16 - L; --i) {
+    for (uint8_t i = 15; i > 15 - L; --i) {
         X1[i] = plaintext_len & 0xff;
         plaintext_len >>= 8;
     }
@@ -129,6 +130,79 @@ int ccm_compute_adata_mac(cipher_t* cipher, uint8_t* auth_data,
 }
 
 
+/*
+ * Encrypts or decrypts the message in counter mode and computes the CBC-MAC
+ * of the plaintext in a single pass. The key stream block of the next message
+ * block does not depend on the CBC-MAC, so both are encrypted together.
+ *
+ * nonce_counter holds the first counter block (A0), its key stream block S0
+ * for the authentication value is written to tag_stream.
+ */
+static int _ccm_crypt(cipher_t* cipher, uint8_t nonce_counter[16],
+                      uint8_t nonce_len, uint8_t mac[16], uint8_t* input,
+                      size_t length, uint8_t* output, uint8_t tag_stream[16],
+                      bool decrypt)
+{
+    /* the counter block and the CBC-MAC block */
+    uint8_t blocks[2 * 16] __attribute__((aligned(4)));
+    /* the key stream block and the encrypted CBC-MAC block */
+    uint8_t blocks_enc[2 * 16] __attribute__((aligned(4)));
+    uint8_t block_size, *mac_block, *mac_enc;
+    size_t offset = 0;
+
+    block_size = cipher_get_block_size(cipher);
+    mac_block = &blocks[block_size];
+    mac_enc = &blocks_enc[block_size];
+
+    /* S0 and the key stream block of the first message block */
+    memcpy(blocks, nonce_counter, block_size);
+    memcpy(mac_block, nonce_counter, block_size);
+    crypto_block_inc_ctr(mac_block, block_size - nonce_len);
+    if (cipher_encrypt_blocks(cipher, blocks, blocks_enc, 2) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+    memcpy(tag_stream, blocks_enc, block_size);
+    memcpy(blocks_enc, mac_enc, block_size);
+    memcpy(blocks, mac_block, block_size);
+    memcpy(mac_enc, mac, block_size);
+
+    do {
+        uint8_t block_size_input = (length - offset > block_size) ?
+                                   block_size : length - offset;
+        uint8_t *plain = (decrypt) ? &output[offset] : &input[offset];
+
+        if (decrypt) {
+            crypto_block_xor(&output[offset], &input[offset], blocks_enc,
+                             block_size_input);
+        }
+        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block,
+         * the plaintext has to be read before it is overwritten in place */
+        if (block_size_input < block_size) {
+            memcpy(mac_block, mac_enc, block_size);
+        }
+        crypto_block_xor(mac_block, mac_enc, plain, block_size_input);
+        if (!decrypt) {
+            crypto_block_xor(&output[offset], &input[offset], blocks_enc,
+                             block_size_input);
+        }
+        offset += block_size_input;
+
+        if (offset < length) {
+            crypto_block_inc_ctr(blocks, block_size - nonce_len);
+            if (cipher_encrypt_blocks(cipher, blocks, blocks_enc, 2) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+        }
+        else if (cipher_encrypt(cipher, mac_block, mac_enc) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+    } while (offset < length);
+
+    memcpy(mac, mac_enc, block_size);
+    return offset;
+}
+
+
 int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_len,
                        uint8_t mac_length, uint8_t length_encoding,
                        uint8_t* nonce, size_t nonce_len,
@@ -137,8 +211,7 @@ int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_
 {
     int len = -1;
     uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
+    uint8_t nonce_counter[16] = {0}, mac[16] = {0}, stream_block[16] = {0};
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -151,33 +224,20 @@ int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_
     }
 
     /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
     if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
+                          nonce, nonce_len, input_len, mac) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
-    if (len < 0) {
-        return len;
-    }
+    /* MAC calulation (T) with additional data */
+    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac);
 
-    /* Compute first stream block */
+    /* Encrypt message in counter mode and compute the MAC of the plaintext */
     nonce_counter[0] = length_encoding - 1;
     memcpy(&nonce_counter[1], nonce,
            min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    len = _ccm_crypt(cipher, nonce_counter, nonce_len, mac, input, input_len,
+                     output, stream_block, false);
     if (len < 0) {
         return len;
     }
@@ -198,9 +258,9 @@ int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
 {
     int len = -1;
     uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    uint8_t nonce_counter[16] = {0}, mac[16] = {0}, mac_recv[16] = {0},
+            stream_block[16] = {0};
+    size_t plain_len;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -212,34 +272,25 @@ int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
-
-    /* Decrypt message in counter mode */
     plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
-    }
 
     /* Create B0, encrypt it (X1) and use it as mac_iv */
     if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
+                          nonce, nonce_len, plain_len, mac) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
+    /* MAC calulation (T) with additional data */
+    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac);
+
+    /* Decrypt message in counter mode and compute the MAC of the plaintext */
+    nonce_counter[0] = length_encoding - 1;
+    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
+    len = _ccm_crypt(cipher, nonce_counter, nonce_len, mac, input, plain_len,
+                     plain, stream_block, true);
     if (len < 0) {
         return len;
     }
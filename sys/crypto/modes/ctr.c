@@ -18,6 +18,8 @@
 * @}
 */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
@@ -26,24 +28,32 @@ int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
                        uint8_t* output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = {0}, block_size;
+    uint8_t ctr_blocks[CTR_BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE] __attribute__((aligned(4)));
+    uint8_t stream_blocks[CTR_BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE] __attribute__((aligned(4)));
+    uint8_t block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t batch_len = length - offset, num = 0;
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
+        if (batch_len > (CTR_BATCH_BLOCKS * block_size)) {
+            batch_len = CTR_BATCH_BLOCKS * block_size;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        /* counter blocks of the batch, at least one like for empty input */
+        do {
+            memcpy(&ctr_blocks[num * block_size], nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+            num++;
+        } while ((num * block_size) < batch_len);
+
+        if (cipher_encrypt_blocks(cipher, ctr_blocks, stream_blocks, num) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        crypto_block_xor(output + offset, input + offset, stream_blocks,
+                         batch_len);
+        offset += batch_len;
     } while (offset < length);
 
     return offset;
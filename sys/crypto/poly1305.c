@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 implementation with 26 bit limbs
+ *
+ * The products of the limbs fit into 64 bit, so 32 bit CPUs only need
+ * 32x32->64 bit multiplications.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/poly1305.h"
+
+#define MASK26      (0x3ffffff)
+
+static uint32_t _le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void _put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* hibit is 1 << 24 for full blocks, the padding of the last partial block
+ * is already in the data */
+static void _blocks(poly1305_ctx_t *ctx, const uint8_t *data, size_t num,
+                    uint32_t hibit)
+{
+    const uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2];
+    const uint32_t r3 = ctx->r[3], r4 = ctx->r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2];
+    uint32_t h3 = ctx->h[3], h4 = ctx->h[4];
+
+    while (num--) {
+        uint64_t d0, d1, d2, d3, d4;
+        uint32_t c;
+
+        /* h += m */
+        h0 += _le32(data) & MASK26;
+        h1 += (_le32(data + 3) >> 2) & MASK26;
+        h2 += (_le32(data + 6) >> 4) & MASK26;
+        h3 += (_le32(data + 9) >> 6) & MASK26;
+        h4 += (_le32(data + 12) >> 8) | hibit;
+
+        /* h *= r, the limbs above 2^130 wrap around multiplied by 5 */
+        d0 = ((uint64_t)h0 * r0) + ((uint64_t)h1 * s4) + ((uint64_t)h2 * s3) +
+             ((uint64_t)h3 * s2) + ((uint64_t)h4 * s1);
+        d1 = ((uint64_t)h0 * r1) + ((uint64_t)h1 * r0) + ((uint64_t)h2 * s4) +
+             ((uint64_t)h3 * s3) + ((uint64_t)h4 * s2);
+        d2 = ((uint64_t)h0 * r2) + ((uint64_t)h1 * r1) + ((uint64_t)h2 * r0) +
+             ((uint64_t)h3 * s4) + ((uint64_t)h4 * s3);
+        d3 = ((uint64_t)h0 * r3) + ((uint64_t)h1 * r2) + ((uint64_t)h2 * r1) +
+             ((uint64_t)h3 * r0) + ((uint64_t)h4 * s4);
+        d4 = ((uint64_t)h0 * r4) + ((uint64_t)h1 * r3) + ((uint64_t)h2 * r2) +
+             ((uint64_t)h3 * r1) + ((uint64_t)h4 * r0);
+
+        /* partial reduction mod 2^130 - 5 */
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & MASK26;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & MASK26;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & MASK26;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & MASK26;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & MASK26;
+        h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+        h1 += c;
+
+        data += 16;
+    }
+
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+    ctx->h[3] = h3;
+    ctx->h[4] = h4;
+}
+
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
+{
+    /* r is clamped as the algorithm requires */
+    ctx->r[0] = _le32(key) & 0x3ffffff;
+    ctx->r[1] = (_le32(key + 3) >> 2) & 0x3ffff03;
+    ctx->r[2] = (_le32(key + 6) >> 4) & 0x3ffc0ff;
+    ctx->r[3] = (_le32(key + 9) >> 6) & 0x3f03fff;
+    ctx->r[4] = (_le32(key + 12) >> 8) & 0x00fffff;
+
+    memset(ctx->h, 0, sizeof(ctx->h));
+
+    for (unsigned i = 0; i < 4; i++) {
+        ctx->pad[i] = _le32(key + 16 + (4 * i));
+    }
+
+    ctx->buf_len = 0;
+}
+
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    if (ctx->buf_len) {
+        size_t n = 16 - ctx->buf_len;
+
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&ctx->buf[ctx->buf_len], data, n);
+        ctx->buf_len += n;
+        data += n;
+        len -= n;
+        if (ctx->buf_len < 16) {
+            return;
+        }
+        _blocks(ctx, ctx->buf, 1, 1UL << 24);
+        ctx->buf_len = 0;
+    }
+
+    if (len >= 16) {
+        _blocks(ctx, data, len / 16, 1UL << 24);
+        data += len & ~(size_t)15;
+        len &= 15;
+    }
+
+    memcpy(ctx->buf, data, len);
+    ctx->buf_len = len;
+}
+
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *tag)
+{
+    uint32_t h0, h1, h2, h3, h4, c;
+    uint32_t g0, g1, g2, g3, g4, mask;
+    uint64_t f;
+
+    /* the last partial block is padded with a one byte and zeros */
+    if (ctx->buf_len) {
+        ctx->buf[ctx->buf_len] = 1;
+        memset(&ctx->buf[ctx->buf_len + 1], 0, 15 - ctx->buf_len);
+        _blocks(ctx, ctx->buf, 1, 0);
+    }
+
+    h0 = ctx->h[0];
+    h1 = ctx->h[1];
+    h2 = ctx->h[2];
+    h3 = ctx->h[3];
+    h4 = ctx->h[4];
+
+    /* full carry */
+    c = h1 >> 26; h1 &= MASK26;
+    h2 += c; c = h2 >> 26; h2 &= MASK26;
+    h3 += c; c = h3 >> 26; h3 &= MASK26;
+    h4 += c; c = h4 >> 26; h4 &= MASK26;
+    h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+    h1 += c;
+
+    /* g = h + 5 - 2^130, h is replaced by g if it is not negative, in
+     * constant time */
+    g0 = h0 + 5; c = g0 >> 26; g0 &= MASK26;
+    g1 = h1 + c; c = g1 >> 26; g1 &= MASK26;
+    g2 = h2 + c; c = g2 >> 26; g2 &= MASK26;
+    g3 = h3 + c; c = g3 >> 26; g3 &= MASK26;
+    g4 = h4 + c - (1UL << 26);
+
+    mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+
+    /* h = (h + s) mod 2^128 */
+    h0 = h0 | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+
+    f = (uint64_t)h0 + ctx->pad[0];
+    _put_le32(tag, (uint32_t)f);
+    f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+    _put_le32(tag + 4, (uint32_t)f);
+    f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+    _put_le32(tag + 8, (uint32_t)f);
+    f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+    _put_le32(tag + 12, (uint32_t)f);
+
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void poly1305_auth(uint8_t *tag, const uint8_t *data, size_t len,
+                   const uint8_t *key)
+{
+    poly1305_ctx_t ctx;
+
+    poly1305_init(&ctx, key);
+    poly1305_update(&ctx, data, len);
+    poly1305_finish(&ctx, tag);
+}
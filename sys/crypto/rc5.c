@@ -41,7 +41,11 @@ static const cipher_interface_t rc5_interface = {
     CIPHERS_MAX_KEY_SIZE,
     rc5_init,
     rc5_encrypt,
-    rc5_decrypt
+    rc5_decrypt,
+    NULL,
+    NULL,
+    NULL,
+    NULL
 };
 const cipher_id_t CIPHER_RC5 = &rc5_interface;
 
@@ -21,34 +21,70 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>  /* for fwrite() */
 #include <unistd.h>
 #include <string.h>
 
-#ifdef __WITH_AVRLIBC__
-#include <stdio.h>  /* for fwrite() */
-#else
+#ifndef __WITH_AVRLIBC__
 /* work around broken sys/posix/unistd.h */
 ssize_t write(int fildes, const void *buf, size_t nbyte);
 #endif
 
 #include "fmt.h"
 
+/* flags of a conversion of fmt_printf() */
+#define FLAG_LEFT       (0x01)
+#define FLAG_ZERO       (0x02)
+#define FLAG_PLUS       (0x04)
+#define FLAG_SPACE      (0x08)
+#define FLAG_ALT        (0x10)
+
 static const char _hex_chars[16] = "0123456789ABCDEF";
+static const char _hex_chars_lower[16] = "0123456789abcdef";
+
+/* "00" to "99", decimals are converted two digits at a time */
+static const char _dec_pairs[200] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+static const uint32_t _pow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000
+};
 
 static inline int _is_digit(char c)
 {
     return (c >= '0' && c <= '9');
 }
 
-static inline unsigned pwr(unsigned val, unsigned exp)
+/* val / 100 for all uint32 values, without a division */
+static inline uint32_t _div100(uint32_t val)
 {
-    unsigned res = 1;
+    return (uint32_t)(((uint64_t)val * 0x51EB851FU) >> 37);
+}
 
-    for (unsigned i = 0; i < exp; i++) {
-        res *= val;
-    }
+/* val / 10000 for all uint32 values, without a division */
+static inline uint32_t _div10000(uint32_t val)
+{
+    return (uint32_t)(((uint64_t)val * 0xD1B71759U) >> 45);
+}
 
-    return res;
+static inline void _put_pair(char *out, unsigned val)
+{
+    out[0] = _dec_pairs[2 * val];
+    out[1] = _dec_pairs[(2 * val) + 1];
+}
+
+/* writes val < 10000 as exactly four digits */
+static void _fmt_4dec(char *out, uint32_t val)
+{
+    /* val / 100, exact for val < 43699 and cheap without 64 bit multiply */
+    uint32_t hi = (val * 5243) >> 19;
+
+    _put_pair(out, hi);
+    _put_pair(&out[2], val - (hi * 100));
 }
 
 size_t fmt_byte_hex(char *out, uint8_t byte)
@@ -109,26 +145,30 @@ size_t fmt_u64_dec(char *out, uint64_t val)
     uint32_t q;
     size_t len = 0;
 
+    if (!(val >> 32)) {
+        return fmt_u32_dec(out, val);
+    }
+
     d[0] = val       & 0xFFFF;
     d[1] = (val>>16) & 0xFFFF;
     d[2] = (val>>32) & 0xFFFF;
     d[3] = (val>>48) & 0xFFFF;
 
     d[0] = 656 * d[3] + 7296 * d[2] + 5536 * d[1] + d[0];
-    q = d[0] / 10000;
-    d[0] = d[0] % 10000;
+    q = _div10000(d[0]);
+    d[0] = d[0] - (q * 10000);
 
     d[1] = q + 7671 * d[3] + 9496 * d[2] + 6 * d[1];
-    q = d[1] / 10000;
-    d[1] = d[1] % 10000;
+    q = _div10000(d[1]);
+    d[1] = d[1] - (q * 10000);
 
     d[2] = q + 4749 * d[3] + 42 * d[2];
-    q = d[2] / 10000;
-    d[2] = d[2] % 10000;
+    q = _div10000(d[2]);
+    d[2] = d[2] - (q * 10000);
 
     d[3] = q + 281 * d[3];
-    q = d[3] / 10000;
-    d[3] = d[3] % 10000;
+    q = _div10000(d[3]);
+    d[3] = d[3] - (q * 10000);
 
     d[4] = q;
 
@@ -143,13 +183,9 @@ size_t fmt_u64_dec(char *out, uint64_t val)
 
     if (out) {
         out += len;
-        memset(out, '0', total_len - len);
         while(first) {
             first--;
-            if (d[first]) {
-                size_t tmp = fmt_u32_dec(NULL, d[first]);
-                fmt_u32_dec(out+(4-tmp), d[first]);
-            }
+            _fmt_4dec(out, d[first]);
             out += 4;
         }
     }
@@ -162,15 +198,24 @@ size_t fmt_u32_dec(char *out, uint32_t val)
     size_t len = 1;
 
     /* count needed characters */
-    for (uint32_t tmp = val; (tmp > 9); len++) {
-        tmp /= 10;
+    while ((len < 10) && (val >= _pow10[len])) {
+        len++;
     }
 
     if (out) {
         char *ptr = out + len;
-        do {
-            *--ptr = (val % 10) + '0';
-        } while ((val /= 10));
+        while (val >= 100) {
+            uint32_t q = _div100(val);
+            ptr -= 2;
+            _put_pair(ptr, val - (q * 100));
+            val = q;
+        }
+        if (val >= 10) {
+            _put_pair(out, val);
+        }
+        else {
+            *out = val + '0';
+        }
     }
 
     return len;
@@ -184,13 +229,14 @@ size_t fmt_u16_dec(char *out, uint16_t val)
 size_t fmt_s32_dec(char *out, int32_t val)
 {
     int negative = (val < 0);
+    uint32_t absolute = val;
     if (negative) {
         if (out) {
             *out++ = '-';
         }
-        val *= -1;
+        absolute = -absolute;
     }
-    return fmt_u32_dec(out, val) + negative;
+    return fmt_u32_dec(out, absolute) + negative;
 }
 
 size_t fmt_s16_dec(char *out, int16_t val)
@@ -198,46 +244,190 @@ size_t fmt_s16_dec(char *out, int16_t val)
     return fmt_s32_dec(out, val);
 }
 
-size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits)
+/* writes the len digits of an integer scaled by 10^fp_digits with a decimal
+ * point and a leading zero where needed */
+static size_t _fmt_point(char *out, const char *digits, size_t len,
+                         unsigned fp_digits)
 {
-    int16_t absolute, divider;
-    size_t pos = 0;
-    size_t div_len, len;
-    unsigned e;
-    char tmp[4];
+    size_t int_len = (len > fp_digits) ? (len - fp_digits) : 0;
+
+    if (!fp_digits) {
+        if (out) {
+            memcpy(out, digits, len);
+        }
+        return len;
+    }
+    if (!out) {
+        return (int_len ? int_len : 1) + 1 + fp_digits;
+    }
+
+    char *pos = out;
+    if (int_len) {
+        memcpy(pos, digits, int_len);
+        pos += int_len;
+    }
+    else {
+        *pos++ = '0';
+    }
+    *pos++ = '.';
+    for (size_t i = len; i < fp_digits; i++) {
+        *pos++ = '0';
+    }
+    memcpy(pos, &digits[int_len], len - int_len);
+    pos += len - int_len;
+
+    return pos - out;
+}
 
+size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits)
+{
     if (fp_digits > 4) {
         return 0;
     }
-    if (fp_digits == 0) {
-        return fmt_s16_dec(out, val);
-    }
+    return fmt_s32_dfp(out, val, fp_digits);
+}
+
+size_t fmt_s32_dfp(char *out, int32_t val, unsigned fp_digits)
+{
+    char digits[10];
+    size_t pos = 0;
+    uint32_t absolute = val;
+
     if (val < 0) {
         if (out) {
-            out[pos++] = '-';
+            out[pos] = '-';
         }
-        val *= -1;
+        pos++;
+        absolute = -absolute;
     }
 
-    e = pwr(10, fp_digits);
-    absolute = (val / (int)e);
-    divider = val - (absolute * e);
+    size_t len = fmt_u32_dec(digits, absolute);
+    return pos + _fmt_point(out ? &out[pos] : NULL, digits, len, fp_digits);
+}
 
-    pos += fmt_s16_dec(&out[pos], absolute);
+/* divides the 128-bit number w by 10^9 and returns the remainder */
+static uint32_t _div_1e9(uint32_t *w)
+{
+    uint64_t rem = 0;
 
-    if (!out) {
-        return pos + 1 + fp_digits;     /* abs len + decimal point + divider */
+    for (int i = 3; i >= 0; i--) {
+        rem = (rem << 32) | w[i];
+        w[i] = rem / 1000000000UL;
+        rem %= 1000000000UL;
     }
+    return rem;
+}
 
-    out[pos++] = '.';
-    len = pos + fp_digits;
-    div_len = fmt_s16_dec(tmp, divider);
+size_t fmt_float(char *out, float f, unsigned precision)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .f = f };
+    char digits[39];
+    size_t pos = 0, len;
+    uint64_t ipart = 0;
+    uint32_t fdec = 0;
+    int exp = (bits.u >> 23) & 0xff;
+    uint32_t mant = bits.u & 0x7fffff;
+
+    if (precision > 7) {
+        return 0;
+    }
+    if ((exp == 0xff) && mant) {
+        return fmt_str(out, "nan");
+    }
+    if (bits.u >> 31) {
+        if (out) {
+            out[pos] = '-';
+        }
+        pos++;
+    }
+    if (exp == 0xff) {
+        return pos + fmt_str(out ? &out[pos] : NULL, "inf");
+    }
 
-    while (pos < (len - div_len)) {
-        out[pos++] = '0';
+    /* f = mant * 2^exp, split into the integer part and 64 bits of the
+     * fraction. The fraction is exact down to 2^-64, below that it can't
+     * round to anything but zero in seven digits. */
+    if (exp) {
+        mant |= 0x800000;
     }
-    for (size_t i = 0; i < div_len; i++) {
-        out[pos++] = tmp[i];
+    else {
+        exp = 1;
+    }
+    exp -= 150;
+
+    if (exp > 40) {
+        /* f >= 2^64 is an integer of up to 128 bits, which is converted in
+         * chunks of nine digits */
+        uint32_t w[4] = { 0, 0, 0, 0 };
+        uint32_t chunks[5];
+        unsigned n = 0;
+
+        w[exp / 32] = mant << (exp % 32);
+        if ((exp % 32) > 8) {
+            w[exp / 32 + 1] = mant >> (32 - (exp % 32));
+        }
+        while (w[0] | w[1] | w[2] | w[3]) {
+            chunks[n++] = _div_1e9(w);
+        }
+        len = fmt_u32_dec(digits, chunks[--n]);
+        while (n--) {
+            size_t clen = fmt_u32_dec(NULL, chunks[n]);
+            memset(&digits[len], '0', 9 - clen);
+            fmt_u32_dec(&digits[len + 9 - clen], chunks[n]);
+            len += 9;
+        }
+    }
+    else {
+        uint64_t frac = 0;
+
+        if (exp >= 0) {
+            ipart = (uint64_t)mant << exp;
+        }
+        else if (exp > -64) {
+            ipart = (exp > -32) ? (mant >> -exp) : 0;
+            frac = (uint64_t)mant << (64 + exp);
+        }
+        else if (exp > -88) {
+            /* the lowest bit keeps dropped bits from looking like a tie */
+            frac = (mant >> (-64 - exp)) |
+                   ((mant & ((1UL << (-64 - exp)) - 1)) != 0);
+        }
+
+        /* the fraction in units of 10^-precision, rounded to nearest, ties
+         * to even, like printf(). frac * 10^precision has up to 88 bits, fdec
+         * are the bits above 2^64, rest the ones below. */
+        uint64_t lo = (frac & 0xffffffff) * _pow10[precision];
+        uint64_t mid = (frac >> 32) * _pow10[precision] + (lo >> 32);
+        uint64_t rest = (mid << 32) | (uint32_t)lo;
+        fdec = mid >> 32;
+        if ((rest > 0x8000000000000000ULL) ||
+            ((rest == 0x8000000000000000ULL) && ((precision ? fdec : ipart) & 1))) {
+            fdec++;
+        }
+        if (fdec == _pow10[precision]) {
+            fdec = 0;
+            ipart++;
+        }
+        len = fmt_u64_dec(digits, ipart);
+    }
+
+    if (out) {
+        memcpy(&out[pos], digits, len);
+    }
+    pos += len;
+
+    if (precision) {
+        if (out) {
+            char *ptr = &out[pos];
+            size_t flen = fmt_u32_dec(NULL, fdec);
+            *ptr++ = '.';
+            memset(ptr, '0', precision - flen);
+            fmt_u32_dec(&ptr[precision - flen], fdec);
+        }
+        pos += 1 + precision;
     }
 
     return pos;
@@ -305,7 +495,7 @@ void print_u64_hex(uint64_t val)
 
 void print_u64_dec(uint64_t val)
 {
-    char buf[18];
+    char buf[20];
     size_t len = fmt_u64_dec(buf, val);
     print(buf, len);
 }
@@ -314,3 +504,388 @@ void print_str(const char* str)
 {
     print(str, fmt_strlen(str));
 }
+
+/* output of fmt_vprintf() and fmt_vsnprintf() */
+typedef struct {
+    char *buf;          /* output buffer */
+    size_t size;        /* usable size of buf */
+    size_t pos;         /* characters in buf */
+    size_t total;       /* characters formatted so far */
+    int flush;          /* write buf to stdout when full, else drop the rest */
+} _out_t;
+
+static void _put(_out_t *o, const char *s, size_t n)
+{
+    o->total += n;
+    while (n) {
+        size_t room = o->size - o->pos;
+        if (!room) {
+            if (!o->flush) {
+                return;
+            }
+            fwrite(o->buf, 1, o->pos, stdout);
+            o->pos = 0;
+            room = o->size;
+        }
+        if (room > n) {
+            room = n;
+        }
+        memcpy(&o->buf[o->pos], s, room);
+        o->pos += room;
+        s += room;
+        n -= room;
+    }
+}
+
+static void _fill(_out_t *o, char c, size_t n)
+{
+    static const char spaces[] = "        ";
+    static const char zeros[] = "00000000";
+    const char *s = (c == '0') ? zeros : spaces;
+
+    while (n) {
+        size_t chunk = (n < 8) ? n : 8;
+        _put(o, s, chunk);
+        n -= chunk;
+    }
+}
+
+/* writes prefix, zeros and str, padded with spaces to width */
+static void _put_field(_out_t *o, const char *prefix, size_t zeros,
+                       const char *str, size_t len, size_t width,
+                       unsigned flags)
+{
+    size_t prefix_len = fmt_strlen(prefix);
+    size_t n = prefix_len + zeros + len;
+    size_t pad = (width > n) ? (width - n) : 0;
+
+    if (flags & FLAG_ZERO) {
+        zeros += pad;
+        pad = 0;
+    }
+    if (!(flags & FLAG_LEFT)) {
+        _fill(o, ' ', pad);
+    }
+    _put(o, prefix, prefix_len);
+    _fill(o, '0', zeros);
+    _put(o, str, len);
+    if (flags & FLAG_LEFT) {
+        _fill(o, ' ', pad);
+    }
+}
+
+/* writes the digits of val in base 8, 10 or 16 in front of end */
+static char *_fmt_ull(char *end, unsigned long long val, char conv)
+{
+    char *ptr = end;
+
+    if ((conv == 'x') || (conv == 'X')) {
+        const char *chars = (conv == 'x') ? _hex_chars_lower : _hex_chars;
+        do {
+            *--ptr = chars[val & 0xf];
+        } while ((val >>= 4));
+    }
+    else if (conv == 'o') {
+        do {
+            *--ptr = (val & 0x7) + '0';
+        } while ((val >>= 3));
+    }
+    else {
+        size_t len = (val >> 32) ? fmt_u64_dec(NULL, val)
+                                 : fmt_u32_dec(NULL, val);
+        ptr -= len;
+        if (val >> 32) {
+            fmt_u64_dec(ptr, val);
+        }
+        else {
+            fmt_u32_dec(ptr, val);
+        }
+    }
+    return ptr;
+}
+
+static void _put_number(_out_t *o, const char *prefix,
+                        unsigned long long val, char conv, size_t width,
+                        int prec, unsigned flags)
+{
+    char buf[22];
+    char *end = &buf[sizeof(buf)];
+    char *digits = _fmt_ull(end, val, conv);
+    size_t n = end - digits;
+    size_t zeros = 0;
+
+    if (prec >= 0) {
+        /* the precision is the minimum number of digits */
+        flags &= ~FLAG_ZERO;
+        if (!prec && !val) {
+            n = 0;
+        }
+        zeros = ((size_t)prec > n) ? (prec - n) : 0;
+    }
+    _put_field(o, prefix, zeros, digits, n, width, flags);
+}
+
+static int _format(_out_t *o, const char *format, va_list args)
+{
+    const char *c;
+
+    while ((c = strchr(format, '%'))) {
+        const char *start = c;
+        unsigned flags = 0;
+        size_t width = 0;
+        int prec = -1;
+        char len = 0;
+
+        _put(o, format, c - format);
+        c++;
+
+        for (;; c++) {
+            if (*c == '-') {
+                flags |= FLAG_LEFT;
+            }
+            else if (*c == '0') {
+                flags |= FLAG_ZERO;
+            }
+            else if (*c == '+') {
+                flags |= FLAG_PLUS;
+            }
+            else if (*c == ' ') {
+                flags |= FLAG_SPACE;
+            }
+            else if (*c == '#') {
+                flags |= FLAG_ALT;
+            }
+            else {
+                break;
+            }
+        }
+        if (*c == '*') {
+            int w = va_arg(args, int);
+            if (w < 0) {
+                flags |= FLAG_LEFT;
+                w = -w;
+            }
+            width = w;
+            c++;
+        }
+        while (_is_digit(*c)) {
+            width = (width * 10) + (*c++ - '0');
+        }
+        if (*c == '.') {
+            c++;
+            if (*c == '*') {
+                prec = va_arg(args, int);
+                prec = (prec < 0) ? -1 : prec;
+                c++;
+            }
+            else {
+                prec = 0;
+                while (_is_digit(*c)) {
+                    prec = (prec * 10) + (*c++ - '0');
+                }
+            }
+        }
+        if (flags & FLAG_LEFT) {
+            flags &= ~FLAG_ZERO;
+        }
+
+        switch (*c) {
+            case 'h':
+                len = 'h';
+                if (*++c == 'h') {
+                    len = 'H';
+                    c++;
+                }
+                break;
+            case 'l':
+                len = 'l';
+                if (*++c == 'l') {
+                    len = 'q';
+                    c++;
+                }
+                break;
+            case 'j':
+                len = 'q';
+                c++;
+                break;
+            case 'z':
+            case 't':
+            case 'L':
+                len = *c++;
+                break;
+        }
+
+        char conv = *c;
+        char buf[FMT_FLOAT_MAXLEN];
+        const char *prefix = "";
+        unsigned long long val;
+
+        switch (conv) {
+            case 'd':
+            case 'i': {
+                long long sval;
+                if (len == 'q') {
+                    sval = va_arg(args, long long);
+                }
+                else if (len == 'l') {
+                    sval = va_arg(args, long);
+                }
+                else if ((len == 'z') || (len == 't')) {
+                    sval = va_arg(args, ptrdiff_t);
+                }
+                else if (len == 'h') {
+                    sval = (short)va_arg(args, int);
+                }
+                else if (len == 'H') {
+                    sval = (signed char)va_arg(args, int);
+                }
+                else {
+                    sval = va_arg(args, int);
+                }
+                val = sval;
+                if (sval < 0) {
+                    val = -val;
+                    prefix = "-";
+                }
+                else if (flags & FLAG_PLUS) {
+                    prefix = "+";
+                }
+                else if (flags & FLAG_SPACE) {
+                    prefix = " ";
+                }
+                _put_number(o, prefix, val, 'u', width, prec, flags);
+                break;
+            }
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                if (len == 'q') {
+                    val = va_arg(args, unsigned long long);
+                }
+                else if (len == 'l') {
+                    val = va_arg(args, unsigned long);
+                }
+                else if ((len == 'z') || (len == 't')) {
+                    val = va_arg(args, size_t);
+                }
+                else if (len == 'h') {
+                    val = (unsigned short)va_arg(args, unsigned);
+                }
+                else if (len == 'H') {
+                    val = (unsigned char)va_arg(args, unsigned);
+                }
+                else {
+                    val = va_arg(args, unsigned);
+                }
+                if ((flags & FLAG_ALT) && val && (conv != 'u')) {
+                    prefix = (conv == 'X') ? "0X" : (conv == 'x') ? "0x" : "0";
+                }
+                _put_number(o, prefix, val, conv, width, prec, flags);
+                break;
+            case 'p':
+                val = (uintptr_t)va_arg(args, void *);
+                prefix = "0x";
+                _put_number(o, prefix, val, 'x', width, prec, flags);
+                break;
+            case 'f':
+            case 'F': {
+                double dval = (len == 'L') ? (double)va_arg(args, long double)
+                                           : va_arg(args, double);
+                prec = (prec < 0) ? 6 : (prec > 7) ? 7 : prec;
+                size_t n = fmt_float(buf, dval, prec);
+                char *digits = buf;
+                if ((flags & FLAG_ALT) && !prec && _is_digit(buf[n - 1])) {
+                    /* the decimal point is kept without digits behind it */
+                    buf[n++] = '.';
+                }
+                if (*digits == '-') {
+                    prefix = "-";
+                    digits++;
+                    n--;
+                }
+                else if (flags & FLAG_PLUS) {
+                    prefix = "+";
+                }
+                else if (flags & FLAG_SPACE) {
+                    prefix = " ";
+                }
+                if (!_is_digit(*digits)) {
+                    /* inf and nan are padded with spaces */
+                    flags &= ~FLAG_ZERO;
+                }
+                _put_field(o, prefix, 0, digits, n, width, flags);
+                break;
+            }
+            case 'c':
+                buf[0] = va_arg(args, int);
+                _put_field(o, "", 0, buf, 1, width, flags & ~FLAG_ZERO);
+                break;
+            case 's': {
+                const char *str = va_arg(args, const char *);
+                size_t n = 0;
+                if (!str) {
+                    str = "(null)";
+                }
+                while (((prec < 0) || (n < (size_t)prec)) && str[n]) {
+                    n++;
+                }
+                _put_field(o, "", 0, str, n, width, flags & ~FLAG_ZERO);
+                break;
+            }
+            case '%':
+                _put(o, "%", 1);
+                break;
+            default:
+                /* the arguments can not be skipped without knowing the
+                 * conversion, so the rest is written as it is */
+                _put(o, start, fmt_strlen(start));
+                return o->total;
+        }
+        format = c + 1;
+    }
+    _put(o, format, fmt_strlen(format));
+
+    return o->total;
+}
+
+int fmt_vprintf(const char *format, va_list args)
+{
+    char buf[FMT_PRINTF_BUFSIZE];
+    _out_t o = { .buf = buf, .size = sizeof(buf), .flush = 1 };
+
+    int res = _format(&o, format, args);
+    fwrite(buf, 1, o.pos, stdout);
+    return res;
+}
+
+int fmt_printf(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int res = fmt_vprintf(format, args);
+    va_end(args);
+    return res;
+}
+
+int fmt_vsnprintf(char *out, size_t size, const char *format, va_list args)
+{
+    _out_t o = { .buf = out, .size = size ? (size - 1) : 0 };
+
+    int res = _format(&o, format, args);
+    if (size) {
+        out[o.pos] = '\0';
+    }
+    return res;
+}
+
+int fmt_snprintf(char *out, size_t size, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int res = fmt_vsnprintf(out, size, format, args);
+    va_end(args);
+    return res;
+}
@@ -14,8 +14,14 @@
  * @author      Christian Mehlis <mehlis@inf.fu-berlin.de>
  */
 
+#include <string.h>
+
+#include "byteorder.h"
 #include "hashes.h"
 
+#define MURMUR3_C1  (0xcc9e2d51UL)
+#define MURMUR3_C2  (0x1b873593UL)
+
 uint32_t djb2_hash(const uint8_t *buf, size_t len)
 {
     uint32_t hash = 5381;
@@ -109,3 +115,95 @@ uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len)
     hash += hash << 15;
     return hash;
 }
+
+static inline uint32_t _rotl(uint32_t x, unsigned n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+/* reads a little endian word without any alignment requirement */
+static inline uint32_t _murmur3_word(const uint8_t *buf)
+{
+    uint32_t k;
+
+    memcpy(&k, buf, sizeof(k));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    k = byteorder_swapl(k);
+#endif
+    return k;
+}
+
+/* the 1 to 3 trailing bytes */
+static inline uint32_t _murmur3_tail(const uint8_t *buf, size_t len)
+{
+    uint32_t k = 0;
+
+    switch (len & 3) {
+        case 3:
+            k ^= (uint32_t)buf[2] << 16;
+            /* fall through */
+        case 2:
+            k ^= (uint32_t)buf[1] << 8;
+            /* fall through */
+        case 1:
+            k ^= buf[0];
+    }
+    return k;
+}
+
+static inline uint32_t _murmur3_scramble(uint32_t k)
+{
+    k *= MURMUR3_C1;
+    k = _rotl(k, 15);
+    return k * MURMUR3_C2;
+}
+
+static inline uint32_t _murmur3_round(uint32_t h, uint32_t k)
+{
+    h ^= _murmur3_scramble(k);
+    h = _rotl(h, 13);
+    return (h * 5) + 0xe6546b64UL;
+}
+
+static inline uint32_t _murmur3_fmix(uint32_t h, size_t len)
+{
+    h ^= (uint32_t)len;
+    h ^= h >> 16;
+    h *= 0x85ebca6bUL;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35UL;
+    h ^= h >> 16;
+    return h;
+}
+
+uint32_t murmur3_hash(const uint8_t *buf, size_t len, uint32_t seed)
+{
+    const uint8_t *end = buf + (len & ~((size_t)3));
+    uint32_t hash = seed;
+
+    for (; buf < end; buf += 4) {
+        hash = _murmur3_round(hash, _murmur3_word(buf));
+    }
+    /* the scrambled tail of an empty tail is 0 */
+    hash ^= _murmur3_scramble(_murmur3_tail(buf, len));
+    return _murmur3_fmix(hash, len);
+}
+
+void murmur3_hash_x2(const uint8_t *buf, size_t len, const uint32_t seed[2],
+                     uint32_t hash[2])
+{
+    const uint8_t *end = buf + (len & ~((size_t)3));
+    uint32_t h1 = seed[0];
+    uint32_t h2 = seed[1];
+    uint32_t k;
+
+    /* both hashes share the loads and the scrambling of the words */
+    for (; buf < end; buf += 4) {
+        k = _murmur3_scramble(_murmur3_word(buf));
+        h1 = (_rotl(h1 ^ k, 13) * 5) + 0xe6546b64UL;
+        h2 = (_rotl(h2 ^ k, 13) * 5) + 0xe6546b64UL;
+    }
+    k = _murmur3_scramble(_murmur3_tail(buf, len));
+    hash[0] = _murmur3_fmix(h1 ^ k, len);
+    hash[1] = _murmur3_fmix(h2 ^ k, len);
+}
@@ -49,6 +49,13 @@
 #include "hashes/sha256.h"
 #include "board.h"
 
+/* The SHA extensions of x86 are used on native if the compiler is allowed to
+ * emit them, i.e. with CFLAGS += -msha -msse4.1 */
+#if defined(CPU_NATIVE) && defined(__SHA__) && defined(__SSE4_1__)
+#define SHA256_SHA_NI
+#include <immintrin.h>
+#endif
+
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
 #define be32enc_vect memcpy
@@ -121,42 +128,216 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+#ifndef SHA256_SHA_NI
+/* One round, the working variables are renamed by the caller instead of
+ * being moved: the new e is written to d and the new a to h. */
+#define ROUND(a, b, c, d, e, f, g, h, i)                            \
+    do {                                                            \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[r + i];    \
+        d += t0;                                                    \
+        h = t0 + S0(a) + Maj(a, b, c);                              \
+    } while (0)
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
+ *
+ * The message schedule only keeps the 16 words that are needed for the next
+ * 16 rounds, the rounds are unrolled by 16 so all indices are constant.
  */
 static void sha256_transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-    /* 1. Prepare message schedule W. */
     be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+
+    for (unsigned r = 0; ; r += 16) {
+        ROUND(a, b, c, d, e, f, g, h, 0);
+        ROUND(h, a, b, c, d, e, f, g, 1);
+        ROUND(g, h, a, b, c, d, e, f, 2);
+        ROUND(f, g, h, a, b, c, d, e, 3);
+        ROUND(e, f, g, h, a, b, c, d, 4);
+        ROUND(d, e, f, g, h, a, b, c, 5);
+        ROUND(c, d, e, f, g, h, a, b, 6);
+        ROUND(b, c, d, e, f, g, h, a, 7);
+        ROUND(a, b, c, d, e, f, g, h, 8);
+        ROUND(h, a, b, c, d, e, f, g, 9);
+        ROUND(g, h, a, b, c, d, e, f, 10);
+        ROUND(f, g, h, a, b, c, d, e, 11);
+        ROUND(e, f, g, h, a, b, c, d, 12);
+        ROUND(d, e, f, g, h, a, b, c, 13);
+        ROUND(c, d, e, f, g, h, a, b, 14);
+        ROUND(b, c, d, e, f, g, h, a, 15);
+
+        if (r == 48) {
+            break;
+        }
+
+        /* message schedule of the next 16 rounds, W[i] still holds the word
+         * of 16 rounds before */
+        for (unsigned i = 0; i < 16; i++) {
+            W[i] += s1(W[(i + 14) & 15]) + W[(i + 9) & 15] + s0(W[(i + 1) & 15]);
+        }
     }
 
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+#endif /* !SHA256_SHA_NI */
+
+#ifdef SHA256_SHA_NI
+/* Expands x for every lane, with a constant lane index so the registers of
+ * the lanes are not spilled into arrays */
+#define FOR_LANES(x)        \
+    do {                    \
+        x(0);               \
+        if (lanes > 1) {    \
+            x(1);           \
+        }                   \
+    } while (0)
+
+#define LOAD_STATE(l)                                                   \
+    do {                                                                \
+        __m128i tmp = _mm_loadu_si128((const __m128i *)&state[l][0]);   \
+        s1[l] = _mm_loadu_si128((const __m128i *)&state[l][4]);         \
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);                             \
+        s1[l] = _mm_shuffle_epi32(s1[l], 0x1B);                         \
+        s0[l] = _mm_alignr_epi8(tmp, s1[l], 8);                         \
+        s1[l] = _mm_blend_epi16(s1[l], tmp, 0xF0);                      \
+    } while (0)
+
+#define STORE_STATE(l)                                                  \
+    do {                                                                \
+        __m128i tmp = _mm_shuffle_epi32(s0[l], 0x1B);                   \
+        s1[l] = _mm_shuffle_epi32(s1[l], 0xB1);                         \
+        _mm_storeu_si128((__m128i *)&state[l][0],                       \
+                         _mm_blend_epi16(tmp, s1[l], 0xF0));            \
+        _mm_storeu_si128((__m128i *)&state[l][4],                       \
+                         _mm_alignr_epi8(s1[l], tmp, 8));               \
+    } while (0)
+
+#define SAVE_STATE(l)                                                   \
+    do {                                                                \
+        save0[l] = s0[l];                                               \
+        save1[l] = s1[l];                                               \
+    } while (0)
+
+#define ADD_STATE(l)                                                    \
+    do {                                                                \
+        s0[l] = _mm_add_epi32(s0[l], save0[l]);                         \
+        s1[l] = _mm_add_epi32(s1[l], save1[l]);                         \
+        data[l] += 64;                                                  \
+    } while (0)
+
+/* One quad-round k of lane l, the message words of quad-round k are in
+ * m[l][k % 4].  The schedule of the message words 16 rounds ahead is
+ * interleaved with the rounds. */
+#define QROUND_LANE(k, l)                                                   \
+    do {                                                                    \
+        __m128i msg;                                                        \
+        if ((k) < 4) {                                                      \
+            msg = _mm_loadu_si128((const __m128i *)(data[l] + 16 * (k)));   \
+            m[l][(k) % 4] = _mm_shuffle_epi8(msg, bswap);                   \
+        }                                                                   \
+        msg = _mm_add_epi32(m[l][(k) % 4],                                  \
+                            _mm_loadu_si128((const __m128i *)&K[4 * (k)])); \
+        s1[l] = _mm_sha256rnds2_epu32(s1[l], s0[l], msg);                   \
+        if ((k) >= 3 && (k) <= 14) {                                        \
+            __m128i tmp = _mm_alignr_epi8(m[l][(k) % 4],                    \
+                                          m[l][((k) + 3) % 4], 4);          \
+            tmp = _mm_add_epi32(m[l][((k) + 1) % 4], tmp);                  \
+            m[l][((k) + 1) % 4] = _mm_sha256msg2_epu32(tmp, m[l][(k) % 4]); \
+        }                                                                   \
+        msg = _mm_shuffle_epi32(msg, 0x0E);                                 \
+        s0[l] = _mm_sha256rnds2_epu32(s0[l], s1[l], msg);                   \
+        if ((k) >= 1 && (k) <= 12) {                                        \
+            m[l][((k) + 3) % 4] = _mm_sha256msg1_epu32(m[l][((k) + 3) % 4], \
+                                                       m[l][(k) % 4]);      \
+        }                                                                   \
+    } while (0)
+
+#define QROUND(k)                                                           \
+    do {                                                                    \
+        QROUND_LANE(k, 0);                                                  \
+        if (lanes > 1) {                                                    \
+            QROUND_LANE(k, 1);                                              \
+        }                                                                   \
+    } while (0)
 
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
+/*
+ * Compresses num consecutive blocks of each lane with the SHA extensions.
+ * The state is kept in registers between the blocks.  With two lanes the
+ * rounds of both are interleaved to hide the latency of the round
+ * instructions.
+ */
+static inline __attribute__((always_inline))
+void sha256_ni_blocks(uint32_t *const state[], const unsigned char *data[],
+                      size_t num, unsigned lanes)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i s0[2], s1[2], m[2][4];
+
+    /* the round instructions want the state as ABEF and CDGH */
+    FOR_LANES(LOAD_STATE);
 
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
+    while (num--) {
+        __m128i save0[2], save1[2];
 
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+        FOR_LANES(SAVE_STATE);
+
+        QROUND(0);  QROUND(1);  QROUND(2);  QROUND(3);
+        QROUND(4);  QROUND(5);  QROUND(6);  QROUND(7);
+        QROUND(8);  QROUND(9);  QROUND(10); QROUND(11);
+        QROUND(12); QROUND(13); QROUND(14); QROUND(15);
+
+        FOR_LANES(ADD_STATE);
     }
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
+    FOR_LANES(STORE_STATE);
+}
+#endif /* SHA256_SHA_NI */
+
+/* Compresses num consecutive blocks */
+static void sha256_transform_blocks(uint32_t *state,
+                                    const unsigned char *blocks, size_t num)
+{
+#ifdef SHA256_SHA_NI
+    uint32_t *states[] = { state };
+    const unsigned char *data[] = { blocks };
+
+    sha256_ni_blocks(states, data, num, 1);
+#else
+    while (num--) {
+        sha256_transform(state, blocks);
+        blocks += 64;
     }
+#endif
+}
+
+/* Compresses num consecutive blocks of two independent messages */
+static void sha256_transform_blocks_x2(uint32_t *state0, uint32_t *state1,
+                                       const unsigned char *blocks0,
+                                       const unsigned char *blocks1,
+                                       size_t num)
+{
+#ifdef SHA256_SHA_NI
+    uint32_t *states[] = { state0, state1 };
+    const unsigned char *data[] = { blocks0, blocks1 };
+
+    sha256_ni_blocks(states, data, num, 2);
+#else
+    sha256_transform_blocks(state0, blocks0, num);
+    sha256_transform_blocks(state1, blocks1, num);
+#endif
 }
 
 static unsigned char PAD[64] = {
@@ -230,16 +411,14 @@ void sha256_update(sha256_context_t *ctx, const uint8_t *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha256_transform(ctx->state, ctx->buf);
+    sha256_transform_blocks(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
     /* Perform complete blocks */
-    while (len >= 64) {
-        sha256_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
-    }
+    sha256_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~(size_t)0x3f;
+    len &= 0x3f;
 
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
@@ -277,6 +456,34 @@ unsigned char *sha256(const unsigned char *d, size_t n, unsigned char *md)
     return md;
 }
 
+void sha256_multi(const uint8_t *const data[], const size_t len[],
+                  uint8_t *const digests[], size_t num)
+{
+    size_t i = 0;
+
+    for (; (i + 1) < num; i += 2) {
+        sha256_context_t ctx[2];
+        size_t common = ((len[i] < len[i + 1]) ? len[i] : len[i + 1]) & ~(size_t)0x3f;
+
+        sha256_init(&ctx[0]);
+        sha256_init(&ctx[1]);
+
+        /* the full blocks both messages have are hashed in lockstep */
+        sha256_transform_blocks_x2(ctx[0].state, ctx[1].state, data[i],
+                                   data[i + 1], common / 64);
+        for (unsigned j = 0; j < 2; j++) {
+            ctx[j].count[1] = (uint32_t)common << 3;
+            ctx[j].count[0] = (uint32_t)((uint64_t)common >> 29);
+            sha256_update(&ctx[j], data[i + j] + common, len[i + j] - common);
+            sha256_final(&ctx[j], digests[i + j]);
+        }
+    }
+
+    if (i < num) {
+        sha256(data[i], len[i], digests[i]);
+    }
+}
+
 const unsigned char *hmac_sha256(const unsigned char *key,
                                  size_t key_length,
                                  const unsigned *message,
@@ -345,11 +552,19 @@ const unsigned char *hmac_sha256(const unsigned char *key,
  */
 static inline void sha256_inplace(unsigned char element[SHA256_DIGEST_LENGTH])
 {
+    /* the message is shorter than a block, so the padded block is built
+     * directly: the element, a one bit, zeros, and the length of 256 bit */
+    unsigned char block[SHA256_INTERNAL_BLOCK_SIZE];
     sha256_context_t ctx;
 
+    memcpy(block, element, SHA256_DIGEST_LENGTH);
+    memcpy(&block[SHA256_DIGEST_LENGTH], PAD,
+           SHA256_INTERNAL_BLOCK_SIZE - SHA256_DIGEST_LENGTH);
+    block[62] = (SHA256_DIGEST_LENGTH * 8) >> 8;
+
     sha256_init(&ctx);
-    sha256_update(&ctx, element, SHA256_DIGEST_LENGTH);
-    sha256_final(&ctx, element);
+    sha256_transform_blocks(ctx.state, block, 1);
+    be32enc_vect(element, ctx.state, SHA256_DIGEST_LENGTH);
 }
 
 unsigned char *sha256_chain(const unsigned char *seed, size_t seed_length,
@@ -14,6 +14,13 @@
  * @{
  *
  * @brief       encoding and decoding functions for base64
+ *
+ * Besides the functions that convert a whole buffer, there is a streaming
+ * API that converts a datum in chunks of any size, and the URL and filename
+ * safe alphabet "base64url" of RFC 4648, section 5, which is encoded without
+ * padding. Each decoder accepts its own alphabet only and ignores '=' and all
+ * other symbols that are not part of it, e.g. line breaks.
+ *
  * @author      Martin Landsmann <Martin.Landsmann@HAW-Hamburg.de>
  */
 
@@ -21,6 +28,7 @@
 #define BASE64_ENCODER_DECODER_H_
 
 #include <stddef.h> /* for size_t */
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +40,15 @@ extern "C" {
 #define BASE64_ERROR_DATA_IN          (-3) /**< error value for invalid input buffer           */
 #define BASE64_ERROR_DATA_IN_SIZE     (-4) /**< error value for invalid output buffer size     */
 
+/**
+ * @brief   State of a streaming encoder or decoder
+ */
+typedef struct {
+    uint32_t acc;   /**< the bits of the pending bytes or symbols */
+    uint8_t num;    /**< number of pending bytes or symbols */
+    uint8_t url;    /**< use the base64url alphabet */
+} base64_ctx_t;
+
 /**
  * @brief           Encodes a given datum to base64 and save the result to the given destination.
  * @param[in]       data_in           pointer to the datum to encode
@@ -74,6 +91,133 @@ int base64_encode(unsigned char *data_in, size_t data_in_size, \
 int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
                   unsigned char *data_out, size_t *data_out_size);
 
+/**
+ * @brief           Encodes a given datum to base64url without padding.
+ *
+ * Same as base64_encode(), but with the alphabet of RFC 4648, section 5.
+ */
+int base64url_encode(unsigned char *data_in, size_t data_in_size, \
+                     unsigned char *base64_out, size_t *base64_out_size);
+
+/**
+ * @brief           Decodes a given base64url string.
+ *
+ * Same as base64_decode(), but with the alphabet of RFC 4648, section 5, and
+ * @p base64_in_size may be as small as 2, since base64url is not padded.
+ */
+int base64url_decode(unsigned char *base64_in, size_t base64_in_size, \
+                     unsigned char *data_out, size_t *data_out_size);
+
+/**
+ * @brief           Starts the encoding of a datum in chunks.
+ * @param[out]      ctx               the encoder
+ */
+void base64_encode_init(base64_ctx_t *ctx);
+
+/**
+ * @brief           Starts the encoding of a datum in chunks to base64url.
+ * @param[out]      ctx               the encoder
+ */
+void base64url_encode_init(base64_ctx_t *ctx);
+
+/**
+ * @brief           Encodes the next chunk of a datum.
+ *
+ * The encoder keeps up to 2 bytes that do not fill a group of 3 bytes for the
+ * next chunk. Encoding a chunk of n bytes takes at most 4 * ((n + 2) / 3)
+ * bytes of @p base64_out.
+ *
+ * @param[in,out]   ctx               the encoder
+ * @param[in]       data_in           the chunk, may be NULL if @p data_in_size
+ *                                    is 0
+ * @param[in]       data_in_size      the size of `data_in`
+ * @param[out]      base64_out        pointer to store the encoded base64 string
+ * @param[in,out]   base64_out_size   the size of `base64_out`. It is
+ *                                    overwritten with the required size on
+ *                                    BASE64_ERROR_BUFFER_OUT_SIZE, and with the
+ *                                    actual used size on BASE64_SUCCESS.
+ *
+ * @returns BASE64_SUCCESS on success,
+ *          BASE64_ERROR_BUFFER_OUT_SIZE on insufficient size of `base64_out`,
+ *          BASE64_ERROR_BUFFER_OUT if `base64_out` equals NULL,
+ *          BASE64_ERROR_DATA_IN if `data_in` equals NULL.
+ */
+int base64_encode_update(base64_ctx_t *ctx, const unsigned char *data_in,
+                         size_t data_in_size, unsigned char *base64_out,
+                         size_t *base64_out_size);
+
+/**
+ * @brief           Encodes the pending bytes and pads the base64 string.
+ *
+ * Takes at most 4 bytes of @p base64_out. The encoder can be used for the
+ * next datum afterwards.
+ *
+ * @param[in,out]   ctx               the encoder
+ * @param[out]      base64_out        pointer to store the encoded base64 string
+ * @param[in,out]   base64_out_size   see base64_encode_update()
+ *
+ * @returns BASE64_SUCCESS on success,
+ *          BASE64_ERROR_BUFFER_OUT_SIZE on insufficient size of `base64_out`,
+ *          BASE64_ERROR_BUFFER_OUT if `base64_out` equals NULL.
+ */
+int base64_encode_finish(base64_ctx_t *ctx, unsigned char *base64_out,
+                         size_t *base64_out_size);
+
+/**
+ * @brief           Starts the decoding of a base64 string in chunks.
+ * @param[out]      ctx               the decoder
+ */
+void base64_decode_init(base64_ctx_t *ctx);
+
+/**
+ * @brief           Starts the decoding of a base64url string in chunks.
+ * @param[out]      ctx               the decoder
+ */
+void base64url_decode_init(base64_ctx_t *ctx);
+
+/**
+ * @brief           Decodes the next chunk of a base64 or base64url string.
+ *
+ * The decoder keeps up to 3 symbols that do not fill a group of 4 symbols for
+ * the next chunk. Decoding a chunk of n symbols takes at most 3 * ((n + 3) / 4)
+ * bytes of @p data_out.
+ *
+ * @param[in,out]   ctx               the decoder
+ * @param[in]       base64_in         the chunk, may be NULL if
+ *                                    @p base64_in_size is 0
+ * @param[in]       base64_in_size    the size of `base64_in`
+ * @param[out]      data_out          pointer to store the decoded datum
+ * @param[in,out]   data_out_size     the size of `data_out`. It is
+ *                                    overwritten with the required size on
+ *                                    BASE64_ERROR_BUFFER_OUT_SIZE, and with the
+ *                                    actual used size on BASE64_SUCCESS.
+ *
+ * @returns BASE64_SUCCESS on success,
+ *          BASE64_ERROR_BUFFER_OUT_SIZE on insufficient size of `data_out`,
+ *          BASE64_ERROR_BUFFER_OUT if `data_out` equals NULL,
+ *          BASE64_ERROR_DATA_IN if `base64_in` equals NULL.
+ */
+int base64_decode_update(base64_ctx_t *ctx, const unsigned char *base64_in,
+                         size_t base64_in_size, unsigned char *data_out,
+                         size_t *data_out_size);
+
+/**
+ * @brief           Decodes the pending symbols of an unpadded string.
+ *
+ * Takes at most 2 bytes of @p data_out. The decoder can be used for the next
+ * string afterwards.
+ *
+ * @param[in,out]   ctx               the decoder
+ * @param[out]      data_out          pointer to store the decoded datum
+ * @param[in,out]   data_out_size     see base64_decode_update()
+ *
+ * @returns BASE64_SUCCESS on success,
+ *          BASE64_ERROR_BUFFER_OUT_SIZE on insufficient size of `data_out`,
+ *          BASE64_ERROR_BUFFER_OUT if `data_out` equals NULL.
+ */
+int base64_decode_finish(base64_ctx_t *ctx, unsigned char *data_out,
+                         size_t *data_out_size);
+
 #ifdef __cplusplus
 }
 #endif
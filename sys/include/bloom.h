@@ -146,20 +146,87 @@ typedef struct {
     size_t k;
     /** the bloom array */
     uint8_t *a;
-    /** the hash functions */
+    /** the hash functions, NULL for double hashing */
     hashfp_t *hash;
 } bloom_t;
 
+/**
+ * @brief   Number of bytes needed for @p size 4 bit cells of a counting or a
+ *          rotating Bloom filter
+ */
+#define BLOOM_CELLS_SIZE(size)      (((size) + 1) / 2)
+
+/**
+ * @brief   Maximum value of a counter of a counting Bloom filter
+ *
+ * Counters that reached this value are never decremented.
+ */
+#define BLOOM_COUNTER_MAX           (15U)
+
+/**
+ * @brief   Maximum number of generations a rotating Bloom filter remembers
+ */
+#define BLOOM_ROTATING_GENS_MAX     (14U)
+
+/**
+ * @brief bloom_counting_t counting Bloom filter object
+ *
+ * Like @ref bloom_t, but with a 4 bit counter instead of a bit per index, so
+ * that strings can be removed again.
+ */
+typedef struct {
+    /** number of counters */
+    size_t m;
+    /** number of hash functions */
+    size_t k;
+    /** the counters, two per byte */
+    uint8_t *cells;
+    /** the hash functions, NULL for double hashing */
+    hashfp_t *hash;
+} bloom_counting_t;
+
+/**
+ * @brief bloom_rotating_t time-decaying Bloom filter object
+ *
+ * Remembers the strings added in the last @ref bloom_rotating_t::gens
+ * generations. Each index has a 4 bit cell that holds the generation in
+ * which it was set last. A rotation starts a new generation and thereby
+ * forgets the strings of the oldest one without touching their cells.
+ */
+typedef struct {
+    /** number of cells */
+    size_t m;
+    /** number of hash functions */
+    size_t k;
+    /** the cells, two per byte */
+    uint8_t *cells;
+    /** the hash functions, NULL for double hashing */
+    hashfp_t *hash;
+    /** next byte of the cells to check for expired cells */
+    size_t sweep;
+    /** number of generations the filter remembers */
+    uint8_t gens;
+    /** the current generation, 1 to 15 */
+    uint8_t gen;
+} bloom_rotating_t;
+
 /**
  * @brief Initialize a Bloom Filter.
  *
  * @note For best results, make 'size' a power of 2.
  *
+ * If @p hashes is NULL, the filter uses double hashing: the @p hashes_numof
+ * bit indices of a string are derived from two seeded MurmurHash3 hashes
+ * (see murmur3_hash_x2()), so bloom_add() and bloom_check() read the string
+ * only once instead of once per hash function. This needs the `hashes`
+ * module.
+ *
  * @param bloom             bloom_t to initialize
  * @param size              size of the bloom filter in bits
  * @param bitfield          underlying bitfield of the bloom filter
- * @param hashes            array of hashes
- * @param hashes_numof      number of elements in hashes
+ * @param hashes            array of hashes, or NULL for double hashing
+ * @param hashes_numof      number of elements in hashes, or number of bit
+ *                          indices per string for double hashing
  *
  * @pre     @p bitfield MUST be large enough to hold @p size bits.
  */
@@ -228,6 +295,120 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @brief Initialize a counting Bloom filter.
+ *
+ * The counters are cleared.
+ *
+ * @param bloom             bloom_counting_t to initialize
+ * @param size              number of counters of the filter
+ * @param cells             the counters, at least BLOOM_CELLS_SIZE(@p size)
+ *                          bytes
+ * @param hashes            array of hashes, or NULL for double hashing
+ * @param hashes_numof      number of elements in hashes, or number of
+ *                          counters per string for double hashing
+ */
+void bloom_counting_init(bloom_counting_t *bloom, size_t size, uint8_t *cells,
+                         hashfp_t *hashes, int hashes_numof);
+
+/**
+ * @brief Add a string to a counting Bloom filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Remove a string from a counting Bloom filter.
+ *
+ * The string must have been added before, removing a false positive removes
+ * other strings from the filter. Counters that overflowed stay at
+ * @ref BLOOM_COUNTER_MAX.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to remove
+ * @param len    the length of the string @p buf
+ *
+ * @return       0 on success
+ * @return       -ENOENT if the string is not in the filter, nothing is
+ *               removed then
+ */
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a string is in a counting Bloom filter.
+ *
+ * @see bloom_check()
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Initialize a rotating Bloom filter.
+ *
+ * The cells are cleared.
+ *
+ * @param bloom             bloom_rotating_t to initialize
+ * @param size              number of cells of the filter
+ * @param cells             the cells, at least BLOOM_CELLS_SIZE(@p size)
+ *                          bytes
+ * @param hashes            array of hashes, or NULL for double hashing
+ * @param hashes_numof      number of elements in hashes, or number of cells
+ *                          per string for double hashing
+ * @param gens              number of generations a string stays in the
+ *                          filter, 1 to @ref BLOOM_ROTATING_GENS_MAX
+ */
+void bloom_rotating_init(bloom_rotating_t *bloom, size_t size, uint8_t *cells,
+                         hashfp_t *hashes, int hashes_numof, unsigned gens);
+
+/**
+ * @brief Add a string to the current generation of a rotating Bloom filter.
+ *
+ * Adding a string that is already in the filter moves it to the current
+ * generation.
+ *
+ * @param bloom  rotating Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_rotating_add(bloom_rotating_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a string was added in the last generations.
+ *
+ * @see bloom_check()
+ *
+ * @param bloom  rotating Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_rotating_check(const bloom_rotating_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Start a new generation of a rotating Bloom filter.
+ *
+ * The strings of the oldest generation are forgotten. They expire by the
+ * change of the current generation, no cell has to be cleared for that. Only
+ * to allow the 4 bit generation numbers to wrap around, each rotation clears
+ * the expired cells among the next size / (15 - gens) cells. This is a fixed
+ * amount of work, independent of the number of strings in the filter, and
+ * a fraction of clearing the whole filter.
+ *
+ * @param bloom  rotating Bloom filter
+ */
+void bloom_rotating_rotate(bloom_rotating_t *bloom);
+
 #ifdef __cplusplus
 }
 #endif
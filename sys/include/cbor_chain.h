@@ -0,0 +1,456 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cbor
+ * @{
+ *
+ * @file
+ * @brief       CBOR reader and writer for chains of buffers
+ *
+ * Unlike the functions of cbor.h, which need the whole message in one
+ * cbor_stream_t, the reader and the writer work on a vector of buffers
+ * (struct iovec), or with the module gnrc_pkt on a gnrc_pktsnip_t chain.
+ * Items may span the borders of the buffers.
+ *
+ * The reader is a pull parser with an explicit cursor: cbor_reader_next()
+ * returns the head of the next item and moves the cursor past it. Containers
+ * are not descended into automatically, their items simply follow. The
+ * length prefixes of strings let cbor_reader_skip() skip their content
+ * without looking at it.
+ *
+ * Input may arrive incrementally, e.g. block by block over CoAP. If an item
+ * is not complete yet, the functions return -EAGAIN and leave the cursor
+ * unchanged. Add the next buffer to the vector and call cbor_reader_feed(),
+ * or append the next snip to the packet, and call the function again.
+ *
+ * A typical loop over the map of a telemetry batch looks like:
+ * @code
+ * cbor_item_t item;
+ *
+ * cbor_reader_next(&reader, &item);          // the map, item.val pairs
+ * for (uint64_t i = 0; i < item.val; i++) {
+ *     uint64_t key;
+ *     int64_t value;
+ *
+ *     cbor_reader_uint(&reader, &key);
+ *     if (key == WANTED) {
+ *         cbor_reader_int(&reader, &value);
+ *     }
+ *     else {
+ *         cbor_reader_skip(&reader);
+ *     }
+ * }
+ * @endcode
+ *
+ * None of the functions allocate memory, the reader and the writer consist
+ * of a cursor only.
+ */
+
+#ifndef CBOR_CHAIN_H
+#define CBOR_CHAIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#ifdef MODULE_GNRC_PKT
+#include "net/gnrc/pkt.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum nesting of containers cbor_reader_skip() handles
+ */
+#ifndef CBOR_CHAIN_DEPTH_MAX
+#define CBOR_CHAIN_DEPTH_MAX        (8U)
+#endif
+
+/**
+ * @brief   Major types of CBOR items
+ */
+enum {
+    CBOR_MAJOR_UINT = 0,        /**< unsigned integer */
+    CBOR_MAJOR_NEGINT,          /**< negative integer */
+    CBOR_MAJOR_BYTES,           /**< byte string */
+    CBOR_MAJOR_TEXT,            /**< text string */
+    CBOR_MAJOR_ARRAY,           /**< array */
+    CBOR_MAJOR_MAP,             /**< map */
+    CBOR_MAJOR_TAG,             /**< semantic tag */
+    CBOR_MAJOR_SIMPLE,          /**< simple value, float, or break */
+};
+
+/**
+ * @brief   Additional information of an indefinite length or a break
+ */
+#define CBOR_INFO_INDEFINITE        (31U)
+
+/**
+ * @brief   The head of an item
+ */
+typedef struct {
+    uint8_t type;   /**< the major type, CBOR_MAJOR_UINT... */
+    uint8_t info;   /**< the additional information of the initial byte,
+                     *   CBOR_INFO_INDEFINITE for indefinite lengths */
+    uint64_t val;   /**< the value of an integer, the length of a string,
+                     *   the number of items of an array, the number of
+                     *   pairs of a map, the number of a tag, the simple
+                     *   value, or the bits of a float */
+} cbor_item_t;
+
+/**
+ * @brief   Position in a chain of buffers
+ *
+ * The buffers are the elements of a vector or the snips of a packet.
+ */
+typedef struct {
+    const void *buf;                /**< the next element of the vector, or
+                                     *   the current snip of the packet */
+    const struct iovec *vec_end;    /**< end of the vector */
+    uint8_t *pos;                   /**< position in the current buffer */
+    uint8_t *end;                   /**< end of the current buffer */
+    bool pkt;                       /**< the buffers are snips of a packet */
+} cbor_cursor_t;
+
+/**
+ * @brief   Pull parser
+ */
+typedef struct {
+    cbor_cursor_t cur;              /**< the position of the next item */
+} cbor_reader_t;
+
+/**
+ * @brief   Encoder
+ */
+typedef struct {
+    cbor_cursor_t cur;              /**< the position of the next item */
+    size_t avail;                   /**< free space behind the cursor */
+    size_t len;                     /**< bytes written so far */
+} cbor_writer_t;
+
+/**
+ * @brief   Initializes a reader for a vector of buffers
+ *
+ * @param[out] reader   the reader
+ * @param[in] vec       the buffers, they must stay valid until the reader
+ *                      moved past them
+ * @param[in] count     number of buffers in @p vec, may be 0
+ */
+void cbor_reader_init(cbor_reader_t *reader, const struct iovec *vec,
+                      size_t count);
+
+#if defined(MODULE_GNRC_PKT) || defined(DOXYGEN)
+/**
+ * @brief   Initializes a reader for the payload of a packet
+ *
+ * Snips that are appended to the chain later are read as well.
+ *
+ * @param[out] reader   the reader
+ * @param[in] pkt       the first snip
+ */
+void cbor_reader_init_pkt(cbor_reader_t *reader, const gnrc_pktsnip_t *pkt);
+#endif
+
+/**
+ * @brief   Announces buffers that were appended to the vector of a reader
+ *
+ * @param[in,out] reader    the reader
+ * @param[in] count         number of appended buffers
+ */
+void cbor_reader_feed(cbor_reader_t *reader, size_t count);
+
+/**
+ * @brief   Gets the head of the next item without moving the cursor
+ *
+ * @param[in] reader    the reader
+ * @param[out] item     the head of the item
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the head
+ * @return  -EBADMSG, if the head is malformed
+ */
+int cbor_reader_peek(const cbor_reader_t *reader, cbor_item_t *item);
+
+/**
+ * @brief   Gets the head of the next item and moves the cursor past it
+ *
+ * For a definite string, the cursor is at its content then, read it with
+ * cbor_reader_read(). Items of a container or a tag follow its head.
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] item         the head of the item
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the head
+ * @return  -EBADMSG, if the head is malformed
+ */
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item);
+
+/**
+ * @brief   Reads raw bytes, e.g. the content of a string
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] buf          buffer for the bytes, may be NULL to skip them
+ * @param[in] len           number of bytes
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before @p len bytes
+ */
+int cbor_reader_read(cbor_reader_t *reader, void *buf, size_t len);
+
+/**
+ * @brief   Skips the next item, including the items of containers and
+ *          tags
+ *
+ * The content of definite strings is skipped by their length, only the
+ * heads of items are decoded.
+ *
+ * @param[in,out] reader    the reader
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the end of the item
+ * @return  -EBADMSG, if the item is malformed
+ * @return  -ENOTSUP, if the containers are nested deeper than
+ *          CBOR_CHAIN_DEPTH_MAX
+ */
+int cbor_reader_skip(cbor_reader_t *reader);
+
+/**
+ * @brief   Reads an unsigned integer
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] val          the integer
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the item
+ * @return  -EBADMSG, if the next item is no unsigned integer
+ */
+int cbor_reader_uint(cbor_reader_t *reader, uint64_t *val);
+
+/**
+ * @brief   Reads an integer
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] val          the integer
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the item
+ * @return  -EBADMSG, if the next item is no integer
+ * @return  -ERANGE, if the integer does not fit into @p val
+ */
+int cbor_reader_int(cbor_reader_t *reader, int64_t *val);
+
+/**
+ * @brief   Reads a definite byte or text string
+ *
+ * The string is not terminated.
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] buf          buffer for the string
+ * @param[in,out] len       size of @p buf, the length of the string on
+ *                          return
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the end of the string
+ * @return  -EBADMSG, if the next item is no definite string
+ * @return  -ENOBUFS, if @p buf is too small, the string is not consumed
+ */
+int cbor_reader_string(cbor_reader_t *reader, void *buf, size_t *len);
+
+/**
+ * @brief   Reads a boolean
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] val          the boolean
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the item
+ * @return  -EBADMSG, if the next item is no boolean
+ */
+int cbor_reader_bool(cbor_reader_t *reader, bool *val);
+
+#if !defined(CBOR_NO_FLOAT) || defined(DOXYGEN)
+/**
+ * @brief   Reads a half, single, or double precision float
+ *
+ * @param[in,out] reader    the reader
+ * @param[out] val          the float
+ *
+ * @return  0 on success
+ * @return  -EAGAIN, if the input ends before the item
+ * @return  -EBADMSG, if the next item is no float
+ */
+int cbor_reader_double(cbor_reader_t *reader, double *val);
+#endif
+
+/**
+ * @brief   Initializes a writer for a vector of buffers
+ *
+ * The buffers are filled one after the other.
+ *
+ * @param[out] writer   the writer
+ * @param[in] vec       the buffers
+ * @param[in] count     number of buffers in @p vec
+ */
+void cbor_writer_init(cbor_writer_t *writer, const struct iovec *vec,
+                      size_t count);
+
+#if defined(MODULE_GNRC_PKT) || defined(DOXYGEN)
+/**
+ * @brief   Initializes a writer for the payload of a packet
+ *
+ * @param[out] writer   the writer
+ * @param[in] pkt       the first snip, the snips must not be shared
+ */
+void cbor_writer_init_pkt(cbor_writer_t *writer, gnrc_pktsnip_t *pkt);
+#endif
+
+/**
+ * @brief   Gets the number of bytes written so far
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  the number of bytes
+ */
+static inline size_t cbor_writer_len(const cbor_writer_t *writer)
+{
+    return writer->len;
+}
+
+/**
+ * @brief   Writes the head of an item
+ *
+ * The other functions of the writer are based on this one. Use it for
+ * containers, with the number of items or pairs in @p val, or for tags.
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] type          the major type
+ * @param[in] val           the value of the head
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full, nothing is written then
+ */
+int cbor_writer_head(cbor_writer_t *writer, uint8_t type, uint64_t val);
+
+/**
+ * @brief   Writes the head of an indefinite string or container
+ *
+ * Terminate its items with cbor_writer_break().
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] type          the major type
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+int cbor_writer_indefinite(cbor_writer_t *writer, uint8_t type);
+
+/**
+ * @brief   Writes the break that ends an indefinite item
+ *
+ * @param[in,out] writer    the writer
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+int cbor_writer_break(cbor_writer_t *writer);
+
+/**
+ * @brief   Writes an unsigned integer
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] val           the integer
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+static inline int cbor_writer_uint(cbor_writer_t *writer, uint64_t val)
+{
+    return cbor_writer_head(writer, CBOR_MAJOR_UINT, val);
+}
+
+/**
+ * @brief   Writes an integer
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] val           the integer
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+static inline int cbor_writer_int(cbor_writer_t *writer, int64_t val)
+{
+    if (val < 0) {
+        /* -1 - val without overflow for INT64_MIN */
+        return cbor_writer_head(writer, CBOR_MAJOR_NEGINT, ~(uint64_t)val);
+    }
+    return cbor_writer_head(writer, CBOR_MAJOR_UINT, (uint64_t)val);
+}
+
+/**
+ * @brief   Writes a byte or text string
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] type          CBOR_MAJOR_BYTES or CBOR_MAJOR_TEXT
+ * @param[in] buf           the string
+ * @param[in] len           length of @p buf
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full, nothing is written then
+ */
+int cbor_writer_string(cbor_writer_t *writer, uint8_t type, const void *buf,
+                       size_t len);
+
+/**
+ * @brief   Writes a boolean
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] val           the boolean
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+static inline int cbor_writer_bool(cbor_writer_t *writer, bool val)
+{
+    return cbor_writer_head(writer, CBOR_MAJOR_SIMPLE, val ? 21 : 20);
+}
+
+#if !defined(CBOR_NO_FLOAT) || defined(DOXYGEN)
+/**
+ * @brief   Writes a single precision float
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] val           the float
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+int cbor_writer_float(cbor_writer_t *writer, float val);
+
+/**
+ * @brief   Writes a double precision float
+ *
+ * @param[in,out] writer    the writer
+ * @param[in] val           the float
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the buffers are full
+ */
+int cbor_writer_double(cbor_writer_t *writer, double val);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CBOR_CHAIN_H */
+/** @} */
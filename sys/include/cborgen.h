@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cbor
+ * @{
+ *
+ * @file
+ * @brief       Helpers for the CBOR codecs generated by cborgen
+ *
+ * dist/tools/cborgen/cborgen.py compiles a schema of fixed records, e.g. a
+ * phydat_t with a timestamp, into an encoder and a decoder per record. Each
+ * field is encoded with a head of fixed width, so every field has a fixed
+ * offset and the record a fixed size. The generated code then consists of
+ * the stores of the constant heads and the functions below, with one bounds
+ * check per record instead of one per field.
+ *
+ * Fixed widths are valid CBOR, but not the shortest encoding: uint32 fields
+ * always take 5 bytes. The generated decoders accept exactly this layout.
+ * Use the functions of cbor.h or cbor_chain.h for records of other encoders.
+ *
+ * Signed integers are encoded without branches: the sign selects the major
+ * type by a mask and the value is stored as `val ^ mask`, which is the
+ * argument of a negative integer (-1 - val) for negative values.
+ */
+
+#ifndef CBORGEN_H
+#define CBORGEN_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Heads of the fixed width items
+ * @{
+ */
+#define CBORGEN_UINT8           (0x18)  /**< unsigned, 1 byte follows */
+#define CBORGEN_UINT16          (0x19)  /**< unsigned, 2 bytes follow */
+#define CBORGEN_UINT32          (0x1a)  /**< unsigned, 4 bytes follow */
+#define CBORGEN_UINT64          (0x1b)  /**< unsigned, 8 bytes follow */
+#define CBORGEN_NEGATIVE        (0x20)  /**< turns the above into negative */
+#define CBORGEN_FALSE           (0xf4)  /**< false, true is CBORGEN_FALSE | 1 */
+#define CBORGEN_FLOAT32         (0xfa)  /**< single precision float */
+/** @} */
+
+/**
+ * @name    Big endian stores and loads
+ * @{
+ */
+static inline void cborgen_put_be16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = (uint8_t)(val >> 8);
+    buf[1] = (uint8_t)val;
+}
+
+static inline void cborgen_put_be32(uint8_t *buf, uint32_t val)
+{
+    buf[0] = (uint8_t)(val >> 24);
+    buf[1] = (uint8_t)(val >> 16);
+    buf[2] = (uint8_t)(val >> 8);
+    buf[3] = (uint8_t)val;
+}
+
+static inline void cborgen_put_be64(uint8_t *buf, uint64_t val)
+{
+    cborgen_put_be32(buf, (uint32_t)(val >> 32));
+    cborgen_put_be32(&buf[4], (uint32_t)val);
+}
+
+static inline uint16_t cborgen_get_be16(const uint8_t *buf)
+{
+    return (uint16_t)((buf[0] << 8) | buf[1]);
+}
+
+static inline uint32_t cborgen_get_be32(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+           ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+static inline uint64_t cborgen_get_be64(const uint8_t *buf)
+{
+    return ((uint64_t)cborgen_get_be32(buf) << 32) | cborgen_get_be32(&buf[4]);
+}
+/** @} */
+
+/**
+ * @brief   Defines the encoder and the decoder of integers of a width
+ *
+ * The decoders expect the head to be checked by the caller, for signed
+ * integers also that the most significant bit of the argument is clear.
+ */
+#define CBORGEN_INTEGER(bits, store, load, head)                              \
+    static inline void cborgen_put_uint ## bits(uint8_t *buf,                 \
+                                                uint ## bits ## _t val)       \
+    {                                                                         \
+        buf[0] = head;                                                        \
+        store;                                                                \
+    }                                                                         \
+    static inline uint ## bits ## _t cborgen_get_uint ## bits(                \
+        const uint8_t *buf)                                                   \
+    {                                                                         \
+        return (uint ## bits ## _t)load;                                      \
+    }                                                                         \
+    static inline void cborgen_put_int ## bits(uint8_t *buf,                  \
+                                               int ## bits ## _t sval)        \
+    {                                                                         \
+        uint ## bits ## _t mask = (uint ## bits ## _t)-(sval < 0);            \
+        uint ## bits ## _t val = (uint ## bits ## _t)sval ^ mask;             \
+        buf[0] = head | (mask & CBORGEN_NEGATIVE);                            \
+        store;                                                                \
+    }                                                                         \
+    static inline int ## bits ## _t cborgen_get_int ## bits(                  \
+        const uint8_t *buf)                                                   \
+    {                                                                         \
+        uint ## bits ## _t mask = (uint ## bits ## _t)                        \
+                                  -((buf[0] & CBORGEN_NEGATIVE) != 0);        \
+        return (int ## bits ## _t)((uint ## bits ## _t)load ^ mask);          \
+    }
+
+/**
+ * @name    Encoders and decoders of integers
+ * @{
+ */
+CBORGEN_INTEGER(8, buf[1] = val, buf[1], CBORGEN_UINT8)
+CBORGEN_INTEGER(16, cborgen_put_be16(&buf[1], val), cborgen_get_be16(&buf[1]),
+                CBORGEN_UINT16)
+CBORGEN_INTEGER(32, cborgen_put_be32(&buf[1], val), cborgen_get_be32(&buf[1]),
+                CBORGEN_UINT32)
+CBORGEN_INTEGER(64, cborgen_put_be64(&buf[1], val), cborgen_get_be64(&buf[1]),
+                CBORGEN_UINT64)
+/** @} */
+
+/**
+ * @name    Encoder and decoder of single precision floats
+ * @{
+ */
+static inline void cborgen_put_float(uint8_t *buf, float val)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &val, sizeof(bits));
+    buf[0] = CBORGEN_FLOAT32;
+    cborgen_put_be32(&buf[1], bits);
+}
+
+static inline float cborgen_get_float(const uint8_t *buf)
+{
+    uint32_t bits = cborgen_get_be32(&buf[1]);
+    float val;
+
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CBORGEN_H */
+/** @} */
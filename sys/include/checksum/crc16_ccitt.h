@@ -17,6 +17,10 @@
  *              crc16_ccitt_update() with the desired start value
  *              instead of crc16_ccitt_calc().
  *
+ *              crc16_ccitt_kermit_update() processes the bits of each byte
+ *              in reverse order, as the frame check sequence of
+ *              IEEE 802.15.4 does.
+ *
  * @{
  * @file
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
@@ -32,6 +36,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of bytes crc16_ccitt_update() processes per step: 1, 4, or 8
+ *
+ * Every byte takes a lookup table of 512 bytes.
+ */
+#ifndef CRC16_CCITT_SLICES
+#define CRC16_CCITT_SLICES      (4)
+#endif
+
 /**
  * @brief           Update CRC16-CCITT
  *
@@ -56,6 +69,37 @@ uint16_t crc16_ccitt_update(uint16_t crc, const unsigned char *buf, size_t len);
  */
 uint16_t crc16_ccitt_calc(const unsigned char *buf, size_t len);
 
+/**
+ * @brief           Update CRC16-CCITT with reflected bit order (KERMIT)
+ *
+ * The least significant bit of every byte is processed first. Over an
+ * IEEE 802.15.4 frame that includes its frame check sequence the result is 0.
+ *
+ * @param[in]  crc  A start value for the CRC calculation, usually the
+ *                  return value of a previous call to
+ *                  crc16_ccitt_kermit_calc() or crc16_ccitt_kermit_update()
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area based on the
+ *                  given start value
+ */
+uint16_t crc16_ccitt_kermit_update(uint16_t crc, const unsigned char *buf,
+                                   size_t len);
+
+/**
+ * @brief           Calculate CRC16-CCITT with reflected bit order (KERMIT)
+ *
+ * The start value is 0. The result is the frame check sequence of an
+ * IEEE 802.15.4 frame, which is sent least significant byte first.
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+uint16_t crc16_ccitt_kermit_calc(const unsigned char *buf, size_t len);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32 CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 checksum algorithm
+ * @details     The CRC32 of IEEE 802.3 and zlib, with the reflected
+ *              polynomial 0xEDB88320, a start value of 0xFFFFFFFF, and an
+ *              inverted result.
+ *
+ * @{
+ * @file
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bytes crc32_update() processes per step: 1, 4, or 8
+ *
+ * Every byte takes a lookup table of 1024 bytes.
+ */
+#ifndef CRC32_SLICES
+#define CRC32_SLICES            (4)
+#endif
+
+/**
+ * @brief           Update CRC32
+ *
+ * @param[in]  crc  The return value of a previous call to crc32_calc() or
+ *                  crc32_update(), 0 to start a new checksum
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of all memory areas so far
+ */
+uint32_t crc32_update(uint32_t crc, const unsigned char *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+uint32_t crc32_calc(const unsigned char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_H */
+
+/** @} */
@@ -50,6 +50,7 @@ typedef uint8_t u8;
 #define AES_MAXNR         14
 #define AES_BLOCK_SIZE    16
 #define AES_KEY_SIZE      16
+#define AES_ROUNDS        10    /**< rounds for AES_KEY_SIZE */
 
 /**
  * @brief AES key
@@ -64,6 +65,15 @@ struct aes_key_st {
 
 typedef struct aes_key_st AES_KEY;
 
+/**
+ * @brief   Expanded keys that aes_init() stores in the cipher_context_t if
+ *          CRYPTO_AES_KEY_SCHEDULE is defined
+ */
+typedef struct {
+    uint32_t enc[4 * (AES_ROUNDS + 1)];     /**< encryption key schedule */
+    uint32_t dec[4 * (AES_ROUNDS + 1)];     /**< decryption key schedule */
+} aes_key_schedule_t;
+
 /**
  * @brief the cipher_context_t-struct adapted for AES
  */
@@ -122,6 +132,39 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts num consecutive blocks, the key is expanded only once
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       plain_blocks  a pointer to num plaintext-blocks
+ * @param       cipher_blocks a pointer to the place where the ciphertext will
+ *                            be stored
+ * @param       num           number of blocks
+ *
+ * @return  1 or result of aes_set_encrypt_key if it failed
+ */
+int aes_encrypt_blocks(const cipher_context_t *context,
+                       const uint8_t *plain_blocks, uint8_t *cipher_blocks,
+                       size_t num);
+
+/**
+ * @brief   decrypts num consecutive blocks, the key is expanded only once
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       cipher_blocks a pointer to num ciphertext-blocks
+ * @param       plain_blocks  a pointer to the place where the decrypted
+ *                            plaintext will be stored
+ * @param       num           number of blocks
+ *
+ * @return  1 or negative value if cipher key cannot be expanded into
+ *          decryption key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context,
+                       const uint8_t *cipher_blocks, uint8_t *plain_blocks,
+                       size_t num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,24 @@
 extern "C" {
 #endif
 
+/* four blocks of the keystream are computed in parallel on native if the
+ * compiler may emit SSE2 instructions */
+#if defined(CPU_NATIVE) && defined(__SSE2__)
+#define CHACHA_SSE2
+#endif
+
+/**
+ * @brief   Number of keystream blocks users should request at once from
+ *          chacha_keystream_blocks()
+ */
+#ifndef CHACHA_BATCH_BLOCKS
+#ifdef CHACHA_SSE2
+#define CHACHA_BATCH_BLOCKS     (4U)
+#else
+#define CHACHA_BATCH_BLOCKS     (1U)
+#endif
+#endif
+
 /**
  * @brief A ChaCha cipher stream context.
  * @details Initialize with chacha_init().
@@ -82,6 +100,21 @@ int chacha_init(chacha_ctx *ctx,
  */
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
 
+/**
+ * @brief Generate the next blocks in the keystream.
+ *
+ * @details The same as calling chacha_keystream_bytes() @p num times, but
+ *          faster where several blocks are computed in parallel.
+ *
+ * @warning You need to re-initialized the context with a new nonce after 2^64
+ *          encrypted blocks, or the keystream will repeat!
+ *
+ * @param[in,out] ctx The ChaCha context
+ * @param[out]    x   The blocks of the keystream (`sizeof(x) == 64 * num`).
+ * @param[in]     num Number of blocks.
+ */
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t num);
+
 /**
  * @brief Encode or decode a block of data.
  *
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 authenticated encryption with associated data
+ * @see <a href="https://tools.ietf.org/html/rfc7539#section-2.8">
+ *          RFC 7539, section 2.8, AEAD Construction
+ *      </a>
+ *
+ * Unlike chacha_init(), this uses the 96 bit nonce and the 32 bit block
+ * counter of RFC 7539. A nonce must never be used twice with the same key.
+ */
+
+#ifndef CRYPTO_CHACHA20POLY1305_H_
+#define CRYPTO_CHACHA20POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a key in bytes
+ */
+#define CHACHA20POLY1305_KEY_SIZE       (32U)
+
+/**
+ * @brief   Size of a nonce in bytes
+ */
+#define CHACHA20POLY1305_NONCE_SIZE     (12U)
+
+/**
+ * @brief   Size of the tag that is appended to the ciphertext in bytes
+ */
+#define CHACHA20POLY1305_TAG_SIZE       (16U)
+
+/**
+ * @brief   Encrypts and authenticates a message
+ *
+ * @param[out] cipher   the ciphertext followed by the tag, of
+ *                      @p msg_len + CHACHA20POLY1305_TAG_SIZE bytes. May be
+ *                      equal to @p msg.
+ * @param[in] msg       the plaintext
+ * @param[in] msg_len   length of @p msg
+ * @param[in] aad       the associated data that is authenticated only
+ * @param[in] aad_len   length of @p aad
+ * @param[in] key       the key of CHACHA20POLY1305_KEY_SIZE bytes
+ * @param[in] nonce     the nonce of CHACHA20POLY1305_NONCE_SIZE bytes
+ */
+void chacha20poly1305_encrypt(uint8_t *cipher, const uint8_t *msg,
+                              size_t msg_len, const uint8_t *aad,
+                              size_t aad_len, const uint8_t *key,
+                              const uint8_t *nonce);
+
+/**
+ * @brief   Verifies and decrypts a message
+ *
+ * Nothing is decrypted if the tag does not match.
+ *
+ * @param[in] cipher        the ciphertext followed by the tag
+ * @param[in] cipher_len    length of @p cipher, including the tag
+ * @param[out] msg          the plaintext, of
+ *                          @p cipher_len - CHACHA20POLY1305_TAG_SIZE bytes.
+ *                          May be equal to @p cipher.
+ * @param[out] msg_len      length of the plaintext
+ * @param[in] aad           the associated data
+ * @param[in] aad_len       length of @p aad
+ * @param[in] key           the key of CHACHA20POLY1305_KEY_SIZE bytes
+ * @param[in] nonce         the nonce of CHACHA20POLY1305_NONCE_SIZE bytes
+ *
+ * @return  1, if the tag is valid
+ * @return  0, if the tag is invalid or @p cipher_len is shorter than the tag
+ */
+int chacha20poly1305_decrypt(const uint8_t *cipher, size_t cipher_len,
+                             uint8_t *msg, size_t *msg_len,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *key, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_CHACHA20POLY1305_H_ */
+/** @} */
@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H_
 #define CRYPTO_CIPHERS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -46,11 +47,15 @@ extern "C" {
  * Context sizes needed for the different ciphers.
  * Always order by number of bytes descending!!! <br><br>
  *
+ * aes          needs 352 bytes for the expanded keys with
+ *              CRYPTO_AES_KEY_SCHEDULE                   <br>
  * threedes     needs 24  bytes                           <br>
  * aes          needs CIPHERS_MAX_KEY_SIZE bytes          <br>
  * twofish      needs CIPHERS_MAX_KEY_SIZE bytes          <br>
  */
-#if defined(CRYPTO_THREEDES)
+#if defined(CRYPTO_AES_KEY_SCHEDULE)
+    #define CIPHER_MAX_CONTEXT_SIZE 352
+#elif defined(CRYPTO_THREEDES)
     #define CIPHER_MAX_CONTEXT_SIZE 24
 #elif defined(CRYPTO_AES)
     #define CIPHER_MAX_CONTEXT_SIZE CIPHERS_MAX_KEY_SIZE
@@ -73,10 +78,22 @@ extern "C" {
  * @brief   the context for cipher-operations
  */
 typedef struct {
-    uint8_t context[CIPHER_MAX_CONTEXT_SIZE];  /**< buffer for cipher operations */
+    /** buffer for cipher operations, aligned for ciphers that store words */
+    uint8_t context[CIPHER_MAX_CONTEXT_SIZE] __attribute__((aligned(4)));
 } cipher_context_t;
 
 
+/**
+ * @brief   Callback for asynchronous cipher operations
+ *
+ * May be called in interrupt context.
+ *
+ * @param arg   argument given when the operation was started
+ * @param res   1 on success, a negative value on error
+ */
+typedef void (*cipher_cb_t)(void *arg, int res);
+
+
 /**
  * @brief   BlockCipher-Interface for the Cipher-Algorithms
  */
@@ -97,6 +114,28 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /** encrypts several consecutive blocks, NULL if not supported */
+    int (*encrypt_blocks)(const cipher_context_t* ctx, const uint8_t* plain_blocks,
+                          uint8_t* cipher_blocks, size_t num);
+
+    /** decrypts several consecutive blocks, NULL if not supported */
+    int (*decrypt_blocks)(const cipher_context_t* ctx, const uint8_t* cipher_blocks,
+                          uint8_t* plain_blocks, size_t num);
+
+    /** starts encrypting several consecutive blocks, e.g. by DMA, NULL if
+     *  not supported */
+    int (*encrypt_blocks_async)(const cipher_context_t* ctx,
+                                const uint8_t* plain_blocks,
+                                uint8_t* cipher_blocks, size_t num,
+                                cipher_cb_t cb, void* arg);
+
+    /** starts decrypting several consecutive blocks, e.g. by DMA, NULL if
+     *  not supported */
+    int (*decrypt_blocks_async)(const cipher_context_t* ctx,
+                                const uint8_t* cipher_blocks,
+                                uint8_t* plain_blocks, size_t num,
+                                cipher_cb_t cb, void* arg);
 } cipher_interface_t;
 
 
@@ -107,6 +146,25 @@ extern const cipher_id_t CIPHER_AES_128;
 extern const cipher_id_t CIPHER_TWOFISH;
 
 
+/**
+ * @brief   Hardware backend of a cipher
+ *
+ * A driver for a crypto accelerator registers one backend per cipher it
+ * implements. cipher_init() uses the most recently registered backend of a
+ * cipher whose init function succeeds and falls back to the software
+ * implementation otherwise, e.g. if the accelerator does not support the key
+ * size.
+ *
+ * The context of the backend has to fit into a cipher_context_t.
+ */
+typedef struct cipher_hw {
+    struct cipher_hw* next;                 /**< next registered backend */
+    cipher_id_t cipher;                     /**< the software cipher that is
+                                                 replaced */
+    const cipher_interface_t* interface;    /**< the interface of the driver */
+} cipher_hw_t;
+
+
 /**
  * @brief basic struct for using block ciphers
  *        contains the cipher interface and the context
@@ -119,9 +177,32 @@ typedef struct {
 } cipher_t;
 
 
+/**
+ * @brief Register a hardware backend
+ *
+ * Backends have to be registered before the first call of cipher_init() for
+ * their cipher, usually when the driver of the accelerator is initialized.
+ *
+ * @param hw         the backend, it must not be registered yet
+ */
+void cipher_hw_register(cipher_hw_t* hw);
+
+
+/**
+ * @brief Remove a hardware backend
+ *
+ * Ciphers that were initialized with the backend keep using it.
+ *
+ * @param hw         the backend
+ */
+void cipher_hw_unregister(cipher_hw_t* hw);
+
+
 /**
  * @brief Initialize new cipher state
  *
+ * A registered hardware backend of the cipher is used if there is one.
+ *
  * @param cipher     cipher struct to init (already allocated memory)
  * @param cipher_id  cipher algorithm id
  * @param key        encryption key to use
@@ -155,6 +236,86 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output);
 
 
+/**
+ * @brief Encrypt several consecutive blocks
+ *
+ * Ciphers that have no multi-block function encrypt the blocks one by one.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p num blocks of input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size @p num * BLOCK_SIZE
+ * @param num        number of blocks
+ *
+ * @return  1 on success, a negative value on error
+ */
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t num);
+
+
+/**
+ * @brief Decrypt several consecutive blocks
+ *
+ * Ciphers that have no multi-block function decrypt the blocks one by one.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p num blocks of input data to decrypt
+ * @param output     pointer to allocated memory for decrypted data. It has to
+ *                   be of size @p num * BLOCK_SIZE
+ * @param num        number of blocks
+ *
+ * @return  1 on success, a negative value on error
+ */
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t num);
+
+
+/**
+ * @brief Start encrypting several consecutive blocks
+ *
+ * Backends that support it process the blocks in the background, e.g. by
+ * DMA, and call @p cb when they are done. All other ciphers encrypt the
+ * blocks before this function returns and call @p cb from it.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p num blocks of input data to encrypt, it has
+ *                   to stay valid until @p cb is called
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size @p num * BLOCK_SIZE
+ * @param num        number of blocks
+ * @param cb         called with the result when the operation is finished
+ * @param arg        argument for @p cb
+ *
+ * @return  0 if the operation was started, @p cb is called exactly once then
+ * @return  a negative value if it could not be started, @p cb is not called
+ */
+int cipher_encrypt_blocks_async(const cipher_t* cipher, const uint8_t* input,
+                                uint8_t* output, size_t num, cipher_cb_t cb,
+                                void* arg);
+
+
+/**
+ * @brief Start decrypting several consecutive blocks
+ *
+ * See cipher_encrypt_blocks_async().
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p num blocks of input data to decrypt, it has
+ *                   to stay valid until @p cb is called
+ * @param output     pointer to allocated memory for decrypted data. It has to
+ *                   be of size @p num * BLOCK_SIZE
+ * @param num        number of blocks
+ * @param cb         called with the result when the operation is finished
+ * @param arg        argument for @p cb
+ *
+ * @return  0 if the operation was started, @p cb is called exactly once then
+ * @return  a negative value if it could not be started, @p cb is not called
+ */
+int cipher_decrypt_blocks_async(const cipher_t* cipher, const uint8_t* input,
+                                uint8_t* output, size_t num, cipher_cb_t cb,
+                                void* arg);
+
+
 /**
  * @brief Get block size of cipher
  * *
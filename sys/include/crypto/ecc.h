@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Common interface for ECDSA and ECDH
+ *
+ * The elliptic curve cryptography of the packages micro-ecc and relic is
+ * available through this interface as a backend each, ecc_uecc (module
+ * ecc_uecc) and ecc_relic (module ecc_relic). Both can be used in the same
+ * application.
+ *
+ * All backends use the same encodings:
+ * - a private key is a big-endian number of ecc_curve_size() bytes,
+ * - a public key is the uncompressed point X || Y without a prefix byte,
+ * - a signature is the pair r || s,
+ * - a shared secret is the X coordinate of the shared point.
+ *
+ * A public key that is used to verify many signatures, like the key that
+ * signs firmware updates, is best wrapped in an ecc_pubkey_t. Backends that
+ * support it precompute a table of multiples of the key then, which turns
+ * the most expensive part of a verification into a fixed-base
+ * multiplication.
+ */
+
+#ifndef CRYPTO_ECC_H_
+#define CRYPTO_ECC_H_
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Largest size of a private key, a shared secret, or a coordinate
+ *          in bytes
+ */
+#define ECC_SIZE_MAX                (32U)
+
+/**
+ * @brief   Largest size of a public key or a signature in bytes
+ */
+#define ECC_PUBLIC_KEY_SIZE_MAX     (2 * ECC_SIZE_MAX)
+
+/**
+ * @brief   Supported curves
+ */
+typedef enum {
+    ECC_SECP192R1,              /**< NIST P-192 */
+    ECC_SECP224R1,              /**< NIST P-224 */
+    ECC_SECP256R1,              /**< NIST P-256 */
+    ECC_SECP256K1,              /**< the Koblitz curve of SEC 2 */
+    ECC_CURVE_NUMOF             /**< number of curves */
+} ecc_curve_t;
+
+typedef struct ecc_pubkey ecc_pubkey_t;
+
+/**
+ * @brief   Operations of a backend
+ *
+ * The operations return 0 on success, -EINVAL for an invalid key and
+ * -ENOTSUP for a curve the backend does not support. Verifications return
+ * -EBADMSG for an invalid signature.
+ */
+typedef struct {
+    const char *name;           /**< name of the backend */
+    /** generates a key pair */
+    int (*make_key)(ecc_curve_t curve, uint8_t *pub, uint8_t *priv);
+    /** computes the ECDH shared secret */
+    int (*shared_secret)(ecc_curve_t curve, const uint8_t *pub,
+                         const uint8_t *priv, uint8_t *secret);
+    /** signs a hash */
+    int (*sign)(ecc_curve_t curve, const uint8_t *priv, const uint8_t *hash,
+                size_t hash_len, uint8_t *sig);
+    /** verifies the signature of a hash */
+    int (*verify)(ecc_curve_t curve, const uint8_t *pub, const uint8_t *hash,
+                  size_t hash_len, const uint8_t *sig);
+    /** precomputes the table of a public key, NULL if not supported */
+    int (*precompute)(ecc_pubkey_t *key);
+    /** verifies with a precomputed table, NULL if not supported */
+    int (*verify_pre)(const ecc_pubkey_t *key, const uint8_t *hash,
+                      size_t hash_len, const uint8_t *sig);
+    /** releases the table of a public key, NULL if not supported */
+    void (*release)(ecc_pubkey_t *key);
+} ecc_backend_t;
+
+/**
+ * @brief   A public key that verifies many signatures
+ */
+struct ecc_pubkey {
+    const ecc_backend_t *backend;       /**< the backend */
+    ecc_curve_t curve;                  /**< the curve of the key */
+    uint8_t pub[ECC_PUBLIC_KEY_SIZE_MAX];   /**< the key itself */
+    void *pre;                          /**< precomputed table of the
+                                         *   backend, NULL if there is none */
+};
+
+#if defined(MODULE_ECC_UECC) || defined(DOXYGEN)
+/**
+ * @brief   The micro-ecc backend, without precomputation
+ */
+extern const ecc_backend_t ecc_uecc;
+#endif
+
+#if defined(MODULE_ECC_RELIC) || defined(DOXYGEN)
+/**
+ * @brief   Number of public keys the relic backend precomputes tables for
+ */
+#ifndef ECC_RELIC_PRE_NUMOF
+#define ECC_RELIC_PRE_NUMOF         (1U)
+#endif
+
+/**
+ * @brief   The relic backend
+ *
+ * relic is configured for the size of a single prime field, see
+ * RELIC_CONFIG_FLAGS. Only the curves of that size are supported, e.g.
+ * ECC_SECP256R1 and ECC_SECP256K1 with -DFP_PRIME=256, all operations on
+ * other curves return -ENOTSUP. So do curves relic was built without, like
+ * ECC_SECP256K1 with -DEP_ENDOM=off. The backend initializes relic on first
+ * use.
+ */
+extern const ecc_backend_t ecc_relic;
+#endif
+
+/**
+ * @brief   Gets the size of a private key, a shared secret, or a coordinate
+ *          of a curve
+ *
+ * Public keys and signatures are twice as large.
+ *
+ * @param[in] curve     the curve
+ *
+ * @return  the size in bytes
+ */
+static inline size_t ecc_curve_size(ecc_curve_t curve)
+{
+    static const uint8_t sizes[] = { 24, 28, 32, 32 };
+
+    return sizes[curve];
+}
+
+/**
+ * @brief   Gets the name of a curve
+ *
+ * @param[in] curve     the curve
+ *
+ * @return  the name as in SEC 2
+ */
+static inline const char *ecc_curve_name(ecc_curve_t curve)
+{
+    static const char *const names[] = {
+        "secp192r1", "secp224r1", "secp256r1", "secp256k1"
+    };
+
+    return names[curve];
+}
+
+/**
+ * @brief   Generates a key pair
+ *
+ * @param[in] backend   the backend
+ * @param[in] curve     the curve
+ * @param[out] pub      the public key of 2 * ecc_curve_size() bytes
+ * @param[out] priv     the private key of ecc_curve_size() bytes
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p backend does not support @p curve
+ * @return  -EIO, if the backend failed, e.g. due to its random number
+ *          generator
+ */
+static inline int ecc_make_key(const ecc_backend_t *backend, ecc_curve_t curve,
+                               uint8_t *pub, uint8_t *priv)
+{
+    return backend->make_key(curve, pub, priv);
+}
+
+/**
+ * @brief   Computes the shared secret of ECDH
+ *
+ * @param[in] backend   the backend
+ * @param[in] curve     the curve
+ * @param[in] pub       the public key of the other side
+ * @param[in] priv      the own private key
+ * @param[out] secret   the shared secret of ecc_curve_size() bytes. Apply a
+ *                      key derivation function before using it as a key.
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p pub is not a point of @p curve
+ * @return  -ENOTSUP, if @p backend does not support @p curve
+ */
+static inline int ecc_shared_secret(const ecc_backend_t *backend,
+                                    ecc_curve_t curve, const uint8_t *pub,
+                                    const uint8_t *priv, uint8_t *secret)
+{
+    return backend->shared_secret(curve, pub, priv, secret);
+}
+
+/**
+ * @brief   Signs a hash with ECDSA
+ *
+ * @param[in] backend   the backend
+ * @param[in] curve     the curve
+ * @param[in] priv      the private key
+ * @param[in] hash      the hash of the message, it is truncated to the size
+ *                      of the curve
+ * @param[in] hash_len  length of @p hash
+ * @param[out] sig      the signature of 2 * ecc_curve_size() bytes
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p backend does not support @p curve
+ * @return  -EIO, if the backend failed
+ */
+static inline int ecc_sign(const ecc_backend_t *backend, ecc_curve_t curve,
+                           const uint8_t *priv, const uint8_t *hash,
+                           size_t hash_len, uint8_t *sig)
+{
+    return backend->sign(curve, priv, hash, hash_len, sig);
+}
+
+/**
+ * @brief   Verifies an ECDSA signature
+ *
+ * @param[in] backend   the backend
+ * @param[in] curve     the curve
+ * @param[in] pub       the public key of the signer
+ * @param[in] hash      the hash of the message
+ * @param[in] hash_len  length of @p hash
+ * @param[in] sig       the signature
+ *
+ * @return  0, if the signature is valid
+ * @return  -EBADMSG, if the signature is invalid
+ * @return  -EINVAL, if @p pub is not a point of @p curve
+ * @return  -ENOTSUP, if @p backend does not support @p curve
+ */
+static inline int ecc_verify(const ecc_backend_t *backend, ecc_curve_t curve,
+                             const uint8_t *pub, const uint8_t *hash,
+                             size_t hash_len, const uint8_t *sig)
+{
+    return backend->verify(curve, pub, hash, hash_len, sig);
+}
+
+/**
+ * @brief   Initializes a public key for repeated verifications
+ *
+ * If the backend supports it, a table of multiples of the key is
+ * precomputed. The tables come from a pool of the backend, release them with
+ * ecc_pubkey_release() when the key is no longer used.
+ *
+ * @param[out] key      the key to initialize
+ * @param[in] backend   the backend
+ * @param[in] curve     the curve
+ * @param[in] pub       the public key
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p pub is not a point of @p curve
+ * @return  -ENOTSUP, if @p backend does not support @p curve
+ * @return  -ENOMEM, if the pool of the backend is exhausted
+ */
+int ecc_pubkey_init(ecc_pubkey_t *key, const ecc_backend_t *backend,
+                    ecc_curve_t curve, const uint8_t *pub);
+
+/**
+ * @brief   Verifies an ECDSA signature with a public key of
+ *          ecc_pubkey_init()
+ *
+ * @param[in] key       the public key
+ * @param[in] hash      the hash of the message
+ * @param[in] hash_len  length of @p hash
+ * @param[in] sig       the signature
+ *
+ * @return  0, if the signature is valid
+ * @return  -EBADMSG, if the signature is invalid
+ */
+int ecc_pubkey_verify(const ecc_pubkey_t *key, const uint8_t *hash,
+                      size_t hash_len, const uint8_t *sig);
+
+/**
+ * @brief   Releases the precomputed table of a public key
+ *
+ * @param[in] key       the public key
+ */
+void ecc_pubkey_release(ecc_pubkey_t *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_ECC_H_ */
+/** @} */
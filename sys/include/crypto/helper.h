@@ -38,6 +38,20 @@ extern "C" {
 void crypto_block_inc_ctr(uint8_t block[16], int L);
 
 
+/**
+ * @brief   XORs two buffers of same size, word-wise if they are aligned.
+ *
+ * @p out may be equal to @p a or @p b.
+ *
+ * @param out   result
+ * @param a     buffer a
+ * @param b     buffer b
+ * @param len   size of all buffers
+ */
+void crypto_block_xor(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                      size_t len);
+
+
 /**
  * @brief   Compares two blocks of same size in deterministic time.
  *
@@ -26,6 +26,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of key stream blocks that are generated at once
+ *
+ * The buffers for the counter and the key stream blocks are allocated on the
+ * stack, so they take 2 * CIPHER_MAX_BLOCK_SIZE bytes per block.
+ */
+#ifndef CTR_BATCH_BLOCKS
+#define CTR_BATCH_BLOCKS    (4U)
+#endif
+
 /**
  * @brief Encrypt data of arbitrary length in counter mode.
  *
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 one-time authenticator
+ * @see <a href="https://tools.ietf.org/html/rfc7539#section-2.5">
+ *          RFC 7539, section 2.5, The Poly1305 Algorithm
+ *      </a>
+ *
+ * A key must only be used for a single message.
+ */
+
+#ifndef CRYPTO_POLY1305_H_
+#define CRYPTO_POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a Poly1305 key in bytes
+ */
+#define POLY1305_KEY_SIZE       (32U)
+
+/**
+ * @brief   Size of a Poly1305 tag in bytes
+ */
+#define POLY1305_TAG_SIZE       (16U)
+
+/**
+ * @brief   Poly1305 context
+ */
+typedef struct {
+    uint32_t r[5];          /**< the multiplier r, in 26 bit limbs */
+    uint32_t h[5];          /**< the accumulator, in 26 bit limbs */
+    uint32_t pad[4];        /**< the key s that is added in the end */
+    uint8_t buf[16];        /**< a partial block */
+    size_t buf_len;         /**< bytes in @p buf */
+} poly1305_ctx_t;
+
+/**
+ * @brief   Initializes a Poly1305 context
+ *
+ * @param[out] ctx  the context
+ * @param[in] key   the one-time key of POLY1305_KEY_SIZE bytes
+ */
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key);
+
+/**
+ * @brief   Adds data to the authenticated message
+ *
+ * @param[in,out] ctx   the context
+ * @param[in] data      the data
+ * @param[in] len       length of @p data
+ */
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Computes the tag and clears the context
+ *
+ * @param[in,out] ctx   the context
+ * @param[out] tag      the tag of POLY1305_TAG_SIZE bytes
+ */
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *tag);
+
+/**
+ * @brief   Computes the tag of a message
+ *
+ * @param[out] tag      the tag of POLY1305_TAG_SIZE bytes
+ * @param[in] data      the message
+ * @param[in] len       length of @p data
+ * @param[in] key       the one-time key of POLY1305_KEY_SIZE bytes
+ */
+void poly1305_auth(uint8_t *tag, const uint8_t *data, size_t len,
+                   const uint8_t *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_POLY1305_H_ */
+/** @} */
@@ -11,6 +11,14 @@
  * @ingroup     sys
  * @brief       Provides simple string formatting functions
  *
+ * The decimal conversions do not divide, they multiply with the reciprocal
+ * of 100 and write two digits at a time from a table. This is much faster
+ * than printf() on MCUs without a hardware divider.
+ *
+ * fmt_printf() and fmt_snprintf() implement the subset of printf() used by
+ * the shell and similar modules on top of these conversions, without
+ * pulling in the formatting code of the C library.
+ *
  * @{
  *
  * @file
@@ -22,6 +30,7 @@
 #ifndef FMT_H_
 #define FMT_H_
 
+#include <stdarg.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -29,6 +38,20 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Size of the buffer fmt_printf() collects its output in on the stack
+ */
+#ifndef FMT_PRINTF_BUFSIZE
+#define FMT_PRINTF_BUFSIZE  (64U)
+#endif
+
+/**
+ * @brief Maximum length of the output of fmt_float()
+ *
+ * Sign, 39 digits of FLT_MAX, the decimal point and 7 digits.
+ */
+#define FMT_FLOAT_MAXLEN    (48U)
+
 /**
  * @brief Format a byte value as hex
  *
@@ -187,6 +210,48 @@ size_t fmt_s16_dec(char *out, int16_t val);
  */
 size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits);
 
+/**
+ * @brief Convert 32-bit fixed point number to a decimal string
+ *
+ * Like fmt_s16_dfp(), e.g. @p val := -123456 and @p fp_digits := 3 result
+ * in "-123.456", @p val := 5 and @p fp_digits := 3 in "0.005".
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  val          Fixed point value
+ * @param[in]  fp_digits    Number of digits after the decimal point
+ *
+ * @return      Length of the resulting string
+ */
+size_t fmt_s32_dfp(char *out, int32_t val, unsigned fp_digits);
+
+/**
+ * @brief Format a float value with a fixed number of digits after the
+ *        decimal point
+ *
+ * Like printf("%.*f", precision, f), but without floating point arithmetic:
+ * the value is split into its integer part and a 64-bit binary fraction,
+ * which is rounded to @p precision digits. Values of 2^64 and above have
+ * no fraction and are written with all digits of their exact value.
+ *
+ * Writes "nan" and "inf" for the special values. At most
+ * @ref FMT_FLOAT_MAXLEN characters are written.
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  f            Value to convert
+ * @param[in]  precision    Number of digits after the decimal point, MUST
+ *                          be <= 7
+ *
+ * @return      Length of the resulting string
+ * @return      0 if @p precision is > 7
+ */
+size_t fmt_float(char *out, float f, unsigned precision);
+
 /**
  * @brief Count characters until '\0' (exclusive) in @p str
  *
@@ -275,6 +340,51 @@ void print_u64_dec(uint64_t val);
  */
 void print_str(const char* str);
 
+/**
+ * @brief Formatted output to a string, for a subset of printf()
+ *
+ * Supports the conversions d, i, u, o, x, X, c, s, p, % and f, the flags
+ * '-', '0', '+', ' ' and '#', widths and precisions including '*' and the
+ * length modifiers hh, h, l, ll, j, z and t. f converts the value to float
+ * and is limited to a precision of 7, see fmt_float(). At the first
+ * conversion not in this list, the rest of @p format is written as it is.
+ *
+ * @param[out] out      Output buffer, or NULL if @p size is 0
+ * @param[in]  size     Size of @p out, the output is truncated to
+ *                      @p size - 1 characters and always terminated
+ * @param[in]  format   printf() like format string
+ *
+ * @return      Number of characters the complete output has, without the
+ *              terminating '\0'
+ */
+int fmt_snprintf(char *out, size_t size, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Like fmt_snprintf(), with a va_list
+ */
+int fmt_vsnprintf(char *out, size_t size, const char *format, va_list args);
+
+/**
+ * @brief Formatted output to stdout, for the subset of printf() described
+ *        at fmt_snprintf()
+ *
+ * The output is collected in @ref FMT_PRINTF_BUFSIZE bytes on the stack and
+ * written with fwrite(), so it stays in order with the output of printf()
+ * and puts().
+ *
+ * @param[in]  format   printf() like format string
+ *
+ * @return      Number of characters written
+ */
+int fmt_printf(const char *format, ...)
+    __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Like fmt_printf(), with a va_list
+ */
+int fmt_vprintf(const char *format, va_list args);
+
 #ifdef __cplusplus
 }
 #endif
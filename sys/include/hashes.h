@@ -157,6 +157,38 @@ uint32_t rotating_hash(const uint8_t *buf, size_t len);
  */
 uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len);
 
+/**
+ * @brief MurmurHash3, 32 bit variant (MurmurHash3_x86_32)
+ *
+ * Unlike the hashes above it consumes the input a 32 bit word at a time and
+ * has a good avalanche behaviour, so different seeds yield independent hash
+ * functions of the same key. The words are read as little endian, the
+ * results are the same on all platforms.
+ *
+ * found on
+ * https://github.com/aappleby/smhasher
+ *
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @param seed seed of the hash
+ * @return 32 bit sized hash
+ */
+uint32_t murmur3_hash(const uint8_t *buf, size_t len, uint32_t seed);
+
+/**
+ * @brief Two MurmurHash3 hashes of the same buffer with different seeds
+ *
+ * Scans @p buf once, the results are equal to murmur3_hash() called with
+ * each of the seeds.
+ *
+ * @param[in] buf input buffer to hash
+ * @param[in] len length of buffer
+ * @param[in] seed the two seeds
+ * @param[out] hash the two 32 bit sized hashes
+ */
+void murmur3_hash_x2(const uint8_t *buf, size_t len, const uint32_t seed[2],
+                     uint32_t hash[2]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,7 @@
 #define _SHA256_H_
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -116,6 +117,23 @@ void sha256_final(sha256_context_t *ctx, uint8_t *dst);
  */
 unsigned char *sha256(const unsigned char *d, size_t n, unsigned char *md);
 
+/**
+ * @brief Computes the hashes of several independent messages
+ *
+ * The full blocks that two consecutive messages have in common are hashed in
+ * lockstep.  This only gains speed where the compression of two blocks can be
+ * interleaved, i.e. with the SHA extensions on native.  Elsewhere it is
+ * equivalent to calling sha256() for each message.
+ *
+ * @param[in] data      the messages
+ * @param[in] len       lengths of the messages
+ * @param[out] digests  buffers for the resulting digests, each of length
+ *                      SHA256_DIGEST_LENGTH
+ * @param[in] num       number of messages
+ */
+void sha256_multi(const uint8_t *const data[], const size_t len[],
+                  uint8_t *const digests[], size_t num);
+
 /**
  * @brief function to compute a hmac-sha256 from a given message
  *
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_binary Binary deferred logging
+ * @ingroup     sys
+ * @brief       Log module that formats messages on the host instead of the
+ *              device
+ *
+ * With `USEMODULE += log_binary`, LOG_*() do not format their messages.
+ * DEBUG() in files with ENABLE_DEBUG does the same if `LOG_BINARY_DEBUG` is
+ * defined, e.g. with `CFLAGS += -DLOG_BINARY_DEBUG`. They store the address of the format
+ * string and the raw arguments as a record in a ring buffer in RAM, which a
+ * thread of the lowest priority writes to stdout whenever the CPU is idle
+ * otherwise. A log call costs about as much as copying its arguments, so
+ * enabling logs changes the timing of the code much less than printf() does.
+ *
+ * dist/tools/log_binary/log_binary.py decodes the stream with the format
+ * strings from the ELF file of the application and passes all other output
+ * through.
+ *
+ * Writers claim space in the ring buffer with atomic_cas() and copy their
+ * record without masking interrupts, so LOG_*() can be called from any
+ * thread and from interrupt context. On CPUs without a native compare and
+ * swap, atomic_cas() masks interrupts for the compare and swap itself.
+ * Records that do not fit into the ring buffer are dropped and counted, the
+ * count is sent in place of them. Strings are copied into the record, up to
+ * @ref LOG_BINARY_STR_MAX characters.
+ *
+ * Stream format, every record starts with a marker outside of ASCII and its
+ * length, all values are in the byte order and size of the device:
+ *
+ *     header: | 0xa7 | len | "RL" | version | flags | sizeof(int)
+ *             | sizeof(long) | sizeof(size_t) | sizeof(void *)
+ *             | sizeof(double) | &log_binary_anchor |
+ *     log:    | 0xa5 | len | level | format | arguments... |
+ *     lost:   | 0xa6 | 2 | count (uint16_t) |
+ *
+ * The header is sent before the first record, bit 0 of its flags is set on
+ * big endian devices. Bit 7 of the level of a log record is set if the
+ * arguments did not fit into @ref LOG_BINARY_RECORD_MAX bytes.
+ *
+ * Arguments are stored in the order of the conversions of the format:
+ * `*` widths and precisions and all integers up to `int` as `int`, `l` as
+ * `long`, `ll` and `j` as `long long`, `z` and `t` as `size_t`, `%p` as a
+ * pointer, floating point values as `double`, `%c` as one byte and `%s` as
+ * one byte of length (0xff for NULL) followed by the characters.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Binary deferred logging interface definition
+ */
+
+#ifndef LOG_BINARY_H
+#define LOG_BINARY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer, must be a power of two
+ */
+#ifndef LOG_BINARY_BUFSIZE
+#define LOG_BINARY_BUFSIZE      (512U)
+#endif
+
+/**
+ * @brief   Maximum size of the level, format and arguments of a record
+ *
+ * The record is built on the stack of the caller. At most 255.
+ */
+#ifndef LOG_BINARY_RECORD_MAX
+#define LOG_BINARY_RECORD_MAX   (64U)
+#endif
+
+/**
+ * @brief   Maximum number of characters stored per string argument
+ */
+#ifndef LOG_BINARY_STR_MAX
+#define LOG_BINARY_STR_MAX      (24U)
+#endif
+
+/**
+ * @brief   Priority of the thread writing the records to stdout
+ */
+#ifndef LOG_BINARY_PRIO
+#define LOG_BINARY_PRIO         (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the thread writing the records to stdout
+ */
+#ifndef LOG_BINARY_STACKSIZE
+#define LOG_BINARY_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @name    Markers of the records
+ * @{
+ */
+#define LOG_BINARY_LOG          (0xa5)
+#define LOG_BINARY_LOST         (0xa6)
+#define LOG_BINARY_HDR          (0xa7)
+/** @} */
+
+/**
+ * @brief   Version of the stream format
+ */
+#define LOG_BINARY_VERSION      (1U)
+
+/**
+ * @brief   Set in the level of records with truncated arguments
+ */
+#define LOG_BINARY_TRUNCATED    (0x80)
+
+/**
+ * @brief   Known string whose address locates the format strings in the ELF
+ *          file, e.g. in position independent executables
+ */
+extern const char log_binary_anchor[];
+
+/**
+ * @brief   Start the thread writing the records to stdout
+ *
+ * Called by auto_init.
+ */
+void log_binary_init(void);
+
+/**
+ * @brief   Store a log record
+ *
+ * Called by LOG_*(), may be called from interrupt context.
+ *
+ * @param[in] level     level of the message
+ * @param[in] format    printf() like format string, must stay valid, i.e.
+ *                      usually a string literal
+ */
+void log_binary_write(unsigned level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief   Move complete records out of the ring buffer
+ *
+ * Used by the thread started by log_binary_init(). There must be only one
+ * reader at a time: call it directly only where that thread can not run
+ * meanwhile, e.g. from a thread of higher priority that does not block.
+ *
+ * @param[out] buf      buffer for the records
+ * @param[in] max       size of @p buf, at least
+ *                      @ref LOG_BINARY_RECORD_MAX + 2 to never stall
+ *
+ * @return      the number of bytes stored in @p buf
+ */
+size_t log_binary_read(void *buf, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_BINARY_H */
+/** @} */
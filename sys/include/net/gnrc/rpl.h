@@ -81,6 +81,14 @@
  *   CFLAGS += -DGNRC_RPL_WITHOUT_VALIDATION
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - By default, complete blocks of downward routes are merged into a single
+ *   target of their common prefix and targets that are covered by another
+ *   advertised prefix are left out of DAOs. This can be disabled, e.g. if the
+ *   parents' FIBs can not hold routes to prefixes.
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   CFLAGS += -DGNRC_RPL_WITHOUT_DAO_AGGREGATION
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * @{
  *
  * @file
@@ -340,6 +348,17 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #endif
 /** @} */
 
+/**
+ * @brief   Number of changed targets remembered for incremental DAOs
+ *
+ * A node in storing mode only advertises the targets that were added or
+ * removed since the last acknowledged DAO to its preferred parent. If more
+ * targets change before the next DAO, all targets are advertised again.
+ */
+#ifndef GNRC_RPL_DAO_DELTA_NUMOF
+#define GNRC_RPL_DAO_DELTA_NUMOF (8)
+#endif
+
 /**
  * @brief Cleanup timeout in seconds
  */
@@ -562,6 +581,13 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
  */
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag);
 
+/**
+ * @brief   Delay the DAO sending interval to advertise changed targets only
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ */
+void gnrc_rpl_delta_dao(gnrc_rpl_dodag_t *dodag);
+
 /**
  * @brief Create a new RPL instance and RPL DODAG.
  *
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_ns RPL non-storing mode root
+ * @ingroup     net_gnrc_rpl
+ * @brief       Source routes of the root of a non-storing RPL DODAG
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7, Non-Storing Mode
+ *      </a>
+ *
+ * In non-storing mode the nodes of a DODAG send their DAOs directly to the
+ * root. Each DAO carries the target of a node and the address of its parent.
+ * The root keeps these links in a table that refers to parents by index, so
+ * a route to a node is found by following the parent indices up to the root.
+ *
+ * The routes are computed on demand and cached. A change of a link only
+ * invalidates the cached routes that contain the changed node.
+ *
+ * Packets that the root sends to a node that is more than one hop away get a
+ * RPL source routing header (see @ref net_gnrc_rpl_srh).
+ *
+ * A root without this module installs the target of each DAO with the node
+ * that sent it as next hop, which only reaches the children of the root.
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the non-storing mode root
+ */
+#ifndef GNRC_RPL_NS_H_
+#define GNRC_RPL_NS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of nodes the root knows of
+ */
+#ifndef GNRC_RPL_NS_NODES_NUMOF
+#define GNRC_RPL_NS_NODES_NUMOF     (32)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route
+ */
+#ifndef GNRC_RPL_NS_HOPS_MAX
+#define GNRC_RPL_NS_HOPS_MAX        (8)
+#endif
+
+/**
+ * @brief   Number of cached source routes, at most 255
+ */
+#ifndef GNRC_RPL_NS_CACHE_SIZE
+#define GNRC_RPL_NS_CACHE_SIZE      (8)
+#endif
+
+/**
+ * @brief   Adds or updates the link from a node to its parent
+ *
+ * @param[in] child     Address of the node.
+ * @param[in] parent    Address of the parent of @p child. NULL if the parent
+ *                      is the root.
+ * @param[in] lifetime  Lifetime of the link in seconds.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, if the table of nodes is full.
+ * @return  -EINVAL, if @p child and @p parent are equal.
+ */
+int gnrc_rpl_ns_link_add(const ipv6_addr_t *child, const ipv6_addr_t *parent,
+                         uint32_t lifetime);
+
+/**
+ * @brief   Removes a node
+ *
+ * The nodes that have @p child as parent become unreachable until they
+ * announce a new parent.
+ *
+ * @param[in] child     Address of the node.
+ */
+void gnrc_rpl_ns_link_remove(const ipv6_addr_t *child);
+
+/**
+ * @brief   Builds the source routing header for a destination
+ *
+ * @param[in] dst       The final destination.
+ * @param[out] first_hop    The destination of the IPv6 header that carries
+ *                          the source routing header. May be NULL.
+ * @param[out] buf      Buffer for the source routing header. May be NULL to
+ *                      only get the size of the header.
+ * @param[in] buf_len   Length of @p buf.
+ *
+ * @return  Size of the source routing header.
+ * @return  0, if @p dst is a neighbor of the root and needs no source routing
+ *          header.
+ * @return  -EHOSTUNREACH, if no route to @p dst is known.
+ * @return  -ENOBUFS, if @p buf is too small.
+ */
+int gnrc_rpl_ns_srh_build(const ipv6_addr_t *dst, ipv6_addr_t *first_hop,
+                          uint8_t *buf, size_t buf_len);
+
+/**
+ * @brief   Inserts a source routing header into an outgoing packet
+ *
+ * The upper-layer checksum has to be calculated before, since it covers the
+ * final destination. The destination of the IPv6 header is replaced by the
+ * first hop.
+ *
+ * @param[in,out] ipv6  IPv6 header of the packet.
+ *
+ * @return  Size of the inserted source routing header.
+ * @return  0, if the packet needs no source routing header.
+ * @return  -EHOSTUNREACH, if no route to the destination is known.
+ * @return  -ENOBUFS, if the packet buffer is full.
+ */
+int gnrc_rpl_ns_srh_insert(gnrc_pktsnip_t *ipv6);
+
+/**
+ * @brief   Removes all nodes and cached routes
+ */
+void gnrc_rpl_ns_flush(void);
+
+/**
+ * @brief   Removes nodes whose link lifetime expired
+ */
+void gnrc_rpl_ns_update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_RPL_NS_H_ */
+/** @} */
@@ -211,6 +211,8 @@ struct gnrc_rpl_parent {
     gnrc_rpl_parent_t *next;        /**< pointer to the next parent */
     uint8_t state;                  /**< 0 for unsued, 1 for used */
     ipv6_addr_t addr;               /**< link-local IPv6 address of this parent */
+    ipv6_addr_t global_addr;        /**< address of this parent from a PIO with the
+                                         R flag, unspecified if it sent none */
     uint8_t dtsn;                   /**< last seen dtsn of this parent */
     uint16_t rank;                  /**< rank of the parent */
     gnrc_rpl_dodag_t *dodag;        /**< DODAG the parent belongs to */
@@ -256,9 +258,13 @@ struct gnrc_rpl_dodag {
     uint8_t dao_seq;                /**< dao sequence number */
     uint8_t dao_counter;            /**< amount of retried DAOs */
     bool dao_ack_received;          /**< flag to check for DAO-ACK */
+    bool dao_synced;                /**< the preferred parent acknowledged all targets
+                                         except for the changed ones */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
     uint8_t dao_time;               /**< time to schedule a DAO in seconds */
+    uint8_t dao_full_time;          /**< time until the next DAO has to carry all
+                                         targets in seconds */
     trickle_t trickle;              /**< trickle representation */
 };
 
@@ -113,17 +113,24 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
  *
  * @param[in] id    A context ID.
  */
-static inline void gnrc_sixlowpan_ctx_remove(uint8_t id)
-{
-    gnrc_sixlowpan_ctx_lookup_id(id)->prefix_len = 0;
-}
-#endif
+void gnrc_sixlowpan_ctx_remove(uint8_t id);
+
+/**
+ * @brief   Gets the current state of the context buffer.
+ *
+ * @details The state changes whenever a context is added, changed, removed,
+ *          or loses its compression flag due to its lifetime expiring. It can
+ *          be used to invalidate data derived from the context buffer, e.g.
+ *          cached compression results.
+ *
+ * @return  The current state of the context buffer.
+ */
+unsigned gnrc_sixlowpan_ctx_state(void);
 
 #ifdef TEST_SUITES
 /**
@@ -42,6 +42,27 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Number of datagrams that can be queued for fragmented sending
+ *
+ * @details Fragments of queued datagrams are sent interleaved in round-robin
+ *          order, so one large datagram does not block others.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_MSG_SIZE
+#define GNRC_SIXLOWPAN_FRAG_MSG_SIZE    (4U)
+#endif
+
+/**
+ * @brief   Minimum gap between two fragments sent in microseconds
+ *
+ * @details Pacing the fragments gives unfragmented packets (e.g. RPL and NDP
+ *          messages) and the next hop's reassembly buffer some air. Set to 0
+ *          to send fragments back-to-back.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_GAP
+#define GNRC_SIXLOWPAN_FRAG_GAP         (0U)
+#endif
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -51,10 +72,65 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+    uint16_t tag;           /**< Datagram tag of the datagram to be fragmented */
+    bool prio;              /**< Send fragments of this datagram before others
+                             *   (for control traffic) */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS) || defined(DOXYGEN)
+    uint32_t enqueued;      /**< Time in microseconds the datagram was queued */
+#endif
 } gnrc_sixlowpan_msg_frag_t;
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Statistics on fragmented sending
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_stats`.
+ */
+typedef struct {
+    uint32_t datagrams;     /**< datagrams sent fragmented */
+    uint32_t fragments;     /**< fragments sent */
+    uint32_t dropped;       /**< datagrams dropped, because the queue was full */
+    uint32_t aborted;       /**< datagrams aborted, because a fragment could
+                             *   not be sent */
+    uint32_t delay_sum;     /**< sum of the times in microseconds datagrams
+                             *   waited for their first fragment to be sent */
+    uint32_t delay_max;     /**< maximum time in microseconds a datagram waited
+                             *   for its first fragment to be sent */
+    uint32_t duration_sum;  /**< sum of the times in microseconds from queueing
+                             *   a datagram until its last fragment was sent */
+} gnrc_sixlowpan_frag_stats_t;
+
+/**
+ * @brief   Get the statistics on fragmented sending
+ *
+ * @return  The statistics.
+ */
+gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void);
+#endif
+
+/**
+ * @brief   Gets a free fragmentation message from the send queue.
+ *
+ * @return  An unused fragmentation message.
+ * @return  NULL, if @ref GNRC_SIXLOWPAN_FRAG_MSG_SIZE datagrams are already
+ *          queued.
+ */
+gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
+
+/**
+ * @brief   Queues a datagram for fragmented sending.
+ *
+ * @pre @p fragment_msg was returned by gnrc_sixlowpan_msg_frag_get() and
+ *      all its fields are set, gnrc_sixlowpan_msg_frag_t::offset to 0.
+ * @pre Is called from the 6LoWPAN thread.
+ *
+ * @param[in] fragment_msg    Message containing the datagram.
+ */
+void gnrc_sixlowpan_frag_schedule(gnrc_sixlowpan_msg_frag_t *fragment_msg);
+
 /**
- * @brief   Sends a packet fragmented.
+ * @brief   Sends the next fragment of a packet and schedules the next
+ *          fragment to send.
  *
  * @param[in] fragment_msg    Message containing status of the 6LoWPAN
  *                            fragmentation progress
@@ -29,6 +29,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of flows compression templates are cached for
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (4U)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -60,6 +69,22 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
  */
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Removes all cached compression templates.
+ *
+ * @details With module `gnrc_sixlowpan_iphc_cache`,
+ *          @ref gnrc_sixlowpan_iphc_encode() keeps the compressed header of
+ *          the last @ref GNRC_SIXLOWPAN_IPHC_CACHE_SIZE flows (identified by
+ *          their IPv6 header without payload length, link-layer addresses and
+ *          interface) and reuses it for the next packet of the same flow.
+ *          Templates are invalidated automatically when the 6LoWPAN context
+ *          buffer changes, so calling this is only required if anything else
+ *          the compression depends on changes (e.g. the IID of an interface).
+ */
+void gnrc_sixlowpan_iphc_cache_flush(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
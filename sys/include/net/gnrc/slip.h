@@ -29,13 +29,14 @@
 #include "net/gnrc.h"
 #include "periph/uart.h"
 #include "ringbuffer.h"
+#include "uart_txbuf.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief   UART buffer size used for TX and RX buffers
+ * @brief   UART buffer size used for the RX buffer
  *
  * Reduce this value if your expected traffic does not include full IPv6 MTU
  * sized packets
@@ -44,14 +45,26 @@ extern "C" {
 #define GNRC_SLIP_BUFSIZE       (1500U)
 #endif
 
+/**
+ * @brief   Size of the TX buffer, must be a power of two
+ *
+ * Encoded packets are sent from this buffer in the background, the SLIP
+ * thread only waits for the UART while it is full. With a size of at least
+ * twice the largest packet, the thread does not wait at all.
+ */
+#ifndef GNRC_SLIP_TX_BUFSIZE
+#define GNRC_SLIP_TX_BUFSIZE    (256U)
+#endif
+
 /**
  * @brief   Device descriptor for SLIP devices
  */
 typedef struct {
     uart_t uart;                    /**< the UART interface */
     ringbuffer_t in_buf;            /**< RX buffer */
-    ringbuffer_t out_buf;           /**< TX buffer */
+    uart_txbuf_t out_buf;           /**< TX buffer */
     char rx_mem[GNRC_SLIP_BUFSIZE]; /**< memory used by RX buffer */
+    uint8_t tx_mem[GNRC_SLIP_TX_BUFSIZE];   /**< memory used by TX buffer */
     uint32_t in_bytes;              /**< the number of bytes received of a
                                      *   currently incoming packet */
     uint16_t in_esc;                /**< receiver is in escape mode */
@@ -66,6 +79,34 @@ typedef struct xbee_params {
     uint32_t baudrate;      /**< baudrate to use */
 } gnrc_slip_params_t;
 
+/**
+ * @brief   Receives an encoded frame, one part after the other
+ *
+ * @param[in] arg       argument given to gnrc_slip_encode()
+ * @param[in] data      the next part of the frame
+ * @param[in] len       length of @p data
+ */
+typedef void (*gnrc_slip_out_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Encodes a packet into a SLIP frame
+ *
+ * Escapes the END and ESC bytes of all snips of @p pkt and terminates the
+ * frame with an END byte. The frame is encoded into @p buf, which is passed
+ * to @p out whenever the next byte would not fit, and with the rest of the
+ * frame at the end.
+ *
+ * @pre @p size >= 2
+ *
+ * @param[in] pkt       the packet to encode, without the netif header
+ * @param[out] buf      buffer to encode into
+ * @param[in] size      size of @p buf
+ * @param[in] out       receives the parts of the frame
+ * @param[in] arg       argument passed to @p out
+ */
+void gnrc_slip_encode(const gnrc_pktsnip_t *pkt, uint8_t *buf, size_t size,
+                      gnrc_slip_out_t out, void *arg);
+
 /**
  * @brief   Initializes a new @ref net_gnrc_slip control thread for UART device
  *          @p uart
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_phydat_ts Phydat time series
+ * @ingroup     sys_phydat
+ * @brief       Compact storage of timestamped phydat_t samples
+ *
+ * A time series stores the samples of one channel, i.e. of one unit, scale
+ * and number of dimensions, which are stored once in the header of the
+ * series. Each sample is then encoded as the delta of the delta of its
+ * timestamp and the deltas of its values to the previous sample, as zigzag
+ * varints. Periodic samples take one byte for the timestamp, and slowly
+ * changing values one byte per dimension, compared to 12 bytes for a
+ * phydat_t and a timestamp.
+ *
+ * The encoded series is self-contained, it can be written to an nvram_t
+ * with phydat_ts_flush() and decoded from a copy with the reader.
+ *
+ * Layout, all integers little endian:
+ *
+ *     | len (2) | count (2) | dim (1) | unit (1) | scale (1) | samples... |
+ *
+ * @{
+ *
+ * @file
+ * @brief       Phydat time series interface definition
+ */
+
+#ifndef PHYDAT_TS_H
+#define PHYDAT_TS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nvram.h"
+#include "phydat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the header of a series
+ */
+#define PHYDAT_TS_HDR_LEN       (7U)
+
+/**
+ * @brief   Maximum size of an encoded sample
+ *
+ * 5 bytes for the timestamp, 3 bytes per dimension.
+ */
+#define PHYDAT_TS_SAMPLE_MAX    (5U + (3U * PHYDAT_DIM))
+
+/**
+ * @brief   Time series descriptor
+ */
+typedef struct {
+    uint8_t *buf;               /**< the encoded series */
+    size_t size;                /**< capacity of @p buf */
+    size_t len;                 /**< bytes used in @p buf */
+    uint16_t count;             /**< number of samples */
+    uint8_t dim;                /**< number of dimensions of the samples */
+    uint8_t unit;               /**< unit of the samples */
+    int8_t scale;               /**< scale of the samples */
+    uint32_t time;              /**< timestamp of the last sample */
+    uint32_t delta;             /**< last difference of the timestamps */
+    int16_t val[PHYDAT_DIM];    /**< values of the last sample */
+} phydat_ts_t;
+
+/**
+ * @brief   Time series reader
+ */
+typedef struct {
+    const uint8_t *buf;         /**< the encoded series */
+    size_t len;                 /**< length of the encoded series */
+    size_t pos;                 /**< position of the next sample */
+    uint16_t left;              /**< number of samples not read yet */
+    uint8_t dim;                /**< number of dimensions of the samples */
+    uint8_t unit;               /**< unit of the samples */
+    int8_t scale;               /**< scale of the samples */
+    uint32_t time;              /**< timestamp of the last sample */
+    uint32_t delta;             /**< last difference of the timestamps */
+    int16_t val[PHYDAT_DIM];    /**< values of the last sample */
+} phydat_ts_reader_t;
+
+/**
+ * @brief   Initialize an empty time series
+ *
+ * @param[out] ts       the series
+ * @param[in] buf       buffer for the encoded series
+ * @param[in] size      size of @p buf, at least @ref PHYDAT_TS_HDR_LEN
+ * @param[in] dim       number of dimensions to store per sample [1-3]
+ * @param[in] unit      unit of the samples
+ * @param[in] scale     scale of the samples
+ *
+ * @return      0 on success
+ * @return      -EINVAL on invalid @p dim or @p size
+ */
+int phydat_ts_init(phydat_ts_t *ts, void *buf, size_t size, uint8_t dim,
+                   uint8_t unit, int8_t scale);
+
+/**
+ * @brief   Append a sample to a time series
+ *
+ * The series is left unchanged on errors.
+ *
+ * @param[in] ts        the series
+ * @param[in] time      timestamp of the sample, e.g. from xtimer_now()
+ * @param[in] data      the sample
+ *
+ * @return      0 on success
+ * @return      -EINVAL if unit or scale of @p data differ from the series
+ * @return      -ENOSPC if the buffer of the series is full
+ * @return      -EOVERFLOW if the series has 65535 samples
+ */
+int phydat_ts_append(phydat_ts_t *ts, uint32_t time, const phydat_t *data);
+
+/**
+ * @brief   Remove all samples from a time series
+ *
+ * @param[in] ts        the series
+ */
+void phydat_ts_clear(phydat_ts_t *ts);
+
+/**
+ * @brief   Write a time series to a non-volatile memory and clear it
+ *
+ * @param[in] ts        the series
+ * @param[in] dev       the memory
+ * @param[in] dst       address to write the series to
+ *
+ * @return      the number of bytes written on success
+ * @return      the error of the write function of @p dev otherwise
+ */
+int phydat_ts_flush(phydat_ts_t *ts, nvram_t *dev, uint32_t dst);
+
+/**
+ * @brief   Read a time series written by phydat_ts_flush()
+ *
+ * @param[in] dev       the memory
+ * @param[in] src       address of the series
+ * @param[out] buf      buffer for the encoded series
+ * @param[in] size      size of @p buf
+ *
+ * @return      the length of the encoded series on success
+ * @return      -EBADMSG if there is no series at @p src
+ * @return      -ENOBUFS if @p buf is too small for the series
+ * @return      the error of the read function of @p dev otherwise
+ */
+int phydat_ts_load(nvram_t *dev, uint32_t src, void *buf, size_t size);
+
+/**
+ * @brief   Initialize a reader of an encoded time series
+ *
+ * @param[out] reader   the reader
+ * @param[in] buf       the encoded series, e.g. phydat_ts_t::buf
+ * @param[in] len       length of the encoded series
+ *
+ * @return      0 on success
+ * @return      -EBADMSG if the header is invalid
+ */
+int phydat_ts_reader_init(phydat_ts_reader_t *reader, const void *buf,
+                          size_t len);
+
+/**
+ * @brief   Decode the next sample of a time series
+ *
+ * @param[in] reader    the reader
+ * @param[out] time     timestamp of the sample
+ * @param[out] data     the sample, the dimensions beyond the ones of the
+ *                      series are 0
+ *
+ * @return      1 on success
+ * @return      0 after the last sample
+ * @return      -EBADMSG if the series is truncated
+ */
+int phydat_ts_read(phydat_ts_reader_t *reader, uint32_t *time,
+                   phydat_t *data);
+
+/**
+ * @brief   Decode the samples of a time range
+ *
+ * Continues behind the last sample read and skips the samples before
+ * @p from. Timestamps are compared modulo 2^32, so the range must be shorter
+ * than 2^31.
+ *
+ * @param[in] reader    the reader
+ * @param[in] from      first timestamp of the range
+ * @param[in] to        last timestamp of the range
+ * @param[out] times    timestamps of the samples, may be NULL
+ * @param[out] data     the samples
+ * @param[in] max       capacity of @p times and @p data
+ *
+ * @return      the number of samples decoded
+ * @return      -EBADMSG if the series is truncated
+ */
+int phydat_ts_read_range(phydat_ts_reader_t *reader, uint32_t from,
+                         uint32_t to, uint32_t *times, phydat_t *data,
+                         size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PHYDAT_TS_H */
+/** @} */
@@ -31,6 +31,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of registry entries that are looked up by position
+ *
+ * saul_reg_find_nth() returns these entries directly, and the other lookups
+ * scan them as an array instead of following the list. Entries beyond are
+ * still found by walking the list.
+ */
+#ifndef SAUL_REG_INDEX_NUMOF
+#define SAUL_REG_INDEX_NUMOF    (8U)
+#endif
+
 /**
  * @brief   SAUL registry entry
  */
@@ -77,6 +88,13 @@ int saul_reg_add(saul_reg_t *dev);
  */
 int saul_reg_rm(saul_reg_t *dev);
 
+/**
+ * @brief   Get the number of devices in the registry
+ *
+ * @return      the number of registered devices
+ */
+unsigned saul_reg_numof(void);
+
 /**
  * @brief   Find a device by it's position in the registry
  *
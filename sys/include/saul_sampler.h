@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_sampler SAUL sampler
+ * @ingroup     sys_saul_reg
+ * @brief       Periodic sampling of sets of SAUL devices
+ *
+ * The sampler reads sets of devices of the SAUL registry at the period of
+ * each set, timestamps the samples and stores them in a ring buffer, from
+ * which the application fetches them in bulk:
+ *
+ * @code
+ * static const saul_sampler_dev_t env_devs[] = {
+ *     { .dev = &temp_reg, .bus = 0 },
+ *     { .dev = &hum_reg, .bus = 0 },
+ *     { .dev = &light_reg, .bus = 1 },
+ * };
+ * static saul_sampler_set_t env = {
+ *     .devs = env_devs, .numof = 3, .period = 10 * SEC_IN_USEC, .id = 1,
+ * };
+ *
+ * static saul_sample_t samples[64];
+ *
+ * saul_sampler_init(&sampler, samples, 64);
+ * saul_sampler_add(&sampler, &env);
+ * thread_create(stack, sizeof(stack), prio, 0, saul_sampler_run, &sampler, ...);
+ * ...
+ * n = saul_sampler_fetch(&sampler, buf, 16);
+ * @endcode
+ *
+ * All sets that are due within @ref SAUL_SAMPLER_COALESCE of each other are
+ * read in one pass. A device that is part of several of these sets is read
+ * only once, and the devices are read ordered by their bus, so that the
+ * transfers to one bus follow each other without interleaving with other
+ * buses. The bus is a number chosen by the application, SAUL itself does
+ * not know which bus a device is attached to.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler interface definition
+ */
+
+#ifndef SAUL_SAMPLER_H
+#define SAUL_SAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "mutex.h"
+#include "phydat.h"
+#include "saul_reg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sets due within this many microseconds are read in one pass
+ */
+#ifndef SAUL_SAMPLER_COALESCE
+#define SAUL_SAMPLER_COALESCE   (1000U)
+#endif
+
+/**
+ * @brief   Maximum number of distinct devices read in one pass
+ *
+ * Sets are always read as a whole, due sets that do not fit into a pass any
+ * more are read in the next one.
+ */
+#ifndef SAUL_SAMPLER_PASS_NUMOF
+#define SAUL_SAMPLER_PASS_NUMOF (16U)
+#endif
+
+/**
+ * @brief   Bus of devices that are not attached to any bus
+ */
+#define SAUL_SAMPLER_NO_BUS     (0xff)
+
+/**
+ * @brief   A device of a set
+ */
+typedef struct {
+    saul_reg_t *dev;            /**< the device to read */
+    uint8_t bus;                /**< the bus the device is attached to */
+} saul_sampler_dev_t;
+
+/**
+ * @brief   A set of devices that is read periodically
+ */
+typedef struct saul_sampler_set {
+    struct saul_sampler_set *next;  /**< next set of the sampler */
+    const saul_sampler_dev_t *devs; /**< the devices of the set */
+    uint32_t period;                /**< sampling period in microseconds */
+    uint32_t deadline;              /**< time of the next sample */
+    uint8_t numof;                  /**< number of devices in the set */
+    uint8_t id;                     /**< identifies the set in the samples */
+} saul_sampler_set_t;
+
+/**
+ * @brief   A timestamped sample of one device
+ */
+typedef struct {
+    uint32_t time;              /**< xtimer_now() when the device was read */
+    phydat_t data;              /**< the data read */
+    int16_t dim;                /**< result of saul_reg_read() */
+    uint8_t set;                /**< saul_sampler_set_t::id of the set */
+    uint8_t index;              /**< position of the device in the set */
+} saul_sample_t;
+
+/**
+ * @brief   Sampler descriptor
+ */
+typedef struct {
+    saul_sampler_set_t *sets;   /**< the sets to sample */
+    saul_sample_t *buf;         /**< ring buffer of samples */
+    size_t size;                /**< capacity of the ring buffer */
+    size_t start;               /**< position of the oldest sample */
+    size_t avail;               /**< number of samples in the ring buffer */
+    uint32_t lost;              /**< number of overwritten samples */
+    mutex_t lock;               /**< protects the sets and the ring buffer */
+    kernel_pid_t pid;           /**< thread in saul_sampler_run() */
+} saul_sampler_t;
+
+/**
+ * @brief   Initialize a sampler
+ *
+ * @param[out] sampler  the sampler to initialize
+ * @param[in] buf       ring buffer for the samples
+ * @param[in] size      capacity of @p buf in samples
+ */
+void saul_sampler_init(saul_sampler_t *sampler, saul_sample_t *buf,
+                       size_t size);
+
+/**
+ * @brief   Add a set of devices to a sampler
+ *
+ * The set is read for the first time one period after adding it.
+ *
+ * @param[in] sampler   the sampler
+ * @param[in] set       the set, must stay valid until it is removed
+ *
+ * @return      0 on success
+ * @return      -EINVAL if the set has no devices, more than
+ *              @ref SAUL_SAMPLER_PASS_NUMOF devices, or no period
+ */
+int saul_sampler_add(saul_sampler_t *sampler, saul_sampler_set_t *set);
+
+/**
+ * @brief   Remove a set of devices from a sampler
+ *
+ * @param[in] sampler   the sampler
+ * @param[in] set       the set
+ *
+ * @return      0 on success
+ * @return      -ENOENT if the set is not part of the sampler
+ */
+int saul_sampler_remove(saul_sampler_t *sampler, saul_sampler_set_t *set);
+
+/**
+ * @brief   Read all sets that are due at @p now
+ *
+ * Called by saul_sampler_run(). Call it directly to drive a sampler from an
+ * own loop.
+ *
+ * @param[in] sampler   the sampler
+ * @param[in] now       the current time, as of xtimer_now()
+ *
+ * @return      microseconds from @p now until the next set is due
+ * @return      UINT32_MAX if the sampler has no sets
+ */
+uint32_t saul_sampler_poll(saul_sampler_t *sampler, uint32_t now);
+
+/**
+ * @brief   Sample forever
+ *
+ * The function to pass to thread_create(), it sleeps until the next set is
+ * due and then calls saul_sampler_poll().
+ *
+ * @param[in] sampler   the sampler
+ *
+ * @return      never
+ */
+void *saul_sampler_run(void *sampler);
+
+/**
+ * @brief   Move the oldest samples out of the ring buffer
+ *
+ * @param[in] sampler   the sampler
+ * @param[out] out      where to store the samples
+ * @param[in] max       capacity of @p out
+ *
+ * @return      the number of samples stored in @p out
+ */
+size_t saul_sampler_fetch(saul_sampler_t *sampler, saul_sample_t *out,
+                          size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_SAMPLER_H */
+/** @} */
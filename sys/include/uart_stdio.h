@@ -49,6 +49,18 @@ extern "C" {
 #define UART_STDIO_RX_BUFSIZE    (64)
 #endif
 
+#ifndef UART_STDIO_TX_BUFSIZE
+/**
+ * @brief Transmit buffer size for STDIO, 0 to write blocking
+ *
+ * With a power of two, output is copied into a buffer that is sent by
+ * uart_write_async() in the background, see @ref sys_uart_txbuf. Output
+ * from interrupt context that does not fit into the buffer is dropped, e.g.
+ * most of a kernel panic message, so it is disabled by default.
+ */
+#define UART_STDIO_TX_BUFSIZE    (0)
+#endif
+
 /**
  * @brief initialize the module
  */
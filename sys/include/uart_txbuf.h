@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_uart_txbuf UART transmit buffer
+ * @ingroup     sys
+ * @brief       Ring buffer drained to a UART by uart_write_async()
+ *
+ * Writers copy their data into the ring buffer and return, while the UART
+ * sends the buffered data in the background, one contiguous piece per
+ * uart_write_async(). Writers only block while the buffer is full. On CPUs
+ * without `PERIPH_UART_HAS_WRITE_ASYNC`, the data is sent before
+ * uart_txbuf_write() returns, as with uart_write().
+ *
+ * Threads write one at a time, so the data of one uart_txbuf_write() is not
+ * interleaved with the one of other threads. Writes from interrupt context
+ * do not block, the data that does not fit into the buffer is dropped.
+ *
+ * The buffer owns the asynchronous transmissions of its UART, the device
+ * must not be written to by other means meanwhile.
+ *
+ * @{
+ *
+ * @file
+ * @brief       UART transmit buffer interface definition
+ */
+
+#ifndef UART_TXBUF_H
+#define UART_TXBUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mutex.h"
+#include "periph/uart.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   UART transmit buffer
+ */
+typedef struct {
+    uart_t uart;                /**< UART device the data is sent on */
+    uint8_t *buf;               /**< buffer memory */
+    unsigned mask;              /**< size of the buffer - 1 */
+    volatile unsigned reads;    /**< total number of bytes sent */
+    volatile unsigned writes;   /**< total number of bytes stored */
+    volatile unsigned sending;  /**< number of bytes in flight */
+    volatile unsigned waiting;  /**< a thread waits for @p done */
+    mutex_t lock;               /**< serializes the writing threads */
+    mutex_t done;               /**< unlocked when a transmission completed */
+} uart_txbuf_t;
+
+/**
+ * @brief   Initialize a transmit buffer
+ *
+ * @param[out] txbuf    transmit buffer to initialize
+ * @param[in] uart      initialized UART device to send on
+ * @param[in] buf       buffer memory
+ * @param[in] size      size of @p buf, must be a power of two
+ */
+void uart_txbuf_init(uart_txbuf_t *txbuf, uart_t uart, uint8_t *buf,
+                     size_t size);
+
+/**
+ * @brief   Store data in the buffer and start sending it
+ *
+ * Blocks while the buffer is full, unless called from interrupt context.
+ *
+ * @param[in] txbuf     transmit buffer
+ * @param[in] data      data to send
+ * @param[in] len       number of bytes to send
+ *
+ * @return      the number of bytes stored, less than @p len only in
+ *              interrupt context
+ */
+size_t uart_txbuf_write(uart_txbuf_t *txbuf, const void *data, size_t len);
+
+/**
+ * @brief   Wait until all data in the buffer was handed to the hardware
+ *
+ * Returns right away in interrupt context.
+ *
+ * @param[in] txbuf     transmit buffer
+ */
+void uart_txbuf_flush(uart_txbuf_t *txbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_TXBUF_H */
+/** @} */
@@ -268,8 +268,32 @@ struct ubjson_cookie {
      * @internal
      */
     char marker;
+
+    /**
+     * @brief     Read-ahead or write-behind buffer, NULL for unbuffered I/O.
+     * @internal
+     */
+    uint8_t *buf;
+    size_t buf_size; /**< @internal size of ubjson_cookie::buf */
+    size_t buf_pos;  /**< @internal next byte to read, or number of bytes to write */
+    size_t buf_len;  /**< @internal number of bytes read ahead */
 };
 
+/**
+ * @brief Element types of strongly typed arrays
+ *
+ * Used by ubjson_write_array() and ubjson_get_array().
+ */
+typedef enum {
+    UBJSON_ARRAY_INT8,   /**< int8_t elements */
+    UBJSON_ARRAY_UINT8,  /**< uint8_t elements */
+    UBJSON_ARRAY_INT16,  /**< int16_t elements */
+    UBJSON_ARRAY_INT32,  /**< int32_t elements */
+    UBJSON_ARRAY_INT64,  /**< int64_t elements */
+    UBJSON_ARRAY_FLOAT,  /**< float elements */
+    UBJSON_ARRAY_DOUBLE, /**< double elements */
+} ubjson_array_type_t;
+
 /**
  * @brief         Used to read with a setup cookie.
  * @details       You need to use this function instead of ubjson_read() only if
@@ -304,9 +328,39 @@ static inline ubjson_read_callback_result_t ubjson_read(ubjson_cookie_t *__restr
     cookie->rw.read = read;
     cookie->callback.read = callback;
     cookie->marker = 0;
+    cookie->buf = NULL;
     return ubjson_read_next(cookie);
 }
 
+/**
+ * @brief         Sets up a cookie to read through a read-ahead buffer.
+ * @details       Without a buffer, ubjson_read() invokes the read function once per marker,
+ *                and at least once per value. With a buffer, the read function is asked for
+ *                up to `size` bytes at once, and the data is taken from the buffer.
+ *
+ *                Call ubjson_read_next() to read each value afterwards.
+ *                Data behind the last value may be read into the buffer already,
+ *                so only use a buffer if the stream carries nothing but UBJSON data.
+ * @param[out]    cookie     The cookie that is passed to the callback function.
+ * @param[in]     read       The function that is called to receive more data.
+ * @param[in]     callback   The callback function.
+ * @param[in]     buf        The read-ahead buffer.
+ * @param[in]     size       The size of @p buf, `>= 1`.
+ */
+static inline void ubjson_read_init_buffered(ubjson_cookie_t *__restrict cookie,
+                                             ubjson_read_t read,
+                                             ubjson_read_callback_t callback,
+                                             void *buf, size_t size)
+{
+    cookie->rw.read = read;
+    cookie->callback.read = callback;
+    cookie->marker = 0;
+    cookie->buf = (uint8_t *) buf;
+    cookie->buf_size = size;
+    cookie->buf_pos = 0;
+    cookie->buf_len = 0;
+}
+
 /**
  * @brief         Use in a callback if type1 is UBJSON_KEY or UBJSON_INDEX.
  * @details       Call like ``ubjson_peek_value(cookie, &type2, &content2)``.
@@ -414,6 +468,26 @@ static inline ssize_t ubjson_get_double(ubjson_cookie_t *__restrict cookie, ssiz
 ubjson_read_callback_result_t ubjson_read_array(ubjson_cookie_t *__restrict cookie);
 
 
+/**
+ * @brief         Call if type1 of the callback was UBJSON_ENTER_ARRAY to read a numeric array at once.
+ * @details       Instead of invoking the callback once per element, the elements are stored in
+ *                @p dest. If the array is strongly typed (`[$<type>#<count>`) with the type of
+ *                @p dest, the data is copied in one go and only converted to the host byte order.
+ *                Other arrays are read element by element, as long as every element is a number
+ *                that fits into the type of @p dest.
+ * @param[in]     cookie     The cookie that was passed to the callback function.
+ * @param[in]     type       The type of the elements of @p dest.
+ * @param[out]    dest       The elements of the array.
+ * @param[in,out] count      The capacity of @p dest in elements, returns the number of elements.
+ * @returns       @arg UBJSON_OKAY on success.
+ *                @arg UBJSON_SIZE_ERROR if the array has more than @p count elements.
+ *                @arg UBJSON_INVALID_DATA if an element is not a number of the type of @p dest.
+ *                @arg UBJSON_PREMATURELY_ENDED if the stream ended.
+ */
+ubjson_read_callback_result_t ubjson_get_array(ubjson_cookie_t *__restrict cookie,
+                                               ubjson_array_type_t type,
+                                               void *dest, size_t *count);
+
 /**
  * @brief         Call if type1 of the callback was UBJSON_ENTER_OBJECT.
  * @details       Inside this call the callback function will be invoked multiple times,
@@ -443,8 +517,38 @@ ubjson_read_callback_result_t ubjson_read_object(ubjson_cookie_t *__restrict coo
 static inline void ubjson_write_init(ubjson_cookie_t *__restrict cookie, ubjson_write_t write_fun)
 {
     cookie->rw.write = write_fun;
+    cookie->buf = NULL;
+}
+
+/**
+ * @brief         Like ubjson_write_init(), but collects the data in a write-behind buffer.
+ * @details       The write function is invoked only if the buffer is full, or if
+ *                ubjson_write_flush() is called.
+ *                Data that does not fit into the buffer at all bypasses it.
+ * @param[out]    cookie     The cookie that will be passed to ubjson_write_null() and friends.
+ * @param[in]     write_fun  The function that will be called to write data.
+ * @param[in]     buf        The write-behind buffer.
+ * @param[in]     size       The size of @p buf, `>= 1`.
+ */
+static inline void ubjson_write_init_buffered(ubjson_cookie_t *__restrict cookie,
+                                              ubjson_write_t write_fun,
+                                              void *buf, size_t size)
+{
+    cookie->rw.write = write_fun;
+    cookie->buf = (uint8_t *) buf;
+    cookie->buf_size = size;
+    cookie->buf_pos = 0;
 }
 
+/**
+ * @brief         Write the data in the write-behind buffer.
+ * @details       Call after the last value, and whenever the receiver should see the data.
+ *                Does nothing for a cookie without a buffer.
+ * @param[in]     cookie     The cookie that was initialized with ubjson_write_init_buffered().
+ * @returns       The result of the supplied @ref ubjson_write_t function, or `0` if there was no data.
+ */
+ssize_t ubjson_write_flush(ubjson_cookie_t *__restrict cookie);
+
 /**
  * @brief         Write a null value.
  * @param[in]     cookie     The cookie that was initialized with ubjson_write_init().
@@ -533,6 +637,21 @@ ssize_t ubjson_open_array_len(ubjson_cookie_t *__restrict cookie, size_t len);
  */
 ssize_t ubjson_close_array(ubjson_cookie_t *__restrict cookie);
 
+/**
+ * @brief         Write a strongly typed array of numbers.
+ * @details       Writes the array as `[$<type>#<count>` followed by the elements without
+ *                markers, which takes about half the space of an array of numbers for small
+ *                types, and lets ubjson_get_array() copy the elements in one go.
+ *                Do not call ubjson_close_array().
+ * @param[in]     cookie     The cookie that was initialized with ubjson_write_init().
+ * @param[in]     type       The type of the elements.
+ * @param[in]     values     The elements.
+ * @param[in]     count      The number of elements.
+ * @returns       The result of the supplied @ref ubjson_write_t function.
+ */
+ssize_t ubjson_write_array(ubjson_cookie_t *__restrict cookie, ubjson_array_type_t type,
+                           const void *values, size_t count);
+
 /**
  * @brief         Open an object.
  * @details       Write multiple keys inside this object.
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       Binary deferred logging implementation
+ *
+ * @}
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "atomic.h"
+#include "log_binary.h"
+#include "mutex.h"
+#include "thread.h"
+
+#if (LOG_BINARY_BUFSIZE & (LOG_BINARY_BUFSIZE - 1)) != 0
+#error "LOG_BINARY_BUFSIZE must be a power of two"
+#endif
+
+#if LOG_BINARY_RECORD_MAX > 255
+#error "LOG_BINARY_RECORD_MAX must not exceed 255"
+#endif
+
+#define MASK            (LOG_BINARY_BUFSIZE - 1)
+#define HDR_LEN         (11U + sizeof(void *))
+#define LOST_LEN        (4U)
+
+/* keeps the compiler from moving memory accesses across it */
+#define BARRIER()       __asm__ volatile ("" : : : "memory")
+
+/* stores the next argument of type t, gives up if it does not fit */
+#define PUT_ARG(t)                                  \
+    do {                                            \
+        t _val = va_arg(args, t);                   \
+        if ((size_t)(end - pos) < sizeof(t)) {      \
+            *truncated = 1;                         \
+            return pos;                             \
+        }                                           \
+        memcpy(pos, &_val, sizeof(t));              \
+        pos += sizeof(t);                           \
+    } while (0)
+
+const char log_binary_anchor[] = "log_binary";
+
+/* Writers claim space by advancing _reserved and complete their record by
+ * setting its marker last, the reader stops at the first record without
+ * marker and clears the bytes it consumed. Both positions are free running. */
+static uint8_t _buf[LOG_BINARY_BUFSIZE];
+static atomic_int_t _reserved = ATOMIC_INIT(0);
+static volatile unsigned _reads;
+static atomic_int_t _lost = ATOMIC_INIT(0);
+static unsigned _hdr_sent;
+
+/* the thread is woken up by unlocking _signal if it set _waiting */
+static mutex_t _signal = MUTEX_INIT;
+static volatile unsigned _waiting;
+static char _stack[LOG_BINARY_STACKSIZE];
+
+static void _put(unsigned pos, const uint8_t *src, size_t len)
+{
+    unsigned start = pos & MASK;
+    size_t first = LOG_BINARY_BUFSIZE - start;
+
+    if (first >= len) {
+        memcpy(&_buf[start], src, len);
+    }
+    else {
+        memcpy(&_buf[start], src, first);
+        memcpy(_buf, &src[first], len - first);
+    }
+}
+
+static void _take(unsigned pos, uint8_t *dst, size_t len)
+{
+    unsigned start = pos & MASK;
+    size_t first = LOG_BINARY_BUFSIZE - start;
+
+    if (first >= len) {
+        memcpy(dst, &_buf[start], len);
+        memset(&_buf[start], 0, len);
+    }
+    else {
+        memcpy(dst, &_buf[start], first);
+        memcpy(&dst[first], _buf, len - first);
+        memset(&_buf[start], 0, first);
+        memset(_buf, 0, len - first);
+    }
+}
+
+/* packs the arguments of format after pos, up to the last one that fits */
+static uint8_t *_pack(uint8_t *pos, uint8_t *end, const char *format,
+                      va_list args, int *truncated)
+{
+    for (const char *c = strchr(format, '%'); c; c = strchr(c + 1, '%')) {
+        c++;
+        while ((*c == '-') || (*c == '+') || (*c == ' ') || (*c == '#') ||
+               (*c == '0')) {
+            c++;
+        }
+        if (*c == '*') {
+            PUT_ARG(int);
+            c++;
+        }
+        while ((*c >= '0') && (*c <= '9')) {
+            c++;
+        }
+        if (*c == '.') {
+            c++;
+            if (*c == '*') {
+                PUT_ARG(int);
+                c++;
+            }
+            while ((*c >= '0') && (*c <= '9')) {
+                c++;
+            }
+        }
+
+        char len = 0;
+        switch (*c) {
+            case 'h':
+                c += (c[1] == 'h') ? 2 : 1;
+                break;
+            case 'l':
+                if (c[1] == 'l') {
+                    len = 'j';
+                    c += 2;
+                    break;
+                }
+                /* falls through */
+            case 'j':
+            case 'z':
+            case 't':
+            case 'L':
+                len = *c++;
+                break;
+        }
+
+        switch (*c) {
+            case 'd':
+            case 'i':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                switch (len) {
+                    case 'l':
+                        PUT_ARG(long);
+                        break;
+                    case 'j':
+                        PUT_ARG(long long);
+                        break;
+                    case 'z':
+                    case 't':
+                        PUT_ARG(size_t);
+                        break;
+                    default:
+                        PUT_ARG(int);
+                        break;
+                }
+                break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (len == 'L') {
+                    /* stored as double, the host knows no long double */
+                    double val = va_arg(args, long double);
+                    if ((size_t)(end - pos) < sizeof(val)) {
+                        *truncated = 1;
+                        return pos;
+                    }
+                    memcpy(pos, &val, sizeof(val));
+                    pos += sizeof(val);
+                }
+                else {
+                    PUT_ARG(double);
+                }
+                break;
+            case 'p':
+                PUT_ARG(void *);
+                break;
+            case 'c':
+                if (pos == end) {
+                    *truncated = 1;
+                    return pos;
+                }
+                *pos++ = (uint8_t)va_arg(args, int);
+                break;
+            case 's': {
+                const char *str = va_arg(args, const char *);
+                size_t n = 0;
+
+                if (pos == end) {
+                    *truncated = 1;
+                    return pos;
+                }
+                if (str == NULL) {
+                    *pos++ = 0xff;
+                    break;
+                }
+                while ((n < LOG_BINARY_STR_MAX) && str[n]) {
+                    n++;
+                }
+                if ((size_t)(end - pos) < (n + 1)) {
+                    *truncated = 1;
+                    return pos;
+                }
+                *pos++ = n;
+                memcpy(pos, str, n);
+                pos += n;
+                break;
+            }
+            case 'n':
+                (void)va_arg(args, void *);
+                break;
+            case '%':
+                break;
+            default:
+                /* the host stops at the same conversion */
+                *truncated = 1;
+                return pos;
+        }
+    }
+    return pos;
+}
+
+void log_binary_write(unsigned level, const char *format, ...)
+{
+    uint8_t rec[LOG_BINARY_RECORD_MAX + 2];
+    uint8_t *end = &rec[sizeof(rec)];
+    uint8_t *pos;
+    int truncated = 0;
+    va_list args;
+
+    va_start(args, format);
+    pos = _pack(&rec[3 + sizeof(format)], end, format, args, &truncated);
+    va_end(args);
+
+    size_t len = pos - rec;
+    rec[0] = LOG_BINARY_LOG;
+    rec[2] = level & ~LOG_BINARY_TRUNCATED;
+    if (truncated) {
+        /* the arguments packed so far are kept */
+        rec[2] |= LOG_BINARY_TRUNCATED;
+    }
+    memcpy(&rec[3], &format, sizeof(format));
+    rec[1] = len - 2;
+
+    int old;
+    do {
+        old = ATOMIC_VALUE(_reserved);
+        if ((LOG_BINARY_BUFSIZE - ((unsigned)old - _reads)) < len) {
+            atomic_inc(&_lost);
+            return;
+        }
+    } while (!atomic_cas(&_reserved, old, (int)((unsigned)old + len)));
+
+    _put((unsigned)old + 1, &rec[1], len - 1);
+    BARRIER();
+    *(volatile uint8_t *)&_buf[(unsigned)old & MASK] = LOG_BINARY_LOG;
+
+    if (_waiting) {
+        _waiting = 0;
+        mutex_unlock(&_signal);
+    }
+}
+
+size_t log_binary_read(void *buf_, size_t max)
+{
+    uint8_t *buf = buf_;
+    size_t pos = 0;
+
+    if (!_hdr_sent) {
+        if (max < HDR_LEN) {
+            return 0;
+        }
+        const void *anchor = log_binary_anchor;
+        uint16_t endian = 1;
+
+        buf[0] = LOG_BINARY_HDR;
+        buf[1] = HDR_LEN - 2;
+        buf[2] = 'R';
+        buf[3] = 'L';
+        buf[4] = LOG_BINARY_VERSION;
+        buf[5] = (*(uint8_t *)&endian == 1) ? 0 : 1;
+        buf[6] = sizeof(int);
+        buf[7] = sizeof(long);
+        buf[8] = sizeof(size_t);
+        buf[9] = sizeof(void *);
+        buf[10] = sizeof(double);
+        memcpy(&buf[11], &anchor, sizeof(anchor));
+        pos = HDR_LEN;
+        _hdr_sent = 1;
+    }
+
+    if ((max - pos) >= LOST_LEN) {
+        int old;
+        uint16_t lost;
+
+        do {
+            old = ATOMIC_VALUE(_lost);
+            lost = (old > UINT16_MAX) ? UINT16_MAX : old;
+        } while (lost && !atomic_cas(&_lost, old, old - lost));
+
+        if (lost) {
+            buf[pos++] = LOG_BINARY_LOST;
+            buf[pos++] = LOST_LEN - 2;
+            memcpy(&buf[pos], &lost, sizeof(lost));
+            pos += sizeof(lost);
+        }
+    }
+
+    unsigned reads = _reads;
+    while (((unsigned)ATOMIC_VALUE(_reserved) != reads) &&
+           (*(volatile uint8_t *)&_buf[reads & MASK] != 0)) {
+        /* the record is complete */
+        BARRIER();
+        size_t len = _buf[(reads + 1) & MASK] + 2U;
+        if (len > (max - pos)) {
+            break;
+        }
+        _take(reads, &buf[pos], len);
+        pos += len;
+        reads += len;
+    }
+    /* the space is cleared before the writers may claim it */
+    BARRIER();
+    _reads = reads;
+    return pos;
+}
+
+static void *_drain(void *arg)
+{
+    uint8_t buf[LOG_BINARY_RECORD_MAX + 2];
+    size_t len;
+
+    (void)arg;
+    while (1) {
+        while ((len = log_binary_read(buf, sizeof(buf))) > 0) {
+            fwrite(buf, 1, len, stdout);
+        }
+        fflush(stdout);
+
+        /* a record completed after the last read unlocks _signal again */
+        _waiting = 1;
+        if ((unsigned)ATOMIC_VALUE(_reserved) == _reads) {
+            mutex_lock(&_signal);
+        }
+        _waiting = 0;
+    }
+    return NULL;
+}
+
+void log_binary_init(void)
+{
+    thread_create(_stack, sizeof(_stack), LOG_BINARY_PRIO,
+                  THREAD_CREATE_STACKTEST, _drain, NULL, "log_binary");
+}
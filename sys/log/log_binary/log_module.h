@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       log_module header of the binary deferred logging
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include "log_binary.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   log_write overridden function
+ */
+#define log_write(level, ...) log_binary_write(level, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_MODULE_H */
+/** @} */
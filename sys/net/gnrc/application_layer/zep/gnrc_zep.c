@@ -19,6 +19,7 @@
 #include <string.h>
 #include <time.h>
 
+#include "checksum/crc16_ccitt.h"
 #include "ringbuffer.h"
 #include "hashes.h"
 #include "msg.h"
@@ -43,7 +44,6 @@
 #define _EVENT_RX_STARTED       (1)
 #define _EVENT_RX_COMPLETE      (2)
 #define _RX_BUF_SIZE            (16U * sizeof(gnrc_pktsnip_t *))
-#define IEEE_802154_FCS_POLY    (0x8408)  /* x^16 + x^12 + x^5 + 1 for LSB first */
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _rx_stack[GNRC_ZEP_STACK_SIZE];
@@ -85,7 +85,6 @@ static size_t _make_data_frame_hdr(gnrc_zep_t *dev, uint8_t *buf,
                                    gnrc_netif_hdr_t *hdr);
 static size_t _get_frame_hdr_len(uint8_t *mhr);
 gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr);
-static uint16_t _calc_fcs(uint16_t fcs, const uint8_t *frame, uint8_t frame_len);
 
 kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
                            uint16_t dst_port)
@@ -263,12 +262,12 @@ static int _send(gnrc_netdev_t *netdev, gnrc_pktsnip_t *pkt)
 
     memcpy(((uint8_t *)zep) + mhr_offset, mhr, hdr_len);
 
-    fcs = _calc_fcs(fcs, ((uint8_t *)zep) + mhr_offset, hdr_len);
+    fcs = crc16_ccitt_kermit_update(fcs, ((uint8_t *)zep) + mhr_offset, hdr_len);
     data = ((uint8_t *)zep) + mhr_offset + hdr_len;
     ptr = pkt->next;
 
     while (ptr != NULL) {
-        fcs = _calc_fcs(fcs, ptr->data, ptr->size);
+        fcs = crc16_ccitt_kermit_update(fcs, ptr->data, ptr->size);
         memcpy(data, ptr->data, ptr->size);
         data += ptr->size;
         ptr = ptr->next;
@@ -709,7 +708,7 @@ static gnrc_pktsnip_t *_create_received(gnrc_zep_t *dev, gnrc_pktsnip_t *pkt,
 
     (void)version;
 
-    if ((frame_len != pkt->size) || (_calc_fcs(0, pkt->data, pkt->size) != 0)) {
+    if ((frame_len != pkt->size) || (crc16_ccitt_kermit_calc(pkt->data, pkt->size) != 0)) {
         return NULL;
     }
 
@@ -1048,24 +1047,6 @@ gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
     return snip;
 }
 
-static uint16_t _calc_fcs(uint16_t fcs, const uint8_t *frame, uint8_t frame_len)
-{
-    for (uint8_t byte = 0; byte < frame_len; ++byte) {
-        fcs ^= frame[byte];
-
-        for (uint8_t bit = 8; bit > 0; --bit) {
-            if (fcs & 0x0001) {
-                fcs = (fcs >> 1) ^ IEEE_802154_FCS_POLY;
-            }
-            else {
-                fcs = (fcs >> 1);
-            }
-        }
-    }
-
-    return fcs;
-}
-
 /**
  * @}
  */
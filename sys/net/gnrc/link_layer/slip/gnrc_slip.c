@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -31,6 +32,7 @@
 #include "od.h"
 #include "ringbuffer.h"
 #include "thread.h"
+#include "uart_txbuf.h"
 #include "net/ipv6/hdr.h"
 
 #include "net/gnrc/slip.h"
@@ -46,6 +48,7 @@
 #define _SLIP_MSG_TYPE          (0xc1dc)    /* chosen randomly */
 #define _SLIP_NAME              "SLIP"
 #define _SLIP_MSG_QUEUE_SIZE    (8U)
+#define _SLIP_ENCODE_SIZE       (32U)       /* encoded on the stack */
 
 #define _SLIP_DEV(arg)    ((gnrc_slip_dev_t *)arg)
 
@@ -139,48 +142,71 @@ static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
     }
 }
 
-static inline void _slip_send_char(gnrc_slip_dev_t *dev, char c)
+void gnrc_slip_encode(const gnrc_pktsnip_t *pkt, uint8_t *buf, size_t size,
+                      gnrc_slip_out_t out, void *arg)
 {
-    uart_write(dev->uart, (uint8_t *)&c, 1);
-}
+    size_t len = 0;
 
-/* SLIP send handler */
-static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
-{
-    gnrc_pktsnip_t *ptr;
+    assert(size >= 2);
 
-    ptr = pkt->next;    /* ignore gnrc_netif_hdr_t, we don't need it */
+    while (pkt != NULL) {
+        const uint8_t *data = pkt->data;
 
-    while (ptr != NULL) {
-        DEBUG("slip: send pktsnip of length %u over UART_%d\n", (unsigned)ptr->size, dev->uart);
-        char *data = ptr->data;
+        DEBUG("slip: encode pktsnip of length %u\n", (unsigned)pkt->size);
+
+        for (size_t i = 0; i < pkt->size; i++) {
+            /* room for an escaped byte */
+            if (len > (size - 2)) {
+                out(arg, buf, len);
+                len = 0;
+            }
 
-        for (size_t i = 0; i < ptr->size; i++) {
             switch (data[i]) {
-                case _SLIP_END:
+                case (uint8_t)_SLIP_END:
                     DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
+                    buf[len++] = _SLIP_ESC;
+                    buf[len++] = _SLIP_END_ESC;
                     break;
 
-                case _SLIP_ESC:
+                case (uint8_t)_SLIP_ESC:
                     DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
+                    buf[len++] = _SLIP_ESC;
+                    buf[len++] = _SLIP_ESC_ESC;
                     break;
 
                 default:
-                    _slip_send_char(dev, data[i]);
+                    buf[len++] = data[i];
 
                     break;
             }
         }
 
-        ptr = ptr->next;
+        pkt = pkt->next;
     }
 
-    _slip_send_char(dev, _SLIP_END);
+    /* an escaped byte may have filled the buffer */
+    if (len == size) {
+        out(arg, buf, len);
+        len = 0;
+    }
+    buf[len++] = _SLIP_END;
+    out(arg, buf, len);
+}
+
+static void _slip_out(void *arg, const uint8_t *data, size_t len)
+{
+    /* returns once the data fits into the TX buffer */
+    uart_txbuf_write(arg, data, len);
+}
+
+/* SLIP send handler */
+static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
+{
+    uint8_t buf[_SLIP_ENCODE_SIZE];
 
+    DEBUG("slip: send packet over UART_%d\n", dev->uart);
+    /* ignore gnrc_netif_hdr_t, we don't need it */
+    gnrc_slip_encode(pkt->next, buf, sizeof(buf), _slip_out, &dev->out_buf);
     gnrc_pktbuf_release(pkt);
 }
 
@@ -264,6 +290,7 @@ kernel_pid_t gnrc_slip_init(gnrc_slip_dev_t *dev, uart_t uart, uint32_t baudrate
               uart, baudrate);
         return -ENODEV;
     }
+    uart_txbuf_init(&dev->out_buf, uart, dev->tx_mem, sizeof(dev->tx_mem));
 
     /* start SLIP thread */
     DEBUG("slip: starting SLIP thread\n");
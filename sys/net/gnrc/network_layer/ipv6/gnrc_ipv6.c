@@ -36,6 +36,10 @@
 
 #include "net/gnrc/ipv6.h"
 
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -749,6 +753,21 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
 
+#ifdef MODULE_GNRC_RPL_NS
+        /* the root of a non-storing RPL DODAG source routes its own packets.
+         * The upper-layer checksum covers the final destination, so the
+         * header is filled before the first hop becomes the destination */
+        if (prep_hdr && (gnrc_rpl_ns_srh_build(&hdr->dst, NULL, NULL, 0) > 0)) {
+            if ((_fill_ipv6_hdr(iface, ipv6, payload) < 0) ||
+                (gnrc_rpl_ns_srh_insert(ipv6) < 0)) {
+                DEBUG("ipv6: unable to insert source routing header\n");
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            prep_hdr = false;
+        }
+#endif
+
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
 
         if (iface == KERNEL_PID_UNDEF) {
@@ -24,40 +24,113 @@
 
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
+/* IDs of all valid contexts, ordered by descending prefix length */
+static uint8_t _ctx_order[GNRC_SIXLOWPAN_CTX_SIZE];
+static uint8_t _ctx_order_len = 0;
+/* minute the next context used for compression expires */
+static uint32_t _ctx_next_expiry = UINT32_MAX;
+/* sequence counter for lock-free readers: odd while the buffer is changed */
+static volatile unsigned _ctx_seq = 0;
+/* serializes writers */
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
 static uint32_t _current_minute(void);
+static bool _expired(uint8_t id);
 static void _update_lifetime(uint8_t id);
+static void _update_index(void);
 
 #if ENABLE_DEBUG
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+static inline void _barrier(void)
+{
+    /* keep the compiler from moving buffer accesses across _ctx_seq accesses */
+    __asm__ volatile ("" : : : "memory");
+}
+
+/* must be called with _ctx_mutex locked */
+static inline void _write_begin(void)
+{
+    _ctx_seq++;
+    _barrier();
+}
+
+/* must be called with _ctx_mutex locked */
+static inline void _write_end(void)
+{
+    _barrier();
+    _ctx_seq++;
+}
+
+/* must be called with _ctx_mutex locked */
 static inline bool _valid(uint8_t id)
 {
-    _update_lifetime(id);
+    if (_expired(id)) {
+        /* the context loses its compression flag */
+        _write_begin();
+        _update_lifetime(id);
+        _update_index();
+        _write_end();
+    }
+    else {
+        /* only the remaining lifetime changes, which readers do not use */
+        _update_lifetime(id);
+    }
     return (_ctxs[id].prefix_len > 0);
 }
 
-gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
+/* contexts lose their compression flag when their lifetime expires, so
+ * update all of them once the first one expired */
+static void _check_expiry(void)
 {
-    uint8_t best = 0;
-    gnrc_sixlowpan_ctx_t *res = NULL;
-
-    mutex_lock(&_ctx_mutex);
+    if (_current_minute() >= _ctx_next_expiry) {
+        mutex_lock(&_ctx_mutex);
+        _write_begin();
+        for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+            _update_lifetime(id);
+        }
+        _update_index();
+        _write_end();
+        mutex_unlock(&_ctx_mutex);
+    }
+}
 
-    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
-            uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+static gnrc_sixlowpan_ctx_t *_lookup_addr(const ipv6_addr_t *addr)
+{
+    /* the first matching context has the longest prefix */
+    for (unsigned int i = 0; i < _ctx_order_len; i++) {
+        gnrc_sixlowpan_ctx_t *ctx = &_ctxs[_ctx_order[i]];
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
-            }
+        if ((ctx->prefix_len > 0) &&
+            (ipv6_addr_match_prefix(&ctx->prefix, addr) >= ctx->prefix_len)) {
+            return ctx;
         }
     }
 
-    mutex_unlock(&_ctx_mutex);
+    return NULL;
+}
+
+gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
+{
+    gnrc_sixlowpan_ctx_t *res;
+    unsigned seq;
+
+    _check_expiry();
+
+    do {
+        seq = _ctx_seq;
+        if (seq & 1) {
+            /* writer was interrupted: wait for it instead of spinning */
+            mutex_lock(&_ctx_mutex);
+            res = _lookup_addr(addr);
+            mutex_unlock(&_ctx_mutex);
+            break;
+        }
+        _barrier();
+        res = _lookup_addr(addr);
+        _barrier();
+    } while (seq != _ctx_seq);
 
 #if ENABLE_DEBUG
     if (res != NULL) {
@@ -102,6 +175,7 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
     }
 
     mutex_lock(&_ctx_mutex);
+    _write_begin();
 
     _ctxs[id].ltime = ltime;
 
@@ -126,16 +200,46 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _update_index();
 
+    _write_end();
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    mutex_lock(&_ctx_mutex);
+    _write_begin();
+    _ctxs[id].prefix_len = 0;
+    _update_index();
+    _write_end();
+    mutex_unlock(&_ctx_mutex);
+}
+
+unsigned gnrc_sixlowpan_ctx_state(void)
+{
+    _check_expiry();
+    return _ctx_seq;
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now() / (SEC_IN_USEC * 60);
 }
 
+/* must be called with _ctx_mutex locked */
+static bool _expired(uint8_t id)
+{
+    return (_ctxs[id].ltime != 0) && (_current_minute() >= _ctx_inval_times[id]);
+}
+
+/* must be called with _ctx_mutex locked and, if the context expired, between
+ * _write_begin() and _write_end() */
 static void _update_lifetime(uint8_t id)
 {
     uint32_t now;
@@ -157,12 +261,45 @@ static void _update_lifetime(uint8_t id)
     }
 }
 
+/* must be called with _ctx_mutex locked */
+static void _update_index(void)
+{
+    _ctx_order_len = 0;
+    _ctx_next_expiry = UINT32_MAX;
+
+    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        unsigned int i;
+
+        if (_ctxs[id].prefix_len == 0) {
+            continue;
+        }
+        if ((_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
+            (_ctx_inval_times[id] < _ctx_next_expiry)) {
+            _ctx_next_expiry = _ctx_inval_times[id];
+        }
+        /* insertion sort, stable for equal prefix lengths */
+        for (i = _ctx_order_len; i > 0; i--) {
+            if (_ctxs[_ctx_order[i - 1]].prefix_len >= _ctxs[id].prefix_len) {
+                break;
+            }
+            _ctx_order[i] = _ctx_order[i - 1];
+        }
+        _ctx_order[i] = (uint8_t)id;
+        _ctx_order_len++;
+    }
+}
+
 #ifdef TEST_SUITES
 #include <string.h>
 
 void gnrc_sixlowpan_ctx_reset(void)
 {
+    mutex_lock(&_ctx_mutex);
+    _write_begin();
     memset(_ctxs, 0, sizeof(_ctxs));
+    _update_index();
+    _write_end();
+    mutex_unlock(&_ctx_mutex);
 }
 #endif
 
@@ -17,6 +17,9 @@
  */
 
 #include "kernel_types.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
@@ -26,6 +29,16 @@
 #include "utlist.h"
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/nd.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -35,7 +48,18 @@
 #include <inttypes.h>
 #endif
 
+/* time in microseconds to wait before retrying to schedule a fragment */
+#define GNRC_SIXLOWPAN_FRAG_RETRY   (1000U)
+
 static uint16_t _tag;
+static gnrc_sixlowpan_msg_frag_t _frag_msgs[GNRC_SIXLOWPAN_FRAG_MSG_SIZE];
+/* message to self for the next fragment to send */
+static msg_t _sched;
+static xtimer_t _sched_timer;
+static bool _sched_pending = false;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+static gnrc_sixlowpan_frag_stats_t _stats;
+#endif
 
 static inline uint16_t _floor8(uint16_t length)
 {
@@ -82,7 +106,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -110,7 +135,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     pkt = pkt->next;    /* don't copy netif header */
 
@@ -129,10 +154,12 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send first fragment\n");
         gnrc_pktbuf_release(frag);
+        /* the receiver can not reassemble the datagram anymore */
+        return 0;
     }
 
     return local_offset;
@@ -140,7 +167,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
 static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -166,7 +193,7 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -206,16 +233,254 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send subsequent fragment\n");
         gnrc_pktbuf_release(frag);
+        /* the receiver can not reassemble the datagram anymore */
+        return 0;
     }
 
     return local_offset;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static inline void _vrb_update_rest(vrb_t *entry, size_t frag_size)
+{
+    if (frag_size < entry->rest) {
+        entry->rest -= frag_size;
+    }
+    else {
+        /* datagram was forwarded completely */
+        DEBUG("6lo vrb: datagram (tag: %u) completely forwarded\n", entry->tag);
+        vrb_rm(entry);
+    }
+}
+
+static bool _vrb_forward_1st_fragment(gnrc_netif_hdr_t *hdr, gnrc_pktsnip_t *pkt,
+                                      size_t datagram_size, uint16_t tag)
+{
+    gnrc_pktsnip_t *dec_hdr, *netif = NULL, *payload = NULL, *ptr;
+    gnrc_sixlowpan_netif_t *out_if;
+    ipv6_hdr_t *ipv6_hdr;
+    vrb_t *entry;
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    uint8_t l2addr[RBUF_L2ADDR_MAX_LEN];
+    uint8_t l2addr_len = sizeof(l2addr);
+    size_t iphc_len, nh_len = 0, frag_size;
+    kernel_pid_t out_iface;
+
+    /* only IPHC compressed first fragments are forwarded, everything else
+     * is handed to the reassembly buffer */
+    if (((pkt->size - sizeof(sixlowpan_frag_t)) < SIXLOWPAN_IPHC_HDR_LEN) ||
+        !sixlowpan_iphc_is(data) ||
+        /* subsequent fragments of this datagram were already received */
+        rbuf_has(hdr, datagram_size, tag)) {
+        return false;
+    }
+    /* decode into a temporary snip that also fits the UDP header */
+    dec_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                              GNRC_NETTYPE_IPV6);
+    if (dec_hdr == NULL) {
+        return false;
+    }
+    iphc_len = gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, datagram_size,
+                                          sizeof(sixlowpan_frag_t), &nh_len);
+    if (iphc_len == 0) {
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    ipv6_hdr = dec_hdr->data;
+    /* datagrams for this node, to or from link-local addresses, to multicast
+     * groups, or with an expiring hop-limit take the usual way through the
+     * reassembly buffer and the IPv6 layer */
+    if (ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->src) ||
+        (ipv6_hdr->hl <= 1) ||
+        /* an uncompressed UDP header would be taken for the payload by NHC */
+        ((ipv6_hdr->nh == PROTNUM_UDP) && (nh_len == 0)) ||
+        (gnrc_ipv6_netif_find_by_addr(NULL, &ipv6_hdr->dst) != KERNEL_PID_UNDEF)) {
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    out_iface = gnrc_sixlowpan_nd_next_hop_l2addr(l2addr, &l2addr_len,
+                                                  KERNEL_PID_UNDEF,
+                                                  &ipv6_hdr->dst);
+    if ((out_iface <= KERNEL_PID_UNDEF) || (l2addr_len == 0) ||
+        ((out_if = gnrc_sixlowpan_netif_get(out_iface)) == NULL) ||
+        !out_if->iphc_enabled) {
+        DEBUG("6lo vrb: no suitable next hop found\n");
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    ipv6_hdr->hl--;
+    /* rebuild the outgoing first fragment as netif -> IPv6 [-> UDP] -> payload
+     * so it can be recompressed for the next hop */
+    frag_size = pkt->size - sizeof(sixlowpan_frag_t) - iphc_len;
+    if (((netif = gnrc_netif_hdr_build(NULL, 0, l2addr, l2addr_len)) == NULL) ||
+        ((netif->next = gnrc_pktbuf_add(NULL, ipv6_hdr, sizeof(ipv6_hdr_t),
+                                        GNRC_NETTYPE_IPV6)) == NULL) ||
+        ((nh_len > 0) &&
+         ((netif->next->next = gnrc_pktbuf_add(NULL, ipv6_hdr + 1, nh_len,
+                                               GNRC_NETTYPE_UNDEF)) == NULL)) ||
+        ((frag_size > 0) &&
+         ((payload = gnrc_pktbuf_add(NULL, data + iphc_len, frag_size,
+                                     GNRC_NETTYPE_UNDEF)) == NULL))) {
+        DEBUG("6lo vrb: unable to allocate first fragment\n");
+        gnrc_pktbuf_release(dec_hdr);
+        if (netif != NULL) {
+            gnrc_pktbuf_release(netif);
+        }
+        return false;
+    }
+    gnrc_pktbuf_release(dec_hdr);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = out_iface;
+    if (payload != NULL) {
+        LL_APPEND(netif, payload);
+    }
+    /* frag_size is now the number of uncompressed bytes in the fragment */
+    frag_size += sizeof(ipv6_hdr_t) + nh_len;
+    if (!gnrc_sixlowpan_iphc_encode(netif) ||
+        ((gnrc_pkt_len(netif->next) + sizeof(sixlowpan_frag_t)) > out_if->max_frag_size) ||
+        ((ptr = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                                GNRC_NETTYPE_SIXLOWPAN)) == NULL)) {
+        DEBUG("6lo vrb: unable to recompress first fragment for next hop\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    netif->next = ptr;
+    _tag++;
+    if ((entry = vrb_add(hdr, datagram_size, tag, out_iface, l2addr, l2addr_len,
+                         _tag)) == NULL) {
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    ((sixlowpan_frag_t *)ptr->data)->disp_size = byteorder_htons((uint16_t)datagram_size);
+    ((sixlowpan_frag_t *)ptr->data)->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    ((sixlowpan_frag_t *)ptr->data)->tag = byteorder_htons(_tag);
+    DEBUG("6lo vrb: forward first fragment (datagram size: %u, "
+          "datagram tag: %" PRIu16 " => %" PRIu16 ")\n",
+          (unsigned int)datagram_size, tag, _tag);
+    _vrb_update_rest(entry, frag_size);
+    if (gnrc_netapi_send(out_iface, netif) < 1) {
+        DEBUG("6lo vrb: unable to forward first fragment\n");
+        gnrc_pktbuf_release(netif);
+    }
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+
+static bool _vrb_forward_nth_fragment(gnrc_netif_hdr_t *hdr, gnrc_pktsnip_t *pkt,
+                                      size_t datagram_size, uint16_t tag,
+                                      size_t frag_size)
+{
+    gnrc_pktsnip_t *netif;
+    vrb_t *entry = vrb_get(hdr, datagram_size, tag);
+
+    if (entry == NULL) {
+        return false;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->out_dst, entry->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating new link-layer header\n");
+        /* datagram can not be completed at next hop, so drop fragment */
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = entry->out_iface;
+    /* reuse the received fragment: only swap the link-layer header and tag */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    /* the fragment may still be shared with other receivers */
+    gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
+    if (tmp == NULL) {
+        DEBUG("6lo vrb: unable to get write access to fragment\n");
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif);
+        return true;
+    }
+    pkt = tmp;
+    ((sixlowpan_frag_n_t *)pkt->data)->tag = byteorder_htons(entry->out_tag);
+    LL_PREPEND(pkt, netif);
+    DEBUG("6lo vrb: forward subsequent fragment (datagram tag: %" PRIu16
+          " => %" PRIu16 ", offset: %u)\n", tag, entry->out_tag,
+          ((sixlowpan_frag_n_t *)pkt->data)->offset << 3);
+    if (gnrc_netapi_send(entry->out_iface, netif) < 1) {
+        DEBUG("6lo vrb: unable to forward subsequent fragment\n");
+        gnrc_pktbuf_release(netif);
+    }
+    _vrb_update_rest(entry, frag_size);
+    return true;
+}
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_MSG_SIZE; i++) {
+        if (_frag_msgs[i].pkt == NULL) {
+            return &_frag_msgs[i];
+        }
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    /* caller will drop the datagram */
+    _stats.dropped++;
+#endif
+    return NULL;
+}
+
+/* picks the datagram to send the next fragment of in round-robin order,
+ * starting behind the last one, but datagrams with priority first */
+static gnrc_sixlowpan_msg_frag_t *_next_msg(gnrc_sixlowpan_msg_frag_t *last)
+{
+    gnrc_sixlowpan_msg_frag_t *res = NULL;
+    unsigned start = (unsigned)(last - _frag_msgs) + 1;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_MSG_SIZE; i++) {
+        gnrc_sixlowpan_msg_frag_t *fragment_msg;
+
+        fragment_msg = &_frag_msgs[(start + i) % GNRC_SIXLOWPAN_FRAG_MSG_SIZE];
+        if (fragment_msg->pkt != NULL) {
+            if (fragment_msg->prio) {
+                return fragment_msg;
+            }
+            if (res == NULL) {
+                res = fragment_msg;
+            }
+        }
+    }
+    return res;
+}
+
+static void _sched_msg(gnrc_sixlowpan_msg_frag_t *fragment_msg, uint32_t gap)
+{
+    _sched.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    _sched.content.ptr = (void *)fragment_msg;
+    _sched_pending = true;
+    if (gap == 0) {
+        /* send message to self*/
+        if (msg_send_to_self(&_sched) == 1) {
+            thread_yield();
+            return;
+        }
+        /* queue is full: try again when some messages were handled */
+        DEBUG("6lo frag: message queue full, deferring next fragment\n");
+        gap = GNRC_SIXLOWPAN_FRAG_RETRY;
+    }
+    xtimer_set_msg(&_sched_timer, gap, &_sched, thread_getpid());
+}
+
+void gnrc_sixlowpan_frag_schedule(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    fragment_msg->enqueued = xtimer_now();
+#endif
+    if (!_sched_pending) {
+        _sched_msg(fragment_msg, 0);
+    }
+    /* otherwise it is picked up by gnrc_sixlowpan_frag_send() */
+}
+
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
 {
     gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(fragment_msg->pid);
@@ -223,7 +488,8 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
+
+    _sched_pending = false;
 
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
@@ -232,6 +498,9 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
         gnrc_pktbuf_release(fragment_msg->pkt);
         /* 6LoWPAN free for next fragmentation */
         fragment_msg->pkt = NULL;
+        if ((fragment_msg = _next_msg(fragment_msg)) != NULL) {
+            _sched_msg(fragment_msg, GNRC_SIXLOWPAN_FRAG_GAP);
+        }
         return;
     }
 #endif
@@ -240,47 +509,68 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     if (fragment_msg->offset == 0) {
         /* increment tag for successive, fragmented datagrams */
         _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
+        fragment_msg->tag = _tag;
+        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
+                                      fragment_msg->tag)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
             gnrc_pktbuf_release(fragment_msg->pkt);
             fragment_msg->pkt = NULL;
-            return;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _stats.aborted++;
+#endif
         }
-        fragment_msg->offset += res;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        else {
+            uint32_t delay = xtimer_now() - fragment_msg->enqueued;
 
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
-    }
-    else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
-                fragment_msg->pkt = NULL;
-                return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            _stats.delay_sum += delay;
+            if (delay > _stats.delay_max) {
+                _stats.delay_max = delay;
+            }
         }
-        else {
+#endif
+    }
+    /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
+    else if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
+                                       fragment_msg->offset, fragment_msg->tag)) == 0) {
+        /* error sending subsequent fragment */
+        DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
+              ")\n", fragment_msg->offset);
+        gnrc_pktbuf_release(fragment_msg->pkt);
+        fragment_msg->pkt = NULL;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.aborted++;
+#endif
+    }
+
+    if (fragment_msg->pkt != NULL) {
+        fragment_msg->offset += res;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        _stats.fragments++;
+#endif
+        if (fragment_msg->offset >= payload_len) {
+            DEBUG("6lo frag: datagram (tag: %" PRIu16 ") sent\n", fragment_msg->tag);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            _stats.datagrams++;
+            _stats.duration_sum += xtimer_now() - fragment_msg->enqueued;
+#endif
             gnrc_pktbuf_release(fragment_msg->pkt);
             fragment_msg->pkt = NULL;
         }
     }
+
+    if ((fragment_msg = _next_msg(fragment_msg)) != NULL) {
+        _sched_msg(fragment_msg, GNRC_SIXLOWPAN_FRAG_GAP);
+    }
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats_get(void)
+{
+    return &_stats;
 }
+#endif
 
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
 {
@@ -306,6 +596,18 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    do {
+        size_t datagram_size = byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+        uint16_t tag = byteorder_ntohs(frag->tag);
+
+        if ((offset == 0) ? _vrb_forward_1st_fragment(hdr, pkt, datagram_size, tag) :
+            _vrb_forward_nth_fragment(hdr, pkt, datagram_size, tag, frag_size)) {
+            return;
+        }
+    } while (0);    /* ANSI-C compatible block creation */
+#endif
+
     rbuf_add(hdr, pkt, frag_size, offset);
 
     gnrc_pktbuf_release(pkt);
@@ -189,6 +189,26 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 }
 
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size, uint16_t tag)
+{
+    _rbuf_gc();
+
+    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == datagram_size) &&
+            (rbuf[i].tag == tag) &&
+            (rbuf[i].src_len == netif_hdr->src_l2addr_len) &&
+            (rbuf[i].dst_len == netif_hdr->dst_l2addr_len) &&
+            (memcmp(rbuf[i].src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    rbuf[i].src_len) == 0) &&
+            (memcmp(rbuf[i].dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    rbuf[i].dst_len) == 0)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
 {
     /* start and ends are both inclusive, so using <= for both */
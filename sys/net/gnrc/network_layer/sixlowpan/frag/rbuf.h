@@ -20,6 +20,7 @@
 #define GNRC_SIXLOWPAN_FRAG_RBUF_H_
 
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
@@ -100,6 +101,22 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+/**
+ * @brief   Checks if fragments of a datagram are already in the reassembly
+ *          buffer.
+ *
+ * @param[in] netif_hdr     The interface header of a fragment, with its
+ *                          source and destination address set.
+ * @param[in] datagram_size The datagram's (uncompressed) size.
+ * @param[in] tag           The datagram's tag.
+ *
+ * @return  true, if there is an entry for the datagram.
+ * @return  false, if there is no entry for the datagram.
+ *
+ * @internal
+ */
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size, uint16_t tag);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "assert.h"
+#include "net/gnrc/netif.h"
+#include "xtimer.h"
+
+#include "vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static vrb_t vrb[VRB_SIZE];
+
+#if ENABLE_DEBUG
+static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
+#endif
+
+static inline bool _vrb_entry_used(const vrb_t *entry)
+{
+    return (entry->out_dst_len > 0);
+}
+
+static inline bool _vrb_entry_timed_out(const vrb_t *entry, uint32_t now_usec)
+{
+    return ((now_usec - entry->arrival) > VRB_TIMEOUT);
+}
+
+vrb_t *vrb_add(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size,
+               uint16_t tag, kernel_pid_t out_iface, const uint8_t *out_dst,
+               size_t out_dst_len, uint16_t out_tag)
+{
+    vrb_t *res = NULL;
+    uint32_t now_usec = xtimer_now();
+
+    assert((out_dst_len > 0) && (out_dst_len <= RBUF_L2ADDR_MAX_LEN));
+
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        /* entries are only timed out lazily, so take them as free here */
+        if (!_vrb_entry_used(&vrb[i]) || _vrb_entry_timed_out(&vrb[i], now_usec)) {
+            res = &vrb[i];
+            break;
+        }
+    }
+
+    if (res == NULL) {
+        DEBUG("6lo vrb: virtual reassembly buffer full\n");
+        return NULL;
+    }
+
+    res->arrival = now_usec;
+    memcpy(res->src, gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len);
+    memcpy(res->dst, gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len);
+    memcpy(res->out_dst, out_dst, out_dst_len);
+    res->src_len = netif_hdr->src_l2addr_len;
+    res->dst_len = netif_hdr->dst_l2addr_len;
+    res->out_dst_len = (uint8_t)out_dst_len;
+    res->out_iface = out_iface;
+    res->datagram_size = (uint16_t)datagram_size;
+    res->tag = tag;
+    res->out_tag = out_tag;
+    res->rest = (uint16_t)datagram_size;
+
+    DEBUG("6lo vrb: entry %p (%s, %u, %u) created, forwarding to ", (void *)res,
+          gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
+                                 res->src_len), (unsigned)datagram_size, tag);
+    DEBUG("%s (tag: %u)\n",
+          gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->out_dst,
+                                 res->out_dst_len), out_tag);
+
+    return res;
+}
+
+vrb_t *vrb_get(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size,
+               uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now();
+
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        if (_vrb_entry_used(&vrb[i]) && (vrb[i].datagram_size == datagram_size) &&
+            (vrb[i].tag == tag) &&
+            (vrb[i].src_len == netif_hdr->src_l2addr_len) &&
+            (vrb[i].dst_len == netif_hdr->dst_l2addr_len) &&
+            (memcmp(vrb[i].src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    vrb[i].src_len) == 0) &&
+            (memcmp(vrb[i].dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    vrb[i].dst_len) == 0)) {
+            if (_vrb_entry_timed_out(&vrb[i], now_usec)) {
+                DEBUG("6lo vrb: entry %p timed out\n", (void *)&vrb[i]);
+                vrb_rm(&vrb[i]);
+                return NULL;
+            }
+            vrb[i].arrival = now_usec;
+            return &vrb[i];
+        }
+    }
+
+    return NULL;
+}
+
+void vrb_rm(vrb_t *entry)
+{
+    entry->out_dst_len = 0;
+}
+
+unsigned vrb_used(void)
+{
+    uint32_t now_usec = xtimer_now();
+    unsigned res = 0;
+
+    for (unsigned int i = 0; i < VRB_SIZE; i++) {
+        if (_vrb_entry_used(&vrb[i]) && !_vrb_entry_timed_out(&vrb[i], now_usec)) {
+            res++;
+        }
+    }
+
+    return res;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
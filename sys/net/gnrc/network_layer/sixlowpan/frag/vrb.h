@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ *
+ * The virtual reassembly buffer (VRB) allows a router to forward the
+ * fragments of a datagram as soon as the first fragment arrived instead of
+ * reassembling the whole datagram first. Only a mapping of the incoming
+ * (link-layer source, datagram tag) tuple to the outgoing (interface, next
+ * hop, datagram tag) tuple is kept.
+ *
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly-01
+ *      </a>
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_H_
+#define GNRC_SIXLOWPAN_FRAG_VRB_H_
+
+#include <inttypes.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef VRB_SIZE
+#define VRB_SIZE            (16U)               /**< size of the virtual reassembly buffer */
+#endif
+
+#ifndef VRB_TIMEOUT
+#define VRB_TIMEOUT         (RBUF_TIMEOUT)      /**< timeout for an entry in microseconds */
+#endif
+
+/**
+ * @brief   An entry in the virtual reassembly buffer.
+ *
+ * @details The incoming side is identified in the same way as a datagram in
+ *          the reassembly buffer (see @ref rbuf_t).
+ *
+ * @internal
+ */
+typedef struct {
+    uint32_t arrival;                       /**< time in microseconds of arrival of
+                                             *   last received fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];       /**< source address */
+    uint8_t dst[RBUF_L2ADDR_MAX_LEN];       /**< destination address */
+    uint8_t out_dst[RBUF_L2ADDR_MAX_LEN];   /**< link-layer address of the next hop */
+    uint8_t src_len;                        /**< length of source address */
+    uint8_t dst_len;                        /**< length of destination address */
+    uint8_t out_dst_len;                    /**< length of vrb_t::out_dst, 0 if unused */
+    kernel_pid_t out_iface;                 /**< interface to the next hop */
+    uint16_t datagram_size;                 /**< the datagram's (uncompressed) size */
+    uint16_t tag;                           /**< the incoming datagram's tag */
+    uint16_t out_tag;                       /**< the outgoing datagram's tag */
+    uint16_t rest;                          /**< bytes of the datagram not forwarded yet */
+} vrb_t;
+
+/**
+ * @brief   Adds a new entry to the virtual reassembly buffer.
+ *
+ * @param[in] netif_hdr     The interface header of the first fragment, with
+ *                          its source and destination address set.
+ * @param[in] datagram_size The datagram's (uncompressed) size.
+ * @param[in] tag           The incoming datagram tag.
+ * @param[in] out_iface     The interface to forward the fragments over.
+ * @param[in] out_dst       The link-layer address of the next hop.
+ * @param[in] out_dst_len   The length of @p out_dst.
+ * @param[in] out_tag       The datagram tag used towards the next hop.
+ *
+ * @return  The new entry, on success.
+ * @return  NULL, if the virtual reassembly buffer is full.
+ *
+ * @internal
+ */
+vrb_t *vrb_add(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size,
+               uint16_t tag, kernel_pid_t out_iface, const uint8_t *out_dst,
+               size_t out_dst_len, uint16_t out_tag);
+
+/**
+ * @brief   Gets the entry for a datagram from the virtual reassembly buffer.
+ *
+ * @param[in] netif_hdr     The interface header of a fragment, with its
+ *                          source and destination address set.
+ * @param[in] datagram_size The datagram's (uncompressed) size.
+ * @param[in] tag           The incoming datagram tag.
+ *
+ * @return  The entry, if the datagram is currently forwarded.
+ * @return  NULL, if there is no entry for the datagram.
+ *
+ * @internal
+ */
+vrb_t *vrb_get(gnrc_netif_hdr_t *netif_hdr, size_t datagram_size,
+               uint16_t tag);
+
+/**
+ * @brief   Removes an entry from the virtual reassembly buffer.
+ *
+ * @param[in] entry     The entry to remove.
+ *
+ * @internal
+ */
+void vrb_rm(vrb_t *entry);
+
+/**
+ * @brief   Returns the number of used entries in the virtual reassembly
+ *          buffer.
+ *
+ * @return  The number of used entries.
+ *
+ * @internal
+ */
+unsigned vrb_used(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_SIXLOWPAN_FRAG_VRB_H_ */
+/** @} */
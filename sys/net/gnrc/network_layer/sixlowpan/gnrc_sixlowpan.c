@@ -22,6 +22,7 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/sixlowpan/netif.h"
+#include "net/protnum.h"
 #include "net/sixlowpan.h"
 
 #define ENABLE_DEBUG    (0)
@@ -34,10 +35,6 @@
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
-#endif
-
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
@@ -195,6 +192,11 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_netif_t *iface;
     /* datagram_size: pure IPv6 packet without 6LoWPAN dispatches or compression */
     size_t datagram_size;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    gnrc_sixlowpan_msg_frag_t *fragment_msg;
+    /* ICMPv6 (NDP, RPL) is sent ahead of other fragmented traffic */
+    bool prio;
+#endif
 
     if ((pkt == NULL) || (pkt->size < sizeof(gnrc_netif_hdr_t))) {
         DEBUG("6lo: Sending packet has no netif header\n");
@@ -219,6 +221,10 @@ static void _send(gnrc_pktsnip_t *pkt)
     hdr = pkt2->data;
     iface = gnrc_sixlowpan_netif_get(hdr->if_pid);
     datagram_size = gnrc_pkt_len(pkt2->next);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    /* IPv6 header is gone after compression */
+    prio = (((ipv6_hdr_t *)pkt2->next->data)->nh == PROTNUM_ICMPV6);
+#endif
 
     if (iface == NULL) {
         DEBUG("6lo: Can not get 6LoWPAN specific interface information.\n");
@@ -272,27 +278,23 @@ static void _send(gnrc_pktsnip_t *pkt)
         return;
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-    else if (fragment_msg.pkt != NULL) {
-        DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
+    else if ((fragment_msg = gnrc_sixlowpan_msg_frag_get()) == NULL) {
+        DEBUG("6lo: Fragmentation queue full. Dropping packet\n");
         gnrc_pktbuf_release(pkt2);
         return;
     }
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %" PRIu16 ")\n",
               (unsigned int)datagram_size, iface->max_frag_size);
-        msg_t msg;
 
-        fragment_msg.pid = hdr->if_pid;
-        fragment_msg.pkt = pkt2;
-        fragment_msg.datagram_size = datagram_size;
+        fragment_msg->pid = hdr->if_pid;
+        fragment_msg->pkt = pkt2;
+        fragment_msg->datagram_size = datagram_size;
         /* Sending the first fragment has an offset==0 */
-        fragment_msg.offset = 0;
+        fragment_msg->offset = 0;
+        fragment_msg->prio = prio;
 
-        /* set the outgoing message's fields */
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = &fragment_msg;
-        /* send message to self */
-        msg_send_to_self(&msg);
+        gnrc_sixlowpan_frag_schedule(fragment_msg);
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
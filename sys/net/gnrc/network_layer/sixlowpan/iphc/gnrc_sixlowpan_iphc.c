@@ -17,6 +17,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
 #include "net/ieee802154.h"
@@ -75,6 +76,12 @@
 #define IPHC_M_DAC_DAM_M_8          (0x0b)
 #define IPHC_M_DAC_DAM_M_UC_PREFIX  (0x0c)
 
+/* maximum length of IPHC dispatch + inline fields (without NHC) */
+#define IPHC_HDR_MAX_LEN            (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                                     4U /* TF */ + 1U /* NH */ + 1U /* HL */ + \
+                                     (2 * sizeof(ipv6_addr_t)))
+
 #define NHC_ID_MASK                 (0xF8)
 #define NHC_UDP_ID                  (0xF0)
 #define NHC_UDP_PP_MASK             (0x03)
@@ -89,6 +96,87 @@
 #define NHC_UDP_8BIT_PORT           (0xF000)
 #define NHC_UDP_8BIT_MASK           (0xFF00)
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+/**
+ * @brief   Compression template for a flow
+ */
+typedef struct {
+    ipv6_hdr_t ipv6_hdr;                /**< IPv6 header of the flow (length
+                                         *   field zeroed) */
+    uint8_t src_l2addr[IEEE802154_LONG_ADDRESS_LEN];    /**< link-layer source */
+    uint8_t dst_l2addr[IEEE802154_LONG_ADDRESS_LEN];    /**< link-layer destination */
+    uint8_t src_l2addr_len;             /**< length of gnrc_sixlowpan_iphc_cache_t::src_l2addr */
+    uint8_t dst_l2addr_len;             /**< length of gnrc_sixlowpan_iphc_cache_t::dst_l2addr */
+    kernel_pid_t if_pid;                /**< interface the flow is sent over */
+    uint8_t iphc_hdr_len;               /**< length of gnrc_sixlowpan_iphc_cache_t::iphc_hdr,
+                                         *   0 if entry is unused */
+    unsigned ctx_state;                 /**< context buffer state the template
+                                         *   was created with */
+    uint8_t iphc_hdr[IPHC_HDR_MAX_LEN]; /**< IPHC dispatch and inline fields,
+                                         *   without the NHC header */
+} gnrc_sixlowpan_iphc_cache_t;
+
+static gnrc_sixlowpan_iphc_cache_t _cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _cache_next = 0;
+
+/* only called from the 6LoWPAN thread, so no locking is needed */
+static gnrc_sixlowpan_iphc_cache_t *_cache_get(gnrc_netif_hdr_t *netif_hdr,
+                                               const ipv6_hdr_t *key,
+                                               unsigned ctx_state)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        gnrc_sixlowpan_iphc_cache_t *entry = &_cache[i];
+
+        if ((entry->iphc_hdr_len > 0) && (entry->ctx_state == ctx_state) &&
+            (entry->if_pid == netif_hdr->if_pid) &&
+            (entry->src_l2addr_len == netif_hdr->src_l2addr_len) &&
+            (entry->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+            (memcmp(&entry->ipv6_hdr, key, sizeof(ipv6_hdr_t)) == 0) &&
+            (memcmp(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    entry->src_l2addr_len) == 0) &&
+            (memcmp(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    entry->dst_l2addr_len) == 0)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void _cache_set(gnrc_netif_hdr_t *netif_hdr, const ipv6_hdr_t *key,
+                       unsigned ctx_state, const uint8_t *iphc_hdr,
+                       size_t iphc_hdr_len)
+{
+    gnrc_sixlowpan_iphc_cache_t *entry = &_cache[_cache_next];
+
+    if ((netif_hdr->src_l2addr_len > sizeof(entry->src_l2addr)) ||
+        (netif_hdr->dst_l2addr_len > sizeof(entry->dst_l2addr)) ||
+        (iphc_hdr_len > sizeof(entry->iphc_hdr))) {
+        return;
+    }
+
+    _cache_next = (_cache_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    memcpy(&entry->ipv6_hdr, key, sizeof(ipv6_hdr_t));
+    memcpy(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    memcpy(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    entry->src_l2addr_len = netif_hdr->src_l2addr_len;
+    entry->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    entry->if_pid = netif_hdr->if_pid;
+    entry->ctx_state = ctx_state;
+    memcpy(entry->iphc_hdr, iphc_hdr, iphc_hdr_len);
+    entry->iphc_hdr_len = (uint8_t)iphc_hdr_len;
+    DEBUG("6lo iphc: cached compression template %p\n", (void *)entry);
+}
+
+void gnrc_sixlowpan_iphc_cache_flush(void)
+{
+    memset(_cache, 0, sizeof(_cache));
+    _cache_next = 0;
+}
+#endif
+
 static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
                                          ipv6_addr_t *addr,
                                          eui64_t *iid)
@@ -587,6 +675,50 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 }
 #endif
 
+static void _insert_dispatch(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *dispatch)
+{
+    /* remove IPv6 header */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+
+    /* insert dispatch into packet */
+    dispatch->next = pkt->next;
+    pkt->next = dispatch;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+static bool _encode_from_cache(gnrc_pktsnip_t *pkt,
+                               const gnrc_sixlowpan_iphc_cache_t *entry)
+{
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    bool nhc_comp = (entry->iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH);
+    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL,
+                                               entry->iphc_hdr_len + nhc_comp,
+                                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        return false;
+    }
+
+    memcpy(dispatch->data, entry->iphc_hdr, entry->iphc_hdr_len);
+
+    DEBUG("6lo iphc: using cached compression template %p\n", (void *)entry);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    if (nhc_comp) {
+        /* ports are not part of the template */
+        iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
+        ((uint8_t *)dispatch->data)[entry->iphc_hdr_len] = ipv6_hdr->nh;
+    }
+#else
+    (void)ipv6_hdr;
+#endif
+
+    _insert_dispatch(pkt, dispatch);
+
+    return true;
+}
+#endif
+
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
@@ -595,8 +727,26 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
     bool addr_comp = false, nhc_comp = false;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *dispatch;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    gnrc_sixlowpan_iphc_cache_t *entry;
+    /* the interface's IID is only part of the key if it is taken from the
+     * link-layer source address */
+    bool cacheable = true;
+    unsigned ctx_state = gnrc_sixlowpan_ctx_state();
+    ipv6_hdr_t key;
+
+    /* everything but the payload length determines the compressed header */
+    memcpy(&key, ipv6_hdr, sizeof(ipv6_hdr_t));
+    key.len.u16 = 0;
+
+    if ((entry = _cache_get(netif_hdr, &key, ctx_state)) != NULL) {
+        return _encode_from_cache(pkt, entry);
+    }
+#endif
+
+    dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
+                               GNRC_NETTYPE_SIXLOWPAN);
 
     if (dispatch == NULL) {
         DEBUG("6lo iphc: error allocating dispatch space\n");
@@ -728,6 +878,9 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                 /* but take from driver otherwise */
                 gnrc_netapi_get(netif_hdr->if_pid, NETOPT_IPV6_IID, 0, &iid,
                                 sizeof(eui64_t));
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+                cacheable = false;
+#endif
             }
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
@@ -875,6 +1028,12 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         inline_pos += 16;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    if (cacheable) {
+        _cache_set(netif_hdr, &key, ctx_state, iphc_hdr, inline_pos);
+    }
+#endif
+
     if (nhc_comp) {
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
@@ -883,12 +1042,7 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
     gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
 
-    /* remove IPv6 header */
-    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
-
-    /* insert dispatch into packet */
-    dispatch->next = pkt->next;
-    pkt->next = dispatch;
+    _insert_dispatch(pkt, dispatch);
 
     return true;
 }
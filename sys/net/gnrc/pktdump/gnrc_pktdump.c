@@ -23,6 +23,7 @@
 
 #include <errno.h>
 #include "byteorder.h"
+#include "fmt.h"
 #include "thread.h"
 #include "msg.h"
 #include "net/gnrc/pktdump.h"
@@ -47,51 +48,51 @@ static void _dump_snip(gnrc_pktsnip_t *pkt)
 {
     switch (pkt->type) {
         case GNRC_NETTYPE_UNDEF:
-            printf("NETTYPE_UNDEF (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_UNDEF (%i)\n", pkt->type);
             od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
             break;
 #ifdef MODULE_GNRC_NETIF
         case GNRC_NETTYPE_NETIF:
-            printf("NETTYPE_NETIF (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_NETIF (%i)\n", pkt->type);
             gnrc_netif_hdr_print(pkt->data);
             break;
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN
         case GNRC_NETTYPE_SIXLOWPAN:
-            printf("NETTYPE_SIXLOWPAN (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_SIXLOWPAN (%i)\n", pkt->type);
             sixlowpan_print(pkt->data, pkt->size);
             break;
 #endif
 #ifdef MODULE_GNRC_IPV6
         case GNRC_NETTYPE_IPV6:
-            printf("NETTYPE_IPV6 (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_IPV6 (%i)\n", pkt->type);
             ipv6_hdr_print(pkt->data);
             break;
 #endif
 #ifdef MODULE_GNRC_ICMPV6
         case GNRC_NETTYPE_ICMPV6:
-            printf("NETTYPE_ICMPV6 (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_ICMPV6 (%i)\n", pkt->type);
             break;
 #endif
 #ifdef MODULE_GNRC_TCP
         case GNRC_NETTYPE_TCP:
-            printf("NETTYPE_TCP (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_TCP (%i)\n", pkt->type);
             break;
 #endif
 #ifdef MODULE_GNRC_UDP
         case GNRC_NETTYPE_UDP:
-            printf("NETTYPE_UDP (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_UDP (%i)\n", pkt->type);
             udp_hdr_print(pkt->data);
             break;
 #endif
 #ifdef TEST_SUITES
         case GNRC_NETTYPE_TEST:
-            printf("NETTYPE_TEST (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_TEST (%i)\n", pkt->type);
             od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
             break;
 #endif
         default:
-            printf("NETTYPE_UNKNOWN (%i)\n", pkt->type);
+            fmt_printf("NETTYPE_UNKNOWN (%i)\n", pkt->type);
             od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
             break;
     }
@@ -104,15 +105,15 @@ static void _dump(gnrc_pktsnip_t *pkt)
     gnrc_pktsnip_t *snip = pkt;
 
     while (snip != NULL) {
-        printf("~~ SNIP %2i - size: %3u byte, type: ", snips,
-               (unsigned int)snip->size);
+        fmt_printf("~~ SNIP %2i - size: %3u byte, type: ", snips,
+                   (unsigned int)snip->size);
         _dump_snip(snip);
         ++snips;
         size += snip->size;
         snip = snip->next;
     }
 
-    printf("~~ PKT    - %2i snips, total size: %3i byte\n", snips, size);
+    fmt_printf("~~ PKT    - %2i snips, total size: %3i byte\n", snips, size);
     gnrc_pktbuf_release(pkt);
 }
 
@@ -25,6 +25,9 @@
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -278,6 +281,13 @@ void _update_lifetime(void)
                 }
             }
 
+            if (inst->dodag.dao_full_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
+                inst->dodag.dao_full_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
+            }
+            else {
+                inst->dodag.dao_full_time = 0;
+            }
+
             if (inst->dodag.dao_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
                 inst->dodag.dao_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
             }
@@ -291,6 +301,10 @@ void _update_lifetime(void)
     gnrc_rpl_p2p_update();
 #endif
 
+#ifdef MODULE_GNRC_RPL_NS
+    gnrc_rpl_ns_update();
+#endif
+
     xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 }
 
@@ -299,6 +313,7 @@ void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
     dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_synced = false;
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
@@ -306,6 +321,18 @@ void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
     dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_synced = false;
+}
+
+void gnrc_rpl_delta_dao(gnrc_rpl_dodag_t *dodag)
+{
+    /* the changes of an unacknowledged DAO would get lost otherwise */
+    if (dodag->dao_counter > 0) {
+        dodag->dao_synced = false;
+    }
+    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    dodag->dao_counter = 0;
+    dodag->dao_ack_received = false;
 }
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
@@ -316,6 +343,10 @@ void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
     }
 #endif
     if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
+        if (dodag->dao_counter > 0) {
+            /* retransmissions always carry all targets */
+            dodag->dao_synced = false;
+        }
         dodag->dao_counter++;
         gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
         dodag->dao_time = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
@@ -15,6 +15,9 @@
  * @author  Cenk Gündoğan <cnkgndgn@gmail.com>
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "net/af.h"
 #include "net/icmpv6.h"
 #include "net/ipv6/hdr.h"
@@ -34,6 +37,10 @@
 #include "net/gnrc/rpl/p2p.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_NS
+#include "net/gnrc/rpl/ns.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -48,6 +55,25 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_SHIFTED_MOP_MASK           (0x7)
 #define GNRC_RPL_PRF_MASK                   (0x7)
 #define GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT    (1 << 6)
+#define GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT  (1 << 5)
+#define GNRC_RPL_DAO_DELTA_EXTERNAL         (0x01)
+#define GNRC_RPL_DAO_DELTA_REMOVED          (0x02)
+#define GNRC_RPL_DAO_DELTA_SENT             (0x04)
+
+/**
+ * @brief   A target that changed since the last DAO to the preferred parent
+ */
+typedef struct {
+    gnrc_rpl_instance_t *inst;      /**< instance of the target, NULL if unused */
+    ipv6_addr_t target;             /**< the target */
+    uint8_t prefix_length;          /**< prefix length of the target */
+    uint8_t flags;                  /**< GNRC_RPL_DAO_DELTA_* flags */
+    uint8_t dao_seq;                /**< sequence of the last DAO the target was
+                                     *   sent in, if GNRC_RPL_DAO_DELTA_SENT is set */
+} _dao_delta_t;
+
+static _dao_delta_t _dao_deltas[GNRC_RPL_DAO_DELTA_NUMOF];
+static bool _dao_delta_changed;
 
 void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *dst,
                    ipv6_addr_t *dodag_id)
@@ -137,15 +163,16 @@ gnrc_pktsnip_t *_dio_prefix_info_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *do
     prefix_info = opt_snip->data;
     prefix_info->type = GNRC_RPL_OPT_PREFIX_INFO;
     prefix_info->length = GNRC_RPL_OPT_PREFIX_INFO_LEN;
-    /* auto-address configuration */
-    prefix_info->LAR_flags = GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT;
+    /* auto-address configuration, the prefix field holds the address of this
+     * node, which the children use as parent address in non-storing mode */
+    prefix_info->LAR_flags = GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT |
+                             GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT;
     prefix_info->valid_lifetime = dodag->netif_addr->valid;
     prefix_info->pref_lifetime = dodag->netif_addr->preferred;
     prefix_info->prefix_len = dodag->netif_addr->prefix_len;
     prefix_info->reserved = 0;
 
-    memset(&prefix_info->prefix, 0, sizeof(prefix_info->prefix));
-    ipv6_addr_init_prefix(&prefix_info->prefix, &dodag->dodag_id, dodag->netif_addr->prefix_len);
+    prefix_info->prefix = dodag->netif_addr->addr;
     return opt_snip;
 }
 #endif
@@ -289,6 +316,211 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
+static inline uint8_t _dao_prefix_length(uint8_t prefix_length)
+{
+    /* FIB entries without prefix length are host routes */
+    return ((prefix_length == 0) || (prefix_length > IPV6_ADDR_BIT_LEN)) ?
+           IPV6_ADDR_BIT_LEN : prefix_length;
+}
+
+static void _dao_delta_add(gnrc_rpl_instance_t *inst, ipv6_addr_t *target,
+                           uint8_t prefix_length, uint8_t flags)
+{
+    _dao_delta_t *free_delta = NULL;
+
+    /* the root does not send DAOs */
+    if (inst->dodag.node_status == GNRC_RPL_ROOT_NODE) {
+        return;
+    }
+
+    _dao_delta_changed = true;
+    prefix_length = _dao_prefix_length(prefix_length);
+    for (unsigned i = 0; i < GNRC_RPL_DAO_DELTA_NUMOF; i++) {
+        _dao_delta_t *delta = &_dao_deltas[i];
+
+        if (delta->inst == NULL) {
+            if (free_delta == NULL) {
+                free_delta = delta;
+            }
+        }
+        else if ((delta->inst == inst) && (delta->prefix_length == prefix_length) &&
+                 ipv6_addr_equal(&delta->target, target)) {
+            delta->flags = flags;
+            return;
+        }
+    }
+
+    if (free_delta == NULL) {
+        DEBUG("RPL: too many changed targets, next DAO contains all targets\n");
+        inst->dodag.dao_synced = false;
+        return;
+    }
+
+    free_delta->inst = inst;
+    free_delta->target = *target;
+    free_delta->prefix_length = prefix_length;
+    free_delta->flags = flags;
+}
+
+static size_t _dao_delta_count(gnrc_rpl_instance_t *inst, uint8_t mask, uint8_t flags)
+{
+    size_t res = 0;
+
+    for (unsigned i = 0; i < GNRC_RPL_DAO_DELTA_NUMOF; i++) {
+        if ((_dao_deltas[i].inst == inst) && ((_dao_deltas[i].flags & mask) == flags)) {
+            res++;
+        }
+    }
+    return res;
+}
+
+/* remembers that the changes were sent in the DAO with sequence dao_seq */
+static void _dao_delta_sent(gnrc_rpl_instance_t *inst, uint8_t dao_seq)
+{
+    for (unsigned i = 0; i < GNRC_RPL_DAO_DELTA_NUMOF; i++) {
+        if (_dao_deltas[i].inst == inst) {
+            _dao_deltas[i].flags |= GNRC_RPL_DAO_DELTA_SENT;
+            _dao_deltas[i].dao_seq = dao_seq;
+        }
+    }
+}
+
+/* forgets the changes the parent acknowledged with the DAO-ACK for dao_seq,
+ * changes made after that DAO was sent are kept */
+static void _dao_delta_acked(gnrc_rpl_instance_t *inst, uint8_t dao_seq)
+{
+    for (unsigned i = 0; i < GNRC_RPL_DAO_DELTA_NUMOF; i++) {
+        if ((_dao_deltas[i].inst == inst) &&
+            (_dao_deltas[i].flags & GNRC_RPL_DAO_DELTA_SENT) &&
+            (_dao_deltas[i].dao_seq == dao_seq)) {
+            _dao_deltas[i].inst = NULL;
+        }
+    }
+}
+
+/* installs a target received from src and remembers it for the next DAO if
+ * the parent does not know about it yet */
+static void _dao_target_install(gnrc_rpl_instance_t *inst, gnrc_rpl_opt_target_t *target,
+                                ipv6_addr_t *src, bool external, uint8_t path_lifetime)
+{
+    gnrc_rpl_dodag_t *dodag = &inst->dodag;
+    uint32_t fib_dst_flags = 0;
+    uint32_t next_hop_flags = (external) ? 0x0 : FIB_FLAG_RPL_ROUTE;
+    bool found = false, same_prefix = false, same_type = false, via_src = false;
+
+    if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
+        fib_dst_flags = ((uint32_t)(target->prefix_length) << FIB_FLAG_NET_PREFIX_SHIFT);
+    }
+
+    /* a lookup for the exact target is much cheaper than a FIB lookup, which
+     * searches for the longest matching prefix */
+    mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
+    for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
+        fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
+
+        if ((fentry->lifetime != 0) && (fentry->global != NULL) &&
+            (fentry->global->address_size == sizeof(ipv6_addr_t)) &&
+            (memcmp(fentry->global->address, &target->target, sizeof(ipv6_addr_t)) == 0)) {
+            found = true;
+            same_prefix = ((fentry->global_flags & FIB_FLAG_NET_PREFIX_MASK) == fib_dst_flags);
+            same_type = ((fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE) == next_hop_flags);
+            via_src = (fentry->next_hop != NULL) &&
+                      (memcmp(fentry->next_hop->address, src, sizeof(ipv6_addr_t)) == 0);
+            break;
+        }
+    }
+    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+
+    /* the FIB keys entries by address only, so an entry of another prefix
+     * length at the same address is a different route */
+    if (path_lifetime == 0) {
+        /* a no-path DAO must not remove a route that already moved to another child */
+        if (found && via_src && same_prefix) {
+            DEBUG("RPL: removing fib entry %s/%d\n",
+                  ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
+                  target->prefix_length);
+            fib_remove_entry(&gnrc_ipv6_fib_table, target->target.u8, sizeof(ipv6_addr_t));
+            _dao_delta_add(inst, &target->target, target->prefix_length,
+                           GNRC_RPL_DAO_DELTA_REMOVED);
+        }
+        return;
+    }
+
+    if (found && !same_prefix) {
+        DEBUG("RPL: %s is installed with another prefix length - ignore\n",
+              ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)));
+        return;
+    }
+
+    DEBUG("RPL: adding fib entry %s/%d 0x%" PRIx32 "\n",
+          ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
+          target->prefix_length,
+          fib_dst_flags);
+
+    if ((fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface, target->target.u8,
+                       sizeof(ipv6_addr_t), fib_dst_flags, src->u8,
+                       sizeof(ipv6_addr_t), next_hop_flags,
+                       (path_lifetime * dodag->lifetime_unit * SEC_IN_MS)) == 0) &&
+        !(found && same_type)) {
+        _dao_delta_add(inst, &target->target, target->prefix_length,
+                       (external) ? GNRC_RPL_DAO_DELTA_EXTERNAL : 0);
+    }
+}
+
+static void _dao_targets_install(gnrc_rpl_instance_t *inst, gnrc_rpl_opt_target_t *target,
+                                 gnrc_rpl_opt_t *end, ipv6_addr_t *src, bool external,
+                                 uint8_t path_lifetime)
+{
+    while (((uint8_t *) target < (uint8_t *) end) && (target->type == GNRC_RPL_OPT_TARGET)) {
+        _dao_target_install(inst, target, src, external, path_lifetime);
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) target) + sizeof(gnrc_rpl_opt_t) +
+                                            target->length);
+    }
+}
+
+#ifdef MODULE_GNRC_RPL_NS
+/* the root of a non-storing DODAG learns the parent of each target */
+static void _dao_links_install(gnrc_rpl_instance_t *inst, gnrc_rpl_opt_target_t *target,
+                               gnrc_rpl_opt_transit_t *transit)
+{
+    ipv6_addr_t *parent = (ipv6_addr_t *)(transit + 1);
+    uint32_t lifetime = transit->path_lifetime * inst->dodag.lifetime_unit;
+
+    if (transit->length < (GNRC_RPL_OPT_TRANSIT_INFO_LEN + sizeof(ipv6_addr_t))) {
+        DEBUG("RPL: RPL TRANSIT INFO DAO option without parent address\n");
+        return;
+    }
+    if (gnrc_ipv6_netif_find_by_addr(NULL, parent) != KERNEL_PID_UNDEF) {
+        parent = NULL;
+    }
+    while (((uint8_t *) target < (uint8_t *) transit) && (target->type == GNRC_RPL_OPT_TARGET)) {
+        if (transit->path_lifetime == 0) {
+            gnrc_rpl_ns_link_remove(&target->target);
+        }
+        else if (gnrc_rpl_ns_link_add(&target->target, parent, lifetime) < 0) {
+            DEBUG("RPL: unable to add link of %s\n",
+                  ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)));
+        }
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) target) + sizeof(gnrc_rpl_opt_t) +
+                                            target->length);
+    }
+}
+#endif
+
+/* remembers the address a parent advertised with the R flag of a PIO */
+static void _parent_global_addr_set(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *src,
+                                    ipv6_addr_t *addr)
+{
+    gnrc_rpl_parent_t *parent;
+
+    LL_FOREACH(dodag->parents, parent) {
+        if (ipv6_addr_equal(&parent->addr, src)) {
+            parent->global_addr = *addr;
+            return;
+        }
+    }
+}
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -298,7 +530,7 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
     gnrc_rpl_dodag_t *dodag = &inst->dodag;
     eui64_t iid;
     *included_opts = 0;
-    ipv6_addr_t *me;
+    ipv6_addr_t *me, prefix;
 
 #ifndef GNRC_RPL_WITHOUT_VALIDATION
     if (!gnrc_rpl_validation_options(msg_type, inst, opt, len)) {
@@ -354,13 +586,18 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
                 gnrc_rpl_opt_prefix_info_t *pi = (gnrc_rpl_opt_prefix_info_t *) opt;
+                if (pi->LAR_flags & GNRC_RPL_PREFIX_ROUTER_ADDRESS_BIT) {
+                    _parent_global_addr_set(dodag, src, &pi->prefix);
+                }
                 /* check for the auto address-configuration flag */
                 if ((gnrc_netapi_get(dodag->iface, NETOPT_IPV6_IID, 0, &iid, sizeof(eui64_t)) < 0)
                      && !(pi->LAR_flags & GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT)) {
                     break;
                 }
-                ipv6_addr_set_aiid(&pi->prefix, iid.uint8);
-                me = gnrc_ipv6_netif_add_addr(dodag->iface, &pi->prefix, pi->prefix_len, 0);
+                ipv6_addr_set_unspecified(&prefix);
+                ipv6_addr_init_prefix(&prefix, &pi->prefix, pi->prefix_len);
+                ipv6_addr_set_aiid(&prefix, iid.uint8);
+                me = gnrc_ipv6_netif_add_addr(dodag->iface, &prefix, pi->prefix_len, 0);
                 if (me) {
                     dodag->netif_addr = gnrc_ipv6_netif_addr_get(me);
                 }
@@ -371,27 +608,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 DEBUG("RPL: RPL TARGET DAO option parsed\n");
                 *included_opts |= ((uint32_t) 1) << GNRC_RPL_OPT_TARGET;
 
-                gnrc_rpl_opt_target_t *target = (gnrc_rpl_opt_target_t *) opt;
+                /* targets are installed with the transit information that follows them */
                 if (first_target == NULL) {
-                    first_target = target;
-                }
-
-                uint32_t fib_dst_flags = 0;
-
-                if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
-                    fib_dst_flags = ((uint32_t)(target->prefix_length) << FIB_FLAG_NET_PREFIX_SHIFT);
+                    first_target = (gnrc_rpl_opt_target_t *) opt;
                 }
-
-                DEBUG("RPL: adding fib entry %s/%d 0x%" PRIx32 "\n",
-                      ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
-                      target->prefix_length,
-                      fib_dst_flags);
-
-                fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface, target->target.u8,
-                              sizeof(ipv6_addr_t), fib_dst_flags, src->u8,
-                              sizeof(ipv6_addr_t), FIB_FLAG_RPL_ROUTE,
-                              (dodag->default_lifetime * dodag->lifetime_unit) *
-                              SEC_IN_MS);
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
@@ -404,24 +624,19 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
-                do {
-                    DEBUG("RPL: updating fib entry %s/%d\n",
-                          ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
-                          first_target->prefix_length);
-
-                    fib_update_entry(&gnrc_ipv6_fib_table,
-                                     first_target->target.u8,
-                                     sizeof(ipv6_addr_t), src->u8,
-                                     sizeof(ipv6_addr_t),
-                                     ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
-                                      0x0 : FIB_FLAG_RPL_ROUTE),
-                                     (transit->path_lifetime *
-                                      dodag->lifetime_unit * SEC_IN_MS));
-                    first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
-                                   sizeof(gnrc_rpl_opt_t) + first_target->length);
+#ifdef MODULE_GNRC_RPL_NS
+                if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+                    _dao_links_install(inst, first_target, transit);
+                }
+                else
+#endif
+                {
+                    /* without gnrc_rpl_ns the root of a non-storing DODAG
+                     * routes to the targets via the nodes that sent them */
+                    _dao_targets_install(inst, first_target, opt, src,
+                                         (transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG),
+                                         transit->path_lifetime);
                 }
-                while (first_target->type == GNRC_RPL_OPT_TARGET);
-
                 first_target = NULL;
                 break;
 
@@ -434,6 +649,12 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
         l += opt->length + sizeof(gnrc_rpl_opt_t);
         opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
     }
+
+    /* without a transit, the root of a non-storing DODAG does not know the parent */
+    if ((first_target != NULL) && (inst->mop != GNRC_RPL_MOP_NON_STORING_MODE)) {
+        DEBUG("RPL: RPL TARGET DAO options without RPL TRANSIT INFO DAO option\n");
+        _dao_targets_install(inst, first_target, opt, src, false, dodag->default_lifetime);
+    }
     return true;
 }
 
@@ -634,30 +855,130 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
-gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_t prefix_length)
+static void _dao_target_set(gnrc_rpl_opt_target_t *target, ipv6_addr_t *addr,
+                            uint8_t prefix_length)
 {
-    gnrc_rpl_opt_target_t *target;
-    gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_target_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return NULL;
-    }
-    target = opt_snip->data;
+    DEBUG("RPL: Send DAO - building target %s/%d\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), (int) prefix_length);
+
     target->type = GNRC_RPL_OPT_TARGET;
     target->length = sizeof(target->flags) + sizeof(target->prefix_length) + sizeof(target->target);
     target->flags = 0;
     target->prefix_length = prefix_length;
     target->target = *addr;
-    return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+#ifndef GNRC_RPL_WITHOUT_DAO_AGGREGATION
+static int _dao_target_cmp(const void *a, const void *b)
+{
+    const gnrc_rpl_opt_target_t *ta = a, *tb = b;
+    int res = memcmp(&ta->target, &tb->target, sizeof(ipv6_addr_t));
+
+    return (res != 0) ? res : ((int) ta->prefix_length - (int) tb->prefix_length);
+}
+
+static inline bool _dao_target_covers(gnrc_rpl_opt_target_t *a, gnrc_rpl_opt_target_t *b)
+{
+    return (a->prefix_length <= b->prefix_length) &&
+           (ipv6_addr_match_prefix(&a->target, &b->target) >= a->prefix_length);
+}
+
+static inline bool _dao_target_siblings(gnrc_rpl_opt_target_t *a, gnrc_rpl_opt_target_t *b)
+{
+    /* both halves of the next shorter prefix */
+    return (a->prefix_length == b->prefix_length) && (a->prefix_length > 0) &&
+           (ipv6_addr_match_prefix(&a->target, &b->target) == (a->prefix_length - 1));
+}
+
+/* checks if target is one of the targets in snip */
+static bool _dao_target_in(gnrc_rpl_opt_target_t *target, gnrc_pktsnip_t *snip)
+{
+    gnrc_rpl_opt_target_t *targets;
+    size_t num;
+
+    if (snip == NULL) {
+        return false;
+    }
+    targets = snip->data;
+    num = snip->size / sizeof(gnrc_rpl_opt_target_t);
+    for (size_t i = 0; i < num; i++) {
+        if ((targets[i].prefix_length == target->prefix_length) &&
+            (ipv6_addr_match_prefix(&targets[i].target, &target->target) >=
+             target->prefix_length)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Sorts the targets of a snip and merges them into as few prefixes as
+ * possible, without covering any address not covered before. Merging never
+ * yields one of the targets in removed, which are sent with a no-path transit
+ * behind the targets and would remove the merged route again. Host routes are
+ * not merged, the merged prefix would have the address of the lower one and
+ * take its place in the FIB of the parent. */
+static void _dao_targets_aggregate(gnrc_pktsnip_t *snip, gnrc_pktsnip_t *removed)
+{
+    gnrc_rpl_opt_target_t *targets;
+    size_t num, res = 0;
+
+    if (snip == NULL) {
+        return;
+    }
+
+    targets = snip->data;
+    num = snip->size / sizeof(gnrc_rpl_opt_target_t);
+
+    /* clear the bits behind the prefix, so only equal prefixes compare equal */
+    for (size_t i = 0; i < num; i++) {
+        uint8_t *addr = targets[i].target.u8;
+        unsigned bytes = targets[i].prefix_length >> 3;
+
+        if (targets[i].prefix_length & 0x7) {
+            addr[bytes++] &= (uint8_t)(0xff << (8 - (targets[i].prefix_length & 0x7)));
+        }
+        memset(addr + bytes, 0, sizeof(ipv6_addr_t) - bytes);
+    }
+
+    qsort(targets, num, sizeof(gnrc_rpl_opt_target_t), _dao_target_cmp);
+
+    /* targets[0 .. res - 1] are disjoint and sorted, so a following target
+     * can only be covered by or be a sibling of the last one */
+    for (size_t i = 0; i < num; i++) {
+        if ((res > 0) && _dao_target_covers(&targets[res - 1], &targets[i])) {
+            continue;
+        }
+        if (res != i) {
+            targets[res] = targets[i];
+        }
+        res++;
+        while ((res > 1) && (targets[res - 2].prefix_length < IPV6_ADDR_BIT_LEN) &&
+               _dao_target_siblings(&targets[res - 2], &targets[res - 1])) {
+            gnrc_rpl_opt_target_t merged = targets[res - 2];
+
+            merged.prefix_length--;
+            if (_dao_target_in(&merged, removed)) {
+                break;
+            }
+            targets[res - 2].prefix_length--;
+            res--;
+        }
+    }
+
+    if ((res < num) &&
+        (gnrc_pktbuf_realloc_data(snip, res * sizeof(gnrc_rpl_opt_target_t)) != 0)) {
+        DEBUG("RPL: Send DAO - unable to shrink targets\n");
+    }
+}
+#endif
+
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent != NULL) ? sizeof(ipv6_addr_t) : 0;
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -666,14 +987,145 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit = opt_snip->data;
     transit->type = GNRC_RPL_OPT_TRANSIT;
     transit->length = sizeof(transit->e_flags) + sizeof(transit->path_control) +
-                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime);
+                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime) +
+                      parent_len;
     transit->e_flags = (external) << GNRC_RPL_OPT_TRANSIT_E_FLAG_SHIFT;
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent != NULL) {
+        memcpy((transit + 1), parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
+/* prepends num uninitialized targets and their transit information to pkt */
+static gnrc_pktsnip_t *_dao_group_build(gnrc_pktsnip_t *pkt, size_t num, uint8_t lifetime,
+                                        bool external)
+{
+    gnrc_pktsnip_t *targets;
+
+    if ((pkt = _dao_transit_build(pkt, lifetime, external, NULL)) == NULL) {
+        return NULL;
+    }
+    if ((targets = gnrc_pktbuf_add(pkt, NULL, num * sizeof(gnrc_rpl_opt_target_t),
+                                   GNRC_NETTYPE_UNDEF)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return targets;
+}
+
+static void _dao_delta_targets_set(gnrc_rpl_instance_t *inst, gnrc_pktsnip_t *snip,
+                                   uint8_t mask, uint8_t flags)
+{
+    gnrc_rpl_opt_target_t *target;
+
+    if (snip == NULL) {
+        return;
+    }
+    target = snip->data;
+    for (unsigned i = 0; i < GNRC_RPL_DAO_DELTA_NUMOF; i++) {
+        _dao_delta_t *delta = &_dao_deltas[i];
+
+        if ((delta->inst == inst) && ((delta->flags & mask) == flags)) {
+            _dao_target_set(target++, &delta->target, delta->prefix_length);
+        }
+    }
+}
+
+static inline ipv6_addr_t *_dao_fib_target(fib_entry_t *fentry)
+{
+    ipv6_addr_t *addr;
+
+    if ((fentry->lifetime == 0) || (fentry->global == NULL)) {
+        return NULL;
+    }
+    addr = (ipv6_addr_t *) fentry->global->address;
+    return (ipv6_addr_is_global(addr)) ? addr : NULL;
+}
+
+/* prepends the DAO base object to the options in pkt and sends it */
+static void _dao_send(gnrc_rpl_instance_t *inst, gnrc_pktsnip_t *pkt, ipv6_addr_t *src,
+                      ipv6_addr_t *destination)
+{
+    gnrc_rpl_dodag_t *dodag = &inst->dodag;
+    gnrc_pktsnip_t *tmp;
+    gnrc_rpl_dao_t *dao;
+    bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
+
+    if (local_instance) {
+        if ((tmp = gnrc_pktbuf_add(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
+                                   GNRC_NETTYPE_UNDEF)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        pkt = tmp;
+    }
+
+    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = tmp;
+    dao = pkt->data;
+    dao->instance_id = inst->id;
+    if (local_instance) {
+        /* set the D flag to indicate that a DODAG id is present */
+        dao->k_d_flags = GNRC_RPL_DAO_D_BIT;
+    }
+    else {
+        dao->k_d_flags = 0;
+    }
+
+    /* set the K flag to indicate that ACKs are required */
+    dao->k_d_flags |= GNRC_RPL_DAO_K_BIT;
+    dao->dao_sequence = dodag->dao_seq;
+    dao->reserved = 0;
+
+    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DAO,
+                                 sizeof(icmpv6_hdr_t))) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = tmp;
+
+    gnrc_rpl_send(pkt, dodag->iface, src, destination, &dodag->dodag_id);
+
+    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+}
+
+/* in non-storing mode a node only advertises itself and its parent to the root */
+static gnrc_pktsnip_t *_dao_ns_build(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *me, uint8_t lifetime)
+{
+    gnrc_pktsnip_t *pkt, *target;
+    ipv6_addr_t parent = dodag->parents->global_addr;
+
+    /* the root needs an address of the parent that is valid in the whole
+     * DODAG. Parents that do not advertise theirs with the R flag of a PIO
+     * get the prefix of the PIO in front of their interface identifier. */
+    if (ipv6_addr_is_unspecified(&parent)) {
+        parent = dodag->parents->addr;
+        ipv6_addr_init_prefix(&parent, &dodag->netif_addr->addr,
+                              dodag->netif_addr->prefix_len);
+    }
+    if ((pkt = _dao_transit_build(NULL, lifetime, false, &parent)) == NULL) {
+        return NULL;
+    }
+    if ((target = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_target_t),
+                                  GNRC_NETTYPE_UNDEF)) == NULL) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    _dao_target_set(target->data, me, IPV6_ADDR_BIT_LEN);
+    return target;
+}
+
 void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
 {
     gnrc_rpl_dodag_t *dodag;
@@ -704,9 +1156,12 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         destination = &(dodag->parents->addr);
     }
 
-    gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
-    gnrc_rpl_dao_t *dao;
-    bool ext_processed = false, int_processed = false;
+    gnrc_pktsnip_t *pkt = NULL, *tg_int = NULL, *tg_ext = NULL, *tg_rm = NULL;
+    size_t num_int = 0, num_ext = 0, num_rm = 0;
+    /* only advertise the changed targets while the parent knows all others,
+     * but refresh all routes of the parent regularly */
+    bool full = !dodag->dao_synced || (lifetime == 0) || (dodag->dao_full_time == 0) ||
+                (_dao_delta_count(inst, 0, 0) == 0);
 
     /* find my address */
     ipv6_addr_t *me = NULL;
@@ -716,114 +1171,122 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         return;
     }
 
-    mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        if ((dodag->parents != NULL) && ((pkt = _dao_ns_build(dodag, me, lifetime)) != NULL)) {
+            /* the DAO travels over several hops to the root */
+            _dao_send(inst, pkt, me, &dodag->dodag_id);
+        }
+        return;
+    }
 
-    /* add external and RPL FIB entries */
-    for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
-        fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
-        if (fentry->lifetime != 0) {
-            if (!(fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE)) {
-                ptr = &tmp;
-                if (!ext_processed) {
-                    DEBUG("RPL: Send DAO - building external transit\n");
-                    if ((tmp = _dao_transit_build(NULL, lifetime, true)) == NULL) {
-                        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                        return;
-                    }
-                    ext_processed = true;
-                }
-            }
-            else {
-                ptr = &pkt;
-                if (!int_processed) {
-                    DEBUG("RPL: Send DAO - building internal transit\n");
-                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
-                        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                        return;
-                    }
-                    int_processed = true;
-                }
-            }
-            ipv6_addr_t *addr = (ipv6_addr_t *) fentry->global->address;
-            if (ipv6_addr_is_global(addr)) {
-                size_t prefix_length = (fentry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT);
-
-                DEBUG("RPL: Send DAO - building target %s/%d\n",
-                      ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
-                      (int) prefix_length);
-
-                if ((*ptr = _dao_target_build(*ptr, addr, (uint8_t) prefix_length)) == NULL) {
-                    DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                    return;
-                }
-            }
+    /* targets removed since the last DAO */
+    if (lifetime > 0) {
+        num_rm = _dao_delta_count(inst, GNRC_RPL_DAO_DELTA_REMOVED, GNRC_RPL_DAO_DELTA_REMOVED);
+    }
+    if (num_rm > 0) {
+        DEBUG("RPL: Send DAO - building no-path transit\n");
+        if ((pkt = tg_rm = _dao_group_build(NULL, num_rm, 0, false)) == NULL) {
+            return;
         }
+        _dao_delta_targets_set(inst, pkt, GNRC_RPL_DAO_DELTA_REMOVED,
+                               GNRC_RPL_DAO_DELTA_REMOVED);
     }
 
-    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+    if (full) {
+        mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
+
+        /* count first to put all targets of a transit into one snip */
+        for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
+            fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
 
-    if (tr_int) {
-        tr_int->next = tmp;
+            if (_dao_fib_target(fentry) != NULL) {
+                if (fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE) {
+                    num_int++;
+                }
+                else {
+                    num_ext++;
+                }
+            }
+        }
+        /* own address */
+        num_int++;
     }
     else {
-        pkt = tmp;
+        num_int = _dao_delta_count(inst, GNRC_RPL_DAO_DELTA_REMOVED | GNRC_RPL_DAO_DELTA_EXTERNAL,
+                                   0);
+        num_ext = _dao_delta_count(inst, GNRC_RPL_DAO_DELTA_REMOVED | GNRC_RPL_DAO_DELTA_EXTERNAL,
+                                   GNRC_RPL_DAO_DELTA_EXTERNAL);
     }
 
-    /* add own address */
-    DEBUG("RPL: Send DAO - building target %s/128\n",
-          ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
-    if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        return;
+    if (num_ext > 0) {
+        DEBUG("RPL: Send DAO - building external transit\n");
+        if ((pkt = tg_ext = _dao_group_build(pkt, num_ext, lifetime, true)) == NULL) {
+            if (full) {
+                mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+            }
+            return;
+        }
     }
-
-    bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
-
-    if (local_instance) {
-        if ((tmp = gnrc_pktbuf_add(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
-                                   GNRC_NETTYPE_UNDEF)) == NULL) {
-            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-            gnrc_pktbuf_release(pkt);
+    if (num_int > 0) {
+        DEBUG("RPL: Send DAO - building internal transit\n");
+        if ((pkt = tg_int = _dao_group_build(pkt, num_int, lifetime, false)) == NULL) {
+            if (full) {
+                mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+            }
             return;
         }
-        pkt = tmp;
     }
 
-    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
-    pkt = tmp;
-    dao = pkt->data;
-    dao->instance_id = inst->id;
-    if (local_instance) {
-        /* set the D flag to indicate that a DODAG id is present */
-        dao->k_d_flags = GNRC_RPL_DAO_D_BIT;
+    if (full) {
+        gnrc_rpl_opt_target_t *target_int = tg_int->data;
+        gnrc_rpl_opt_target_t *target_ext = (tg_ext) ? tg_ext->data : NULL;
+
+        /* add external and RPL FIB entries */
+        for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
+            fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
+            ipv6_addr_t *addr = _dao_fib_target(fentry);
+
+            if (addr != NULL) {
+                uint8_t prefix_length = _dao_prefix_length(fentry->global_flags >>
+                                                           FIB_FLAG_NET_PREFIX_SHIFT);
+
+                if (fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE) {
+                    _dao_target_set(target_int++, addr, prefix_length);
+                }
+                else {
+                    _dao_target_set(target_ext++, addr, prefix_length);
+                }
+            }
+        }
+
+        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+
+        /* add own address */
+        _dao_target_set(target_int, me, IPV6_ADDR_BIT_LEN);
     }
     else {
-        dao->k_d_flags = 0;
+        _dao_delta_targets_set(inst, tg_int,
+                               GNRC_RPL_DAO_DELTA_REMOVED | GNRC_RPL_DAO_DELTA_EXTERNAL, 0);
+        _dao_delta_targets_set(inst, tg_ext,
+                               GNRC_RPL_DAO_DELTA_REMOVED | GNRC_RPL_DAO_DELTA_EXTERNAL,
+                               GNRC_RPL_DAO_DELTA_EXTERNAL);
     }
 
-    /* set the K flag to indicate that ACKs are required */
-    dao->k_d_flags |= GNRC_RPL_DAO_K_BIT;
-    dao->dao_sequence = dodag->dao_seq;
-    dao->reserved = 0;
+#ifndef GNRC_RPL_WITHOUT_DAO_AGGREGATION
+    _dao_targets_aggregate(tg_int, tg_rm);
+    _dao_targets_aggregate(tg_ext, tg_rm);
+#endif
 
-    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DAO,
-                                 sizeof(icmpv6_hdr_t))) == NULL) {
-        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return;
+    /* the changes are kept until the parent acknowledges them, so they are
+     * sent again if the DAO gets lost. Removed targets are kept for the new
+     * parent after a no-path DAO. */
+    if (lifetime > 0) {
+        _dao_delta_sent(inst, dodag->dao_seq);
     }
-    pkt = tmp;
-
-    gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
-
-    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
+    if (full) {
+        dodag->dao_full_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
+    }
+    _dao_send(inst, pkt, NULL, destination);
 }
 
 void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t seq)
@@ -840,6 +1303,7 @@ void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination,
     gnrc_pktsnip_t *pkt;
     icmpv6_hdr_t *icmp;
     gnrc_rpl_dao_ack_t *dao_ack;
+    ipv6_addr_t *src = NULL;
     int size = sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_ack_t);
     bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
 
@@ -868,7 +1332,12 @@ void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination,
     dao_ack->dao_sequence = seq;
     dao_ack->status = 0;
 
-    gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
+    /* the DAO-ACK travels over several hops in non-storing mode */
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        gnrc_ipv6_netif_find_by_prefix(&src, &dodag->dodag_id);
+    }
+
+    gnrc_rpl_send(pkt, dodag->iface, src, destination, &dodag->dodag_id);
 }
 
 void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src, uint16_t len)
@@ -911,6 +1380,12 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         return;
     }
 
+    /* in non-storing mode only the root parses DAOs */
+    if ((inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+        (dodag->node_status != GNRC_RPL_ROOT_NODE)) {
+        return;
+    }
+
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
         return;
@@ -918,6 +1393,7 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
 #endif
 
     uint32_t included_opts = 0;
+    _dao_delta_changed = false;
     if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DAO, inst, opts, len, src, &included_opts)) {
         DEBUG("RPL: Error encountered during DAO option parsing - ignore DAO\n");
         return;
@@ -928,7 +1404,10 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         gnrc_rpl_send_DAO_ACK(inst, src, dao->dao_sequence);
     }
 
-    gnrc_rpl_delay_dao(dodag);
+    /* refreshed routes are advertised with the next regular DAO */
+    if (_dao_delta_changed) {
+        gnrc_rpl_delta_dao(dodag);
+    }
 }
 
 void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, uint16_t len)
@@ -968,8 +1447,19 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, uint
         return;
     }
 
+    /* 128 and above reject the DAO */
+    if (dao_ack->status < 128) {
+        _dao_delta_acked(inst, dao_ack->dao_sequence);
+    }
+
     dodag->dao_ack_received = true;
     gnrc_rpl_long_delay_dao(dodag);
+    dodag->dao_synced = true;
+
+    /* advertise targets that changed while waiting for the DAO-ACK */
+    if (_dao_delta_count(inst, GNRC_RPL_DAO_DELTA_SENT, 0) > 0) {
+        dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    }
 }
 
 /**
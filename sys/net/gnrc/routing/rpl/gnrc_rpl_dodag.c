@@ -152,6 +152,8 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->dao_seq = GNRC_RPL_COUNTER_INIT;
     dodag->dtsn = 0;
     dodag->dao_ack_received = false;
+    dodag->dao_synced = false;
+    dodag->dao_full_time = 0;
     dodag->dao_counter = 0;
     dodag->instance = instance;
     dodag->iface = iface;
@@ -203,6 +205,7 @@ bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
         LL_APPEND(dodag->parents, *parent);
         (*parent)->state = 1;
         (*parent)->addr = *addr;
+        ipv6_addr_set_unspecified(&(*parent)->global_addr);
         return true;
     }
 
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#include "net/gnrc/rpl/ns.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* parent of the nodes next to the root */
+#define NODE_ROOT           (UINT16_MAX)
+/* parent of nodes whose parent is unknown, also returned if no node is found */
+#define NODE_NONE           (UINT16_MAX - 1)
+/* open addressing needs free slots to terminate a search */
+#define INDEX_SIZE          (2 * GNRC_RPL_NS_NODES_NUMOF)
+/* the compression fields of the source routing header have four bits */
+#define COMPR_MAX           (15U)
+
+typedef struct {
+    ipv6_addr_t addr;       /**< address of the node */
+    uint32_t expires;       /**< expiry of the link to the parent in seconds */
+    uint16_t parent;        /**< index of the parent, NODE_ROOT, or NODE_NONE */
+    uint8_t route;          /**< cached route to the node + 1, 0 if none is cached */
+    bool used;              /**< entry in use */
+} _node_t;
+
+typedef struct {
+    uint16_t path[GNRC_RPL_NS_HOPS_MAX];    /**< nodes from the first hop to the destination */
+    uint8_t hops;                           /**< length of path, 0 if unused */
+    uint8_t compr;                          /**< CmprI and CmprE of the path */
+} _route_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+static _node_t _nodes[GNRC_RPL_NS_NODES_NUMOF];
+/* index of a node + 1 by the hash of its address, 0 for free slots */
+static uint16_t _index[INDEX_SIZE];
+static _route_t _routes[GNRC_RPL_NS_CACHE_SIZE];
+static unsigned _routes_next;
+
+/* xtimer_now() wraps after about 71 minutes, the seconds of xtimer_now64()
+ * only wrap after 136 years */
+static inline uint32_t _now_sec(void)
+{
+    return (uint32_t)(xtimer_now64() / SEC_IN_USEC);
+}
+
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    /* the nodes of a DODAG usually share their prefix */
+    uint32_t h = addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    h = (h ^ (h >> 16)) * 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % INDEX_SIZE;
+}
+
+static uint16_t _node_find(const ipv6_addr_t *addr)
+{
+    unsigned slot = _hash(addr);
+
+    for (unsigned i = 0; (i < INDEX_SIZE) && (_index[slot] != 0); i++) {
+        uint16_t node = _index[slot] - 1;
+
+        if (ipv6_addr_equal(&_nodes[node].addr, addr)) {
+            return node;
+        }
+        slot = (slot + 1) % INDEX_SIZE;
+    }
+    return NODE_NONE;
+}
+
+static uint16_t _node_add(const ipv6_addr_t *addr)
+{
+    unsigned slot = _hash(addr);
+    uint16_t node;
+
+    for (node = 0; node < GNRC_RPL_NS_NODES_NUMOF; node++) {
+        if (!_nodes[node].used) {
+            break;
+        }
+    }
+    if (node == GNRC_RPL_NS_NODES_NUMOF) {
+        return NODE_NONE;
+    }
+    while (_index[slot] != 0) {
+        slot = (slot + 1) % INDEX_SIZE;
+    }
+    _index[slot] = node + 1;
+    _nodes[node].addr = *addr;
+    _nodes[node].parent = NODE_NONE;
+    _nodes[node].route = 0;
+    _nodes[node].used = true;
+    return node;
+}
+
+static void _index_remove(uint16_t node)
+{
+    unsigned i = _hash(&_nodes[node].addr), j;
+
+    while (_index[i] != (node + 1)) {
+        i = (i + 1) % INDEX_SIZE;
+    }
+    /* move entries of the same probe sequence back into the gap */
+    j = i;
+    while (true) {
+        unsigned home;
+
+        j = (j + 1) % INDEX_SIZE;
+        if (_index[j] == 0) {
+            break;
+        }
+        home = _hash(&_nodes[_index[j] - 1].addr);
+        if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+            continue;
+        }
+        _index[i] = _index[j];
+        i = j;
+    }
+    _index[i] = 0;
+}
+
+static void _route_drop(_route_t *route)
+{
+    _nodes[route->path[route->hops - 1]].route = 0;
+    route->hops = 0;
+}
+
+/* drops the cached routes that lead over node */
+static void _routes_invalidate(uint16_t node)
+{
+    for (unsigned r = 0; r < GNRC_RPL_NS_CACHE_SIZE; r++) {
+        _route_t *route = &_routes[r];
+
+        for (unsigned h = 0; h < route->hops; h++) {
+            if (route->path[h] == node) {
+                _route_drop(route);
+                break;
+            }
+        }
+    }
+}
+
+static void _node_remove(uint16_t node)
+{
+    _routes_invalidate(node);
+    for (unsigned i = 0; i < GNRC_RPL_NS_NODES_NUMOF; i++) {
+        if (_nodes[i].used && (_nodes[i].parent == node)) {
+            _nodes[i].parent = NODE_NONE;
+        }
+    }
+    _index_remove(node);
+    _nodes[node].used = false;
+}
+
+static uint8_t _prefix_octets(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t res = 0;
+
+    while ((res < COMPR_MAX) && (a->u8[res] == b->u8[res])) {
+        res++;
+    }
+    return res;
+}
+
+/* every address is restored from the address of the hop before it */
+static uint8_t _route_compr(const _route_t *route)
+{
+    uint8_t compr_e = _prefix_octets(&_nodes[route->path[route->hops - 2]].addr,
+                                     &_nodes[route->path[route->hops - 1]].addr);
+    uint8_t compr_i = (route->hops > 2) ? COMPR_MAX : compr_e;
+
+    for (unsigned h = 0; (h + 2) < route->hops; h++) {
+        uint8_t compr = _prefix_octets(&_nodes[route->path[h]].addr,
+                                       &_nodes[route->path[h + 1]].addr);
+
+        if (compr < compr_i) {
+            compr_i = compr;
+        }
+    }
+    return (compr_i << 4) | compr_e;
+}
+
+static _route_t *_route_get(uint16_t dst)
+{
+    uint16_t path[GNRC_RPL_NS_HOPS_MAX];
+    uint16_t node = dst;
+    unsigned hops = 0;
+    _route_t *route;
+
+    if (_nodes[dst].route != 0) {
+        return &_routes[_nodes[dst].route - 1];
+    }
+    while (node != NODE_ROOT) {
+        /* too long paths also break loops */
+        if ((node == NODE_NONE) || (hops == GNRC_RPL_NS_HOPS_MAX)) {
+            DEBUG("RPL NS: no path to destination\n");
+            return NULL;
+        }
+        path[hops++] = node;
+        node = _nodes[node].parent;
+    }
+
+    route = &_routes[_routes_next];
+    if (route->hops > 0) {
+        _route_drop(route);
+    }
+    _nodes[dst].route = _routes_next + 1;
+    _routes_next = (_routes_next + 1) % GNRC_RPL_NS_CACHE_SIZE;
+    for (unsigned h = 0; h < hops; h++) {
+        route->path[h] = path[hops - h - 1];
+    }
+    route->hops = hops;
+    if (hops > 1) {
+        route->compr = _route_compr(route);
+    }
+    return route;
+}
+
+int gnrc_rpl_ns_link_add(const ipv6_addr_t *child, const ipv6_addr_t *parent,
+                         uint32_t lifetime)
+{
+    uint16_t c, p = NODE_ROOT;
+    uint32_t expires = _now_sec() + lifetime;
+    int res = 0;
+
+    if ((parent != NULL) && ipv6_addr_equal(child, parent)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&_mutex);
+    if (((c = _node_find(child)) == NODE_NONE) && ((c = _node_add(child)) == NODE_NONE)) {
+        DEBUG("RPL NS: node table full\n");
+        mutex_unlock(&_mutex);
+        return -ENOMEM;
+    }
+    _nodes[c].expires = expires;
+    if (parent != NULL) {
+        /* a parent may be heard of before its own DAO arrives */
+        if (((p = _node_find(parent)) == NODE_NONE) &&
+            ((p = _node_add(parent)) != NODE_NONE)) {
+            _nodes[p].expires = expires;
+        }
+        if (p == NODE_NONE) {
+            DEBUG("RPL NS: node table full\n");
+            res = -ENOMEM;
+        }
+    }
+    if (_nodes[c].parent != p) {
+        _routes_invalidate(c);
+        _nodes[c].parent = p;
+    }
+    mutex_unlock(&_mutex);
+
+    return res;
+}
+
+void gnrc_rpl_ns_link_remove(const ipv6_addr_t *child)
+{
+    uint16_t c;
+
+    mutex_lock(&_mutex);
+    if ((c = _node_find(child)) != NODE_NONE) {
+        _node_remove(c);
+    }
+    mutex_unlock(&_mutex);
+}
+
+/* size of the source routing header of a route with more than one hop */
+static size_t _srh_len(const _route_t *route, uint8_t *pad)
+{
+    uint8_t compr_i = route->compr >> 4, compr_e = route->compr & 0x0f;
+    size_t addrs_len = ((route->hops - 2) * (sizeof(ipv6_addr_t) - compr_i)) +
+                       (sizeof(ipv6_addr_t) - compr_e);
+
+    *pad = (8 - (addrs_len & 0x7)) & 0x7;
+    return sizeof(gnrc_rpl_srh_t) + addrs_len + *pad;
+}
+
+static void _srh_write(const _route_t *route, uint8_t *buf, size_t len, uint8_t pad)
+{
+    uint8_t compr_i = route->compr >> 4, compr_e = route->compr & 0x0f;
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *)buf;
+    uint8_t *addr = (uint8_t *)(srh + 1);
+
+    srh->nh = PROTNUM_IPV6_NONXT;
+    srh->len = (len - sizeof(gnrc_rpl_srh_t)) / 8;
+    srh->type = GNRC_RPL_SRH_TYPE;
+    srh->seg_left = route->hops - 1;
+    srh->compr = route->compr;
+    srh->pad_resv = pad << 4;
+    srh->resv = 0;
+    for (unsigned h = 1; h < route->hops; h++) {
+        uint8_t compr = ((h + 1) < route->hops) ? compr_i : compr_e;
+
+        memcpy(addr, &_nodes[route->path[h]].addr.u8[compr],
+               sizeof(ipv6_addr_t) - compr);
+        addr += sizeof(ipv6_addr_t) - compr;
+    }
+    memset(addr, 0, pad);
+}
+
+/* the route to dst, call with the mutex held */
+static _route_t *_srh_route(const ipv6_addr_t *dst)
+{
+    uint16_t node = _node_find(dst);
+
+    return (node == NODE_NONE) ? NULL : _route_get(node);
+}
+
+int gnrc_rpl_ns_srh_build(const ipv6_addr_t *dst, ipv6_addr_t *first_hop,
+                          uint8_t *buf, size_t buf_len)
+{
+    _route_t *route;
+    int res = 0;
+
+    mutex_lock(&_mutex);
+    if ((route = _srh_route(dst)) == NULL) {
+        mutex_unlock(&_mutex);
+        return -EHOSTUNREACH;
+    }
+    if (route->hops > 1) {
+        uint8_t pad;
+
+        res = _srh_len(route, &pad);
+        if ((buf != NULL) && (buf_len < (size_t)res)) {
+            res = -ENOBUFS;
+        }
+        else if (buf != NULL) {
+            _srh_write(route, buf, res, pad);
+        }
+    }
+    if ((res >= 0) && (first_hop != NULL)) {
+        *first_hop = _nodes[route->path[0]].addr;
+    }
+    mutex_unlock(&_mutex);
+
+    return res;
+}
+
+int gnrc_rpl_ns_srh_insert(gnrc_pktsnip_t *ipv6)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    gnrc_pktsnip_t *srh;
+    _route_t *route;
+    size_t len;
+    uint8_t pad;
+
+    /* the route is looked up once and the header is written right into the
+     * packet buffer, so both use the same route */
+    mutex_lock(&_mutex);
+    if ((route = _srh_route(&hdr->dst)) == NULL) {
+        mutex_unlock(&_mutex);
+        return -EHOSTUNREACH;
+    }
+    if (route->hops <= 1) {
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    len = _srh_len(route, &pad);
+    if ((srh = gnrc_pktbuf_add(ipv6->next, NULL, len, GNRC_NETTYPE_IPV6_EXT)) == NULL) {
+        mutex_unlock(&_mutex);
+        DEBUG("RPL NS: no space left in packet buffer\n");
+        return -ENOBUFS;
+    }
+    _srh_write(route, srh->data, len, pad);
+    hdr->dst = _nodes[route->path[0]].addr;
+    mutex_unlock(&_mutex);
+
+    ((gnrc_rpl_srh_t *)srh->data)->nh = hdr->nh;
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + len);
+    ipv6->next = srh;
+
+    return len;
+}
+
+void gnrc_rpl_ns_flush(void)
+{
+    mutex_lock(&_mutex);
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_index, 0, sizeof(_index));
+    memset(_routes, 0, sizeof(_routes));
+    _routes_next = 0;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_ns_update(void)
+{
+    uint32_t now = _now_sec();
+
+    mutex_lock(&_mutex);
+    for (uint16_t i = 0; i < GNRC_RPL_NS_NODES_NUMOF; i++) {
+        if (_nodes[i].used && ((int32_t)(_nodes[i].expires - now) <= 0)) {
+            DEBUG("RPL NS: link of node %u expired\n", (unsigned)i);
+            _node_remove(i);
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+/** @} */
@@ -15,6 +15,7 @@
 #include <string.h>
 #include <inttypes.h>
 
+#include "fmt.h"
 #include "od.h"
 
 #define _OCTAL_BYTE_LENGTH  (3)
@@ -69,7 +70,7 @@ static inline uint8_t _length(uint16_t flags)
     }
 }
 
-static inline void _bytes_format(char *format, uint16_t flags)
+static inline void _bytes_format(char *format, size_t size, uint16_t flags)
 {
     if (flags & OD_FLAGS_BYTES_CHAR) {
         strncpy(format, "    %c", sizeof("    %c"));
@@ -95,19 +96,19 @@ static inline void _bytes_format(char *format, uint16_t flags)
 
 #if !defined(__MACH__)
         case OD_FLAGS_BYTES_OCTAL | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%0%do", sizeof(short) * _OCTAL_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%do", sizeof(short) * _OCTAL_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_OCTAL | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%0%dlo", sizeof(long) * _OCTAL_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%dlo", sizeof(long) * _OCTAL_BYTE_LENGTH);
             break;
 #else   /* !defined(__MACH__) */
         case OD_FLAGS_BYTES_OCTAL | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %lu", sizeof(short) * _OCTAL_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %lu", sizeof(short) * _OCTAL_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_OCTAL | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %lu", sizeof(long) * _OCTAL_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %lu", sizeof(long) * _OCTAL_BYTE_LENGTH);
             break;
 #endif  /* !defined(__MACH__) */
 
@@ -129,19 +130,19 @@ static inline void _bytes_format(char *format, uint16_t flags)
 
 #if !defined(__MACH__)
         case OD_FLAGS_BYTES_INT | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%%dd", sizeof(short) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%dd", sizeof(short) * _INT_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_INT | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%%dld", sizeof(long) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%dld", sizeof(long) * _INT_BYTE_LENGTH);
             break;
 #else   /* !defined(__MACH__) */
         case OD_FLAGS_BYTES_INT | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%%ld", sizeof(short) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%ld", sizeof(short) * _INT_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_INT | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%%ld", sizeof(long) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%ld", sizeof(long) * _INT_BYTE_LENGTH);
             break;
 #endif  /* !defined(__MACH__) */
 
@@ -163,19 +164,19 @@ static inline void _bytes_format(char *format, uint16_t flags)
 
 #if !defined(__MACH__)
         case OD_FLAGS_BYTES_UINT | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%%uu", (unsigned)sizeof(short) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%uu", (unsigned)sizeof(short) * _INT_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_UINT | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%%ulu", sizeof(long) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%ulu", sizeof(long) * _INT_BYTE_LENGTH);
             break;
 #else   /* !defined(__MACH__) */
         case OD_FLAGS_BYTES_UINT | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%%lu", sizeof(short) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%lu", sizeof(short) * _INT_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_UINT | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%%lu", sizeof(long) * _INT_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%%lu", sizeof(long) * _INT_BYTE_LENGTH);
             break;
 #endif  /* !defined(__MACH__) */
 
@@ -197,19 +198,19 @@ static inline void _bytes_format(char *format, uint16_t flags)
 
 #if !defined(__MACH__)
         case OD_FLAGS_BYTES_HEX | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%0%ux", (unsigned)sizeof(short) * _HEX_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%ux", (unsigned)sizeof(short) * _HEX_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_HEX | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%0%ulx", (unsigned)sizeof(long) * _HEX_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%ulx", (unsigned)sizeof(long) * _HEX_BYTE_LENGTH);
             break;
 #else   /* !defined(__MACH__) */
         case OD_FLAGS_BYTES_HEX | OD_FLAGS_LENGTH_SHORT:
-            sprintf(format, " %%0%lx", sizeof(short) * _HEX_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%lx", sizeof(short) * _HEX_BYTE_LENGTH);
             break;
 
         case OD_FLAGS_BYTES_HEX | OD_FLAGS_LENGTH_LONG:
-            sprintf(format, " %%0%lx", sizeof(long) * _HEX_BYTE_LENGTH);
+            fmt_snprintf(format, size, " %%0%lx", sizeof(long) * _HEX_BYTE_LENGTH);
             break;
 #endif  /* !defined(__MACH__) */
 
@@ -226,44 +227,44 @@ static void _print_date(const void *data, size_t offset, char *format, uint8_t l
             if (flags & OD_FLAGS_BYTES_CHAR) {
                 switch (((signed char *)data)[offset]) {
                     case '\0':
-                        printf("   \\0");
+                        fmt_printf("   \\0");
                         return;
 
                     case '\a':
-                        printf("   \\a");
+                        fmt_printf("   \\a");
                         return;
 
                     case '\b':
-                        printf("   \\b");
+                        fmt_printf("   \\b");
                         return;
 
                     case '\f':
-                        printf("   \\f");
+                        fmt_printf("   \\f");
                         return;
 
                     case '\n':
-                        printf("   \\n");
+                        fmt_printf("   \\n");
                         return;
 
                     case '\r':
-                        printf("   \\r");
+                        fmt_printf("   \\r");
                         return;
 
                     case '\t':
-                        printf("   \\t");
+                        fmt_printf("   \\t");
                         return;
 
                     case '\v':
-                        printf("   \\v");
+                        fmt_printf("   \\v");
                         return;
 
                     default:
                         if (((signed char *)data)[offset] < 0) {
-                            printf("  %03o", ((unsigned char *)data)[offset]);
+                            fmt_printf("  %03o", ((unsigned char *)data)[offset]);
                             return;
                         }
                         else if (((signed char *)data)[offset] < 32) {
-                            printf("  %03o", ((char *)data)[offset]);
+                            fmt_printf("  %03o", ((char *)data)[offset]);
                             return;
                         }
 
@@ -273,20 +274,20 @@ static void _print_date(const void *data, size_t offset, char *format, uint8_t l
             }
 
             if (flags & OD_FLAGS_BYTES_INT) {
-                printf(format, ((int8_t *)data)[offset]);
+                fmt_printf(format, ((int8_t *)data)[offset]);
             }
             else {
-                printf(format, ((uint8_t *)data)[offset]);
+                fmt_printf(format, ((uint8_t *)data)[offset]);
             }
 
             break;
 
         case 2:
             if (flags & OD_FLAGS_BYTES_INT) {
-                printf(format, ((int16_t *)data)[offset]);
+                fmt_printf(format, ((int16_t *)data)[offset]);
             }
             else {
-                printf(format, ((uint16_t *)data)[offset]);
+                fmt_printf(format, ((uint16_t *)data)[offset]);
             }
 
             break;
@@ -294,20 +295,20 @@ static void _print_date(const void *data, size_t offset, char *format, uint8_t l
         case 4:
         default:
             if (flags & OD_FLAGS_BYTES_INT) {
-                printf(format, ((int32_t *)data)[offset]);
+                fmt_printf(format, ((int32_t *)data)[offset]);
             }
             else {
-                printf(format, ((uint32_t *)data)[offset]);
+                fmt_printf(format, ((uint32_t *)data)[offset]);
             }
 
             break;
 
         case 8:
             if (flags & OD_FLAGS_BYTES_INT) {
-                printf(format, ((int64_t *)data)[offset]);
+                fmt_printf(format, ((int64_t *)data)[offset]);
             }
             else {
-                printf(format, ((uint64_t *)data)[offset]);
+                fmt_printf(format, ((uint64_t *)data)[offset]);
             }
 
             break;
@@ -334,7 +335,7 @@ void od(const void *data, size_t data_len, uint8_t width, uint16_t flags)
     char bytes_format[_log10(date_length) + 7];
 
     _address_format(address_format, flags);
-    _bytes_format(bytes_format, flags);
+    _bytes_format(bytes_format, sizeof(bytes_format), flags);
 
     if (width == 0) {
         width = OD_WIDTH_DEFAULT;
@@ -355,18 +356,18 @@ void od(const void *data, size_t data_len, uint8_t width, uint16_t flags)
     }
 
     if ((flags & OD_FLAGS_ADDRESS_MASK) != OD_FLAGS_ADDRESS_NONE) {
-        printf(address_format, 0);
+        fmt_printf(address_format, 0);
     }
 
     for (size_t i = 0; i < data_len; i++) {
         _print_date(data, i, bytes_format, date_length, flags);
 
         if ((((i + 1) % width) == 0) || i == (data_len - 1)) {
-            printf("\n");
+            putchar('\n');
 
             if (i != (data_len - 1)) {
                 if ((flags & OD_FLAGS_ADDRESS_MASK) != OD_FLAGS_ADDRESS_NONE) {
-                    printf(address_format, date_length * (i + 1));
+                    fmt_printf(address_format, date_length * (i + 1));
                 }
             }
         }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_phydat_ts
+ * @{
+ *
+ * @file
+ * @brief       Phydat time series implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "phydat_ts.h"
+
+#define HDR_LEN         (0)
+#define HDR_COUNT       (2)
+#define HDR_DIM         (4)
+#define HDR_UNIT        (5)
+#define HDR_SCALE       (6)
+
+static inline void _put_u16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = (uint8_t)val;
+    buf[1] = (uint8_t)(val >> 8);
+}
+
+static inline uint16_t _get_u16(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8);
+}
+
+static inline uint32_t _zigzag(int32_t val)
+{
+    return ((uint32_t)val << 1) ^ (uint32_t)(val >> 31);
+}
+
+static inline int32_t _unzigzag(uint32_t val)
+{
+    return (int32_t)(val >> 1) ^ -(int32_t)(val & 1);
+}
+
+static inline uint8_t *_put_varint(uint8_t *buf, uint32_t val)
+{
+    while (val >= 0x80) {
+        *buf++ = (uint8_t)val | 0x80;
+        val >>= 7;
+    }
+    *buf++ = (uint8_t)val;
+    return buf;
+}
+
+/* returns NULL if the varint does not end before end */
+static inline const uint8_t *_get_varint(const uint8_t *buf,
+                                         const uint8_t *end, uint32_t *val)
+{
+    uint32_t res = 0;
+
+    for (unsigned shift = 0; (buf < end) && (shift < 35); shift += 7) {
+        uint8_t byte = *buf++;
+        res |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *val = res;
+            return buf;
+        }
+    }
+    return NULL;
+}
+
+int phydat_ts_init(phydat_ts_t *ts, void *buf, size_t size, uint8_t dim,
+                   uint8_t unit, int8_t scale)
+{
+    if ((dim == 0) || (dim > PHYDAT_DIM) || (size < PHYDAT_TS_HDR_LEN)) {
+        return -EINVAL;
+    }
+
+    ts->buf = buf;
+    /* the length has to fit into the header */
+    ts->size = (size > UINT16_MAX) ? UINT16_MAX : size;
+    ts->dim = dim;
+    ts->unit = unit;
+    ts->scale = scale;
+    ts->buf[HDR_DIM] = dim;
+    ts->buf[HDR_UNIT] = unit;
+    ts->buf[HDR_SCALE] = (uint8_t)scale;
+    phydat_ts_clear(ts);
+    return 0;
+}
+
+void phydat_ts_clear(phydat_ts_t *ts)
+{
+    ts->len = PHYDAT_TS_HDR_LEN;
+    ts->count = 0;
+    ts->time = 0;
+    ts->delta = 0;
+    memset(ts->val, 0, sizeof(ts->val));
+    _put_u16(&ts->buf[HDR_LEN], ts->len);
+    _put_u16(&ts->buf[HDR_COUNT], ts->count);
+}
+
+int phydat_ts_append(phydat_ts_t *ts, uint32_t time, const phydat_t *data)
+{
+    uint8_t tmp[PHYDAT_TS_SAMPLE_MAX];
+    uint8_t *start, *pos;
+    uint32_t delta = time - ts->time;
+
+    if ((data->unit != ts->unit) || (data->scale != ts->scale)) {
+        return -EINVAL;
+    }
+    if (ts->count == UINT16_MAX) {
+        return -EOVERFLOW;
+    }
+
+    /* encode in place unless the sample might not fit */
+    start = ((ts->size - ts->len) >= PHYDAT_TS_SAMPLE_MAX) ?
+            &ts->buf[ts->len] : tmp;
+    pos = _put_varint(start, _zigzag((int32_t)(delta - ts->delta)));
+    for (unsigned i = 0; i < ts->dim; i++) {
+        pos = _put_varint(pos, _zigzag((int32_t)data->val[i] - ts->val[i]));
+    }
+
+    size_t len = pos - start;
+    if (start == tmp) {
+        if (len > (ts->size - ts->len)) {
+            return -ENOSPC;
+        }
+        memcpy(&ts->buf[ts->len], tmp, len);
+    }
+
+    ts->len += len;
+    ts->count++;
+    ts->time = time;
+    ts->delta = delta;
+    memcpy(ts->val, data->val, ts->dim * sizeof(ts->val[0]));
+    _put_u16(&ts->buf[HDR_LEN], ts->len);
+    _put_u16(&ts->buf[HDR_COUNT], ts->count);
+    return 0;
+}
+
+int phydat_ts_flush(phydat_ts_t *ts, nvram_t *dev, uint32_t dst)
+{
+    int res = dev->write(dev, ts->buf, dst, ts->len);
+
+    if (res >= 0) {
+        phydat_ts_clear(ts);
+    }
+    return res;
+}
+
+int phydat_ts_load(nvram_t *dev, uint32_t src, void *buf_, size_t size)
+{
+    uint8_t *buf = buf_;
+    int res;
+
+    if (size < PHYDAT_TS_HDR_LEN) {
+        return -ENOBUFS;
+    }
+    res = dev->read(dev, buf, src, PHYDAT_TS_HDR_LEN);
+    if (res < 0) {
+        return res;
+    }
+
+    size_t len = _get_u16(&buf[HDR_LEN]);
+    if ((len < PHYDAT_TS_HDR_LEN) || (buf[HDR_DIM] == 0) ||
+        (buf[HDR_DIM] > PHYDAT_DIM)) {
+        return -EBADMSG;
+    }
+    if (len > size) {
+        return -ENOBUFS;
+    }
+
+    res = dev->read(dev, &buf[PHYDAT_TS_HDR_LEN], src + PHYDAT_TS_HDR_LEN,
+                    len - PHYDAT_TS_HDR_LEN);
+    return (res < 0) ? res : (int)len;
+}
+
+int phydat_ts_reader_init(phydat_ts_reader_t *reader, const void *buf_,
+                          size_t len)
+{
+    const uint8_t *buf = buf_;
+
+    if ((len < PHYDAT_TS_HDR_LEN) || (_get_u16(&buf[HDR_LEN]) > len) ||
+        (_get_u16(&buf[HDR_LEN]) < PHYDAT_TS_HDR_LEN) ||
+        (buf[HDR_DIM] == 0) || (buf[HDR_DIM] > PHYDAT_DIM)) {
+        return -EBADMSG;
+    }
+
+    reader->buf = buf;
+    reader->len = _get_u16(&buf[HDR_LEN]);
+    reader->pos = PHYDAT_TS_HDR_LEN;
+    reader->left = _get_u16(&buf[HDR_COUNT]);
+    reader->dim = buf[HDR_DIM];
+    reader->unit = buf[HDR_UNIT];
+    reader->scale = (int8_t)buf[HDR_SCALE];
+    reader->time = 0;
+    reader->delta = 0;
+    memset(reader->val, 0, sizeof(reader->val));
+    return 0;
+}
+
+int phydat_ts_read(phydat_ts_reader_t *reader, uint32_t *time,
+                   phydat_t *data)
+{
+    const uint8_t *pos = &reader->buf[reader->pos];
+    const uint8_t *end = &reader->buf[reader->len];
+    uint32_t val;
+
+    if (reader->left == 0) {
+        return 0;
+    }
+
+    pos = _get_varint(pos, end, &val);
+    if (pos == NULL) {
+        return -EBADMSG;
+    }
+    reader->delta += (uint32_t)_unzigzag(val);
+    reader->time += reader->delta;
+
+    for (unsigned i = 0; i < reader->dim; i++) {
+        pos = _get_varint(pos, end, &val);
+        if (pos == NULL) {
+            return -EBADMSG;
+        }
+        reader->val[i] += (int16_t)_unzigzag(val);
+    }
+
+    reader->pos = pos - reader->buf;
+    reader->left--;
+    *time = reader->time;
+    memcpy(data->val, reader->val, sizeof(data->val));
+    data->unit = reader->unit;
+    data->scale = reader->scale;
+    return 1;
+}
+
+int phydat_ts_read_range(phydat_ts_reader_t *reader, uint32_t from,
+                         uint32_t to, uint32_t *times, phydat_t *data,
+                         size_t max)
+{
+    size_t n = 0;
+
+    while (n < max) {
+        phydat_ts_reader_t prev = *reader;
+        uint32_t time;
+        int res = phydat_ts_read(reader, &time, &data[n]);
+
+        if (res <= 0) {
+            return (res < 0) ? res : (int)n;
+        }
+        if ((int32_t)(time - from) < 0) {
+            continue;
+        }
+        if ((int32_t)(time - to) > 0) {
+            /* leave the sample for the next range */
+            *reader = prev;
+            break;
+        }
+        if (times) {
+            times[n] = time;
+        }
+        n++;
+    }
+    return n;
+}
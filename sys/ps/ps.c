@@ -17,6 +17,7 @@
 
 #include <stdio.h>
 
+#include "fmt.h"
 #include "thread.h"
 #include "sched.h"
 #include "thread.h"
@@ -54,29 +55,29 @@ void ps(void)
     int overall_stacksz = 0, overall_used = 0;
 #endif
 
-    printf("\tpid | "
+    fmt_printf("\tpid | "
 #ifdef DEVELHELP
-            "%-21s| "
+                "%-21s| "
 #endif
-            "%-9sQ | pri "
+                "%-9sQ | pri "
 #ifdef DEVELHELP
-           "| stack ( used) | base       | current    "
+               "| stack ( used) | base       | current    "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime | switches"
+               "| runtime | switches"
 #endif
-           "\n",
+               "\n",
 #ifdef DEVELHELP
-           "name",
+               "name",
 #endif
-           "state");
+               "state");
 
 #ifdef DEVELHELP
     int isr_usage = thread_arch_isr_stack_usage();
     void *isr_start = thread_arch_isr_stack_start();
     void *isr_sp = thread_arch_isr_stack_pointer();
-    printf("\t  - | isr_stack            | -        - |"
-           "   - | %5i (%5i) | %10p | %10p\n", ISR_STACKSIZE, isr_usage, isr_start, isr_sp);
+    fmt_printf("\t  - | isr_stack            | -        - |"
+               "   - | %5i (%5i) | %10p | %10p\n", ISR_STACKSIZE, isr_usage, isr_start, isr_sp);
     overall_stacksz += ISR_STACKSIZE;
     if (isr_usage > 0) {
         overall_used += isr_usage;
@@ -100,36 +101,36 @@ void ps(void)
             double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now() * 100;
             int switches = sched_pidlist[i].schedules;
 #endif
-            printf("\t%3" PRIkernel_pid
+            fmt_printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
-                   " | %-20s"
+                       " | %-20s"
 #endif
-                   " | %-8s %.1s | %3i"
+                       " | %-8s %.1s | %3i"
 #ifdef DEVELHELP
-                   " | %5i (%5i) | %10p | %10p "
+                       " | %5i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %6.3f%% |  %8d"
+                       " | %6.3f%% |  %8d"
 #endif
-                   "\n",
-                   p->pid,
+                       "\n",
+                       p->pid,
 #ifdef DEVELHELP
-                   p->name,
+                       p->name,
 #endif
-                   sname, queued, p->priority
+                       sname, queued, p->priority
 #ifdef DEVELHELP
-                   , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
+                       , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_ticks, switches
+                       , runtime_ticks, switches
 #endif
-                  );
+                      );
         }
     }
 
 #ifdef DEVELHELP
-    printf("\t%5s %-21s|%13s%6s %5i (%5i)\n", "|", "SUM", "|", "|",
-           overall_stacksz, overall_used);
+    fmt_printf("\t%5s %-21s|%13s%6s %5i (%5i)\n", "|", "SUM", "|", "|",
+               overall_stacksz, overall_used);
 #   ifdef MODULE_TLSF
     puts("\nHeap usage:");
     tlsf_walk_pool(NULL);
@@ -29,11 +29,29 @@
  */
 saul_reg_t *saul_reg = NULL;
 
+/**
+ * @brief   The first SAUL_REG_INDEX_NUMOF entries of the list, by position
+ */
+static saul_reg_t *_index[SAUL_REG_INDEX_NUMOF];
 
-int saul_reg_add(saul_reg_t *dev)
+/**
+ * @brief   Number of entries in the list
+ */
+static unsigned _numof = 0;
+
+static inline unsigned _indexed(void)
 {
-    saul_reg_t *tmp = saul_reg;
+    return (_numof < SAUL_REG_INDEX_NUMOF) ? _numof : SAUL_REG_INDEX_NUMOF;
+}
+
+static saul_reg_t *_unindexed(void)
+{
+    return (_numof > SAUL_REG_INDEX_NUMOF) ?
+           _index[SAUL_REG_INDEX_NUMOF - 1]->next : NULL;
+}
 
+int saul_reg_add(saul_reg_t *dev)
+{
     if (dev == NULL) {
         return -ENODEV;
     }
@@ -45,11 +63,16 @@ int saul_reg_add(saul_reg_t *dev)
         saul_reg = dev;
     }
     else {
+        saul_reg_t *tmp = _index[_indexed() - 1];
         while (tmp->next != NULL) {
             tmp = tmp->next;
         }
         tmp->next = dev;
     }
+    if (_numof < SAUL_REG_INDEX_NUMOF) {
+        _index[_numof] = dev;
+    }
+    _numof++;
     return 0;
 }
 
@@ -63,23 +86,45 @@ int saul_reg_rm(saul_reg_t *dev)
     if (saul_reg == dev) {
         saul_reg = dev->next;
     }
-    while (tmp->next && (tmp->next != dev)) {
-        tmp = tmp->next;
-    }
-    if (tmp->next == dev) {
-        tmp->next = dev->next;
-    }
     else {
-        return -ENODEV;
+        while (tmp->next && (tmp->next != dev)) {
+            tmp = tmp->next;
+        }
+        if (tmp->next == dev) {
+            tmp->next = dev->next;
+        }
+        else {
+            return -ENODEV;
+        }
+    }
+
+    /* rebuild the index, removing devices is rare */
+    _numof = 0;
+    for (tmp = saul_reg; tmp; tmp = tmp->next) {
+        if (_numof < SAUL_REG_INDEX_NUMOF) {
+            _index[_numof] = tmp;
+        }
+        _numof++;
     }
     return 0;
 }
 
+unsigned saul_reg_numof(void)
+{
+    return _numof;
+}
+
 saul_reg_t *saul_reg_find_nth(int pos)
 {
-    saul_reg_t *tmp = saul_reg;
+    if (pos < 0) {
+        return NULL;
+    }
+    if ((unsigned)pos < _indexed()) {
+        return _index[pos];
+    }
 
-    for (int i = 0; (i < pos) && tmp; i++) {
+    saul_reg_t *tmp = _unindexed();
+    for (int i = SAUL_REG_INDEX_NUMOF; (i < pos) && tmp; i++) {
         tmp = tmp->next;
     }
     return tmp;
@@ -87,26 +132,30 @@ saul_reg_t *saul_reg_find_nth(int pos)
 
 saul_reg_t *saul_reg_find_type(uint8_t type)
 {
-    saul_reg_t *tmp = saul_reg;
-
-    while (tmp) {
+    for (unsigned i = 0; i < _indexed(); i++) {
+        if (_index[i]->driver->type == type) {
+            return _index[i];
+        }
+    }
+    for (saul_reg_t *tmp = _unindexed(); tmp; tmp = tmp->next) {
         if (tmp->driver->type == type) {
             return tmp;
         }
-        tmp = tmp->next;
     }
     return NULL;
 }
 
 saul_reg_t *saul_reg_find_name(const char *name)
 {
-    saul_reg_t *tmp = saul_reg;
-
-    while (tmp) {
+    for (unsigned i = 0; i < _indexed(); i++) {
+        if (strcmp(_index[i]->name, name) == 0) {
+            return _index[i];
+        }
+    }
+    for (saul_reg_t *tmp = _unindexed(); tmp; tmp = tmp->next) {
         if (strcmp(tmp->name, name) == 0) {
             return tmp;
         }
-        tmp = tmp->next;
     }
     return NULL;
 }
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_sampler
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "msg.h"
+#include "saul_sampler.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Message type to wake up the sampler after adding a set
+ */
+#define MSG_TYPE_WAKEUP     (0x0531)
+
+/**
+ * @brief   Devices read in one pass, ordered by bus
+ */
+typedef struct {
+    unsigned numof;
+    saul_reg_t *dev[SAUL_SAMPLER_PASS_NUMOF];
+    uint8_t bus[SAUL_SAMPLER_PASS_NUMOF];
+    int16_t dim[SAUL_SAMPLER_PASS_NUMOF];
+    uint32_t time[SAUL_SAMPLER_PASS_NUMOF];
+    phydat_t data[SAUL_SAMPLER_PASS_NUMOF];
+} _pass_t;
+
+static inline bool _due(const saul_sampler_set_t *set, uint32_t now)
+{
+    return (int32_t)(set->deadline - now) <= (int32_t)SAUL_SAMPLER_COALESCE;
+}
+
+static int _find(const _pass_t *pass, const saul_reg_t *dev)
+{
+    for (unsigned i = 0; i < pass->numof; i++) {
+        if (pass->dev[i] == dev) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* adds the devices of a set that are not part of the pass yet, or none at all
+ * if they do not fit */
+static bool _collect(_pass_t *pass, const saul_sampler_set_t *set)
+{
+    unsigned missing = 0;
+
+    for (unsigned i = 0; i < set->numof; i++) {
+        missing += (_find(pass, set->devs[i].dev) < 0);
+    }
+    if (pass->numof + missing > SAUL_SAMPLER_PASS_NUMOF) {
+        return false;
+    }
+
+    for (unsigned i = 0; i < set->numof; i++) {
+        const saul_sampler_dev_t *dev = &set->devs[i];
+        unsigned pos;
+
+        if (_find(pass, dev->dev) >= 0) {
+            continue;
+        }
+        /* insert behind the last device of the same or a lower bus */
+        for (pos = pass->numof; (pos > 0) && (pass->bus[pos - 1] > dev->bus); pos--) {
+            pass->dev[pos] = pass->dev[pos - 1];
+            pass->bus[pos] = pass->bus[pos - 1];
+        }
+        pass->dev[pos] = dev->dev;
+        pass->bus[pos] = dev->bus;
+        pass->numof++;
+    }
+    return true;
+}
+
+static bool _complete(const _pass_t *pass, const saul_sampler_set_t *set)
+{
+    for (unsigned i = 0; i < set->numof; i++) {
+        if (_find(pass, set->devs[i].dev) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _push(saul_sampler_t *sampler, const saul_sample_t *sample)
+{
+    if (sampler->avail == sampler->size) {
+        /* overwrite the oldest sample */
+        sampler->start = (sampler->start + 1) % sampler->size;
+        sampler->avail--;
+        sampler->lost++;
+    }
+    sampler->buf[(sampler->start + sampler->avail) % sampler->size] = *sample;
+    sampler->avail++;
+}
+
+void saul_sampler_init(saul_sampler_t *sampler, saul_sample_t *buf,
+                       size_t size)
+{
+    memset(sampler, 0, sizeof(*sampler));
+    sampler->buf = buf;
+    sampler->size = size;
+    sampler->pid = KERNEL_PID_UNDEF;
+    mutex_init(&sampler->lock);
+}
+
+int saul_sampler_add(saul_sampler_t *sampler, saul_sampler_set_t *set)
+{
+    if ((set->numof == 0) || (set->numof > SAUL_SAMPLER_PASS_NUMOF) ||
+        (set->period == 0)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&sampler->lock);
+    set->deadline = xtimer_now() + set->period;
+    set->next = sampler->sets;
+    sampler->sets = set;
+    mutex_unlock(&sampler->lock);
+
+    if (sampler->pid != KERNEL_PID_UNDEF) {
+        msg_t msg = { .type = MSG_TYPE_WAKEUP };
+        msg_try_send(&msg, sampler->pid);
+    }
+    return 0;
+}
+
+int saul_sampler_remove(saul_sampler_t *sampler, saul_sampler_set_t *set)
+{
+    int res = -ENOENT;
+
+    mutex_lock(&sampler->lock);
+    for (saul_sampler_set_t **tmp = &sampler->sets; *tmp; tmp = &(*tmp)->next) {
+        if (*tmp == set) {
+            *tmp = set->next;
+            res = 0;
+            break;
+        }
+    }
+    mutex_unlock(&sampler->lock);
+    return res;
+}
+
+uint32_t saul_sampler_poll(saul_sampler_t *sampler, uint32_t now)
+{
+    _pass_t pass;
+    uint32_t wait = UINT32_MAX;
+
+    pass.numof = 0;
+    mutex_lock(&sampler->lock);
+    for (saul_sampler_set_t *set = sampler->sets; set; set = set->next) {
+        if (_due(set, now)) {
+            _collect(&pass, set);
+        }
+    }
+    mutex_unlock(&sampler->lock);
+
+    /* do not block fetching while talking to the devices */
+    for (unsigned i = 0; i < pass.numof; i++) {
+        pass.time[i] = xtimer_now();
+        pass.dim[i] = saul_reg_read(pass.dev[i], &pass.data[i]);
+        DEBUG("saul_sampler: read %s: %i\n", pass.dev[i]->name, pass.dim[i]);
+    }
+
+    mutex_lock(&sampler->lock);
+    for (saul_sampler_set_t *set = sampler->sets; set; set = set->next) {
+        if (_due(set, now) && _complete(&pass, set)) {
+            for (unsigned i = 0; i < set->numof; i++) {
+                int pos = _find(&pass, set->devs[i].dev);
+                saul_sample_t sample = {
+                    .time = pass.time[pos],
+                    .data = pass.data[pos],
+                    .dim = pass.dim[pos],
+                    .set = set->id,
+                    .index = i,
+                };
+                _push(sampler, &sample);
+            }
+            /* skip the periods that were missed */
+            set->deadline += set->period;
+            if ((int32_t)(set->deadline - now) <= 0) {
+                set->deadline += ((now - set->deadline) / set->period + 1) * set->period;
+            }
+        }
+
+        uint32_t left = ((int32_t)(set->deadline - now) > 0) ? set->deadline - now : 0;
+        if (left < wait) {
+            wait = left;
+        }
+    }
+    mutex_unlock(&sampler->lock);
+
+    return wait;
+}
+
+void *saul_sampler_run(void *arg)
+{
+    saul_sampler_t *sampler = arg;
+    msg_t queue[2];
+    msg_t msg;
+
+    msg_init_queue(queue, 2);
+    sampler->pid = thread_getpid();
+
+    while (1) {
+        uint32_t now = xtimer_now();
+        uint32_t wait = saul_sampler_poll(sampler, now);
+        uint32_t spent = xtimer_now() - now;
+
+        if (wait == UINT32_MAX) {
+            msg_receive(&msg);
+        }
+        else if (wait > spent) {
+            xtimer_msg_receive_timeout(&msg, wait - spent);
+        }
+    }
+
+    return NULL;
+}
+
+size_t saul_sampler_fetch(saul_sampler_t *sampler, saul_sample_t *out,
+                          size_t max)
+{
+    mutex_lock(&sampler->lock);
+    size_t n = (max < sampler->avail) ? max : sampler->avail;
+    size_t first = sampler->size - sampler->start;
+
+    if (first > n) {
+        first = n;
+    }
+    memcpy(out, &sampler->buf[sampler->start], first * sizeof(*out));
+    memcpy(&out[first], sampler->buf, (n - first) * sizeof(*out));
+    sampler->start = (sampler->start + n) % sampler->size;
+    sampler->avail -= n;
+    mutex_unlock(&sampler->lock);
+
+    return n;
+}
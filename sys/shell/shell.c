@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include "fmt.h"
 #include "shell.h"
 #include "shell_commands.h"
 
@@ -75,7 +76,7 @@ static shell_command_handler_t find_handler(const shell_command_t *command_list,
 
 static void print_help(const shell_command_t *command_list)
 {
-    printf("%-20s %s\n", "Command", "Description");
+    fmt_printf("%-20s %s\n", "Command", "Description");
     puts("---------------------------------------");
 
     const shell_command_t *command_lists[] = {
@@ -92,7 +93,7 @@ static void print_help(const shell_command_t *command_list)
         if ((entry = command_lists[i])) {
             /* iterating over commands in command_lists entry */
             while (entry->name != NULL) {
-                printf("%-20s %s\n", entry->name, entry->desc);
+                fmt_printf("%-20s %s\n", entry->name, entry->desc);
                 entry++;
             }
         }
@@ -212,7 +213,7 @@ static void handle_input_line(const shell_command_t *command_list, char *line)
             print_help(command_list);
         }
         else {
-            printf("shell: command not found: %s\n", argv[0]);
+            fmt_printf("shell: command not found: %s\n", argv[0]);
         }
     }
 }
@@ -27,6 +27,7 @@
 #include "uart_stdio.h"
 
 #include "tsrb.h"
+#include "uart_txbuf.h"
 #include "thread.h"
 #include "mutex.h"
 #include "irq.h"
@@ -49,6 +50,14 @@ static mutex_t _rx_mutex = MUTEX_INIT;
 static char _rx_buf_mem[UART_STDIO_RX_BUFSIZE];
 static tsrb_t _rx_buf = TSRB_INIT(_rx_buf_mem);
 
+#if UART_STDIO_TX_BUFSIZE && !defined(USE_ETHOS_FOR_STDIO)
+/**
+ * @brief buffer for the output sent in the background
+ */
+static uint8_t _tx_buf_mem[UART_STDIO_TX_BUFSIZE];
+static uart_txbuf_t _tx_buf;
+#endif
+
 /**
  * @brief Receive a new character from the UART and put it into the receive buffer
  */
@@ -63,6 +72,10 @@ void uart_stdio_init(void)
 {
 #ifndef USE_ETHOS_FOR_STDIO
     uart_init(UART_STDIO_DEV, UART_STDIO_BAUDRATE, uart_stdio_rx_cb, NULL);
+#if UART_STDIO_TX_BUFSIZE
+    uart_txbuf_init(&_tx_buf, UART_STDIO_DEV, _tx_buf_mem,
+                    sizeof(_tx_buf_mem));
+#endif
 #else
     uart_init(ETHOS_UART, ETHOS_BAUDRATE, uart_stdio_rx_cb, NULL);
 #endif
@@ -79,7 +92,9 @@ int uart_stdio_read(char* buffer, int count)
 
 int uart_stdio_write(const char* buffer, int len)
 {
-#ifndef USE_ETHOS_FOR_STDIO
+#if !defined(USE_ETHOS_FOR_STDIO) && UART_STDIO_TX_BUFSIZE
+    uart_txbuf_write(&_tx_buf, buffer, (size_t)len);
+#elif !defined(USE_ETHOS_FOR_STDIO)
     uart_write(UART_STDIO_DEV, (uint8_t *)buffer, (size_t)len);
 #else
     ethos_send_frame(&ethos, (uint8_t*)buffer, len, ETHOS_FRAME_TYPE_TEXT);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_uart_txbuf
+ * @{
+ *
+ * @file
+ * @brief       UART transmit buffer implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "irq.h"
+#include "uart_txbuf.h"
+
+static void _kick(uart_txbuf_t *txbuf);
+
+/* called by the UART driver, usually in interrupt context */
+static void _tx_done(void *arg)
+{
+    uart_txbuf_t *txbuf = arg;
+
+    txbuf->reads += txbuf->sending;
+    txbuf->sending = 0;
+    if (txbuf->waiting) {
+        txbuf->waiting = 0;
+        mutex_unlock(&txbuf->done);
+    }
+    _kick(txbuf);
+}
+
+/* starts sending the next contiguous piece of the buffer, if idle */
+static void _kick(uart_txbuf_t *txbuf)
+{
+    unsigned state = irq_disable();
+
+    if (txbuf->sending || (txbuf->reads == txbuf->writes)) {
+        irq_restore(state);
+        return;
+    }
+    unsigned start = txbuf->reads & txbuf->mask;
+    unsigned len = txbuf->writes - txbuf->reads;
+    if (len > (txbuf->mask + 1 - start)) {
+        len = txbuf->mask + 1 - start;
+    }
+    txbuf->sending = len;
+    irq_restore(state);
+
+    /* the inline fallback calls _tx_done() before it returns */
+    if (uart_write_async(txbuf->uart, &txbuf->buf[start], len,
+                         _tx_done, txbuf) != 0) {
+        uart_write(txbuf->uart, &txbuf->buf[start], len);
+        _tx_done(txbuf);
+    }
+}
+
+/* copies as much of data as fits, must be called with interrupts disabled */
+static size_t _put(uart_txbuf_t *txbuf, const uint8_t *data, size_t len)
+{
+    unsigned free = txbuf->mask + 1 - (txbuf->writes - txbuf->reads);
+    unsigned start = txbuf->writes & txbuf->mask;
+    size_t first = txbuf->mask + 1 - start;
+
+    if (len > free) {
+        len = free;
+    }
+    if (first >= len) {
+        memcpy(&txbuf->buf[start], data, len);
+    }
+    else {
+        memcpy(&txbuf->buf[start], data, first);
+        memcpy(txbuf->buf, &data[first], len - first);
+    }
+    txbuf->writes += len;
+    return len;
+}
+
+/* waits for the next transmission to complete, must be called with
+ * interrupts disabled, which it restores */
+static void _wait(uart_txbuf_t *txbuf, unsigned state)
+{
+    txbuf->waiting = 1;
+    irq_restore(state);
+    /* unlocked right away if the transmission completed in between */
+    mutex_lock(&txbuf->done);
+}
+
+void uart_txbuf_init(uart_txbuf_t *txbuf, uart_t uart, uint8_t *buf,
+                     size_t size)
+{
+    assert((size != 0) && ((size & (size - 1)) == 0));
+
+    txbuf->uart = uart;
+    txbuf->buf = buf;
+    txbuf->mask = size - 1;
+    txbuf->reads = 0;
+    txbuf->writes = 0;
+    txbuf->sending = 0;
+    txbuf->waiting = 0;
+    mutex_init(&txbuf->lock);
+    mutex_init(&txbuf->done);
+    mutex_lock(&txbuf->done);
+}
+
+size_t uart_txbuf_write(uart_txbuf_t *txbuf, const void *data, size_t len)
+{
+    const uint8_t *pos = data;
+    size_t done = 0;
+    int in_isr = irq_is_in();
+
+    if (!in_isr) {
+        mutex_lock(&txbuf->lock);
+    }
+    while (done < len) {
+        unsigned state = irq_disable();
+        size_t n = _put(txbuf, &pos[done], len - done);
+
+        done += n;
+        if (n) {
+            irq_restore(state);
+            _kick(txbuf);
+        }
+        else if (in_isr) {
+            irq_restore(state);
+            break;
+        }
+        else {
+            /* the buffer is full, so a transmission is in flight */
+            _wait(txbuf, state);
+        }
+    }
+    if (!in_isr) {
+        mutex_unlock(&txbuf->lock);
+    }
+    return done;
+}
+
+void uart_txbuf_flush(uart_txbuf_t *txbuf)
+{
+    if (irq_is_in()) {
+        return;
+    }
+    mutex_lock(&txbuf->lock);
+    while (1) {
+        unsigned state = irq_disable();
+        if (txbuf->reads == txbuf->writes) {
+            irq_restore(state);
+            break;
+        }
+        _wait(txbuf, state);
+    }
+    mutex_unlock(&txbuf->lock);
+}
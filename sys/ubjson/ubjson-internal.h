@@ -21,6 +21,11 @@
 
 /* compare http://ubjson.org/type-reference/ */
 
+#include <stdint.h>
+#include <string.h>
+
+#include "byteorder.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -55,6 +60,46 @@ typedef enum {
     UBJSON_MARKER_TYPE         = '$',
 } ubjson_marker_t;
 
+/* markers and sizes of the elements of ubjson_array_type_t, in its order */
+static const char _ubjson_array_markers[] = {
+    UBJSON_MARKER_INT8, UBJSON_MARKER_UINT8, UBJSON_MARKER_INT16, UBJSON_MARKER_INT32,
+    UBJSON_MARKER_INT64, UBJSON_MARKER_FLOAT32, UBJSON_MARKER_FLOAT64,
+};
+static const uint8_t _ubjson_array_sizes[] = { 1, 1, 2, 4, 8, 4, 8 };
+
+/* converts count elements of size bytes between host and network byte order,
+ * dest may equal src */
+#define _UBJSON_SWAP_ARRAY(BITS, NTOH)                                        \
+    for (size_t i = 0; i < count; ++i) {                                      \
+        network_uint ## BITS ## _t v;                                         \
+        memcpy(&v, &src[i * (BITS / 8)], BITS / 8);                           \
+        uint ## BITS ## _t h = NTOH(v);                                       \
+        memcpy(&dest[i * (BITS / 8)], &h, BITS / 8);                          \
+    }
+
+static inline void _ubjson_swap_array(void *dest_, const void *src_, size_t size, size_t count)
+{
+    uint8_t *dest = dest_;
+    const uint8_t *src = src_;
+
+    switch (size) {
+        case 2:
+            _UBJSON_SWAP_ARRAY(16, byteorder_ntohs);
+            break;
+        case 4:
+            _UBJSON_SWAP_ARRAY(32, byteorder_ntohl);
+            break;
+        case 8:
+            _UBJSON_SWAP_ARRAY(64, byteorder_ntohll);
+            break;
+        default:
+            if (dest != src) {
+                memcpy(dest, src, size * count);
+            }
+            break;
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "ubjson-internal.h"
 #include "ubjson.h"
 #include "byteorder.h"
@@ -37,21 +39,39 @@
         }                                              \
     } while (0)
 
-static ubjson_read_callback_result_t _ubjson_read_marker(ubjson_cookie_t *restrict cookie,
-                                                         char *marker)
+static ssize_t _ubjson_refill(ubjson_cookie_t *restrict cookie)
 {
     while (1) {
-        ssize_t bytes_read;
+        ssize_t bytes_read = cookie->rw.read(cookie, cookie->buf, cookie->buf_size);
+        if (bytes_read > 0) {
+            cookie->buf_pos = 0;
+            cookie->buf_len = bytes_read;
+        }
+        if (bytes_read != 0) {
+            return bytes_read;
+        }
+    }
+}
 
+static ubjson_read_callback_result_t _ubjson_read_marker(ubjson_cookie_t *restrict cookie,
+                                                         char *marker)
+{
+    if (cookie->marker) {
         *marker = cookie->marker;
-        if (!*marker) {
-            bytes_read = cookie->rw.read(cookie, marker, 1);
-        }
-        else {
-            cookie->marker = 0;
-            bytes_read = 1;
+        cookie->marker = 0;
+        return UBJSON_OKAY;
+    }
+
+    if (cookie->buf) {
+        if ((cookie->buf_pos == cookie->buf_len) && (_ubjson_refill(cookie) < 0)) {
+            return UBJSON_PREMATURELY_ENDED;
         }
+        *marker = cookie->buf[cookie->buf_pos++];
+        return UBJSON_OKAY;
+    }
 
+    while (1) {
+        ssize_t bytes_read = cookie->rw.read(cookie, marker, 1);
         if (bytes_read == 1) {
             return UBJSON_OKAY;
         }
@@ -61,10 +81,9 @@ static ubjson_read_callback_result_t _ubjson_read_marker(ubjson_cookie_t *restri
     }
 }
 
-ssize_t ubjson_get_string(ubjson_cookie_t *restrict cookie, ssize_t length, void *dest_)
+static ssize_t _ubjson_read_direct(ubjson_cookie_t *restrict cookie, char *dest, ssize_t length)
 {
     ssize_t total = 0;
-    char *dest = dest_;
     while (total < length) {
         ssize_t read = cookie->rw.read(cookie, dest, length - total);
         if (read < 0) {
@@ -76,6 +95,41 @@ ssize_t ubjson_get_string(ubjson_cookie_t *restrict cookie, ssize_t length, void
     return total;
 }
 
+ssize_t ubjson_get_string(ubjson_cookie_t *restrict cookie, ssize_t length, void *dest_)
+{
+    char *dest = dest_;
+    if (!cookie->buf) {
+        return _ubjson_read_direct(cookie, dest, length);
+    }
+
+    ssize_t total = 0;
+    while (1) {
+        size_t avail = cookie->buf_len - cookie->buf_pos;
+        size_t missing = length - total;
+        if (avail >= missing) {
+            memcpy(dest, &cookie->buf[cookie->buf_pos], missing);
+            cookie->buf_pos += missing;
+            return length;
+        }
+
+        memcpy(dest, &cookie->buf[cookie->buf_pos], avail);
+        cookie->buf_pos = cookie->buf_len;
+        total += avail;
+        dest += avail;
+
+        if (missing - avail >= cookie->buf_size) {
+            /* large strings bypass the buffer */
+            ssize_t read = _ubjson_read_direct(cookie, dest, missing - avail);
+            return (read < 0) ? read : length;
+        }
+
+        ssize_t read = _ubjson_refill(cookie);
+        if (read < 0) {
+            return read;
+        }
+    }
+}
+
 ssize_t ubjson_get_i32(ubjson_cookie_t *restrict cookie, ssize_t content, int32_t *dest)
 {
     static const int8_t LENGHTS[] = { 1, 1, 2, 4 };
@@ -258,12 +312,14 @@ typedef bool (*_ubjson_read_struct_continue)(ubjson_cookie_t *restrict cookie, c
                                              ssize_t count, ssize_t index,
                                              ubjson_type_t *type1, ssize_t *content1);
 
-static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restrict cookie,
-                                                         _ubjson_read_struct_continue get_continue)
+static ubjson_read_callback_result_t _ubjson_read_header(ubjson_cookie_t *restrict cookie,
+                                                         ssize_t *count, char *type_marker)
 {
     ubjson_read_callback_result_t result;
-    ssize_t count = -1;
-    char marker, type_marker = 0;
+    char marker;
+
+    *count = -1;
+    *type_marker = 0;
 
     READ_MARKER();
 
@@ -272,33 +328,50 @@ static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restri
         if (marker == 0) {
             return UBJSON_INVALID_DATA;
         }
-        type_marker = marker;
+        *type_marker = marker;
         READ_MARKER();
+
+        if (marker != UBJSON_MARKER_COUNT) {
+            /* If a type is specified, a count must be specified as well.
+             * Otherwise a ']' could either be data (e.g. the character ']'),
+             * or be meant to close the array.
+             */
+            return UBJSON_INVALID_DATA;
+        }
     }
 
     if (marker == UBJSON_MARKER_COUNT) {
-        result = _ubjson_read_length(cookie, &count);
-        if (result != UBJSON_OKAY) {
-            return result;
-        }
-        READ_MARKER();
+        /* Do not read ahead: the elements of a typed container have no markers. */
+        return _ubjson_read_length(cookie, count);
     }
 
     cookie->marker = marker;
+    return UBJSON_OKAY;
+}
 
-    if ((type_marker != 0) && (count < 0)) {
-        /* If a type is specified, a count must be specified as well.
-         * Otherwise a ']' could either be data (e.g. the character ']'),
-         * or be meant to close the array.
-         */
-        return UBJSON_INVALID_DATA;
+static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restrict cookie,
+                                                         _ubjson_read_struct_continue get_continue)
+{
+    ubjson_read_callback_result_t result;
+    ssize_t count;
+    char marker, type_marker;
+
+    result = _ubjson_read_header(cookie, &count, &type_marker);
+    if (result != UBJSON_OKAY) {
+        return result;
     }
 
     for (ssize_t index = 0; (count < 0) || (index < count); ++index) {
         ubjson_type_t type1;
         ssize_t content1;
 
-        READ_MARKER();
+        if (type_marker != 0) {
+            /* the callback passes type_marker to ubjson_peek_value() */
+            marker = 0;
+        }
+        else {
+            READ_MARKER();
+        }
         if (!get_continue(cookie, marker, &result, count, index, &type1, &content1)
             || (result != UBJSON_OKAY)) {
             break;
@@ -390,3 +463,155 @@ ubjson_read_callback_result_t ubjson_peek_value(ubjson_cookie_t *restrict cookie
     }
     return _ubjson_get_call(cookie, marker, type, content);
 }
+
+static bool _ubjson_store_int(ubjson_array_type_t type, void *dest, size_t index, int64_t value)
+{
+    switch (type) {
+        case UBJSON_ARRAY_INT8:
+            if ((value < INT8_MIN) || (value > INT8_MAX)) {
+                return false;
+            }
+            ((int8_t *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_UINT8:
+            if ((value < 0) || (value > UINT8_MAX)) {
+                return false;
+            }
+            ((uint8_t *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_INT16:
+            if ((value < INT16_MIN) || (value > INT16_MAX)) {
+                return false;
+            }
+            ((int16_t *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_INT32:
+            if ((value < INT32_MIN) || (value > INT32_MAX)) {
+                return false;
+            }
+            ((int32_t *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_INT64:
+            ((int64_t *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_FLOAT:
+            ((float *) dest)[index] = value;
+            return true;
+        case UBJSON_ARRAY_DOUBLE:
+            ((double *) dest)[index] = value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static ubjson_read_callback_result_t _ubjson_get_element(ubjson_cookie_t *restrict cookie,
+                                                         char marker, ubjson_array_type_t type,
+                                                         void *dest, size_t index)
+{
+    ubjson_type_t type1;
+    ssize_t content1;
+    ubjson_read_callback_result_t result = _ubjson_get_call(cookie, marker, &type1, &content1);
+    if (result != UBJSON_OKAY) {
+        return result;
+    }
+
+    ssize_t read;
+    if (type1 == UBJSON_TYPE_INT32) {
+        int32_t value;
+        read = ubjson_get_i32(cookie, content1, &value);
+        if ((read > 0) && !_ubjson_store_int(type, dest, index, value)) {
+            return UBJSON_INVALID_DATA;
+        }
+    }
+    else if (type1 == UBJSON_TYPE_INT64) {
+        int64_t value;
+        read = ubjson_get_i64(cookie, content1, &value);
+        if ((read > 0) && !_ubjson_store_int(type, dest, index, value)) {
+            return UBJSON_INVALID_DATA;
+        }
+    }
+    else if ((type1 == UBJSON_TYPE_FLOAT) || (type1 == UBJSON_TYPE_DOUBLE)) {
+        double value;
+        if (type1 == UBJSON_TYPE_FLOAT) {
+            float f;
+            read = ubjson_get_float(cookie, content1, &f);
+            value = f;
+        }
+        else {
+            read = ubjson_get_double(cookie, content1, &value);
+        }
+
+        if (type == UBJSON_ARRAY_FLOAT) {
+            ((float *) dest)[index] = value;
+        }
+        else if (type == UBJSON_ARRAY_DOUBLE) {
+            ((double *) dest)[index] = value;
+        }
+        else {
+            return UBJSON_INVALID_DATA;
+        }
+    }
+    else {
+        return UBJSON_INVALID_DATA;
+    }
+
+    return (read > 0) ? UBJSON_OKAY : UBJSON_PREMATURELY_ENDED;
+}
+
+ubjson_read_callback_result_t ubjson_get_array(ubjson_cookie_t *restrict cookie,
+                                               ubjson_array_type_t type,
+                                               void *dest, size_t *count_)
+{
+    if ((unsigned) type >= sizeof(_ubjson_array_sizes)) {
+        return UBJSON_INVALID_DATA;
+    }
+
+    ubjson_read_callback_result_t result;
+    ssize_t count;
+    char marker, type_marker;
+
+    result = _ubjson_read_header(cookie, &count, &type_marker);
+    if (result != UBJSON_OKAY) {
+        return result;
+    }
+    else if ((count >= 0) && ((size_t) count > *count_)) {
+        return UBJSON_SIZE_ERROR;
+    }
+
+    if ((count >= 0) && (type_marker == _ubjson_array_markers[type])) {
+        /* the elements are stored just like in dest, except for the byte order */
+        size_t size = _ubjson_array_sizes[type];
+        if (ubjson_get_string(cookie, count * size, dest) < 0) {
+            return UBJSON_PREMATURELY_ENDED;
+        }
+        _ubjson_swap_array(dest, dest, size, count);
+        *count_ = count;
+        return UBJSON_OKAY;
+    }
+
+    size_t index;
+    for (index = 0; (count < 0) || (index < (size_t) count); ++index) {
+        if (type_marker != 0) {
+            marker = type_marker;
+        }
+        else {
+            READ_MARKER();
+            if ((count < 0) && (marker == UBJSON_MARKER_ARRAY_END)) {
+                break;
+            }
+        }
+
+        if (index >= *count_) {
+            return UBJSON_SIZE_ERROR;
+        }
+
+        result = _ubjson_get_element(cookie, marker, type, dest, index);
+        if (result != UBJSON_OKAY) {
+            return result;
+        }
+    }
+
+    *count_ = index;
+    return UBJSON_OKAY;
+}
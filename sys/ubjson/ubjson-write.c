@@ -30,6 +30,7 @@
 #include "byteorder.h"
 
 #include <limits.h>
+#include <string.h>
 
 #define WRITE_CALL(FUN, ...)                                                  \
     do {                                                                      \
@@ -41,14 +42,57 @@
     } while (0)
 
 #define WRITE_BUF(BUF, COUNT) \
-    WRITE_CALL(cookie->rw.write, cookie, (BUF), (COUNT))
+    WRITE_CALL(_ubjson_write, cookie, (BUF), (COUNT))
 
 #define WRITE_MARKER(MARKER)                                                  \
     do {                                                                      \
-        char marker_buf[] = { (char) (MARKER) };                              \
-        WRITE_BUF(marker_buf, 1);                                             \
+        if (cookie->buf && (cookie->buf_pos < cookie->buf_size)) {            \
+            cookie->buf[cookie->buf_pos++] = (uint8_t) (MARKER);              \
+            ++result;                                                         \
+        }                                                                     \
+        else {                                                                \
+            char marker_buf[] = { (char) (MARKER) };                          \
+            WRITE_BUF(marker_buf, 1);                                         \
+        }                                                                     \
     } while (0)
 
+ssize_t ubjson_write_flush(ubjson_cookie_t *restrict cookie)
+{
+    if (!cookie->buf || (cookie->buf_pos == 0)) {
+        return 0;
+    }
+
+    size_t len = cookie->buf_pos;
+    cookie->buf_pos = 0;
+    return cookie->rw.write(cookie, cookie->buf, len);
+}
+
+static ssize_t _ubjson_write_slow(ubjson_cookie_t *restrict cookie, const void *buf, size_t len)
+{
+    if (cookie->buf) {
+        ssize_t wrote = ubjson_write_flush(cookie);
+        if (wrote < 0) {
+            return wrote;
+        }
+        if (len < cookie->buf_size) {
+            memcpy(cookie->buf, buf, len);
+            cookie->buf_pos = len;
+            return len;
+        }
+    }
+    return cookie->rw.write(cookie, buf, len);
+}
+
+static inline ssize_t _ubjson_write(ubjson_cookie_t *restrict cookie, const void *buf, size_t len)
+{
+    if (cookie->buf && (cookie->buf_size - cookie->buf_pos >= len)) {
+        memcpy(&cookie->buf[cookie->buf_pos], buf, len);
+        cookie->buf_pos += len;
+        return len;
+    }
+    return _ubjson_write_slow(cookie, buf, len);
+}
+
 #define MARKER_FUN(NAME, MARKER)                                              \
     ssize_t NAME(ubjson_cookie_t *restrict cookie)                            \
     {                                                                         \
@@ -68,9 +112,9 @@ MARKER_FUN(ubjson_close_object, UBJSON_MARKER_OBJECT_END)
 
 ssize_t ubjson_write_bool(ubjson_cookie_t *restrict cookie, bool value)
 {
-    static const char marker_false[] = { UBJSON_MARKER_FALSE };
-    static const char marker_true[] = { UBJSON_MARKER_TRUE };
-    return cookie->rw.write(cookie, value ? &marker_false : &marker_true, 1);
+    ssize_t result = 0;
+    WRITE_MARKER(value ? UBJSON_MARKER_TRUE : UBJSON_MARKER_FALSE);
+    return result;
 }
 
 ssize_t ubjson_write_i32(ubjson_cookie_t *restrict cookie, int32_t value)
@@ -104,6 +148,7 @@ ssize_t ubjson_write_i64(ubjson_cookie_t *restrict cookie, int64_t value)
     }
 
     ssize_t result = 0;
+    WRITE_MARKER(UBJSON_MARKER_INT64);
     network_uint64_t buf = byteorder_htonll((uint64_t) value);
     WRITE_BUF(&buf, sizeof(buf));
     return result;
@@ -166,6 +211,41 @@ ssize_t ubjson_open_array_len(ubjson_cookie_t *restrict cookie, size_t len)
     return result;
 }
 
+ssize_t ubjson_write_array(ubjson_cookie_t *restrict cookie, ubjson_array_type_t type,
+                           const void *values, size_t count)
+{
+    if ((unsigned) type >= sizeof(_ubjson_array_sizes)) {
+        return -1;
+    }
+
+    ssize_t result = 0;
+    WRITE_MARKER(UBJSON_MARKER_ARRAY_START);
+    WRITE_MARKER(UBJSON_MARKER_TYPE);
+    WRITE_MARKER(_ubjson_array_markers[type]);
+    WRITE_CALL(_ubjson_write_length, cookie, count);
+
+    size_t size = _ubjson_array_sizes[type];
+    if (size == 1) {
+        WRITE_BUF(values, count);
+        return result;
+    }
+
+    /* convert to network byte order in chunks */
+    const uint8_t *src = values;
+    uint64_t chunk[8];
+    while (count > 0) {
+        size_t n = sizeof(chunk) / size;
+        if (n > count) {
+            n = count;
+        }
+        _ubjson_swap_array(chunk, src, size, n);
+        WRITE_BUF(chunk, n * size);
+        src += n * size;
+        count -= n;
+    }
+    return result;
+}
+
 ssize_t ubjson_open_object_len(ubjson_cookie_t *restrict cookie, size_t len)
 {
     ssize_t result = 0;
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the base64 encoder and decoder
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "base64.h"
+#include "board.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define DATA_LEN        (768U)
+#define BASE64_LEN      ((DATA_LEN / 3) * 4)
+/* size of the chunks of the streaming API */
+#define CHUNK_LEN       (64U)
+
+static unsigned char _data[DATA_LEN];
+static unsigned char _base64[BASE64_LEN];
+static unsigned char _out[BASE64_LEN];
+
+static int _encode(void)
+{
+    size_t size = sizeof(_out);
+
+    base64_encode(_data, sizeof(_data), _out, &size);
+    return sizeof(_data);
+}
+
+static int _encode_url(void)
+{
+    size_t size = sizeof(_out);
+
+    base64url_encode(_data, sizeof(_data), _out, &size);
+    return sizeof(_data);
+}
+
+static int _encode_stream(void)
+{
+    base64_ctx_t ctx;
+    size_t used = 0;
+    size_t size;
+
+    base64_encode_init(&ctx);
+    for (unsigned pos = 0; pos < sizeof(_data); pos += CHUNK_LEN) {
+        size = sizeof(_out) - used;
+        base64_encode_update(&ctx, _data + pos, CHUNK_LEN, _out + used, &size);
+        used += size;
+    }
+    size = sizeof(_out) - used;
+    base64_encode_finish(&ctx, _out + used, &size);
+    return sizeof(_data);
+}
+
+static int _decode(void)
+{
+    size_t size = sizeof(_out);
+
+    base64_decode(_base64, sizeof(_base64), _out, &size);
+    return sizeof(_data);
+}
+
+static int _decode_stream(void)
+{
+    base64_ctx_t ctx;
+    size_t used = 0;
+    size_t size;
+
+    base64_decode_init(&ctx);
+    for (unsigned pos = 0; pos < sizeof(_base64); pos += CHUNK_LEN) {
+        size = sizeof(_out) - used;
+        base64_decode_update(&ctx, _base64 + pos, CHUNK_LEN, _out + used, &size);
+        used += size;
+    }
+    size = sizeof(_out) - used;
+    base64_decode_finish(&ctx, _out + used, &size);
+    return sizeof(_data);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long bytes = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        bytes += test();
+    } while (done == 0);
+
+    bytes /= TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu bytes per second, %lu cycles per byte\n", name, bytes,
+           (unsigned long)CLOCK_CORECLOCK / bytes);
+#else
+    printf("+ %s: %lu bytes per second\n", name, bytes);
+#endif
+}
+
+int main(void)
+{
+    size_t size = sizeof(_base64);
+
+    puts("Start.");
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (unsigned char)(i * 7);
+    }
+    base64_encode(_data, sizeof(_data), _base64, &size);
+
+    /* the throughput is given in bytes of binary data */
+    run_test("base64_encode", _encode);
+    run_test("base64url_encode", _encode_url);
+    run_test("base64_encode_update", _encode_stream);
+    run_test("base64_decode", _decode);
+    run_test("base64_decode_update", _decode_stream);
+
+    puts("Done.");
+    return 0;
+}
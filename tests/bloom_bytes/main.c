@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include "xtimer.h"
 
@@ -56,44 +57,52 @@ static void buf_fill(uint32_t *buf, int len)
     }
 }
 
-int main(void)
+static uint32_t ns_per_op(uint32_t usec, int ops)
 {
-    xtimer_init();
+    return (uint32_t)(((uint64_t)usec * 1000) / ops);
+}
 
-    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+static void run(const char *name, hashfp_t *hashfs)
+{
+    bloom_init(&bloom, BLOOM_BITS, bf, hashfs, BLOOM_HASHF);
 
-    printf("Testing Bloom filter.\n\n");
+    printf("%s\n", name);
     printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
            (uint32_t) bloom.k);
 
     random_init(myseed);
 
-    unsigned long t1 = xtimer_now();
+    uint32_t usec = 0;
 
     for (int i = 0; i < lenB; i++) {
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_B;
+
+        uint32_t start = xtimer_now();
         bloom_add(&bloom,
                   (uint8_t *) buf,
                   BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
+        usec += xtimer_now() - start;
     }
 
-    unsigned long t2 = xtimer_now();
-    printf("adding %d elements took %" PRIu32 "ms\n", lenB,
-           (uint32_t) (t2 - t1) / 1000);
+    printf("adding %d elements took %" PRIu32 "ms (%" PRIu32 " ns/op)\n", lenB,
+           usec / 1000, ns_per_op(usec, lenB));
 
     int in = 0;
     int not_in = 0;
 
-    unsigned long t3 = xtimer_now();
-
+    usec = 0;
     for (int i = 0; i < lenA; i++) {
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_A;
 
-        if (bloom_check(&bloom,
-                        (uint8_t *) buf,
-                        BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
+        uint32_t start = xtimer_now();
+        bool res = bloom_check(&bloom,
+                               (uint8_t *) buf,
+                               BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
+        usec += xtimer_now() - start;
+
+        if (res) {
             in++;
         }
         else {
@@ -101,17 +110,28 @@ int main(void)
         }
     }
 
-    unsigned long t4 = xtimer_now();
-    printf("checking %d elements took %" PRIu32 "ms\n", lenA,
-           (uint32_t) (t4 - t3) / 1000);
+    printf("checking %d elements took %" PRIu32 "ms (%" PRIu32 " ns/op)\n", lenA,
+           usec / 1000, ns_per_op(usec, lenA));
 
     printf("\n");
     printf("%d elements probably in the filter.\n", in);
     printf("%d elements not in the filter.\n", not_in);
     double false_positive_rate = (double) in / (double) lenA;
-    printf("%f false positive rate.\n", false_positive_rate);
+    printf("%f false positive rate.\n\n", false_positive_rate);
 
     bloom_del(&bloom);
-    printf("\nAll done!\n");
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    printf("Testing Bloom filter.\n\n");
+
+    run("8 hash functions:", hashes);
+    /* the same number of indices from a single pass over each element */
+    run("double hashing:", NULL);
+
+    printf("All done!\n");
     return 0;
 }
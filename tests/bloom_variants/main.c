@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Memory, speed, and false positives of the Bloom filter variants
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "bloom.h"
+#include "xtimer.h"
+
+/* number of bits or cells of each filter */
+#define SIZE            (1UL << 12)
+#define HASHES_NUMOF    (8)
+/* elements in each filter, and elements that were never added */
+#define ELEMS           (256)
+#define CHECKS          (10000)
+/* the rotating filter gets ELEMS / GENS elements per generation */
+#define GENS            (4)
+#define ROUNDS          (4 * GENS)
+
+#define MAGIC_IN        (0xafafafaf)
+#define MAGIC_OUT       (0x0c0c0c0c)
+
+BITFIELD(bf, SIZE);
+static uint8_t cells[BLOOM_CELLS_SIZE(SIZE)];
+static uint32_t key[4];
+
+/* distinct keys of 16 bytes, like a source address and a sequence number */
+static const uint8_t *_key(uint32_t magic, uint32_t i)
+{
+    key[0] = magic;
+    key[1] = i;
+    key[2] = i * 0x9e3779b9;
+    key[3] = ~i;
+    return (const uint8_t *)key;
+}
+
+static void _print_time(const char *op, uint32_t usec, unsigned num)
+{
+    printf(", %s %" PRIu32 " ns/op", op, (uint32_t)(((uint64_t)usec * 1000) / num));
+}
+
+static void _print_rate(const char *what, unsigned num, unsigned total)
+{
+    unsigned rate = (num * 10000U) / total;
+
+    printf(", %u.%02u%% %s", rate / 100, rate % 100, what);
+}
+
+static void _bloom(void)
+{
+    bloom_t bloom;
+    unsigned in = 0;
+    uint32_t start;
+
+    memset(bf, 0, sizeof(bf));
+    bloom_init(&bloom, SIZE, bf, NULL, HASHES_NUMOF);
+    printf("bloom:    %5u bytes", (unsigned)(sizeof(bloom) + sizeof(bf)));
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ELEMS; i++) {
+        bloom_add(&bloom, _key(MAGIC_IN, i), sizeof(key));
+    }
+    _print_time("add", xtimer_now() - start, ELEMS);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < CHECKS; i++) {
+        in += bloom_check(&bloom, _key(MAGIC_OUT, i), sizeof(key));
+    }
+    _print_time("check", xtimer_now() - start, CHECKS);
+    _print_rate("false positives\n", in, CHECKS);
+}
+
+static void _counting(void)
+{
+    bloom_counting_t bloom;
+    unsigned in = 0, missing = 0;
+    uint32_t start;
+
+    bloom_counting_init(&bloom, SIZE, cells, NULL, HASHES_NUMOF);
+    printf("counting: %5u bytes", (unsigned)(sizeof(bloom) + sizeof(cells)));
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ELEMS; i++) {
+        bloom_counting_add(&bloom, _key(MAGIC_IN, i), sizeof(key));
+    }
+    _print_time("add", xtimer_now() - start, ELEMS);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < CHECKS; i++) {
+        in += bloom_counting_check(&bloom, _key(MAGIC_OUT, i), sizeof(key));
+    }
+    _print_time("check", xtimer_now() - start, CHECKS);
+    _print_rate("false positives", in, CHECKS);
+
+    /* remove half of the elements */
+    start = xtimer_now();
+    for (unsigned i = 0; i < ELEMS; i += 2) {
+        if (bloom_counting_remove(&bloom, _key(MAGIC_IN, i), sizeof(key)) < 0) {
+            missing++;
+        }
+    }
+    _print_time("remove", xtimer_now() - start, ELEMS / 2);
+
+    in = 0;
+    for (unsigned i = 0; i < CHECKS; i++) {
+        in += bloom_counting_check(&bloom, _key(MAGIC_OUT, i), sizeof(key));
+    }
+    _print_rate("after removal", in, CHECKS);
+
+    for (unsigned i = 1; i < ELEMS; i += 2) {
+        missing += !bloom_counting_check(&bloom, _key(MAGIC_IN, i), sizeof(key));
+    }
+    printf(", %u false negatives\n", missing);
+}
+
+static void _rotating(void)
+{
+    bloom_rotating_t bloom;
+    unsigned in = 0, expired = 0, missing = 0;
+    uint32_t start, add = 0, rotate = 0;
+    unsigned elem = 0;
+
+    bloom_rotating_init(&bloom, SIZE, cells, NULL, HASHES_NUMOF, GENS);
+    printf("rotating: %5u bytes", (unsigned)(sizeof(bloom) + sizeof(cells)));
+
+    /* fill many generations, the filter holds about ELEMS elements */
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        if (r > 0) {
+            start = xtimer_now();
+            bloom_rotating_rotate(&bloom);
+            rotate += xtimer_now() - start;
+        }
+        start = xtimer_now();
+        for (unsigned i = 0; i < (ELEMS / GENS); i++) {
+            bloom_rotating_add(&bloom, _key(MAGIC_IN, elem++), sizeof(key));
+        }
+        add += xtimer_now() - start;
+    }
+    _print_time("add", add, ROUNDS * (ELEMS / GENS));
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < CHECKS; i++) {
+        in += bloom_rotating_check(&bloom, _key(MAGIC_OUT, i), sizeof(key));
+    }
+    _print_time("check", xtimer_now() - start, CHECKS);
+    _print_time("rotate", rotate, ROUNDS - 1);
+    _print_rate("false positives", in, CHECKS);
+
+    for (unsigned i = 0; i < elem; i++) {
+        bool res = bloom_rotating_check(&bloom, _key(MAGIC_IN, i), sizeof(key));
+
+        if (i < (elem - ELEMS)) {
+            expired += res;
+        }
+        else {
+            missing += !res;
+        }
+    }
+    _print_rate("of expired", expired, elem - ELEMS);
+    printf(", %u false negatives\n", missing);
+}
+
+int main(void)
+{
+    puts("Bloom filter variants");
+    printf("%lu bits or cells, %d indices, %d elements\n", SIZE, HASHES_NUMOF, ELEMS);
+
+    _bloom();
+    _counting();
+    _rotating();
+
+    puts("[SUCCESS]");
+    return 0;
+}
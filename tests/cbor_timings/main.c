@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the throughput of cbor_stream_t with the reader and
+ *              writer for chains of buffers and with generated codecs
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "cbor.h"
+#include "cbor_chain.h"
+#include "records.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+/* records of a telemetry batch */
+#define RECORDS         (32U)
+/* the payload of a CoAP block */
+#define BLOCK_SIZE      (64U)
+#define BUF_SIZE        (2048U)
+#define BLOCKS          (BUF_SIZE / BLOCK_SIZE)
+
+enum {
+    KEY_TIME = 1,
+    KEY_VALUE,
+    KEY_UNIT,
+    KEY_ID,
+};
+
+static const char _unit[] = "degC";
+static const char _id[8] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x00, 0x00, 0x01 };
+
+static unsigned char _buf[BUF_SIZE];
+static struct iovec _vec[BLOCKS];
+static cbor_stream_t _stream;
+static size_t _len;
+static long _sum;
+static sample_t _samples[RECORDS];
+
+static int _stream_encode(void)
+{
+    cbor_clear(&_stream);
+    cbor_serialize_array(&_stream, RECORDS);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        cbor_serialize_map(&_stream, 4);
+        cbor_serialize_int(&_stream, KEY_TIME);
+        cbor_serialize_int(&_stream, 1470000000 + (i * 60));
+        cbor_serialize_int(&_stream, KEY_VALUE);
+        cbor_serialize_int(&_stream, 2000 - (i * 100));
+        cbor_serialize_int(&_stream, KEY_UNIT);
+        cbor_serialize_unicode_string(&_stream, _unit);
+        cbor_serialize_int(&_stream, KEY_ID);
+        cbor_serialize_byte_stringl(&_stream, _id, sizeof(_id));
+    }
+    return (_stream.pos > 0) ? 0 : -1;
+}
+
+static int _chain_encode(void)
+{
+    cbor_writer_t writer;
+
+    cbor_writer_init(&writer, _vec, BLOCKS);
+    cbor_writer_head(&writer, CBOR_MAJOR_ARRAY, RECORDS);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        cbor_writer_head(&writer, CBOR_MAJOR_MAP, 4);
+        cbor_writer_uint(&writer, KEY_TIME);
+        cbor_writer_uint(&writer, 1470000000 + (i * 60));
+        cbor_writer_uint(&writer, KEY_VALUE);
+        cbor_writer_int(&writer, 2000 - ((int)i * 100));
+        cbor_writer_uint(&writer, KEY_UNIT);
+        cbor_writer_string(&writer, CBOR_MAJOR_TEXT, _unit, sizeof(_unit) - 1);
+        cbor_writer_uint(&writer, KEY_ID);
+        cbor_writer_string(&writer, CBOR_MAJOR_BYTES, _id, sizeof(_id));
+    }
+    return (cbor_writer_len(&writer) == _len) ? 0 : -1;
+}
+
+static int _stream_decode(void)
+{
+    size_t offset = 0, num, pairs;
+    char str[16];
+    int val;
+
+    offset += cbor_deserialize_array(&_stream, offset, &num);
+    for (size_t i = 0; i < num; i++) {
+        offset += cbor_deserialize_map(&_stream, offset, &pairs);
+        for (size_t j = 0; j < pairs; j++) {
+            offset += cbor_deserialize_int(&_stream, offset, &val);
+            switch (val) {
+                case KEY_UNIT:
+                    offset += cbor_deserialize_unicode_string(&_stream, offset,
+                                                              str, sizeof(str));
+                    break;
+                case KEY_ID:
+                    offset += cbor_deserialize_byte_string(&_stream, offset,
+                                                           str, sizeof(str));
+                    break;
+                default:
+                    offset += cbor_deserialize_int(&_stream, offset, &val);
+                    _sum += val;
+                    break;
+            }
+        }
+    }
+    return (offset == _len) ? 0 : -1;
+}
+
+static int _chain_decode(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t array, map;
+    char str[16];
+
+    cbor_reader_init(&reader, _vec, BLOCKS);
+    cbor_reader_next(&reader, &array);
+    for (uint64_t i = 0; i < array.val; i++) {
+        cbor_reader_next(&reader, &map);
+        for (uint64_t j = 0; j < map.val; j++) {
+            size_t len = sizeof(str);
+            uint64_t key;
+            int64_t val;
+
+            cbor_reader_uint(&reader, &key);
+            switch (key) {
+                case KEY_UNIT:
+                case KEY_ID:
+                    cbor_reader_string(&reader, str, &len);
+                    break;
+                default:
+                    if (cbor_reader_int(&reader, &val) < 0) {
+                        return -1;
+                    }
+                    _sum += val;
+                    break;
+            }
+        }
+    }
+    return 0;
+}
+
+/* a consumer that only needs the values */
+static int _chain_skip(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t array, map;
+
+    cbor_reader_init(&reader, _vec, BLOCKS);
+    cbor_reader_next(&reader, &array);
+    for (uint64_t i = 0; i < array.val; i++) {
+        cbor_reader_next(&reader, &map);
+        for (uint64_t j = 0; j < map.val; j++) {
+            uint64_t key;
+            int64_t val;
+
+            cbor_reader_uint(&reader, &key);
+            if (key == KEY_VALUE) {
+                cbor_reader_int(&reader, &val);
+                _sum += val;
+            }
+            else if (cbor_reader_skip(&reader) < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* the hand-written counterparts of the codec generated from records.json */
+static int _stream_sample_encode(void)
+{
+    cbor_clear(&_stream);
+    cbor_serialize_array(&_stream, RECORDS);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        const sample_t *sample = &_samples[i];
+
+        cbor_serialize_map(&_stream, 3);
+        cbor_serialize_int(&_stream, 1);
+        cbor_serialize_uint64_t(&_stream, sample->time);
+        cbor_serialize_int(&_stream, 2);
+        cbor_serialize_array(&_stream, 3);
+        cbor_serialize_array(&_stream, PHYDAT_DIM);
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            cbor_serialize_int(&_stream, sample->data.val[j]);
+        }
+        cbor_serialize_int(&_stream, sample->data.unit);
+        cbor_serialize_int(&_stream, sample->data.scale);
+        cbor_serialize_int(&_stream, 3);
+        cbor_serialize_byte_stringl(&_stream, (const char *)sample->id,
+                                    sizeof(sample->id));
+    }
+    return (_stream.pos > 0) ? 0 : -1;
+}
+
+static int _stream_sample_decode(void)
+{
+    size_t offset = 0, num, len;
+    char id[sizeof(_samples[0].id) + 1];
+    uint64_t time;
+    int key, val;
+
+    offset += cbor_deserialize_array(&_stream, offset, &num);
+    for (size_t i = 0; i < num; i++) {
+        sample_t *sample = &_samples[i];
+
+        offset += cbor_deserialize_map(&_stream, offset, &len);
+        offset += cbor_deserialize_int(&_stream, offset, &key);
+        offset += cbor_deserialize_uint64_t(&_stream, offset, &time);
+        sample->time = time;
+        offset += cbor_deserialize_int(&_stream, offset, &key);
+        offset += cbor_deserialize_array(&_stream, offset, &len);
+        offset += cbor_deserialize_array(&_stream, offset, &len);
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            offset += cbor_deserialize_int(&_stream, offset, &val);
+            sample->data.val[j] = val;
+        }
+        offset += cbor_deserialize_int(&_stream, offset, &val);
+        sample->data.unit = val;
+        offset += cbor_deserialize_int(&_stream, offset, &val);
+        sample->data.scale = val;
+        offset += cbor_deserialize_int(&_stream, offset, &key);
+        len = cbor_deserialize_byte_string(&_stream, offset, id, sizeof(id));
+        if (len == 0) {
+            return -1;
+        }
+        offset += len;
+        memcpy(sample->id, id, sizeof(sample->id));
+    }
+    return 0;
+}
+
+static int _gen_sample_encode(void)
+{
+    size_t offset;
+
+    cbor_clear(&_stream);
+    offset = cbor_serialize_array(&_stream, RECORDS);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        size_t len = sample_cbor_encode(&_samples[i], &_buf[offset],
+                                        sizeof(_buf) - offset);
+
+        if (len == 0) {
+            return -1;
+        }
+        offset += len;
+    }
+    _stream.pos = offset;
+    return 0;
+}
+
+static int _gen_sample_decode(void)
+{
+    size_t offset, num;
+
+    offset = cbor_deserialize_array(&_stream, 0, &num);
+    for (size_t i = 0; i < num; i++) {
+        size_t len = sample_cbor_decode(&_samples[i], &_buf[offset],
+                                        _stream.pos - offset);
+
+        if (len == 0) {
+            return -1;
+        }
+        offset += len;
+    }
+    return 0;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void), unsigned long size,
+                     const char *unit)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s: failed\n", name);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * size) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu %ss per second, %lu cycles per %s\n", name, count,
+           unit, (unsigned long)CLOCK_CORECLOCK / count, unit);
+#else
+    printf("+ %s: %lu %ss per second\n", name, count, unit);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        _vec[i].iov_base = &_buf[i * BLOCK_SIZE];
+        _vec[i].iov_len = BLOCK_SIZE;
+    }
+    cbor_init(&_stream, _buf, sizeof(_buf));
+    _stream_encode();
+    _len = _stream.pos;
+    printf("%u records, %u bytes in blocks of %u bytes\n", RECORDS,
+           (unsigned)_len, BLOCK_SIZE);
+
+    run_test("cbor_stream encode", _stream_encode, _len, "byte");
+    run_test("cbor_chain encode", _chain_encode, _len, "byte");
+    run_test("cbor_stream decode", _stream_decode, _len, "byte");
+    run_test("cbor_chain decode", _chain_decode, _len, "byte");
+    run_test("cbor_chain skip", _chain_skip, _len, "byte");
+
+    for (unsigned i = 0; i < RECORDS; i++) {
+        _samples[i].time = 1470000000 + (i * 60);
+        _samples[i].data.val[0] = 2000 - (i * 100);
+        _samples[i].data.unit = UNIT_TEMP_C;
+        _samples[i].data.scale = -2;
+        memcpy(_samples[i].id, _id, sizeof(_id));
+    }
+    /* the decoders need the output of the encoder before */
+    run_test("cbor_stream sample encode", _stream_sample_encode, RECORDS,
+             "record");
+    run_test("cbor_stream sample decode", _stream_sample_decode, RECORDS,
+             "record");
+    run_test("cborgen sample encode", _gen_sample_encode, RECORDS, "record");
+    run_test("cborgen sample decode", _gen_sample_decode, RECORDS, "record");
+
+    printf("Done (%ld).\n", _sum);
+    return 0;
+}
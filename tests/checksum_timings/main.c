@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the checksums
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/fletcher16.h"
+#include "checksum/fletcher32.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define BUF_LEN         (1024U)
+/* a full IEEE 802.15.4 frame */
+#define FRAME_LEN       (127U)
+
+static uint16_t _buf[BUF_LEN / sizeof(uint16_t)];
+static volatile uint32_t _result;
+
+static int _crc16_ccitt(void)
+{
+    _result = crc16_ccitt_calc((unsigned char *)_buf, BUF_LEN);
+    return BUF_LEN;
+}
+
+static int _crc16_ccitt_kermit(void)
+{
+    _result = crc16_ccitt_kermit_calc((unsigned char *)_buf, FRAME_LEN);
+    return FRAME_LEN;
+}
+
+static int _crc32(void)
+{
+    _result = crc32_calc((unsigned char *)_buf, BUF_LEN);
+    return BUF_LEN;
+}
+
+static int _fletcher16(void)
+{
+    _result = fletcher16((uint8_t *)_buf, BUF_LEN);
+    return BUF_LEN;
+}
+
+static int _fletcher32(void)
+{
+    _result = fletcher32(_buf, BUF_LEN / sizeof(uint16_t));
+    return BUF_LEN;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long bytes = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        bytes += test();
+    } while (done == 0);
+
+    bytes /= TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu bytes per second, %lu cycles per byte\n", name, bytes,
+           (unsigned long)CLOCK_CORECLOCK / bytes);
+#else
+    printf("+ %s: %lu bytes per second\n", name, bytes);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+    printf("CRC slices: %u\n", (unsigned)CRC16_CCITT_SLICES);
+
+    for (unsigned i = 0; i < (BUF_LEN / sizeof(uint16_t)); i++) {
+        _buf[i] = (uint16_t)(i * 7919);
+    }
+
+    run_test("crc16_ccitt, 1024 bytes", _crc16_ccitt);
+    run_test("crc16_ccitt_kermit, 127 bytes", _crc16_ccitt_kermit);
+    run_test("crc32, 1024 bytes", _crc32);
+    run_test("fletcher16, 1024 bytes", _fletcher16);
+    run_test("fletcher32, 1024 bytes", _fletcher32);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the AES cipher modes and of
+ *              ChaCha20-Poly1305
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "crypto/aes.h"
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define MSG_LEN_MAX     (1024U)
+#define MAC_LEN         (8U)
+/* length of the length field of CCM, this leaves 13 bytes for the nonce */
+#define CCM_LEN_ENC     (2U)
+
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const uint8_t _chacha_key[CHACHA20POLY1305_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+/* a single block, a full IEEE 802.15.4 frame, and a large message */
+static const size_t _msg_lens[] = { 16, 127, MSG_LEN_MAX };
+
+static cipher_t _cipher;
+static chacha_ctx _chacha;
+static uint8_t _input[MSG_LEN_MAX];
+static uint8_t _output[MSG_LEN_MAX + CHACHA20POLY1305_TAG_SIZE];
+static uint8_t _iv[AES_BLOCK_SIZE];
+static size_t _msg_len;
+
+/* ECB and CBC only take whole blocks */
+static size_t _padded_len(void)
+{
+    return ((_msg_len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE) * AES_BLOCK_SIZE;
+}
+
+static int _ecb(void)
+{
+    return cipher_encrypt_ecb(&_cipher, _input, _padded_len(), _output);
+}
+
+static int _cbc(void)
+{
+    return cipher_encrypt_cbc(&_cipher, _iv, _input, _padded_len(), _output);
+}
+
+static int _ctr(void)
+{
+    return cipher_encrypt_ctr(&_cipher, _iv, 0, _input, _msg_len, _output);
+}
+
+static int _ccm(void)
+{
+    return cipher_encrypt_ccm(&_cipher, NULL, 0, MAC_LEN, CCM_LEN_ENC, _iv,
+                              15 - CCM_LEN_ENC, _input, _msg_len, _output);
+}
+
+/* the key stream of whole blocks */
+static int _chacha20(void)
+{
+    chacha_keystream_blocks(&_chacha, _output, (_msg_len + 63) / 64);
+    return 0;
+}
+
+static int _chacha20poly1305(void)
+{
+    chacha20poly1305_encrypt(_output, _input, _msg_len, NULL, 0, _chacha_key, _iv);
+    return 0;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s, %4u bytes: failed\n", name, (unsigned)_msg_len);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * (unsigned long)_msg_len) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s, %4u bytes: %lu bytes per second, %lu cycles per byte\n",
+           name, (unsigned)_msg_len, count, (unsigned long)CLOCK_CORECLOCK / count);
+#else
+    printf("+ %s, %4u bytes: %lu bytes per second\n", name, (unsigned)_msg_len,
+           count);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    if (cipher_init(&_cipher, CIPHER_AES_128, _key, AES_KEY_SIZE) < 0) {
+        puts("unable to initialize AES");
+        return 1;
+    }
+    printf("context size: %u bytes\n", (unsigned)sizeof(cipher_context_t));
+    chacha_init(&_chacha, 20, _chacha_key, sizeof(_chacha_key), _iv);
+
+    for (unsigned i = 0; i < (sizeof(_msg_lens) / sizeof(_msg_lens[0])); i++) {
+        _msg_len = _msg_lens[i];
+        run_test("ecb", _ecb);
+        run_test("cbc", _cbc);
+        run_test("ctr", _ctr);
+        run_test("ccm", _ccm);
+        run_test("chacha20", _chacha20);
+        run_test("chacha20poly1305", _chacha20poly1305);
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the ECC operations of micro-ecc and relic per curve
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/ecc.h"
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#define ROUNDS          (10U)
+
+static const ecc_backend_t *const _backends[] = { &ecc_uecc, &ecc_relic };
+
+static const char _msg[] = "firmware image";
+
+static uint8_t _hash[SHA256_DIGEST_LENGTH];
+static uint8_t _pub[ROUNDS][ECC_PUBLIC_KEY_SIZE_MAX];
+static uint8_t _priv[ROUNDS][ECC_SIZE_MAX];
+static uint8_t _sig[ROUNDS][ECC_PUBLIC_KEY_SIZE_MAX];
+static uint8_t _secret[2][ECC_SIZE_MAX];
+static unsigned _errors;
+
+static void _print(const char *op, uint32_t usec)
+{
+    printf(", %s %6" PRIu32 " us", op, usec / ROUNDS);
+}
+
+static void _check(int res, const char *what)
+{
+    if (res != 0) {
+        printf("\n%s failed: %d", what, res);
+        _errors++;
+    }
+}
+
+/* signatures of one backend must be valid for the other ones */
+static void _check_others(const ecc_backend_t *backend, ecc_curve_t curve)
+{
+    for (unsigned i = 0; i < (sizeof(_backends) / sizeof(_backends[0])); i++) {
+        if ((_backends[i] != backend) &&
+            (ecc_verify(_backends[i], curve, _pub[0], _hash, sizeof(_hash),
+                        _sig[0]) == 0)) {
+            printf(", verified by %s", _backends[i]->name);
+        }
+    }
+}
+
+static void _run(const ecc_backend_t *backend, ecc_curve_t curve)
+{
+    ecc_pubkey_t key;
+    uint32_t start;
+    int res;
+
+    printf("%-9s %s", backend->name, ecc_curve_name(curve));
+    res = ecc_make_key(backend, curve, _pub[0], _priv[0]);
+    if (res == -ENOTSUP) {
+        puts(": not supported");
+        return;
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _check(ecc_make_key(backend, curve, _pub[i], _priv[i]), "keygen");
+    }
+    _print("keygen", xtimer_now() - start);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _check(ecc_shared_secret(backend, curve, _pub[(i + 1) % ROUNDS],
+                                 _priv[i], _secret[0]), "ecdh");
+    }
+    _print("ecdh", xtimer_now() - start);
+    ecc_shared_secret(backend, curve, _pub[1], _priv[0], _secret[0]);
+    ecc_shared_secret(backend, curve, _pub[0], _priv[1], _secret[1]);
+    if (memcmp(_secret[0], _secret[1], ecc_curve_size(curve)) != 0) {
+        _check(-EINVAL, "ecdh agreement");
+    }
+
+    /* all signatures are made by the first key, as for firmware updates */
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _check(ecc_sign(backend, curve, _priv[0], _hash, sizeof(_hash),
+                        _sig[i]), "sign");
+    }
+    _print("sign", xtimer_now() - start);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _check(ecc_verify(backend, curve, _pub[0], _hash, sizeof(_hash),
+                          _sig[i]), "verify");
+    }
+    _print("verify", xtimer_now() - start);
+
+    start = xtimer_now();
+    res = ecc_pubkey_init(&key, backend, curve, _pub[0]);
+    start = xtimer_now() - start;
+    _check(res, "precompute");
+    if (key.pre != NULL) {
+        printf(", precompute %6" PRIu32 " us", start);
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _check(ecc_pubkey_verify(&key, _hash, sizeof(_hash), _sig[i]),
+               "verify with precomputation");
+    }
+    _print("verify fixed key", xtimer_now() - start);
+
+    /* a signature over another message must be rejected */
+    _hash[0] ^= 0x01;
+    if (ecc_pubkey_verify(&key, _hash, sizeof(_hash), _sig[0]) != -EBADMSG) {
+        _check(-EINVAL, "rejecting a forged signature");
+    }
+    _hash[0] ^= 0x01;
+    ecc_pubkey_release(&key);
+
+    _check_others(backend, curve);
+    puts("");
+}
+
+int main(void)
+{
+    printf("ECC timings, averaged over %u operations\n", ROUNDS);
+
+    sha256((const unsigned char *)_msg, sizeof(_msg) - 1, _hash);
+    for (unsigned i = 0; i < (sizeof(_backends) / sizeof(_backends[0])); i++) {
+        for (ecc_curve_t curve = 0; curve < ECC_CURVE_NUMOF; curve++) {
+            _run(_backends[i], curve);
+        }
+    }
+
+    if (_errors) {
+        printf("[FAILURE] %u errors\n", _errors);
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
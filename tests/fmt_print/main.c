@@ -14,18 +14,165 @@
  * @brief       fmt print test application
  *
  * This test is supposed to check for "compilabilty" of the fmt print_* instructions.
+ * It then compares the speed of the fmt conversions to snprintf() of the C
+ * library, see README.md.
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
+#include <stdio.h>
+
+#include "board.h"
 #include "fmt.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define NUMOF(a)        (sizeof(a) / sizeof(a[0]))
+
+static const uint32_t _ints[] = {
+    0, 7, 42, 1234, 99999, 1234567, 87654321, 4294967295LU
+};
+static const float _floats[] = {
+    0.0f, -1.5f, 3.14159f, 21.37f, -273.15f, 1013.25f, 0.001f, 65535.5f
+};
+
+static char _buf[64];
+static long _sum;
+
+/* lines like the ones of ps, od and gnrc_pktdump */
+#define LINES(fn)                                                           \
+    do {                                                                    \
+        _sum += fn(_buf, sizeof(_buf), "\t%3i | %-20s | %-8s %.1s | %3i",   \
+                   3, "main", "running", "Q", 7);                           \
+        _sum += fn(_buf, sizeof(_buf), " | %5i (%5i) | %10p", 1536, 612,    \
+                   (void *)_buf);                                           \
+        _sum += fn(_buf, sizeof(_buf), "%09o %02x %02x %02x %02x", 16,      \
+                   0xde, 0xad, 0xbe, 0xef);                                 \
+        _sum += fn(_buf, sizeof(_buf), "~~ SNIP %2i - size: %3u byte", 2,   \
+                   40u);                                                    \
+    } while (0)
+#define LINES_NUMOF     (4U)
+
+#if !defined(FMT_PRINT_ONLY_libc)
+static int _fmt_u32_dec(void)
+{
+    for (unsigned i = 0; i < NUMOF(_ints); i++) {
+        _sum += fmt_u32_dec(_buf, _ints[i]);
+    }
+    return 0;
+}
+
+static int _fmt_float(void)
+{
+    for (unsigned i = 0; i < NUMOF(_floats); i++) {
+        _sum += fmt_float(_buf, _floats[i], 3);
+    }
+    return 0;
+}
+
+static int _fmt_snprintf(void)
+{
+    LINES(fmt_snprintf);
+    return 0;
+}
+#endif
+
+#if !defined(FMT_PRINT_ONLY_fmt)
+static int _snprintf_u32(void)
+{
+    for (unsigned i = 0; i < NUMOF(_ints); i++) {
+        _sum += snprintf(_buf, sizeof(_buf), "%lu", (unsigned long)_ints[i]);
+    }
+    return 0;
+}
+
+static int _snprintf_float(void)
+{
+    for (unsigned i = 0; i < NUMOF(_floats); i++) {
+        _sum += snprintf(_buf, sizeof(_buf), "%.3f", (double)_floats[i]);
+    }
+    return 0;
+}
+
+static int _snprintf(void)
+{
+    LINES(snprintf);
+    return 0;
+}
+#endif
+
+#if !defined(FMT_PRINT_ONLY_fmt) && !defined(FMT_PRINT_ONLY_libc)
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void), unsigned long size,
+                     const char *unit)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s: failed\n", name);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * size) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu %ss per second, %lu cycles per %s\n", name, count,
+           unit, (unsigned long)CLOCK_CORECLOCK / count, unit);
+#else
+    printf("+ %s: %lu %ss per second\n", name, count, unit);
+#endif
+}
+#endif
 
 int main(void)
 {
     print_str("If you can read this:\n");
     print_str("Test successful.\n");
 
+#if defined(FMT_PRINT_ONLY_fmt)
+    /* only one of the implementations is linked, see README.md */
+    _fmt_u32_dec();
+    _fmt_float();
+    _fmt_snprintf();
+    print_str(_buf);
+#elif defined(FMT_PRINT_ONLY_libc)
+    _snprintf_u32();
+    _snprintf_float();
+    _snprintf();
+    print_str(_buf);
+#endif
+
+#if defined(FMT_PRINT_ONLY_fmt) || defined(FMT_PRINT_ONLY_libc)
+    print_str("\nDone (");
+    print_s32_dec(_sum);
+    print_str(").\n");
+#else
+    run_test("fmt_u32_dec", _fmt_u32_dec, NUMOF(_ints), "conversion");
+    run_test("snprintf %lu", _snprintf_u32, NUMOF(_ints), "conversion");
+    run_test("fmt_float", _fmt_float, NUMOF(_floats), "conversion");
+    run_test("snprintf %.3f", _snprintf_float, NUMOF(_floats), "conversion");
+    run_test("fmt_snprintf", _fmt_snprintf, LINES_NUMOF, "line");
+    run_test("snprintf", _snprintf, LINES_NUMOF, "line");
+    printf("Done (%ld).\n", _sum);
+#endif
+
     return 0;
 }
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the DAO handling of a RPL router in storing mode
+ *
+ * A router with a few children learns the routes to 50, 200, and 500
+ * descendants from DAOs of its children. The time it takes to process the
+ * DAOs of its children and to generate its own DAO, as well as the size of
+ * its own DAO are measured for several changes in the sub-DODAG.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/icmpv6.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define INSTANCE_ID         (GNRC_RPL_DEFAULT_INSTANCE)
+#define CHILD_NUMOF         (5U)
+#define DESC_MAX            (500U)
+/* the last child advertises one descendant more at most */
+#define TARGETS_MAX         ((DESC_MAX / CHILD_NUMOF) + 1)
+#define MAIN_QUEUE_SIZE     (8U)
+#define NETIF_QUEUE_SIZE    (8U)
+
+static const unsigned _desc_numof[] = { 50, 200, 500 };
+
+static uint8_t _dao_buf[sizeof(gnrc_rpl_dao_t) + (TARGETS_MAX * sizeof(gnrc_rpl_opt_target_t)) +
+                        sizeof(gnrc_rpl_opt_transit_t)];
+static uint8_t _dao_seq;
+/* sequence of the last DAO of the router */
+static uint8_t _sent_seq;
+static kernel_pid_t _iface;
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_queue[NETIF_QUEUE_SIZE];
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_queue, NETIF_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+/* descendants use addresses derived from short addresses, like on IEEE 802.15.4 */
+static void _desc_addr(ipv6_addr_t *addr, unsigned desc)
+{
+    ipv6_addr_from_str(addr, "2001:db8::ff:fe00:0");
+    addr->u8[14] = (uint8_t)((0x100 + desc) >> 8);
+    addr->u8[15] = (uint8_t)(0x100 + desc);
+}
+
+static void _child_addr(ipv6_addr_t *addr, unsigned child)
+{
+    ipv6_addr_from_str(addr, "fe80::ff:fe00:0");
+    addr->u8[15] = (uint8_t)(child + 2);
+}
+
+static uint32_t _recv_dao(unsigned child, unsigned first, unsigned num, uint8_t lifetime)
+{
+    gnrc_rpl_dao_t *dao = (gnrc_rpl_dao_t *)_dao_buf;
+    gnrc_rpl_opt_target_t *target = (gnrc_rpl_opt_target_t *)(dao + 1);
+    gnrc_rpl_opt_transit_t *transit;
+    ipv6_addr_t src;
+    uint16_t len;
+    uint32_t start;
+
+    /* no DAO-ACK requested */
+    dao->instance_id = INSTANCE_ID;
+    dao->k_d_flags = 0;
+    dao->reserved = 0;
+    dao->dao_sequence = _dao_seq++;
+    for (unsigned i = 0; i < num; i++, target++) {
+        target->type = GNRC_RPL_OPT_TARGET;
+        target->length = sizeof(gnrc_rpl_opt_target_t) - sizeof(gnrc_rpl_opt_t);
+        target->flags = 0;
+        target->prefix_length = IPV6_ADDR_BIT_LEN;
+        _desc_addr(&target->target, first + i);
+    }
+    transit = (gnrc_rpl_opt_transit_t *)target;
+    transit->type = GNRC_RPL_OPT_TRANSIT;
+    transit->length = sizeof(gnrc_rpl_opt_transit_t) - sizeof(gnrc_rpl_opt_t);
+    transit->e_flags = 0;
+    transit->path_control = 0;
+    transit->path_sequence = 0;
+    transit->path_lifetime = lifetime;
+    len = (uint16_t)(sizeof(icmpv6_hdr_t) + ((uint8_t *)(transit + 1) - _dao_buf));
+
+    _child_addr(&src, child);
+    start = xtimer_now();
+    gnrc_rpl_recv_DAO(dao, _iface, &src, len);
+    return xtimer_now() - start;
+}
+
+/* counts the targets of a DAO that are advertised with a no-path transit,
+ * and remembers its sequence */
+static unsigned _parse_dao(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *icmpv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6);
+    unsigned targets = 0, res = 0;
+
+    if ((icmpv6 == NULL) || (icmpv6->next == NULL)) {
+        return 0;
+    }
+    _sent_seq = ((gnrc_rpl_dao_t *)icmpv6->next->data)->dao_sequence;
+    /* every snip behind the DAO base object holds whole options */
+    for (gnrc_pktsnip_t *snip = icmpv6->next->next; snip != NULL; snip = snip->next) {
+        uint8_t *opt = snip->data;
+
+        while (opt < ((uint8_t *)snip->data + snip->size)) {
+            gnrc_rpl_opt_t *hdr = (gnrc_rpl_opt_t *)opt;
+
+            if (hdr->type == GNRC_RPL_OPT_TARGET) {
+                targets++;
+            }
+            else if (hdr->type == GNRC_RPL_OPT_TRANSIT) {
+                /* a transit applies to the targets in front of it */
+                if (((gnrc_rpl_opt_transit_t *)hdr)->path_lifetime == 0) {
+                    res += targets;
+                }
+                targets = 0;
+            }
+            opt += sizeof(gnrc_rpl_opt_t) + hdr->length;
+        }
+    }
+    return res;
+}
+
+static size_t _send_dao(gnrc_rpl_instance_t *inst, uint32_t *usec, unsigned *no_path)
+{
+    msg_t msg;
+    size_t res = 0;
+    uint32_t start = xtimer_now();
+
+    gnrc_rpl_send_DAO(inst, NULL, inst->dodag.default_lifetime);
+    *usec = xtimer_now() - start;
+    *no_path = 0;
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+            /* IPv6 packet without the interface header */
+            res += gnrc_pkt_len(pkt->next);
+            *no_path += _parse_dao(pkt);
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return res;
+}
+
+static void _recv_dao_ack(gnrc_rpl_instance_t *inst)
+{
+    gnrc_rpl_dao_ack_t dao_ack;
+
+    dao_ack.instance_id = inst->id;
+    dao_ack.d_reserved = 0;
+    dao_ack.dao_sequence = _sent_seq;
+    dao_ack.status = 0;
+    gnrc_rpl_recv_DAO_ACK(&dao_ack, _iface, sizeof(icmpv6_hdr_t) + sizeof(dao_ack));
+}
+
+static void _print(unsigned desc_numof, const char *event, uint32_t recv_usec,
+                   gnrc_rpl_instance_t *inst, bool ack)
+{
+    uint32_t send_usec;
+    size_t bytes;
+    unsigned no_path;
+
+    printf("%3u descendants, %-13s: DAOs processed in %6" PRIu32 " us, ",
+           desc_numof, event, recv_usec);
+    if (inst->dodag.dao_time > GNRC_RPL_DEFAULT_DAO_DELAY) {
+        puts("no DAO scheduled");
+        return;
+    }
+    bytes = _send_dao(inst, &send_usec, &no_path);
+    if (ack) {
+        _recv_dao_ack(inst);
+    }
+    printf("DAO built in %6" PRIu32 " us, %5u bytes, %u no-path\n", send_usec,
+           (unsigned)bytes, no_path);
+}
+
+static void _run(gnrc_rpl_instance_t *inst, unsigned desc_numof)
+{
+    unsigned per_child = desc_numof / CHILD_NUMOF;
+    unsigned last = (CHILD_NUMOF - 1) * per_child;
+    uint8_t lifetime = inst->dodag.default_lifetime;
+    uint32_t usec = 0;
+
+    fib_flush(&gnrc_ipv6_fib_table, KERNEL_PID_UNDEF);
+    /* the parent does not know about any descendant yet */
+    gnrc_rpl_delay_dao(&inst->dodag);
+
+    for (unsigned c = 0; c < CHILD_NUMOF; c++) {
+        usec += _recv_dao(c, c * per_child, per_child, lifetime);
+    }
+    _print(desc_numof, "children join", usec, inst, true);
+
+    usec = 0;
+    for (unsigned c = 0; c < CHILD_NUMOF; c++) {
+        usec += _recv_dao(c, c * per_child, per_child, lifetime);
+    }
+    _print(desc_numof, "refresh", usec, inst, true);
+
+    usec = _recv_dao(CHILD_NUMOF - 1, last, per_child + 1, lifetime);
+    _print(desc_numof, "one joins", usec, inst, true);
+
+    /* the DAO with the no-path target gets lost */
+    usec = _recv_dao(CHILD_NUMOF - 1, desc_numof, 1, 0);
+    _print(desc_numof, "one leaves", usec, inst, false);
+
+    /* so its retransmission, which carries all targets, has to remove the
+     * target again */
+    inst->dodag.dao_synced = false;
+    inst->dodag.dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    _print(desc_numof, "retransmitted", 0, inst, true);
+
+    /* the regular DAO after GNRC_RPL_REGULAR_DAO_INTERVAL refreshes all routes */
+    inst->dodag.dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    _print(desc_numof, "regular", 0, inst, true);
+}
+
+int main(void)
+{
+    gnrc_rpl_instance_t *inst;
+    gnrc_rpl_parent_t *parent;
+    gnrc_netreg_entry_t me_reg;
+    ipv6_addr_t addr;
+
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    puts("RPL DAO benchmark");
+
+    _iface = thread_create(_netif_stack, sizeof(_netif_stack), THREAD_PRIORITY_MAIN - 1,
+                           THREAD_CREATE_STACKTEST, _netif_thread, NULL, "dummy_netif");
+    gnrc_netif_add(_iface);
+    ipv6_addr_from_str(&addr, "fe80::ff:fe00:1");
+    gnrc_ipv6_netif_add_addr(_iface, &addr, 64, GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    ipv6_addr_from_str(&addr, "2001:db8::ff:fe00:1");
+    gnrc_ipv6_netif_add_addr(_iface, &addr, 64, GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+
+    /* join a DODAG as router below the root */
+    gnrc_rpl_instance_add(INSTANCE_ID, &inst);
+    inst->mop = GNRC_RPL_MOP_STORING_MODE_NO_MC;
+    ipv6_addr_from_str(&addr, "2001:db8::ff:fe00:0");
+    gnrc_rpl_dodag_init(inst, &addr, _iface, NULL);
+    ipv6_addr_from_str(&addr, "fe80::ff:fe00:0");
+    gnrc_rpl_parent_add_by_addr(&inst->dodag, &addr, &parent);
+
+    /* capture the DAOs on their way to IPv6 */
+    me_reg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    me_reg.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
+
+    for (unsigned i = 0; i < (sizeof(_desc_numof) / sizeof(_desc_numof[0])); i++) {
+        _run(inst, _desc_numof[i]);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
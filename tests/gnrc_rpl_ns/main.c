@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the source routes of a RPL root in non-storing mode
+ *
+ * The root learns the links of 100, 500, and 1000 nodes and builds the
+ * source routing headers to them with and without cached routes.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "net/gnrc/rpl/ns.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+/* children per node */
+#define FANOUT              (4U)
+/* destinations that are addressed over and over */
+#define WARM_NUMOF          (GNRC_RPL_NS_CACHE_SIZE)
+#define WARM_ROUNDS         (100U)
+#define LIFETIME            (3600U)
+
+static const unsigned _nodes_numof[] = { 100, 500, GNRC_RPL_NS_NODES_NUMOF };
+
+static uint8_t _srh[sizeof(gnrc_rpl_srh_t) + (GNRC_RPL_NS_HOPS_MAX * sizeof(ipv6_addr_t))];
+/* statistics of the routes to all nodes */
+static unsigned _hops, _size, _size_uncompr;
+
+/* nodes use addresses derived from short addresses, like on IEEE 802.15.4 */
+static void _node_addr(ipv6_addr_t *addr, unsigned node)
+{
+    ipv6_addr_from_str(addr, "2001:db8::ff:fe00:0");
+    addr->u8[14] = (uint8_t)((0x100 + node) >> 8);
+    addr->u8[15] = (uint8_t)(0x100 + node);
+}
+
+/* nodes are numbered from 1, the nodes 1 to FANOUT are neighbors of the root */
+static unsigned _parent(unsigned node)
+{
+    return (node <= FANOUT) ? 0 : ((node - 1) / FANOUT);
+}
+
+static int _link_add(unsigned node, unsigned parent)
+{
+    ipv6_addr_t child_addr, parent_addr;
+
+    _node_addr(&child_addr, node);
+    _node_addr(&parent_addr, parent);
+    return gnrc_rpl_ns_link_add(&child_addr, (parent == 0) ? NULL : &parent_addr, LIFETIME);
+}
+
+static uint32_t _build(unsigned node, bool stats)
+{
+    ipv6_addr_t dst;
+    uint32_t start;
+    int res;
+
+    _node_addr(&dst, node);
+    start = xtimer_now();
+    res = gnrc_rpl_ns_srh_build(&dst, NULL, _srh, sizeof(_srh));
+    start = xtimer_now() - start;
+    if (res < 0) {
+        printf("no route to node %u\n", node);
+        return start;
+    }
+    if (stats) {
+        unsigned addrs = (res > 0) ? ((gnrc_rpl_srh_t *)_srh)->seg_left : 0;
+
+        _hops += addrs + 1;
+        _size += res;
+        _size_uncompr += (res > 0) ? (sizeof(gnrc_rpl_srh_t) + (addrs * sizeof(ipv6_addr_t))) : 0;
+    }
+    return start;
+}
+
+static uint32_t _warm(unsigned numof)
+{
+    uint32_t usec = 0;
+
+    for (unsigned r = 0; r < WARM_ROUNDS; r++) {
+        for (unsigned i = 0; i < WARM_NUMOF; i++) {
+            usec += _build(numof - i, false);
+        }
+    }
+    return usec;
+}
+
+static void _run(unsigned numof)
+{
+    unsigned moved = (numof - 1) / FANOUT;
+    uint32_t usec = 0;
+
+    gnrc_rpl_ns_flush();
+    _hops = 0;
+    _size = 0;
+    _size_uncompr = 0;
+
+    for (unsigned node = 1; node <= numof; node++) {
+        uint32_t start = xtimer_now();
+
+        if (_link_add(node, _parent(node)) < 0) {
+            printf("unable to add node %u\n", node);
+        }
+        usec += xtimer_now() - start;
+    }
+    printf("%4u nodes: links %6" PRIu32 " us", numof, usec);
+
+    usec = 0;
+    for (unsigned node = 1; node <= numof; node++) {
+        usec += _build(node, true);
+    }
+    printf(", cold %6" PRIu32 " us", usec);
+    printf(", warm %6" PRIu32 " us", _warm(numof));
+
+    /* the parent of the last nodes moves next to the root */
+    _link_add(moved, 0);
+    printf(", moved %6" PRIu32 " us", _warm(numof));
+
+    printf(", %u.%02u hops, SRH %u bytes (uncompressed %u bytes)\n",
+           _hops / numof, ((_hops % numof) * 100) / numof, _size / numof,
+           _size_uncompr / numof);
+}
+
+int main(void)
+{
+    puts("RPL non-storing mode root benchmark");
+
+    for (unsigned i = 0; i < (sizeof(_nodes_numof) / sizeof(_nodes_numof[0])); i++) {
+        _run(_nodes_numof[i]);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
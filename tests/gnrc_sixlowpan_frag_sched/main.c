@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Multi-flow benchmark for the 6LoWPAN fragment scheduler
+ *
+ * Queues several datagrams that need fragmentation at once and measures
+ * when their fragments leave a dummy interface that is as slow as an
+ * IEEE 802.15.4 radio. Build with `GAP=<usec>` to pace the fragments.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* maximum 6LoWPAN payload of an IEEE 802.15.4 frame with long addresses */
+#define MAX_FRAG_SIZE       (102U)
+/* time to transmit one byte at 250 kbit/s */
+#define USEC_PER_BYTE       (32U)
+/* frame overhead on air: SHR, PHR, MHR with long addresses, FCS */
+#define FRAME_OVERHEAD      (6U + 21U + 2U)
+/* a radio driver only buffers very few frames */
+#define NETIF_QUEUE_SIZE    (2U)
+
+typedef struct {
+    const char *name;
+    uint8_t nh;
+    size_t payload_size;
+    uint32_t enqueued;
+    uint32_t first;
+    uint32_t last;
+    unsigned frags;
+} flow_t;
+
+static const uint8_t _src_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _dst_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+static const ipv6_addr_t _src = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _dst = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+
+/* datagram sizes have to differ to tell the flows apart at the interface */
+static flow_t _flows[] = {
+    { "bulk 1", PROTNUM_IPV6_NONXT, 700, 0, 0, 0, 0 },
+    { "bulk 2", PROTNUM_IPV6_NONXT, 500, 0, 0, 0, 0 },
+    { "bulk 3", PROTNUM_IPV6_NONXT, 300, 0, 0, 0, 0 },
+    { "icmpv6", PROTNUM_ICMPV6, 250, 0, 0, 0, 0 },
+};
+
+#define FLOW_NUMOF          (sizeof(_flows) / sizeof(_flows[0]))
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_queue[NETIF_QUEUE_SIZE];
+
+static flow_t *_flow_by_size(size_t datagram_size)
+{
+    for (unsigned i = 0; i < FLOW_NUMOF; i++) {
+        if ((sizeof(ipv6_hdr_t) + _flows[i].payload_size) == datagram_size) {
+            return &_flows[i];
+        }
+    }
+    return NULL;
+}
+
+static void _record(gnrc_pktsnip_t *pkt)
+{
+    sixlowpan_frag_t *frag;
+    flow_t *flow;
+    uint32_t now = xtimer_now();
+
+    if ((pkt->next == NULL) || (pkt->next->size < sizeof(sixlowpan_frag_t)) ||
+        !sixlowpan_frag_is(pkt->next->data)) {
+        return;
+    }
+    frag = pkt->next->data;
+    flow = _flow_by_size(byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK);
+    if (flow != NULL) {
+        if (flow->frags++ == 0) {
+            flow->first = now;
+        }
+        flow->last = now;
+    }
+}
+
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_queue, NETIF_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+                _record(pkt);
+                /* emulate transmission */
+                xtimer_usleep((gnrc_pkt_len(pkt->next) + FRAME_OVERHEAD) * USEC_PER_BYTE);
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_build_pkt(kernel_pid_t iface, const flow_t *flow)
+{
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, flow->payload_size, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memset(payload->data, 0xa5, flow->payload_size);
+    ipv6 = gnrc_ipv6_hdr_build(payload, &_src, &_dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->nh = flow->nh;
+    ipv6_hdr->hl = 64;
+    ipv6_hdr->len = byteorder_htons((uint16_t)flow->payload_size);
+    netif = gnrc_netif_hdr_build((uint8_t *)_src_l2, sizeof(_src_l2),
+                                 (uint8_t *)_dst_l2, sizeof(_dst_l2));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    netif->next = ipv6;
+    return netif;
+}
+
+int main(void)
+{
+    kernel_pid_t iface;
+    gnrc_netreg_entry_t *sixlowpan;
+
+    printf("6LoWPAN fragment scheduler benchmark (gap: %u us)\n",
+           (unsigned)GNRC_SIXLOWPAN_FRAG_GAP);
+
+    iface = thread_create(_netif_stack, sizeof(_netif_stack), THREAD_PRIORITY_MAIN - 1,
+                          THREAD_CREATE_STACKTEST, _netif_thread, NULL, "dummy_netif");
+    gnrc_netif_add(iface);
+    gnrc_sixlowpan_netif_add(iface, MAX_FRAG_SIZE);
+    sixlowpan = gnrc_netreg_lookup(GNRC_NETTYPE_SIXLOWPAN, GNRC_NETREG_DEMUX_CTX_ALL);
+    if (sixlowpan == NULL) {
+        puts("6LoWPAN thread not found");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < FLOW_NUMOF; i++) {
+        gnrc_pktsnip_t *pkt = _build_pkt(iface, &_flows[i]);
+
+        _flows[i].enqueued = xtimer_now();
+        if ((pkt == NULL) || (gnrc_netapi_send(sixlowpan->pid, pkt) < 1)) {
+            printf("unable to send %s\n", _flows[i].name);
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    xtimer_usleep(2U * SEC_IN_USEC);
+
+    for (unsigned i = 0; i < FLOW_NUMOF; i++) {
+        flow_t *flow = &_flows[i];
+
+        if (flow->frags == 0) {
+            printf("%s: %4u bytes: not sent\n", flow->name, (unsigned)flow->payload_size);
+            continue;
+        }
+        printf("%s: %4u bytes, %2u fragments, first after %7" PRIu32 " us, "
+               "last after %7" PRIu32 " us\n", flow->name,
+               (unsigned)flow->payload_size, flow->frags,
+               flow->first - flow->enqueued, flow->last - flow->enqueued);
+    }
+
+    {
+        gnrc_sixlowpan_frag_stats_t *stats = gnrc_sixlowpan_frag_stats_get();
+
+        printf("datagrams: %" PRIu32 ", fragments: %" PRIu32 ", dropped: %" PRIu32
+               ", aborted: %" PRIu32 "\n", stats->datagrams, stats->fragments,
+               stats->dropped, stats->aborted);
+        if (stats->datagrams > 0) {
+            printf("queueing delay: avg %" PRIu32 " us, max %" PRIu32 " us, "
+                   "avg time to send datagram: %" PRIu32 " us\n",
+                   stats->delay_sum / stats->datagrams, stats->delay_max,
+                   stats->duration_sum / stats->datagrams);
+        }
+    }
+
+#if defined(DEVELHELP) && defined(MODULE_OD)
+    gnrc_pktbuf_stats();
+#endif
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Latency and memory benchmark for 6LoWPAN fragment forwarding
+ *
+ * Emulates a 6LoWPAN router between a previous hop that feeds fragments into
+ * the stack at the pace of an IEEE 802.15.4 radio and a next hop that is
+ * represented by a dummy interface thread timestamping forwarded fragments.
+ * Build with `VRB=0` to compare against forwarding after full reassembly.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/gnrc/udp.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* maximum 6LoWPAN payload of an IEEE 802.15.4 frame with long addresses */
+#define MAX_FRAG_SIZE       (102U)
+/* time to transmit one byte at 250 kbit/s */
+#define USEC_PER_BYTE       (32U)
+/* frame overhead on air: SHR, PHR, MHR with long addresses, FCS */
+#define FRAME_OVERHEAD      (6U + 21U + 2U)
+#define FRAMES_MAX          (16U)
+#define NETIF_QUEUE_SIZE    (8U)
+#define HOPS                (5U)
+
+static const uint8_t _prev_hop[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _this_hop[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+static const uint8_t _next_hop[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x03 };
+static const ipv6_addr_t _src = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _dst = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04
+    } };
+static const size_t _payload_sizes[] = { 200, 500, 1000 };
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_queue[NETIF_QUEUE_SIZE];
+static uint8_t _frames[FRAMES_MAX][MAX_FRAG_SIZE];
+static size_t _frame_lens[FRAMES_MAX];
+static volatile unsigned _out_count;
+static volatile uint32_t _out_first, _out_last;
+
+static inline uint32_t _airtime(size_t len)
+{
+    return (len + FRAME_OVERHEAD) * USEC_PER_BYTE;
+}
+
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_queue, NETIF_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+                /* only count fragments, ignore ND messages */
+                if ((pkt->next != NULL) && (pkt->next->size > 0) &&
+                    sixlowpan_frag_is(pkt->next->data)) {
+                    uint32_t now = xtimer_now();
+
+                    if (_out_count++ == 0) {
+                        _out_first = now;
+                    }
+                    _out_last = now;
+                }
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_GET: {
+                gnrc_netapi_opt_t *opt = msg.content.ptr;
+
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                if ((opt->opt == NETOPT_IPV6_IID) && (opt->data_len >= sizeof(eui64_t))) {
+                    memcpy(opt->data, _this_hop, sizeof(eui64_t));
+                    ((uint8_t *)opt->data)[0] ^= 0x02;
+                    reply.content.value = sizeof(eui64_t);
+                }
+                msg_reply(&msg, &reply);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                reply.content.value = (uint32_t)(-ENOTSUP);
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+/* builds the fragments the previous hop sends for a UDP datagram */
+static unsigned _build_frames(kernel_pid_t iface, size_t payload_size, uint16_t tag)
+{
+    gnrc_pktsnip_t *payload, *pkt, *netif;
+    size_t datagram_size = sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) + payload_size;
+    size_t offset = 0, comp_size, pos;
+    uint8_t *ptr;
+    unsigned num = 0;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, payload_size, GNRC_NETTYPE_UNDEF);
+    memset(payload->data, 0xa5, payload_size);
+    pkt = gnrc_udp_hdr_build(payload, 0xf0b1, 0xf0b2);
+    pkt = gnrc_ipv6_hdr_build(pkt, &_src, &_dst);
+    ((ipv6_hdr_t *)pkt->data)->nh = PROTNUM_UDP;
+    ((ipv6_hdr_t *)pkt->data)->hl = 64;
+    ((ipv6_hdr_t *)pkt->data)->len = byteorder_htons(datagram_size - sizeof(ipv6_hdr_t));
+    netif = gnrc_netif_hdr_build((uint8_t *)_prev_hop, sizeof(_prev_hop),
+                                 (uint8_t *)_this_hop, sizeof(_this_hop));
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    netif->next = pkt;
+    gnrc_sixlowpan_iphc_encode(netif);
+
+    /* first fragment: compressed headers + as much payload as fits into the
+     * frame while keeping the uncompressed offset a multiple of 8 */
+    comp_size = gnrc_pkt_len(netif->next) - payload_size;
+    ptr = _frames[num] + sizeof(sixlowpan_frag_t);
+    pos = 0;
+    for (pkt = netif->next; pkt != NULL; pkt = pkt->next) {
+        size_t len = MAX_FRAG_SIZE - sizeof(sixlowpan_frag_t) - pos;
+
+        len = (pkt->size < len) ? pkt->size : len;
+        memcpy(ptr + pos, pkt->data, len);
+        pos += len;
+    }
+    offset = ((MAX_FRAG_SIZE - sizeof(sixlowpan_frag_t) - comp_size +
+               sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)) & 0xfff8);
+    _frame_lens[num] = sizeof(sixlowpan_frag_t) + comp_size +
+                       (offset - sizeof(ipv6_hdr_t) - sizeof(udp_hdr_t));
+    ((sixlowpan_frag_t *)_frames[num])->disp_size = byteorder_htons(datagram_size);
+    ((sixlowpan_frag_t *)_frames[num])->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    ((sixlowpan_frag_t *)_frames[num])->tag = byteorder_htons(tag);
+    gnrc_pktbuf_release(netif);
+
+    /* subsequent fragments: payload only */
+    while ((offset < datagram_size) && (++num < FRAMES_MAX)) {
+        sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)_frames[num];
+        size_t len = (MAX_FRAG_SIZE - sizeof(sixlowpan_frag_n_t)) & 0xfff8;
+
+        if (len > (datagram_size - offset)) {
+            len = datagram_size - offset;
+        }
+        hdr->disp_size = byteorder_htons(datagram_size);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->tag = byteorder_htons(tag);
+        hdr->offset = (uint8_t)(offset >> 3);
+        memset(hdr + 1, 0xa5, len);
+        _frame_lens[num] = sizeof(sixlowpan_frag_n_t) + len;
+        offset += len;
+    }
+    return num + 1;
+}
+
+static void _inject(kernel_pid_t iface, unsigned idx)
+{
+    gnrc_pktsnip_t *netif, *frag;
+
+    netif = gnrc_netif_hdr_build((uint8_t *)_prev_hop, sizeof(_prev_hop),
+                                 (uint8_t *)_this_hop, sizeof(_this_hop));
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    frag = gnrc_pktbuf_add(netif, _frames[idx], _frame_lens[idx],
+                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN, GNRC_NETREG_DEMUX_CTX_ALL,
+                                 frag);
+}
+
+static void _run(kernel_pid_t iface, size_t payload_size, uint16_t tag)
+{
+    unsigned num = _build_frames(iface, payload_size, tag);
+    uint32_t start, in_last = 0, hop_latency, airtime = 0;
+
+    _out_count = 0;
+    start = xtimer_now();
+    for (unsigned i = 0; i < num; i++) {
+        /* emulate transmission on the previous hop's link */
+        xtimer_usleep(_airtime(_frame_lens[i]));
+        airtime += _airtime(_frame_lens[i]);
+        in_last = xtimer_now();
+        _inject(iface, i);
+    }
+    xtimer_usleep(100U * MS_IN_USEC);
+    if (_out_count == 0) {
+        printf("%4u bytes: datagram was not forwarded\n", (unsigned)payload_size);
+        return;
+    }
+    /* time from the end of the first frame on air until the first fragment
+     * leaves towards the next hop */
+    hop_latency = _out_first - (start + _airtime(_frame_lens[0]));
+    printf("%4u bytes: %2u/%2u fragments in/out, first out after %6" PRIu32 " us, "
+           "last out %4" PRIu32 " us after last in, %u-hop latency: %7" PRIu32 " us\n",
+           (unsigned)payload_size, num, _out_count, hop_latency, _out_last - in_last, HOPS,
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+           /* the datagram is pipelined: each further hop only adds one frame */
+           airtime + ((HOPS - 1) * (_airtime(_frame_lens[0]) + hop_latency))
+#else
+           /* each hop needs the whole datagram before sending it on */
+           HOPS * (airtime + hop_latency)
+#endif
+           );
+}
+
+int main(void)
+{
+    kernel_pid_t iface;
+    ipv6_addr_t next_hop;
+    gnrc_ipv6_netif_t *ipv6_if;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    puts("6LoWPAN fragment forwarding benchmark (virtual reassembly)");
+#else
+    puts("6LoWPAN fragment forwarding benchmark (reassembly)");
+#endif
+
+    iface = thread_create(_netif_stack, sizeof(_netif_stack), THREAD_PRIORITY_MAIN - 1,
+                          THREAD_CREATE_STACKTEST, _netif_thread, NULL, "dummy_netif");
+    gnrc_netif_add(iface);
+    gnrc_ipv6_netif_add(iface);
+    ipv6_if = gnrc_ipv6_netif_get(iface);
+    ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN;
+    gnrc_sixlowpan_netif_add(iface, MAX_FRAG_SIZE);
+
+    /* route to _dst via the link-local address of _next_hop */
+    ipv6_addr_set_link_local_prefix(&next_hop);
+    memcpy(&next_hop.u8[8], _next_hop, sizeof(_next_hop));
+    next_hop.u8[8] ^= 0x02;
+    fib_add_entry(&gnrc_ipv6_fib_table, iface, (uint8_t *)&_dst, sizeof(_dst), 0,
+                  next_hop.u8, sizeof(next_hop), 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+
+    for (unsigned i = 0; i < (sizeof(_payload_sizes) / sizeof(_payload_sizes[0])); i++) {
+        _run(iface, _payload_sizes[i], (uint16_t)i);
+    }
+
+#if defined(DEVELHELP) && defined(MODULE_OD)
+    gnrc_pktbuf_stats();
+#endif
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of SHA-256
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define MSG_LEN_MAX     (1024U)
+#define MULTI_NUMOF     (4U)
+#define CHAIN_LEN       (16U)
+
+static uint8_t _input[MULTI_NUMOF][MSG_LEN_MAX];
+static uint8_t _digest[MULTI_NUMOF][SHA256_DIGEST_LENGTH];
+static const uint8_t _key[] = "RIOT";
+
+static int _sha256_64(void)
+{
+    sha256(_input[0], 64, _digest[0]);
+    return 64;
+}
+
+static int _sha256_1024(void)
+{
+    sha256(_input[0], MSG_LEN_MAX, _digest[0]);
+    return MSG_LEN_MAX;
+}
+
+static int _hmac_64(void)
+{
+    hmac_sha256(_key, sizeof(_key), (const unsigned *)_input[0], 64, _digest[0]);
+    return 64;
+}
+
+/* every element of a chain is the hash of 32 bytes */
+static int _chain(void)
+{
+    sha256_chain(_digest[0], SHA256_DIGEST_LENGTH, CHAIN_LEN, _digest[0]);
+    return CHAIN_LEN * SHA256_DIGEST_LENGTH;
+}
+
+static int _multi(void)
+{
+    static const uint8_t *const data[MULTI_NUMOF] = {
+        _input[0], _input[1], _input[2], _input[3]
+    };
+    static const size_t len[MULTI_NUMOF] = {
+        MSG_LEN_MAX, MSG_LEN_MAX, MSG_LEN_MAX, MSG_LEN_MAX
+    };
+    static uint8_t *const digests[MULTI_NUMOF] = {
+        _digest[0], _digest[1], _digest[2], _digest[3]
+    };
+
+    sha256_multi(data, len, digests, MULTI_NUMOF);
+    return MULTI_NUMOF * MSG_LEN_MAX;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long bytes = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        bytes += test();
+    } while (done == 0);
+
+    bytes /= TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu bytes per second, %lu cycles per byte\n", name, bytes,
+           (unsigned long)CLOCK_CORECLOCK / bytes);
+#else
+    printf("+ %s: %lu bytes per second\n", name, bytes);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    for (unsigned i = 0; i < MULTI_NUMOF; i++) {
+        for (unsigned j = 0; j < MSG_LEN_MAX; j++) {
+            _input[i][j] = (uint8_t)(i + j);
+        }
+    }
+
+    run_test("sha256, 64 bytes", _sha256_64);
+    run_test("sha256, 1024 bytes", _sha256_1024);
+    run_test("hmac_sha256, 64 bytes", _hmac_64);
+    run_test("sha256_chain, 32 bytes per element", _chain);
+    run_test("sha256_multi, 4 x 1024 bytes", _multi);
+
+    puts("Done.");
+    return 0;
+}
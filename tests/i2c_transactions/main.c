@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Count the I2C bus acquisitions and transactions of the calls
+ *              of the mpu9150 and lsm303dlhc drivers on the mock I2C bus
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "i2c_mock.h"
+#include "lsm303dlhc.h"
+#include "mpu9150.h"
+
+#define MPU9150_ADDR    (MPU9150_HW_ADDR_HEX_68)
+#define COMPASS_ADDR    (MPU9150_COMP_ADDR_HEX_0C)
+#define ACC_ADDR        (25U)
+#define MAG_ADDR        (30U)
+
+/* registers of the devices, the MSB of the register address is the auto
+ * increment flag of the lsm303dlhc accelerometer */
+static uint8_t _mpu9150_regs[128];
+static uint8_t _compass_regs[128];
+static uint8_t _acc_regs[128];
+static uint8_t _mag_regs[128];
+
+static i2c_mock_stats_t _start;
+
+static uint8_t _regfile(void *arg, uint8_t reg, int write, uint8_t value)
+{
+    uint8_t *regs = arg;
+
+    if (write) {
+        regs[reg & 0x7f] = value;
+    }
+    return regs[reg & 0x7f];
+}
+
+static void _begin(void)
+{
+    i2c_mock_get_stats(&_start);
+}
+
+static void _end(const char *name, int res)
+{
+    i2c_mock_stats_t stats;
+
+    i2c_mock_get_stats(&stats);
+    printf("+ %s: %lu acquisitions, %lu transactions, %lu bytes%s\n",
+           name, (unsigned long)(stats.acquires - _start.acquires),
+           (unsigned long)(stats.transactions - _start.transactions),
+           (unsigned long)(stats.bytes - _start.bytes),
+           (res == 0) ? "" : ", failed");
+}
+
+static void _test_mpu9150(void)
+{
+    mpu9150_t dev;
+    mpu9150_results_t res;
+    int32_t temp;
+
+    /* answer of the compass and its sensitivity adjustment values */
+    _compass_regs[0x00] = MPU9150_COMP_WHOAMI_ANSWER;
+    _compass_regs[0x10] = 128;
+    _compass_regs[0x11] = 128;
+    _compass_regs[0x12] = 128;
+
+    _begin();
+    _end("mpu9150_init",
+         mpu9150_init(&dev, I2C_0, MPU9150_ADDR, COMPASS_ADDR));
+    _begin();
+    _end("mpu9150_read_accel", mpu9150_read_accel(&dev, &res));
+    _begin();
+    _end("mpu9150_read_gyro", mpu9150_read_gyro(&dev, &res));
+    _begin();
+    _end("mpu9150_read_temperature", mpu9150_read_temperature(&dev, &temp));
+    _begin();
+    _end("mpu9150_set_gyro_power off",
+         mpu9150_set_gyro_power(&dev, MPU9150_SENSOR_PWR_OFF));
+    _begin();
+    _end("mpu9150_set_gyro_power on",
+         mpu9150_set_gyro_power(&dev, MPU9150_SENSOR_PWR_ON));
+    _begin();
+    _end("mpu9150_set_compass_power off",
+         mpu9150_set_compass_power(&dev, MPU9150_SENSOR_PWR_OFF));
+    _begin();
+    _end("mpu9150_set_compass_power on",
+         mpu9150_set_compass_power(&dev, MPU9150_SENSOR_PWR_ON));
+}
+
+static void _test_lsm303dlhc(void)
+{
+    lsm303dlhc_t dev;
+    lsm303dlhc_3d_data_t acc;
+    int16_t temp;
+    int res;
+
+    /* 0x123, -0x123 and 0x7ff in the 12 MSB of the acceleration */
+    _acc_regs[0x28] = 0x30;
+    _acc_regs[0x29] = 0x12;
+    _acc_regs[0x2a] = 0xd0;
+    _acc_regs[0x2b] = 0xed;
+    _acc_regs[0x2c] = 0xf0;
+    _acc_regs[0x2d] = 0x7f;
+
+    _begin();
+    _end("lsm303dlhc_init",
+         lsm303dlhc_init(&dev, I2C_0, GPIO_PIN(0, 0), GPIO_PIN(0, 1),
+                         ACC_ADDR, LSM303DLHC_ACC_SAMPLE_RATE_10HZ,
+                         LSM303DLHC_ACC_SCALE_2G, MAG_ADDR,
+                         LSM303DLHC_MAG_SAMPLE_RATE_75HZ,
+                         LSM303DLHC_MAG_GAIN_400_355_GAUSS));
+    _begin();
+    res = lsm303dlhc_read_acc(&dev, &acc);
+    _end("lsm303dlhc_read_acc", res);
+    if ((acc.x_axis != 0x123) || (acc.y_axis != -0x123) ||
+        (acc.z_axis != 0x7ff)) {
+        printf("Error: read %i, %i, %i\n", acc.x_axis, acc.y_axis,
+               acc.z_axis);
+    }
+    _begin();
+    _end("lsm303dlhc_read_temp", lsm303dlhc_read_temp(&dev, &temp));
+    _begin();
+    _end("lsm303dlhc_disable", lsm303dlhc_disable(&dev));
+    _begin();
+    _end("lsm303dlhc_enable", lsm303dlhc_enable(&dev));
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    i2c_mock_attach(MPU9150_ADDR, _regfile, _mpu9150_regs);
+    i2c_mock_attach(COMPASS_ADDR, _regfile, _compass_regs);
+    i2c_mock_attach(ACC_ADDR, _regfile, _acc_regs);
+    i2c_mock_attach(MAG_ADDR, _regfile, _mag_regs);
+
+    _test_mpu9150();
+    _test_lsm303dlhc();
+
+    puts("Done.");
+    return 0;
+}
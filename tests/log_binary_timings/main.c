@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the cost of a log call with log_binary to formatting
+ *              the message on the device
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "log.h"
+#include "log_binary.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+/* log calls per test run */
+#define CALLS           (4U)
+#define PRINTF_RUNS     (16U)
+
+static char _buf[128];
+static uint8_t _records[LOG_BINARY_BUFSIZE];
+static long _sum;
+
+/* messages like the ones of the network stack */
+#define MESSAGES(log)                                                       \
+    do {                                                                    \
+        log("ipv6: received packet from %s to %s, %u bytes\n",              \
+            "fe80::2", "ff02::1", 52u);                                     \
+        log("sixlowpan: fragment %u of datagram %u, offset %u\n",           \
+            3u, 4711u, 96u);                                                \
+        log("netif %d: tx done, retries %u, rssi %d\n", 7, 1u, -64);        \
+        log("rpl: DIO rank %u from %s\n", 256u, "fe80::1");                 \
+    } while (0)
+
+#define SNPRINTF(...)   _sum += snprintf(_buf, sizeof(_buf), __VA_ARGS__)
+
+static int _snprintf(void)
+{
+    MESSAGES(SNPRINTF);
+    return 0;
+}
+
+static int _log_binary(void)
+{
+    MESSAGES(LOG_INFO);
+    /* what the thread of log_binary does when the CPU is idle */
+    _sum += log_binary_read(_records, sizeof(_records));
+    return 0;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void), unsigned long size,
+                     const char *unit)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s: failed\n", name);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * size) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu %ss per second, %lu cycles per %s\n", name, count,
+           unit, (unsigned long)CLOCK_CORECLOCK / count, unit);
+#else
+    printf("+ %s: %lu %ss per second\n", name, count, unit);
+#endif
+}
+
+/* printf can not run for a second without flooding the terminal */
+static void run_printf(void)
+{
+    uint32_t start = xtimer_now();
+
+    for (unsigned i = 0; i < PRINTF_RUNS; i++) {
+        MESSAGES(printf);
+    }
+
+    unsigned long count = ((unsigned long)PRINTF_RUNS * CALLS * SEC_IN_USEC) /
+                          (xtimer_now() - start);
+#ifdef CLOCK_CORECLOCK
+    printf("+ printf: %lu calls per second, %lu cycles per call\n", count,
+           (unsigned long)CLOCK_CORECLOCK / count);
+#else
+    printf("+ printf: %lu calls per second\n", count);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    run_printf();
+    run_test("snprintf", _snprintf, CALLS, "call");
+    run_test("log_binary", _log_binary, CALLS, "call");
+
+    printf("Done (%ld).\n", _sum);
+    return 0;
+}
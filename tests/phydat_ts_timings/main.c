@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the compression ratio and the throughput of phydat
+ *              time series for a temperature and an accelerometer trace
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "phydat_ts.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+#define SAMPLES         (256U)
+#define BUF_SIZE        (SAMPLES * PHYDAT_TS_SAMPLE_MAX + PHYDAT_TS_HDR_LEN)
+/* a phydat_t and a timestamp */
+#define RAW_SIZE        (sizeof(phydat_t) + sizeof(uint32_t))
+
+typedef struct {
+    uint32_t time[SAMPLES];
+    phydat_t data[SAMPLES];
+    uint8_t dim;
+    size_t len;
+    uint8_t buf[BUF_SIZE];
+} trace_t;
+
+static trace_t _temp;
+static trace_t _accel;
+static trace_t *_trace;
+static uint32_t _seed = 1;
+static long _sum;
+
+static int _noise(int range)
+{
+    _seed = (_seed * 1103515245) + 12345;
+    return (int)((_seed >> 16) % ((2 * range) + 1)) - range;
+}
+
+/* every 10 s with a few 100 us of jitter, drifting by 0.01 degree */
+static void _gen_temp(void)
+{
+    int16_t val = 2150;
+
+    _temp.dim = 1;
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        val += (_noise(8) / 8);
+        _temp.time[i] = (i * 10 * SEC_IN_USEC) + _noise(300);
+        _temp.data[i].val[0] = val;
+        _temp.data[i].unit = UNIT_TEMP_C;
+        _temp.data[i].scale = -2;
+    }
+}
+
+/* 100 Hz in mg, lying on a vibrating table */
+static void _gen_accel(void)
+{
+    _accel.dim = 3;
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        _accel.time[i] = (i * 10000) + _noise(20);
+        _accel.data[i].val[0] = _noise(30);
+        _accel.data[i].val[1] = 15 + _noise(30);
+        _accel.data[i].val[2] = 1000 + _noise(30);
+        _accel.data[i].unit = UNIT_G;
+        _accel.data[i].scale = -3;
+    }
+}
+
+static int _append(void)
+{
+    phydat_ts_t ts;
+
+    phydat_ts_init(&ts, _trace->buf, BUF_SIZE, _trace->dim,
+                   _trace->data[0].unit, _trace->data[0].scale);
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        if (phydat_ts_append(&ts, _trace->time[i], &_trace->data[i]) < 0) {
+            return -1;
+        }
+    }
+    _trace->len = ts.len;
+    return 0;
+}
+
+static int _decode(void)
+{
+    phydat_ts_reader_t reader;
+    phydat_t data;
+    uint32_t time;
+
+    phydat_ts_reader_init(&reader, _trace->buf, _trace->len);
+    while (phydat_ts_read(&reader, &time, &data) > 0) {
+        _sum += data.val[0];
+    }
+    return 0;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void), unsigned long size,
+                     const char *unit)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s: failed\n", name);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * size) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu %ss per second, %lu cycles per %s\n", name, count,
+           unit, (unsigned long)CLOCK_CORECLOCK / count, unit);
+#else
+    printf("+ %s: %lu %ss per second\n", name, count, unit);
+#endif
+}
+
+static void _print_ratio(const char *name)
+{
+    unsigned raw = SAMPLES * RAW_SIZE;
+
+    printf("%s: %u samples, %u bytes instead of %u (%u %%)\n", name,
+           SAMPLES, (unsigned)_trace->len, raw,
+           (unsigned)((_trace->len * 100) / raw));
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    _gen_temp();
+    _gen_accel();
+
+    _trace = &_temp;
+    _append();
+    _print_ratio("temperature");
+    _trace = &_accel;
+    _append();
+    _print_ratio("accelerometer");
+
+    _trace = &_temp;
+    run_test("temperature append", _append, SAMPLES, "sample");
+    run_test("temperature decode", _decode, SAMPLES, "sample");
+    _trace = &_accel;
+    run_test("accelerometer append", _append, SAMPLES, "sample");
+    run_test("accelerometer decode", _decode, SAMPLES, "sample");
+
+    printf("Done (%ld).\n", _sum);
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the jitter and the CPU time of the SAUL sampler with
+ *              mock devices
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "saul_reg.h"
+#include "saul_sampler.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define DURATION        (2U * SEC_IN_USEC)
+#define DEVS_NUMOF      (12U)
+#define SAMPLES_NUMOF   (1024U)
+#define FETCH_NUMOF     (64U)
+
+/**
+ * @brief   A mock device that takes some time to read, like a transfer on
+ *          its bus
+ */
+typedef struct {
+    uint32_t spin;
+    unsigned reads;
+} mock_t;
+
+static int mock_read(void *arg, phydat_t *res)
+{
+    mock_t *mock = arg;
+
+    xtimer_spin(mock->spin);
+    mock->reads++;
+    memset(res, 0, sizeof(*res));
+    res->val[0] = mock->reads;
+    res->unit = UNIT_NONE;
+    return 1;
+}
+
+static const saul_driver_t mock_driver = {
+    .read = mock_read,
+    .write = NULL,
+    .type = SAUL_SENSE_ANALOG,
+};
+
+static const char *names[DEVS_NUMOF] = {
+    "i2c0", "i2c1", "i2c2", "i2c3", "spi0", "spi1", "spi2", "spi3",
+    "adc0", "adc1", "adc2", "adc3",
+};
+
+static mock_t mocks[DEVS_NUMOF];
+static saul_reg_t regs[DEVS_NUMOF];
+
+/* accelerometers on both buses at 100 Hz */
+static const saul_sampler_dev_t fast_devs[] = {
+    { &regs[0], 0 }, { &regs[4], 1 }, { &regs[8], SAUL_SAMPLER_NO_BUS },
+};
+
+/* environment sensors at 10 Hz, sharing devices with the other sets */
+static const saul_sampler_dev_t env_devs[] = {
+    { &regs[1], 0 }, { &regs[5], 1 }, { &regs[2], 0 }, { &regs[6], 1 },
+    { &regs[9], SAUL_SAMPLER_NO_BUS }, { &regs[0], 0 },
+};
+
+/* all devices at 1 Hz */
+static const saul_sampler_dev_t all_devs[] = {
+    { &regs[0], 0 }, { &regs[1], 0 }, { &regs[2], 0 }, { &regs[3], 0 },
+    { &regs[4], 1 }, { &regs[5], 1 }, { &regs[6], 1 }, { &regs[7], 1 },
+    { &regs[8], SAUL_SAMPLER_NO_BUS }, { &regs[9], SAUL_SAMPLER_NO_BUS },
+    { &regs[10], SAUL_SAMPLER_NO_BUS }, { &regs[11], SAUL_SAMPLER_NO_BUS },
+};
+
+static saul_sampler_set_t sets[] = {
+    { .devs = fast_devs, .numof = 3, .period = 10000, .id = 0 },
+    { .devs = env_devs, .numof = 6, .period = 100000, .id = 1 },
+    { .devs = all_devs, .numof = 12, .period = 1000000, .id = 2 },
+};
+
+#define SETS_NUMOF      (sizeof(sets) / sizeof(sets[0]))
+
+static saul_sampler_t sampler;
+static saul_sample_t samples[SAMPLES_NUMOF];
+static saul_sample_t fetched[FETCH_NUMOF];
+static char stack[THREAD_STACKSIZE_DEFAULT + 512];
+
+/* statistics of the first device of each set */
+static struct {
+    uint32_t first;
+    unsigned count;
+    uint32_t max;
+    uint64_t sum;
+} stats[SETS_NUMOF];
+static unsigned samples_numof;
+
+static unsigned long count_idle(void)
+{
+    uint32_t start = xtimer_now();
+    unsigned long count = 0;
+
+    while ((xtimer_now() - start) < DURATION) {
+        count++;
+    }
+    return count;
+}
+
+static void evaluate(const saul_sample_t *sample)
+{
+    samples_numof++;
+    if ((sample->set >= SETS_NUMOF) || (sample->index != 0)) {
+        return;
+    }
+
+    unsigned set = sample->set;
+    if (stats[set].count == 0) {
+        stats[set].first = sample->time;
+    }
+    else {
+        uint32_t ideal = stats[set].first + (stats[set].count * sets[set].period);
+        uint32_t jitter = abs((int32_t)(sample->time - ideal));
+        if (jitter > stats[set].max) {
+            stats[set].max = jitter;
+        }
+        stats[set].sum += jitter;
+    }
+    stats[set].count++;
+}
+
+int main(void)
+{
+    puts("SAUL sampler test");
+
+    for (unsigned i = 0; i < DEVS_NUMOF; i++) {
+        /* an I2C read takes longer than an SPI read or an ADC conversion */
+        mocks[i].spin = (i < 4) ? 300 : (i < 8) ? 100 : 50;
+        regs[i].dev = &mocks[i];
+        regs[i].name = names[i];
+        regs[i].driver = &mock_driver;
+        saul_reg_add(&regs[i]);
+    }
+    if ((saul_reg_numof() != DEVS_NUMOF) ||
+        (saul_reg_find_name("adc3") != &regs[11]) ||
+        (saul_reg_find_nth(10) != &regs[10])) {
+        puts("[FAILED] registry lookup");
+        return 1;
+    }
+
+    saul_sampler_init(&sampler, samples, SAMPLES_NUMOF);
+    thread_create(stack, sizeof(stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, saul_sampler_run, &sampler,
+                  "saul_sampler");
+
+    unsigned long idle = count_idle();
+
+    for (unsigned i = 0; i < SETS_NUMOF; i++) {
+        saul_sampler_add(&sampler, &sets[i]);
+    }
+    unsigned long busy = count_idle();
+
+    size_t n;
+    while ((n = saul_sampler_fetch(&sampler, fetched, FETCH_NUMOF)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            evaluate(&fetched[i]);
+        }
+    }
+
+    unsigned reads = 0;
+    uint32_t spun = 0;
+    for (unsigned i = 0; i < DEVS_NUMOF; i++) {
+        reads += mocks[i].reads;
+        spun += mocks[i].reads * mocks[i].spin;
+    }
+
+    printf("%u samples from %u reads, %lu lost\n", samples_numof, reads,
+           (unsigned long)sampler.lost);
+    for (unsigned i = 0; i < SETS_NUMOF; i++) {
+        unsigned count = (stats[i].count > 1) ? stats[i].count - 1 : 1;
+        printf("set %u: period %lu us, %u samples, jitter mean %lu us, "
+               "max %lu us\n", i, (unsigned long)sets[i].period,
+               stats[i].count, (unsigned long)(stats[i].sum / count),
+               (unsigned long)stats[i].max);
+    }
+
+    /* the main thread only runs while the sampler does not */
+    uint32_t cpu = DURATION - (uint32_t)(((uint64_t)DURATION * busy) / idle);
+    printf("CPU time %lu us of %lu us, %lu us reading the devices\n",
+           (unsigned long)cpu, (unsigned long)DURATION, (unsigned long)spun);
+
+    if ((stats[0].count == 0) || (sampler.lost != 0)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
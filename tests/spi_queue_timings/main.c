@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the throughput and the time the caller blocks for of
+ *              frame buffer reads of an at86rf2xx like radio with blocking
+ *              transfers, spi_transfer_segs() and spi_queue()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "mutex.h"
+#include "periph/gpio.h"
+#include "periph/spi.h"
+#include "xtimer.h"
+
+#ifdef MODULE_SPI_MOCK
+#include "spi_mock.h"
+#endif
+
+#ifndef TEST_SPI
+#define TEST_SPI        SPI_0
+#endif
+
+#ifndef TEST_CS
+#define TEST_CS         GPIO_PIN(0, 0)
+#endif
+
+#ifndef TEST_SPEED
+#define TEST_SPEED      SPI_SPEED_1MHZ
+#define TEST_SPEED_HZ   (1000000UL)
+#endif
+
+/* frame buffer read command of the at86rf2xx */
+#define FB_READ         (0x20)
+
+#define FRAMES          (64U)
+#define FRAME_LEN       (127U)
+/* command, PHR, PSDU, LQI and ED */
+#define READ_LEN        (1U + 1U + FRAME_LEN + 2U)
+#define WIRE_US         ((READ_LEN * 8UL * SEC_IN_USEC) / TEST_SPEED_HZ)
+/* the time to process a frame, e.g. to pass it up the network stack */
+#define WORK_US         (WIRE_US)
+
+typedef struct {
+    char hdr[2];                /* status byte and PHR */
+    char psdu[FRAME_LEN];
+    char lqi_ed[2];
+} frame_t;
+
+static frame_t _frames[2];
+static const char _cmd[2] = { FB_READ, 0 };
+static unsigned _errors;
+
+static mutex_t _rx_done = MUTEX_INIT;
+static volatile unsigned _rx_busy;
+
+#ifdef MODULE_SPI_MOCK
+/* model of the frame buffer of the radio, every read returns the next frame */
+static unsigned _seq;
+
+static uint8_t _radio(void *arg, unsigned pos, uint8_t out)
+{
+    (void)arg;
+
+    if ((pos == 0) || (out != 0)) {
+        /* the command, the radio answers with its status */
+        return 0x00;
+    }
+    if (pos == 1) {
+        return FRAME_LEN;
+    }
+    if (pos < (2 + FRAME_LEN)) {
+        return (uint8_t)(_seq + pos - 2);
+    }
+    if (pos == (READ_LEN - 1)) {
+        _seq++;
+    }
+    return 0xff;
+}
+#endif
+
+static void _work(frame_t *frame, unsigned seq)
+{
+    xtimer_spin(WORK_US);
+#ifdef MODULE_SPI_MOCK
+    if ((uint8_t)frame->hdr[1] != FRAME_LEN) {
+        _errors++;
+        return;
+    }
+    for (unsigned i = 0; i < FRAME_LEN; i++) {
+        if ((uint8_t)frame->psdu[i] != (uint8_t)(seq + i)) {
+            _errors++;
+            return;
+        }
+    }
+#else
+    (void)frame;
+    (void)seq;
+#endif
+}
+
+static void _rx_cb(void *arg, int res)
+{
+    (void)arg;
+
+    if (res != (int)READ_LEN) {
+        _errors++;
+    }
+    _rx_busy = 0;
+    mutex_unlock(&_rx_done);
+}
+
+/* the way at86rf2xx_fb_start(), at86rf2xx_fb_read() and
+ * at86rf2xx_fb_stop() access the frame buffer */
+static uint32_t _blocking(void)
+{
+    uint32_t blocked = 0;
+
+    for (unsigned i = 0; i < FRAMES; i++) {
+        frame_t *frame = &_frames[0];
+        uint32_t start = xtimer_now();
+
+        spi_acquire(TEST_SPI);
+        gpio_clear(TEST_CS);
+        spi_transfer_byte(TEST_SPI, FB_READ, &frame->hdr[0]);
+        spi_transfer_bytes(TEST_SPI, NULL, &frame->hdr[1], 1);
+        spi_transfer_bytes(TEST_SPI, NULL, frame->psdu, FRAME_LEN);
+        spi_transfer_bytes(TEST_SPI, NULL, frame->lqi_ed, 2);
+        gpio_set(TEST_CS);
+        spi_release(TEST_SPI);
+        blocked += xtimer_now() - start;
+        _work(frame, i);
+    }
+    return blocked;
+}
+
+static void _segs_init(spi_seg_t *segs, frame_t *frame)
+{
+    segs[0].out = _cmd;
+    segs[0].in = frame->hdr;
+    segs[0].length = sizeof(frame->hdr);
+    segs[1].out = NULL;
+    segs[1].in = frame->psdu;
+    segs[1].length = sizeof(frame->psdu);
+    segs[2].out = NULL;
+    segs[2].in = frame->lqi_ed;
+    segs[2].length = sizeof(frame->lqi_ed);
+}
+
+static uint32_t _segs(void)
+{
+    uint32_t blocked = 0;
+    spi_seg_t segs[3];
+
+    _segs_init(segs, &_frames[0]);
+    for (unsigned i = 0; i < FRAMES; i++) {
+        uint32_t start = xtimer_now();
+
+        if (spi_transfer_segs(TEST_SPI, TEST_CS, segs, 3) != (int)READ_LEN) {
+            _errors++;
+        }
+        blocked += xtimer_now() - start;
+        _work(&_frames[0], i);
+    }
+    return blocked;
+}
+
+static uint32_t _queued(void)
+{
+    uint32_t blocked = 0;
+    spi_seg_t segs[2][3];
+    spi_trans_t trans[2];
+
+    for (unsigned i = 0; i < 2; i++) {
+        _segs_init(segs[i], &_frames[i]);
+        trans[i].cs = TEST_CS;
+        trans[i].segs = segs[i];
+        trans[i].segs_numof = 3;
+        trans[i].cb = _rx_cb;
+        trans[i].arg = NULL;
+    }
+    /* read the next frame while processing the one read before */
+    for (unsigned i = 0; i <= FRAMES; i++) {
+        uint32_t start = xtimer_now();
+
+        while (_rx_busy) {
+            mutex_lock(&_rx_done);
+        }
+        if (i < FRAMES) {
+            _rx_busy = 1;
+            spi_queue(TEST_SPI, &trans[i & 1]);
+        }
+        blocked += xtimer_now() - start;
+        if (i > 0) {
+            _work(&_frames[(i - 1) & 1], i - 1);
+        }
+    }
+    return blocked;
+}
+
+static void run_test(const char *name, uint32_t (*test)(void))
+{
+    uint32_t start, total, blocked;
+
+#ifdef MODULE_SPI_MOCK
+    _seq = 0;
+#endif
+    _errors = 0;
+    start = xtimer_now();
+    blocked = test();
+    total = xtimer_now() - start;
+
+    printf("+ %s: %lu frames per second, blocked %lu us per frame, "
+           "%u errors\n", name,
+           (unsigned long)(((uint64_t)FRAMES * SEC_IN_USEC) / total),
+           (unsigned long)(blocked / FRAMES), _errors);
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    if (spi_init_master(TEST_SPI, SPI_CONF_FIRST_RISING, TEST_SPEED) != 0) {
+        puts("Error: unable to initialize the SPI bus");
+        return 1;
+    }
+    gpio_init(TEST_CS, GPIO_OUT);
+    gpio_set(TEST_CS);
+#ifdef MODULE_SPI_MOCK
+    spi_mock_attach(TEST_CS, _radio, NULL);
+#endif
+    mutex_lock(&_rx_done);
+
+    printf("%u frames of %u bytes, %lu us on the bus, %lu us to process\n",
+           FRAMES, FRAME_LEN, (unsigned long)WIRE_US, (unsigned long)WORK_US);
+    run_test("blocking", _blocking);
+    run_test("spi_transfer_segs", _segs);
+    run_test("spi_queue", _queued);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the throughput and the time the caller blocks for of
+ *              uart_write(), uart_write_async() and uart_txbuf
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "mutex.h"
+#include "periph/uart.h"
+#include "uart_txbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_UART
+/* on most boards, UART_DEV(0) is stdio */
+#define TEST_UART       UART_DEV(UART_NUMOF - 1)
+#endif
+
+#ifndef TEST_BAUDRATE
+#define TEST_BAUDRATE   (115200UL)
+#endif
+
+/* frames like the ones of SLIP */
+#define FRAMES          (32U)
+#define FRAME_LEN       (128U)
+#define WIRE_US         ((FRAME_LEN * 10UL * SEC_IN_USEC) / TEST_BAUDRATE)
+/* the time to prepare a frame, e.g. to build a packet */
+#define WORK_US         (WIRE_US)
+
+static uint8_t _frames[2][FRAME_LEN];
+static uint8_t _txbuf_mem[256];
+static uart_txbuf_t _txbuf;
+
+static mutex_t _tx_done = MUTEX_INIT;
+static volatile unsigned _tx_busy;
+
+static void _rx_cb(void *arg, uint8_t data)
+{
+    (void)arg;
+    (void)data;
+}
+
+static void _tx_cb(void *arg)
+{
+    (void)arg;
+    _tx_busy = 0;
+    mutex_unlock(&_tx_done);
+}
+
+static uint8_t *_work(unsigned i)
+{
+    uint8_t *frame = _frames[i & 1];
+
+    xtimer_spin(WORK_US);
+    memset(frame, 'a' + (i % 26), FRAME_LEN - 1);
+    frame[FRAME_LEN - 1] = '\n';
+    return frame;
+}
+
+static uint32_t _blocking(void)
+{
+    uint32_t blocked = 0;
+
+    for (unsigned i = 0; i < FRAMES; i++) {
+        uint8_t *frame = _work(i);
+        uint32_t start = xtimer_now();
+
+        uart_write(TEST_UART, frame, FRAME_LEN);
+        blocked += xtimer_now() - start;
+    }
+    return blocked;
+}
+
+static uint32_t _async(void)
+{
+    uint32_t blocked = 0;
+
+    for (unsigned i = 0; i < FRAMES; i++) {
+        uint8_t *frame = _work(i);
+        uint32_t start = xtimer_now();
+
+        /* the frame prepared before is still being sent */
+        while (_tx_busy) {
+            mutex_lock(&_tx_done);
+        }
+        _tx_busy = 1;
+        uart_write_async(TEST_UART, frame, FRAME_LEN, _tx_cb, NULL);
+        blocked += xtimer_now() - start;
+    }
+    while (_tx_busy) {
+        mutex_lock(&_tx_done);
+    }
+    return blocked;
+}
+
+static uint32_t _txbuffered(void)
+{
+    uint32_t blocked = 0;
+
+    for (unsigned i = 0; i < FRAMES; i++) {
+        uint8_t *frame = _work(i);
+        uint32_t start = xtimer_now();
+
+        uart_txbuf_write(&_txbuf, frame, FRAME_LEN);
+        blocked += xtimer_now() - start;
+    }
+    uart_txbuf_flush(&_txbuf);
+    return blocked;
+}
+
+static void run_test(const char *name, uint32_t (*test)(void))
+{
+    uint32_t start = xtimer_now();
+    uint32_t blocked = test();
+    uint32_t total = xtimer_now() - start;
+
+    printf("+ %s: %lu bytes per second, blocked %lu us per frame\n", name,
+           (unsigned long)(((uint64_t)FRAMES * FRAME_LEN * SEC_IN_USEC) /
+                           total),
+           (unsigned long)(blocked / FRAMES));
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    if (uart_init(TEST_UART, TEST_BAUDRATE, _rx_cb, NULL) != 0) {
+        puts("Error: unable to initialize the UART");
+        return 1;
+    }
+    mutex_lock(&_tx_done);
+    uart_txbuf_init(&_txbuf, TEST_UART, _txbuf_mem, sizeof(_txbuf_mem));
+
+    printf("%u frames of %u bytes, %lu us on the wire, %lu us to prepare\n",
+           FRAMES, FRAME_LEN, (unsigned long)WIRE_US, (unsigned long)WORK_US);
+    run_test("uart_write", _blocking);
+    run_test("uart_write_async", _async);
+    run_test("uart_txbuf", _txbuffered);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare the throughput of unbuffered and buffered UBJSON
+ *              streams and of strongly typed arrays
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "irq.h"
+#include "ubjson.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1UL)
+#define TIMEOUT         (TIMEOUT_S * SEC_IN_USEC)
+/* int16_t samples of a sensor */
+#define SAMPLES         (64U)
+/* the size of the read-ahead and write-behind buffers */
+#define CACHE_SIZE      (64U)
+#define BUF_SIZE        (512U)
+
+static uint8_t _buf[BUF_SIZE];
+static size_t _pos;
+static size_t _len;
+static uint8_t _cache[CACHE_SIZE];
+static int16_t _samples[SAMPLES];
+static int16_t _out[SAMPLES];
+static long _sum;
+
+/* The stream is guarded like a buffer shared with an interrupt handler, e.g.
+ * the one of a UART, so every call has a fixed cost besides the copy. */
+static ssize_t _write(ubjson_cookie_t *__restrict cookie, const void *buf,
+                      size_t len)
+{
+    (void) cookie;
+    unsigned state = irq_disable();
+    if (len > (BUF_SIZE - _pos)) {
+        irq_restore(state);
+        return -1;
+    }
+    memcpy(&_buf[_pos], buf, len);
+    _pos += len;
+    irq_restore(state);
+    return len;
+}
+
+static ssize_t _read(ubjson_cookie_t *__restrict cookie, void *buf,
+                     size_t max_len)
+{
+    (void) cookie;
+    unsigned state = irq_disable();
+    if (_pos == _len) {
+        irq_restore(state);
+        return -1;
+    }
+    if (max_len > (_len - _pos)) {
+        max_len = _len - _pos;
+    }
+    memcpy(buf, &_buf[_pos], max_len);
+    _pos += max_len;
+    irq_restore(state);
+    return max_len;
+}
+
+static int _write_values(ubjson_cookie_t *cookie)
+{
+    if (ubjson_open_array_len(cookie, SAMPLES) < 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        if (ubjson_write_i32(cookie, _samples[i]) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _unbuffered_write(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    ubjson_write_init(&cookie, _write);
+    return _write_values(&cookie);
+}
+
+static int _buffered_write(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    ubjson_write_init_buffered(&cookie, _write, _cache, sizeof(_cache));
+    if (_write_values(&cookie) < 0) {
+        return -1;
+    }
+    return (ubjson_write_flush(&cookie) < 0) ? -1 : 0;
+}
+
+static int _typed_write(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    ubjson_write_init_buffered(&cookie, _write, _cache, sizeof(_cache));
+    if (ubjson_write_array(&cookie, UBJSON_ARRAY_INT16, _samples,
+                           SAMPLES) < 0) {
+        return -1;
+    }
+    return (ubjson_write_flush(&cookie) < 0) ? -1 : 0;
+}
+
+static ubjson_read_callback_result_t _values_callback(
+        ubjson_cookie_t *__restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2)
+{
+    (void) content1;
+    (void) type2;
+
+    if (type1 == UBJSON_ENTER_ARRAY) {
+        return ubjson_read_array(cookie);
+    }
+    else if (type1 != UBJSON_INDEX) {
+        return UBJSON_INVALID_DATA;
+    }
+
+    ubjson_type_t type;
+    int32_t value;
+    ubjson_read_callback_result_t result;
+
+    result = ubjson_peek_value(cookie, &type, &content2);
+    if (result != UBJSON_OKAY) {
+        return result;
+    }
+    else if (type != UBJSON_TYPE_INT32) {
+        return UBJSON_INVALID_DATA;
+    }
+    else if (ubjson_get_i32(cookie, content2, &value) <= 0) {
+        return UBJSON_PREMATURELY_ENDED;
+    }
+    _sum += value;
+    return UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t _array_callback(
+        ubjson_cookie_t *__restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2)
+{
+    size_t count = SAMPLES;
+
+    (void) content1;
+    (void) type2;
+    (void) content2;
+
+    if (type1 != UBJSON_ENTER_ARRAY) {
+        return UBJSON_INVALID_DATA;
+    }
+    return ubjson_get_array(cookie, UBJSON_ARRAY_INT16, _out, &count);
+}
+
+static int _unbuffered_read(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    return (ubjson_read(&cookie, _read, _values_callback) == UBJSON_OKAY)
+           ? 0 : -1;
+}
+
+static int _buffered_read(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    ubjson_read_init_buffered(&cookie, _read, _values_callback,
+                              _cache, sizeof(_cache));
+    return (ubjson_read_next(&cookie) == UBJSON_OKAY) ? 0 : -1;
+}
+
+static int _typed_read(void)
+{
+    ubjson_cookie_t cookie;
+
+    _pos = 0;
+    ubjson_read_init_buffered(&cookie, _read, _array_callback,
+                              _cache, sizeof(_cache));
+    if (ubjson_read_next(&cookie) != UBJSON_OKAY) {
+        return -1;
+    }
+    _sum += _out[SAMPLES - 1];
+    return 0;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, int (*test)(void), unsigned long size,
+                     const char *unit)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    xtimer_t xtimer;
+
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    if (test() < 0) {
+        printf("+ %s: failed\n", name);
+        return;
+    }
+
+    xtimer_set(&xtimer, TIMEOUT);
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    count = (count * size) / TIMEOUT_S;
+#ifdef CLOCK_CORECLOCK
+    printf("+ %s: %lu %ss per second, %lu cycles per %s\n", name, count,
+           unit, (unsigned long)CLOCK_CORECLOCK / count, unit);
+#else
+    printf("+ %s: %lu %ss per second\n", name, count, unit);
+#endif
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        _samples[i] = 2000 - (i * 100);
+    }
+
+    _typed_write();
+    size_t typed_len = _pos;
+    _unbuffered_write();
+    _len = _pos;
+    printf("%u samples, %u bytes as array of numbers, %u as typed array\n",
+           SAMPLES, (unsigned)_len, (unsigned)typed_len);
+
+    /* the readers need the output of the writers before */
+    run_test("unbuffered write", _unbuffered_write, SAMPLES, "value");
+    run_test("buffered write", _buffered_write, SAMPLES, "value");
+    run_test("unbuffered read", _unbuffered_read, SAMPLES, "value");
+    run_test("buffered read", _buffered_read, SAMPLES, "value");
+    run_test("typed array write", _typed_write, SAMPLES, "value");
+    _len = typed_len;
+    run_test("typed array read", _typed_read, SAMPLES, "value");
+
+    printf("Done (%ld).\n", _sum);
+    return 0;
+}
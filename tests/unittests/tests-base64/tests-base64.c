@@ -301,6 +301,181 @@ static void test_base64_07_stream_decode(void)
 #endif
 }
 
+/* the test vectors of RFC 4648, section 10 */
+static const char *rfc4648_data[] = {
+    "f", "fo", "foo", "foob", "fooba", "foobar"
+};
+
+static const char *rfc4648_base64[] = {
+    "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"
+};
+
+static void test_base64_08_rfc4648(void)
+{
+    for (unsigned i = 0; i < sizeof(rfc4648_data) / sizeof(rfc4648_data[0]); i++) {
+        unsigned char out[8];
+        size_t out_size = sizeof(out);
+        unsigned char data[8];
+        size_t data_size = sizeof(data);
+
+        int ret = base64_encode((unsigned char *)rfc4648_data[i], strlen(rfc4648_data[i]),
+                                out, &out_size);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(strlen(rfc4648_base64[i]), out_size);
+        TEST_ASSERT(memcmp(rfc4648_base64[i], out, out_size) == 0);
+
+        /* base64url leaves out the padding */
+        out_size = sizeof(out);
+        ret = base64url_encode((unsigned char *)rfc4648_data[i], strlen(rfc4648_data[i]),
+                               out, &out_size);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(strcspn(rfc4648_base64[i], "="), out_size);
+        TEST_ASSERT(memcmp(rfc4648_base64[i], out, out_size) == 0);
+
+        ret = base64url_decode(out, out_size, data, &data_size);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(strlen(rfc4648_data[i]), data_size);
+        TEST_ASSERT(memcmp(rfc4648_data[i], data, data_size) == 0);
+    }
+}
+
+static void test_base64_09_url_alphabet(void)
+{
+    unsigned char data_in[] = { 0xfb, 0xff, 0xbf };
+    unsigned char out[4];
+    size_t out_size = sizeof(out);
+    unsigned char data[3];
+    size_t data_size = sizeof(data);
+
+    int ret = base64_encode(data_in, sizeof(data_in), out, &out_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT(memcmp("+/+/", out, 4) == 0);
+
+    out_size = sizeof(out);
+    ret = base64url_encode(data_in, sizeof(data_in), out, &out_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT(memcmp("-_-_", out, 4) == 0);
+
+    ret = base64url_decode(out, 4, data, &data_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(data_in), data_size);
+    TEST_ASSERT(memcmp(data_in, data, data_size) == 0);
+}
+
+static void test_base64_10_stream_encode_chunks(void)
+{
+    unsigned char data_in[] = "Hello RIOT this is a base64 test!\n"
+                              "This should work as intended.";
+    unsigned char expected_encoding[] = "SGVsbG8gUklPVCB0aGlzIGlzIGEgYmFzZTY0IHR"
+                                        "lc3QhClRoaXMgc2hvdWxkIHdvcmsgYXMgaW50ZW5kZWQu";
+    unsigned char base64_out[sizeof(expected_encoding)];
+    size_t data_in_size = strlen((char *)data_in);
+
+    /* chunks of any size */
+    for (size_t chunk = 1; chunk <= 5; chunk++) {
+        base64_ctx_t ctx;
+        size_t used = 0;
+        size_t size;
+
+        base64_encode_init(&ctx);
+        for (size_t pos = 0; pos < data_in_size; pos += chunk) {
+            size_t len = (data_in_size - pos < chunk) ? (data_in_size - pos) : chunk;
+
+            size = sizeof(base64_out) - used;
+            int ret = base64_encode_update(&ctx, data_in + pos, len, base64_out + used, &size);
+            TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+            used += size;
+        }
+        size = sizeof(base64_out) - used;
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS,
+                              base64_encode_finish(&ctx, base64_out + used, &size));
+        used += size;
+
+        TEST_ASSERT_EQUAL_INT(strlen((char *)expected_encoding), used);
+        TEST_ASSERT(memcmp(expected_encoding, base64_out, used) == 0);
+    }
+}
+
+static void test_base64_11_stream_decode_chunks(void)
+{
+    /* line breaks and padding are skipped */
+    unsigned char encoded[] = "UGV0ZXIgUGlwZXIgcGlja2VkIGEgcGVjayBvZiBwaWNr\r\n"
+                              "bGVkIHBlcHBlcnMu\r\nCg==";
+    unsigned char expected[] = "Peter Piper picked a peck of pickled peppers.\n";
+    /* the decoder reserves space for the skipped symbols too */
+    unsigned char data_out[sizeof(expected) + 8];
+    size_t encoded_size = strlen((char *)encoded);
+
+    for (size_t chunk = 1; chunk <= 7; chunk++) {
+        base64_ctx_t ctx;
+        size_t used = 0;
+        size_t size;
+
+        base64_decode_init(&ctx);
+        for (size_t pos = 0; pos < encoded_size; pos += chunk) {
+            size_t len = (encoded_size - pos < chunk) ? (encoded_size - pos) : chunk;
+
+            size = sizeof(data_out) - used;
+            int ret = base64_decode_update(&ctx, encoded + pos, len, data_out + used, &size);
+            TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+            used += size;
+        }
+        size = sizeof(data_out) - used;
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, base64_decode_finish(&ctx, data_out + used, &size));
+        used += size;
+
+        TEST_ASSERT_EQUAL_INT(strlen((char *)expected), used);
+        TEST_ASSERT(memcmp(expected, data_out, used) == 0);
+    }
+}
+
+static void test_base64_12_stream_buffer_size(void)
+{
+    base64_ctx_t ctx;
+    unsigned char out[4];
+    size_t size = 3;
+
+    base64_encode_init(&ctx);
+    /* nothing to write yet */
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS,
+                          base64_encode_update(&ctx, (unsigned char *)"ab", 2, NULL, &size));
+    TEST_ASSERT_EQUAL_INT(0, size);
+    TEST_ASSERT_EQUAL_INT(BASE64_ERROR_BUFFER_OUT_SIZE,
+                          base64_encode_update(&ctx, (unsigned char *)"c", 1, out, &size));
+    TEST_ASSERT_EQUAL_INT(4, size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS,
+                          base64_encode_update(&ctx, (unsigned char *)"c", 1, out, &size));
+    TEST_ASSERT(memcmp("YWJj", out, 4) == 0);
+}
+
+static void test_base64_13_alphabet_mismatch(void)
+{
+    unsigned char data_in[] = { 0xfb, 0xff, 0xbf };
+    unsigned char data[6];
+    size_t data_size = sizeof(data);
+    base64_ctx_t ctx;
+
+    /* each decoder ignores the symbols of the other alphabet */
+    int ret = base64_decode((unsigned char *)"-+/_+/-_", 8, data, &data_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(data_in), data_size);
+    TEST_ASSERT(memcmp(data_in, data, data_size) == 0);
+
+    data_size = sizeof(data);
+    ret = base64url_decode((unsigned char *)"+-_/-_+/", 8, data, &data_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(data_in), data_size);
+    TEST_ASSERT(memcmp(data_in, data, data_size) == 0);
+
+    /* so does the streaming decoder */
+    base64url_decode_init(&ctx);
+    data_size = sizeof(data);
+    ret = base64_decode_update(&ctx, (unsigned char *)"+-_/-_+/", 8, data, &data_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_INT(sizeof(data_in), data_size);
+    TEST_ASSERT(memcmp(data_in, data, data_size) == 0);
+}
+
 Test *tests_base64_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -311,6 +486,12 @@ Test *tests_base64_tests(void)
         new_TestFixture(test_base64_05_decode_larger),
         new_TestFixture(test_base64_06_stream_encode),
         new_TestFixture(test_base64_07_stream_decode),
+        new_TestFixture(test_base64_08_rfc4648),
+        new_TestFixture(test_base64_09_url_alphabet),
+        new_TestFixture(test_base64_10_stream_encode_chunks),
+        new_TestFixture(test_base64_11_stream_decode_chunks),
+        new_TestFixture(test_base64_12_stream_buffer_size),
+        new_TestFixture(test_base64_13_alphabet_mismatch),
     };
 
     EMB_UNIT_TESTCALLER(base64_tests, NULL, NULL, fixtures);
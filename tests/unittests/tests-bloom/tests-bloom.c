@@ -6,6 +6,7 @@
  * General Public License v2.1. See the file LICENSE in the top level
  * directory for more details.
  */
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -22,9 +23,17 @@
 #define TESTS_BLOOM_PROB_IN_FILTER (4)
 #define TESTS_BLOOM_NOT_IN_FILTER (996)
 #define TESTS_BLOOM_FALSE_POS_RATE_THR (0.005)
+#define TESTS_BLOOM_DH_PROB_IN_FILTER (6)
+#define TESTS_BLOOM_DH_NOT_IN_FILTER (994)
+#define TESTS_BLOOM_DH_FALSE_POS_RATE_THR (0.01)
+
+#define TESTS_BLOOM_GENS (3)
 
 static bloom_t bloom;
 BITFIELD(bf, TESTS_BLOOM_BITS);
+static bloom_counting_t counting;
+static bloom_rotating_t rotating;
+static uint8_t cells[BLOOM_CELLS_SIZE(TESTS_BLOOM_BITS)];
 hashfp_t hashes[TESTS_BLOOM_HASHF] = {
                      (hashfp_t) fnv_hash,
                      (hashfp_t) sax_hash,
@@ -85,11 +94,181 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static void test_bloom_double_hashing(void)
+{
+    int in = 0;
+    int not_in = 0;
+    double false_positive_rate = 0;
+
+    bloom_init(&bloom, TESTS_BLOOM_BITS, bf, NULL, TESTS_BLOOM_HASHF);
+    load_dictionary_fixture();
+
+    for (int i = 0; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_check(&bloom, (const uint8_t *) B[i], strlen(B[i])));
+    }
+
+    for (int i = 0; i < lenA; i++)
+    {
+        if (bloom_check(&bloom, (const uint8_t *) A[i], strlen(A[i])))
+        {
+            in++;
+        }
+        else
+        {
+            not_in++;
+        }
+    }
+    false_positive_rate = (double) in / (double) lenA;
+
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_DH_PROB_IN_FILTER, in);
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_DH_NOT_IN_FILTER, not_in);
+    TEST_ASSERT(false_positive_rate < TESTS_BLOOM_DH_FALSE_POS_RATE_THR);
+}
+
+static void test_bloom_double_hashing_more_hashes_than_bits(void)
+{
+    memset(bf, 0, sizeof(bf));
+    bloom_init(&bloom, 4, bf, NULL, 12);
+    load_dictionary_fixture();
+
+    for (int i = 0; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_check(&bloom, (const uint8_t *) B[i], strlen(B[i])));
+    }
+    /* all indices stay below m */
+    TEST_ASSERT_EQUAL_INT(0, bf[0] & 0xf0);
+    for (unsigned i = 1; i < sizeof(bf); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, bf[i]);
+    }
+}
+
+static void test_bloom_counting_remove(void)
+{
+    bloom_counting_init(&counting, TESTS_BLOOM_BITS, cells, NULL, TESTS_BLOOM_HASHF);
+
+    for (int i = 0; i < lenB; i++)
+    {
+        bloom_counting_add(&counting, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++)
+    {
+        TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[i], strlen(B[i])));
+    }
+
+    /* the removed strings are gone, the others stay */
+    for (int i = 0; i < lenB; i += 2)
+    {
+        TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&counting, (const uint8_t *) B[i],
+                                                       strlen(B[i])));
+    }
+    for (int i = 1; i < lenB; i += 2)
+    {
+        TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[i], strlen(B[i])));
+    }
+    for (int i = 1; i < lenB; i += 2)
+    {
+        TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&counting, (const uint8_t *) B[i],
+                                                       strlen(B[i])));
+    }
+
+    /* all counters are back to 0 */
+    for (unsigned i = 0; i < sizeof(cells); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, cells[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOENT, bloom_counting_remove(&counting, (const uint8_t *) B[0],
+                                                         strlen(B[0])));
+}
+
+static void test_bloom_counting_overflow(void)
+{
+    const uint8_t *str = (const uint8_t *) B[0];
+
+    bloom_counting_init(&counting, TESTS_BLOOM_BITS, cells, hashes, TESTS_BLOOM_HASHF);
+
+    for (unsigned i = 0; i < BLOOM_COUNTER_MAX + 5; i++)
+    {
+        bloom_counting_add(&counting, str, strlen(B[0]));
+    }
+    for (unsigned i = 0; i < BLOOM_COUNTER_MAX + 5; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&counting, str, strlen(B[0])));
+    }
+    /* overflowed counters stick */
+    TEST_ASSERT(bloom_counting_check(&counting, str, strlen(B[0])));
+}
+
+static void test_bloom_rotating_expire(void)
+{
+    bloom_rotating_init(&rotating, TESTS_BLOOM_BITS, cells, NULL, TESTS_BLOOM_HASHF,
+                        TESTS_BLOOM_GENS);
+
+    /* one string per generation */
+    for (int i = 0; i < lenB; i++)
+    {
+        bloom_rotating_add(&rotating, (const uint8_t *) B[i], strlen(B[i]));
+
+        for (int j = 0; j <= i; j++)
+        {
+            bool in = bloom_rotating_check(&rotating, (const uint8_t *) B[j],
+                                           strlen(B[j]));
+
+            if (i - j < TESTS_BLOOM_GENS)
+            {
+                TEST_ASSERT(in);
+            }
+        }
+        bloom_rotating_rotate(&rotating);
+    }
+
+    for (int i = 0; i < TESTS_BLOOM_GENS; i++)
+    {
+        bloom_rotating_rotate(&rotating);
+    }
+    for (int i = 0; i < lenB; i++)
+    {
+        TEST_ASSERT(!bloom_rotating_check(&rotating, (const uint8_t *) B[i], strlen(B[i])));
+    }
+}
+
+static void test_bloom_rotating_wrap_around(void)
+{
+    const uint8_t *str = (const uint8_t *) B[0];
+
+    bloom_rotating_init(&rotating, TESTS_BLOOM_BITS, cells, NULL, TESTS_BLOOM_HASHF,
+                        TESTS_BLOOM_GENS);
+    bloom_rotating_add(&rotating, str, strlen(B[0]));
+
+    /* the generation numbers wrap around several times */
+    for (int i = 0; i < 100; i++)
+    {
+        bloom_rotating_rotate(&rotating);
+        TEST_ASSERT((i < (TESTS_BLOOM_GENS - 1)) ==
+                    bloom_rotating_check(&rotating, str, strlen(B[0])));
+    }
+
+    /* refreshing a string keeps it */
+    for (int i = 0; i < 100; i++)
+    {
+        bloom_rotating_add(&rotating, str, strlen(B[0]));
+        bloom_rotating_rotate(&rotating);
+        TEST_ASSERT(bloom_rotating_check(&rotating, str, strlen(B[0])));
+    }
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_double_hashing),
+        new_TestFixture(test_bloom_double_hashing_more_hashes_than_bits),
+        new_TestFixture(test_bloom_counting_remove),
+        new_TestFixture(test_bloom_counting_overflow),
+        new_TestFixture(test_bloom_rotating_expire),
+        new_TestFixture(test_bloom_rotating_wrap_around),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
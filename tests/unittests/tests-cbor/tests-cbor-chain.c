@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "cbor_chain.h"
+#include "tests-cbor.h"
+
+/* examples of RFC 7049, appendix A */
+static const uint8_t _rfc[] = {
+    0x00,                                           /* 0 */
+    0x17,                                           /* 23 */
+    0x18, 0x18,                                     /* 24 */
+    0x19, 0x03, 0xe8,                               /* 1000 */
+    0x1a, 0x00, 0x0f, 0x42, 0x40,                   /* 1000000 */
+    0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00, /* 1000000000000 */
+    0x39, 0x03, 0xe7,                               /* -1000 */
+    0x64, 0x49, 0x45, 0x54, 0x46,                   /* "IETF" */
+    0x82, 0x01, 0x82, 0x02, 0x03,                   /* [1, [2, 3]] */
+    0xa1, 0x01, 0x02,                               /* {1: 2} */
+    0xf5,                                           /* true */
+};
+
+/* {1: [_ "a", 2], 2: 24(h'0102'), 3: (_ h'01', h'02'), 4: {}} 42 */
+static const uint8_t _nested[] = {
+    0xa4,
+    0x01, 0x9f, 0x61, 0x61, 0x02, 0xff,
+    0x02, 0xd8, 0x18, 0x42, 0x01, 0x02,
+    0x03, 0x5f, 0x41, 0x01, 0x41, 0x02, 0xff,
+    0x04, 0xa0,
+    0x18, 0x2a,
+};
+
+static uint8_t _buf[64];
+static struct iovec _vec[sizeof(_buf)];
+
+/* splits _buf into buffers of size bytes */
+static size_t _split(size_t len, size_t size)
+{
+    size_t count = 0;
+
+    for (size_t off = 0; off < len; off += size) {
+        _vec[count].iov_base = &_buf[off];
+        _vec[count].iov_len = ((len - off) < size) ? (len - off) : size;
+        count++;
+    }
+    return count;
+}
+
+static void _write_rfc(cbor_writer_t *writer)
+{
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 0));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 23));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 24));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 1000));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 1000000));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 1000000000000));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(writer, -1000));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_string(writer, CBOR_MAJOR_TEXT, "IETF", 4));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_head(writer, CBOR_MAJOR_ARRAY, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(writer, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_head(writer, CBOR_MAJOR_ARRAY, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(writer, 3));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_head(writer, CBOR_MAJOR_MAP, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_bool(writer, true));
+}
+
+static void test_cbor_chain_write(void)
+{
+    cbor_writer_t writer;
+
+    /* buffers of 3 bytes split most of the items */
+    cbor_writer_init(&writer, _vec, _split(sizeof(_rfc), 3));
+    _write_rfc(&writer);
+    TEST_ASSERT_EQUAL_INT(sizeof(_rfc), cbor_writer_len(&writer));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_rfc, _buf, sizeof(_rfc)));
+}
+
+static void test_cbor_chain_write_full(void)
+{
+    cbor_writer_t writer;
+
+    memset(_buf, 0, sizeof(_buf));
+    cbor_writer_init(&writer, _vec, _split(7, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(&writer, 1000));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_string(&writer, CBOR_MAJOR_TEXT, "IETF", 4));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_uint(&writer, 1000000));
+    TEST_ASSERT_EQUAL_INT(3, cbor_writer_len(&writer));
+    TEST_ASSERT_EQUAL_INT(0, _buf[3]);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_string(&writer, CBOR_MAJOR_TEXT, "IET", 3));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_bool(&writer, true));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_rfc + 4, _buf, 3));
+}
+
+static void test_cbor_chain_read(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    uint64_t uval;
+    int64_t ival;
+    char str[4];
+    size_t len = sizeof(str);
+    bool b;
+
+    memcpy(_buf, _rfc, sizeof(_rfc));
+    cbor_reader_init(&reader, _vec, _split(sizeof(_rfc), 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 0);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 23);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 24);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 1000);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &ival));
+    TEST_ASSERT(ival == 1000000);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 1000000000000);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &ival));
+    TEST_ASSERT(ival == -1000);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_string(&reader, str, &len));
+    TEST_ASSERT_EQUAL_INT(4, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp("IETF", str, 4));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_MAJOR_ARRAY, item.type);
+    TEST_ASSERT(item.val == 2);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_bool(&reader, &b));
+    TEST_ASSERT(b);
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, cbor_reader_peek(&reader, &item));
+}
+
+static void test_cbor_chain_read_string_too_long(void)
+{
+    cbor_reader_t reader;
+    char str[3];
+    size_t len = sizeof(str);
+
+    memcpy(_buf, _rfc + 24, 5);
+    cbor_reader_init(&reader, _vec, _split(5, 5));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_reader_string(&reader, str, &len));
+    TEST_ASSERT_EQUAL_INT(3, len);
+    /* the string was not consumed */
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, cbor_reader_skip(&reader));
+}
+
+static void test_cbor_chain_skip_nested(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    uint64_t val;
+
+    memcpy(_buf, _nested, sizeof(_nested));
+    cbor_reader_init(&reader, _vec, _split(sizeof(_nested), 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &val));
+    TEST_ASSERT(val == 42);
+
+    /* the items of the map one by one */
+    cbor_reader_init(&reader, _vec, _split(sizeof(_nested), 5));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_MAJOR_MAP, item.type);
+    TEST_ASSERT(item.val == 4);
+    for (unsigned i = 1; i <= 4; i++) {
+        TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &val));
+        TEST_ASSERT(val == i);
+        TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    }
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &val));
+    TEST_ASSERT(val == 42);
+}
+
+static void test_cbor_chain_skip_too_deep(void)
+{
+    cbor_reader_t reader;
+
+    memset(_buf, 0x81, CBOR_CHAIN_DEPTH_MAX + 1);
+    _buf[CBOR_CHAIN_DEPTH_MAX + 1] = 0x00;
+    cbor_reader_init(&reader, _vec, _split(CBOR_CHAIN_DEPTH_MAX + 2, 16));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, cbor_reader_skip(&reader));
+
+    cbor_reader_init(&reader, _vec, _split(CBOR_CHAIN_DEPTH_MAX + 1, 16));
+    _buf[CBOR_CHAIN_DEPTH_MAX] = 0x00;
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+}
+
+static void test_cbor_chain_malformed(void)
+{
+    static const uint8_t bad[] = {
+        0x1c,           /* reserved additional information */
+        0x3f,           /* indefinite negative integer */
+        0xdf,           /* indefinite tag */
+        0x82, 0x01, 0xff, /* break in a definite array */
+    };
+    cbor_reader_t reader;
+    cbor_item_t item;
+
+    memcpy(_buf, bad, sizeof(bad));
+    _split(sizeof(bad), 1);
+    for (unsigned i = 0; i < 3; i++) {
+        cbor_reader_init(&reader, &_vec[i], sizeof(bad) - i);
+        TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_next(&reader, &item));
+    }
+    cbor_reader_init(&reader, _vec, _split(sizeof(bad), 1));
+    cbor_reader_read(&reader, NULL, 3);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_skip(&reader));
+}
+
+static void test_cbor_chain_incremental(void)
+{
+    cbor_reader_t reader;
+    uint64_t val = 0;
+    unsigned count = 0, again = 0;
+
+    /* nothing has arrived yet */
+    cbor_reader_init(&reader, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, cbor_reader_skip(&reader));
+
+    /* the data arrives byte by byte */
+    memcpy(_buf, _nested, sizeof(_nested));
+    _split(sizeof(_nested), 1);
+    cbor_reader_init(&reader, _vec, 0);
+    while (cbor_reader_skip(&reader) == -EAGAIN) {
+        cbor_reader_feed(&reader, 1);
+        count++;
+        again++;
+    }
+    while (cbor_reader_uint(&reader, &val) == -EAGAIN) {
+        cbor_reader_feed(&reader, 1);
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(sizeof(_nested), count);
+    TEST_ASSERT_EQUAL_INT(sizeof(_nested) - 2, again);
+    TEST_ASSERT(val == 42);
+}
+
+#ifndef CBOR_NO_FLOAT
+static void test_cbor_chain_float(void)
+{
+    /* 1.5 as half precision float */
+    static const uint8_t half[] = { 0xf9, 0x3e, 0x00 };
+    cbor_writer_t writer;
+    cbor_reader_t reader;
+    double val;
+
+    cbor_writer_init(&writer, _vec, _split(sizeof(_buf), 5));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_float(&writer, 100000.0f));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_double(&writer, -4.1));
+    memcpy(&_buf[cbor_writer_len(&writer)], half, sizeof(half));
+    /* RFC 7049, appendix A */
+    TEST_ASSERT_EQUAL_INT(0, memcmp("\xfa\x47\xc3\x50\x00", _buf, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("\xfb\xc0\x10\x66\x66\x66\x66\x66\x66", _buf + 5, 9));
+
+    cbor_reader_init(&reader, _vec, _split(sizeof(_buf), 5));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_double(&reader, &val));
+    TEST_ASSERT(val == 100000.0);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_double(&reader, &val));
+    TEST_ASSERT(val == -4.1);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_double(&reader, &val));
+    TEST_ASSERT(val == 1.5);
+}
+#endif /* CBOR_NO_FLOAT */
+
+#ifdef MODULE_GNRC_PKT
+static void test_cbor_chain_pkt(void)
+{
+    gnrc_pktsnip_t snips[3];
+    cbor_writer_t writer;
+    cbor_reader_t reader;
+    int64_t val;
+
+    memset(snips, 0, sizeof(snips));
+    for (unsigned i = 0; i < 3; i++) {
+        snips[i].data = &_buf[i * 2];
+        snips[i].size = 2;
+        snips[i].next = (i < 2) ? &snips[i + 1] : NULL;
+    }
+    cbor_writer_init_pkt(&writer, &snips[0]);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, -1000));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, 24));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_int(&writer, 24));
+
+    /* the last snip arrives later */
+    snips[1].next = NULL;
+    cbor_reader_init_pkt(&reader, &snips[0]);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT(val == -1000);
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, cbor_reader_int(&reader, &val));
+    snips[1].next = &snips[2];
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT(val == 24);
+}
+#endif /* MODULE_GNRC_PKT */
+
+Test *tests_cbor_chain_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_cbor_chain_write),
+        new_TestFixture(test_cbor_chain_write_full),
+        new_TestFixture(test_cbor_chain_read),
+        new_TestFixture(test_cbor_chain_read_string_too_long),
+        new_TestFixture(test_cbor_chain_skip_nested),
+        new_TestFixture(test_cbor_chain_skip_too_deep),
+        new_TestFixture(test_cbor_chain_malformed),
+        new_TestFixture(test_cbor_chain_incremental),
+#ifndef CBOR_NO_FLOAT
+        new_TestFixture(test_cbor_chain_float),
+#endif
+#ifdef MODULE_GNRC_PKT
+        new_TestFixture(test_cbor_chain_pkt),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(cbor_chain_tests, NULL, NULL, fixtures);
+
+    return (Test *)&cbor_chain_tests;
+}
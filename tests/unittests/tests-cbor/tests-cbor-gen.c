@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "cbor_chain.h"
+#include "cbor_records.h"
+#include "tests-cbor.h"
+
+static const cbor_sample_t _sample = {
+    .time = 1470000000,
+    .data = { .val = { 2150, -1, INT16_MIN }, .unit = UNIT_TEMP_C,
+              .scale = -2 },
+    .id = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x00, 0x00, 0x01 },
+};
+
+/* {1: 1470000000, 2: [[2150, -1, -32768], unit, -2], 3: h'...'} */
+static const uint8_t _sample_cbor[] = {
+    0xa3,
+    0x01, 0x1a, 0x57, 0x9e, 0x6b, 0x80,
+    0x02, 0x83, 0x83, 0x19, 0x08, 0x66, 0x39, 0x00, 0x00, 0x39, 0x7f, 0xff,
+    0x18, UNIT_TEMP_C, 0x38, 0x01,
+    0x03, 0x48, 0x02, 0x00, 0x5e, 0x10, 0x00, 0x00, 0x00, 0x01,
+};
+
+static uint8_t _buf[64];
+
+static void test_cbor_gen_encode(void)
+{
+    TEST_ASSERT_EQUAL_INT(sizeof(_sample_cbor), CBOR_SAMPLE_CBOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(CBOR_SAMPLE_CBOR_SIZE,
+                          cbor_sample_cbor_encode(&_sample, _buf,
+                                                  sizeof(_buf)));
+    TEST_ASSERT(memcmp(_sample_cbor, _buf, sizeof(_sample_cbor)) == 0);
+}
+
+static void test_cbor_gen_decode(void)
+{
+    cbor_sample_t sample;
+
+    memset(&sample, 0, sizeof(sample));
+    TEST_ASSERT_EQUAL_INT(CBOR_SAMPLE_CBOR_SIZE,
+                          cbor_sample_cbor_decode(&sample, _sample_cbor,
+                                                  sizeof(_sample_cbor)));
+    TEST_ASSERT(sample.time == _sample.time);
+    TEST_ASSERT_EQUAL_INT(2150, sample.data.val[0]);
+    TEST_ASSERT_EQUAL_INT(-1, sample.data.val[1]);
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, sample.data.val[2]);
+    TEST_ASSERT_EQUAL_INT(UNIT_TEMP_C, sample.data.unit);
+    TEST_ASSERT_EQUAL_INT(-2, sample.data.scale);
+    TEST_ASSERT(memcmp(sample.id, _sample.id, sizeof(sample.id)) == 0);
+}
+
+static void test_cbor_gen_limits(void)
+{
+    const cbor_limits_t limits[] = {
+        { 0, 0, 0, 0, 0, false, 0.0f },
+        { UINT8_MAX, UINT64_MAX, INT8_MIN, INT32_MIN, INT64_MIN, true, -1.5f },
+        { 23, 24, INT8_MAX, INT32_MAX, INT64_MAX, true, 65504.0f },
+    };
+
+    for (unsigned i = 0; i < (sizeof(limits) / sizeof(limits[0])); i++) {
+        cbor_limits_t out;
+
+        TEST_ASSERT_EQUAL_INT(CBOR_LIMITS_CBOR_SIZE,
+                              cbor_limits_cbor_encode(&limits[i], _buf,
+                                                      sizeof(_buf)));
+        TEST_ASSERT_EQUAL_INT(CBOR_LIMITS_CBOR_SIZE,
+                              cbor_limits_cbor_decode(&out, _buf,
+                                                      sizeof(_buf)));
+        TEST_ASSERT_EQUAL_INT(limits[i].u8, out.u8);
+        TEST_ASSERT(limits[i].u64 == out.u64);
+        TEST_ASSERT_EQUAL_INT(limits[i].i8, out.i8);
+        TEST_ASSERT(limits[i].i32 == out.i32);
+        TEST_ASSERT(limits[i].i64 == out.i64);
+        TEST_ASSERT(limits[i].flag == out.flag);
+        TEST_ASSERT(limits[i].ratio == out.ratio);
+    }
+}
+
+/* the fixed layout is valid CBOR for every other decoder */
+static void test_cbor_gen_interop(void)
+{
+    const cbor_limits_t limits = {
+        200, UINT64_MAX, -100, -70000, INT64_MIN, true, 0.5f
+    };
+    struct iovec vec = { _buf, CBOR_LIMITS_CBOR_SIZE };
+    cbor_reader_t reader;
+    cbor_item_t item;
+    uint64_t uval;
+    int64_t val;
+    bool flag;
+
+    cbor_limits_cbor_encode(&limits, _buf, sizeof(_buf));
+    cbor_reader_init(&reader, &vec, 1);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_MAJOR_ARRAY, item.type);
+    TEST_ASSERT_EQUAL_INT(7, (int)item.val);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == 200);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_uint(&reader, &uval));
+    TEST_ASSERT(uval == UINT64_MAX);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT(val == -100);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT(val == -70000);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT(val == INT64_MIN);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_bool(&reader, &flag));
+    TEST_ASSERT(flag);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+}
+
+static void test_cbor_gen_too_small(void)
+{
+    cbor_sample_t sample;
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_sample_cbor_encode(&_sample, _buf,
+                                                     sizeof(_sample_cbor) - 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_sample_cbor_decode(&sample, _sample_cbor,
+                                                     sizeof(_sample_cbor) - 1));
+}
+
+static void test_cbor_gen_rejects(void)
+{
+    cbor_sample_t sample;
+    cbor_writer_t writer;
+    struct iovec vec = { _buf, sizeof(_buf) };
+
+    /* the shortest encoding of another encoder */
+    cbor_writer_init(&writer, &vec, 1);
+    cbor_writer_head(&writer, CBOR_MAJOR_MAP, 3);
+    cbor_writer_uint(&writer, 1);
+    cbor_writer_uint(&writer, _sample.time);
+    cbor_writer_uint(&writer, 2);
+    cbor_writer_head(&writer, CBOR_MAJOR_ARRAY, 3);
+    cbor_writer_head(&writer, CBOR_MAJOR_ARRAY, 3);
+    cbor_writer_int(&writer, 2150);
+    cbor_writer_int(&writer, -1);
+    cbor_writer_int(&writer, INT16_MIN);
+    cbor_writer_uint(&writer, UNIT_TEMP_C);
+    cbor_writer_int(&writer, -2);
+    cbor_writer_uint(&writer, 3);
+    cbor_writer_string(&writer, CBOR_MAJOR_BYTES, _sample.id,
+                       sizeof(_sample.id));
+    TEST_ASSERT_EQUAL_INT(0, cbor_sample_cbor_decode(&sample, _buf,
+                                                     cbor_writer_len(&writer)));
+
+    /* -32769 does not fit into the int16_t */
+    memcpy(_buf, _sample_cbor, sizeof(_sample_cbor));
+    _buf[16] = 0x80;
+    _buf[17] = 0x00;
+    TEST_ASSERT_EQUAL_INT(0, cbor_sample_cbor_decode(&sample, _buf,
+                                                     sizeof(_sample_cbor)));
+
+    /* another key */
+    memcpy(_buf, _sample_cbor, sizeof(_sample_cbor));
+    _buf[23] = 0x04;
+    TEST_ASSERT_EQUAL_INT(0, cbor_sample_cbor_decode(&sample, _buf,
+                                                     sizeof(_sample_cbor)));
+}
+
+Test *tests_cbor_gen_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_cbor_gen_encode),
+        new_TestFixture(test_cbor_gen_decode),
+        new_TestFixture(test_cbor_gen_limits),
+        new_TestFixture(test_cbor_gen_interop),
+        new_TestFixture(test_cbor_gen_too_small),
+        new_TestFixture(test_cbor_gen_rejects),
+    };
+
+    EMB_UNIT_TESTCALLER(cbor_gen_tests, NULL, NULL, fixtures);
+
+    return (Test *)&cbor_gen_tests;
+}
@@ -17,6 +17,7 @@
 
 #include "bitarithm.h"
 #include "cbor.h"
+#include "tests-cbor.h"
 
 #include <float.h>
 #include <math.h>
@@ -800,4 +801,6 @@ void tests_cbor(void)
 #endif /* CBOR_NO_PRINT */
 
     TESTS_RUN(tests_cbor_all());
+    TESTS_RUN(tests_cbor_chain_tests());
+    TESTS_RUN(tests_cbor_gen_tests());
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``cbor`` module
+ */
+
+#ifndef TESTS_CBOR_H_
+#define TESTS_CBOR_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_cbor(void);
+
+/**
+ * @brief   Generates tests for cbor_chain.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_cbor_chain_tests(void);
+
+/**
+ * @brief   Generates tests for the codecs generated by cborgen
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_cbor_gen_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_CBOR_H_ */
+/** @} */
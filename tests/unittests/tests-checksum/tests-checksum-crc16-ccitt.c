@@ -88,6 +88,58 @@ static void test_checksum_crc16_ccitt_sequence_4bytes(void)
                 sizeof(buf) / 2, expect));
 }
 
+/* bit by bit, most significant bit first */
+static uint16_t crc16_ccitt_bitwise(uint16_t crc, const unsigned char *buf,
+                                    size_t len)
+{
+    while (len--) {
+        crc ^= *buf++ << 8;
+        for (unsigned i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void test_checksum_crc16_ccitt_slices(void)
+{
+    static unsigned char buf[300];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (unsigned char)((i * 7) ^ (i >> 3));
+    }
+
+    /* unaligned starts and lengths that are not a multiple of the slices */
+    for (unsigned start = 0; start < 9; start++) {
+        for (unsigned len = 0; len < (sizeof(buf) - start); len += 13) {
+            TEST_ASSERT_EQUAL_INT(crc16_ccitt_bitwise(0x1D0F, buf + start, len),
+                                  crc16_ccitt_calc(buf + start, len));
+        }
+    }
+}
+
+static void test_checksum_crc16_ccitt_kermit_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    TEST_ASSERT_EQUAL_INT(0x2189, crc16_ccitt_kermit_calc(buf, sizeof(buf) - 1));
+    TEST_ASSERT_EQUAL_INT(0x2189, crc16_ccitt_kermit_update(
+                              crc16_ccitt_kermit_calc(buf, 4), buf + 4,
+                              sizeof(buf) - 5));
+}
+
+static void test_checksum_crc16_ccitt_kermit_fcs(void)
+{
+    /* an IEEE 802.15.4 frame with its frame check sequence appended */
+    unsigned char frame[] = { 0x41, 0xd8, 0x01, 0x23, 0x00, 0xff, 0xff, 0x00,
+                              0x00, 0x00, 0x00 };
+    uint16_t fcs = crc16_ccitt_kermit_calc(frame, sizeof(frame) - 2);
+
+    frame[sizeof(frame) - 2] = (unsigned char)fcs;
+    frame[sizeof(frame) - 1] = (unsigned char)(fcs >> 8);
+    TEST_ASSERT_EQUAL_INT(0, crc16_ccitt_kermit_calc(frame, sizeof(frame)));
+}
+
 Test *tests_checksum_crc16_ccitt_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -98,6 +150,10 @@ Test *tests_checksum_crc16_ccitt_tests(void)
         new_TestFixture(test_checksum_crc16_ccitt_sequence_256a),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_1to9),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_4bytes),
+        new_TestFixture(test_checksum_crc16_ccitt_slices),
+        /* check value of CRC-16/KERMIT */
+        new_TestFixture(test_checksum_crc16_ccitt_kermit_1to9),
+        new_TestFixture(test_checksum_crc16_ccitt_kermit_fcs),
     };
 
     EMB_UNIT_TESTCALLER(checksum_crc16_ccitt_tests, NULL, NULL, fixtures);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+/* bit by bit, with reflected bits */
+static uint32_t crc32_bitwise(const unsigned char *buf, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    while (len--) {
+        crc ^= *buf++;
+        for (unsigned i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static void test_checksum_crc32_empty(void)
+{
+    unsigned char buf[] = "";
+
+    TEST_ASSERT_EQUAL_INT(0, crc32_calc(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    TEST_ASSERT(0xCBF43926 == crc32_calc(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32_update(void)
+{
+    unsigned char buf[] = "123456789";
+    uint32_t crc = crc32_calc(buf, 5);
+
+    TEST_ASSERT(0xCBF43926 == crc32_update(crc, buf + 5, sizeof(buf) - 6));
+}
+
+static void test_checksum_crc32_slices(void)
+{
+    static unsigned char buf[300];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (unsigned char)((i * 7) ^ (i >> 3));
+    }
+
+    /* unaligned starts and lengths that are not a multiple of the slices */
+    for (unsigned start = 0; start < 9; start++) {
+        for (unsigned len = 0; len < (sizeof(buf) - start); len += 13) {
+            TEST_ASSERT(crc32_bitwise(buf + start, len) ==
+                        crc32_calc(buf + start, len));
+        }
+    }
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        /* check value of CRC-32 */
+        new_TestFixture(test_checksum_crc32_empty),
+        new_TestFixture(test_checksum_crc32_1to9),
+        new_TestFixture(test_checksum_crc32_update),
+        new_TestFixture(test_checksum_crc32_slices),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
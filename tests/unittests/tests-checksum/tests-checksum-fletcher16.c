@@ -7,6 +7,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "embUnit/embUnit.h"
 
@@ -59,12 +60,54 @@ static void test_checksum_fletcher16_atoe(void)
     TEST_ASSERT(calc_and_compare_checksum(buf, sizeof(buf) - 1, expect));
 }
 
+/* reduces the sums every 20 bytes, with 16 bit sums */
+static uint16_t fletcher16_reference(const uint8_t *data, size_t bytes)
+{
+    uint16_t sum1 = 0xff, sum2 = 0xff;
+
+    while (bytes) {
+        size_t tlen = bytes > 20 ? 20 : bytes;
+        bytes -= tlen;
+        do {
+            sum2 += sum1 += *data++;
+        } while (--tlen);
+        sum1 = (sum1 & 0xff) + (sum1 >> 8);
+        sum2 = (sum2 & 0xff) + (sum2 >> 8);
+    }
+    sum1 = (sum1 & 0xff) + (sum1 >> 8);
+    sum2 = (sum2 & 0xff) + (sum2 >> 8);
+    return (sum2 << 8) | sum1;
+}
+
+static void test_checksum_fletcher16_reference(void)
+{
+    /* more than the block of the implementation, which reduces the sums
+     * only every 5802 bytes */
+    static uint8_t buf[5900];
+
+    /* all ones gives the largest sums */
+    memset(buf, 0xff, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(fletcher16_reference(buf, sizeof(buf)),
+                          fletcher16(buf, sizeof(buf)));
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)((i * 7) ^ (i >> 3));
+    }
+    for (unsigned len = 0; len < sizeof(buf); len += 97) {
+        TEST_ASSERT_EQUAL_INT(fletcher16_reference(buf, len),
+                              fletcher16(buf, len));
+    }
+    TEST_ASSERT_EQUAL_INT(fletcher16_reference(buf, sizeof(buf)),
+                          fletcher16(buf, sizeof(buf)));
+}
+
 Test *tests_checksum_fletcher16_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_checksum_fletcher16_empty),
         new_TestFixture(test_checksum_fletcher16_0to1_undetected),
         new_TestFixture(test_checksum_fletcher16_atoe),
+        new_TestFixture(test_checksum_fletcher16_reference),
     };
 
     EMB_UNIT_TESTCALLER(checksum_fletcher16_tests, NULL, NULL, fixtures);
@@ -36,6 +36,8 @@ void tests_checksum(void);
  */
 Test *tests_checksum_crc16_ccitt_tests(void);
 
+Test *tests_checksum_crc32_tests(void);
+
 /**
  * @brief   Generates tests for checksum/fletcher16.h
  *
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+#include "tests-crypto.h"
+
+/* RFC 7539, section 2.5.2 */
+static const uint8_t POLY1305_KEY[] = {
+    0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+    0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+    0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+    0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b,
+};
+
+static const char POLY1305_MSG[] = "Cryptographic Forum Research Group";
+
+static const uint8_t POLY1305_TAG[] = {
+    0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+    0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9,
+};
+
+/* RFC 7539, section 2.8.2 */
+static const uint8_t AEAD_KEY[] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+
+static const uint8_t AEAD_NONCE[] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47,
+};
+
+static const uint8_t AEAD_AAD[] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+static const char AEAD_MSG[] = "Ladies and Gentlemen of the class of '99: If I "
+                               "could offer you only one tip for the future, "
+                               "sunscreen would be it.";
+
+static const uint8_t AEAD_CIPHER[] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb,
+    0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+    0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+    0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+    0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12,
+    0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29,
+    0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+    0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+    0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+    0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94,
+    0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d,
+    0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+    0x61, 0x16, 0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09,
+    0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60,
+    0x06, 0x91,
+};
+
+#define AEAD_MSG_LEN    (sizeof(AEAD_MSG) - 1)
+
+static uint8_t _buf[sizeof(AEAD_CIPHER)];
+
+static void test_crypto_poly1305_rfc7539(void)
+{
+    uint8_t tag[POLY1305_TAG_SIZE];
+
+    poly1305_auth(tag, (const uint8_t *)POLY1305_MSG, sizeof(POLY1305_MSG) - 1,
+                  POLY1305_KEY);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tag, POLY1305_TAG, sizeof(tag)));
+}
+
+static void test_crypto_poly1305_update(void)
+{
+    poly1305_ctx_t ctx;
+    uint8_t tag[POLY1305_TAG_SIZE];
+    const uint8_t *msg = (const uint8_t *)POLY1305_MSG;
+
+    /* in pieces that do not align with the blocks */
+    poly1305_init(&ctx, POLY1305_KEY);
+    poly1305_update(&ctx, msg, 5);
+    poly1305_update(&ctx, msg + 5, 20);
+    poly1305_update(&ctx, msg + 25, sizeof(POLY1305_MSG) - 26);
+    poly1305_finish(&ctx, tag);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(tag, POLY1305_TAG, sizeof(tag)));
+}
+
+static void test_crypto_chacha20poly1305_encrypt(void)
+{
+    chacha20poly1305_encrypt(_buf, (const uint8_t *)AEAD_MSG, AEAD_MSG_LEN,
+                             AEAD_AAD, sizeof(AEAD_AAD), AEAD_KEY, AEAD_NONCE);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, AEAD_CIPHER, sizeof(AEAD_CIPHER)));
+}
+
+static void test_crypto_chacha20poly1305_decrypt(void)
+{
+    size_t len;
+
+    TEST_ASSERT_EQUAL_INT(1, chacha20poly1305_decrypt(AEAD_CIPHER,
+                                                      sizeof(AEAD_CIPHER),
+                                                      _buf, &len, AEAD_AAD,
+                                                      sizeof(AEAD_AAD),
+                                                      AEAD_KEY, AEAD_NONCE));
+    TEST_ASSERT_EQUAL_INT(AEAD_MSG_LEN, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, AEAD_MSG, len));
+}
+
+static void test_crypto_chacha20poly1305_decrypt_invalid(void)
+{
+    uint8_t aad[sizeof(AEAD_AAD)];
+    size_t len;
+
+    memcpy(aad, AEAD_AAD, sizeof(aad));
+    aad[0] ^= 1;
+    memset(_buf, 0, sizeof(_buf));
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(AEAD_CIPHER,
+                                                      sizeof(AEAD_CIPHER),
+                                                      _buf, &len, aad,
+                                                      sizeof(aad), AEAD_KEY,
+                                                      AEAD_NONCE));
+    /* nothing was decrypted */
+    TEST_ASSERT_EQUAL_INT(0, _buf[0]);
+    TEST_ASSERT_EQUAL_INT(0, chacha20poly1305_decrypt(AEAD_CIPHER,
+                                                      CHACHA20POLY1305_TAG_SIZE - 1,
+                                                      _buf, &len, NULL, 0,
+                                                      AEAD_KEY, AEAD_NONCE));
+}
+
+static void test_crypto_chacha_keystream_blocks(void)
+{
+    chacha_ctx ctx1, ctx2;
+    uint8_t blocks[5 * 64];
+    uint8_t block[64];
+
+    chacha_init(&ctx1, 20, AEAD_KEY, sizeof(AEAD_KEY), AEAD_NONCE);
+    /* the low word of the counter overflows inside the blocks */
+    ctx1.state[12] = 0xfffffffe;
+    ctx2 = ctx1;
+
+    chacha_keystream_blocks(&ctx1, blocks, 5);
+    for (unsigned i = 0; i < 5; i++) {
+        chacha_keystream_bytes(&ctx2, block);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(block, &blocks[64 * i], 64));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctx1.state, ctx2.state, sizeof(ctx1.state)));
+}
+
+Test *tests_crypto_chacha20poly1305_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_poly1305_rfc7539),
+        new_TestFixture(test_crypto_poly1305_update),
+        new_TestFixture(test_crypto_chacha20poly1305_encrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt_invalid),
+        new_TestFixture(test_crypto_chacha_keystream_blocks),
+    };
+    EMB_UNIT_TESTCALLER(crypto_chacha20poly1305_tests, NULL, NULL, fixtures);
+    return (Test *) &crypto_chacha20poly1305_tests;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdbool.h>
+
+#include "embUnit.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "tests-crypto.h"
+
+#ifdef MODULE_AES_MOCK
+#include "aes_mock.h"
+#include "mutex.h"
+#endif
+
+static uint8_t TEST_KEY[] = {
+    0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7,
+    0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF
+};
+
+static uint8_t TEST_INP[] = {
+    0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF,
+    0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7
+};
+
+static uint8_t TEST_ENC_AES[] = {
+    0x37, 0x29, 0xa3, 0x6c, 0xaf, 0xe9, 0x84, 0xff,
+    0x46, 0x22, 0x70, 0x42, 0xee, 0x24, 0x83, 0xf6
+};
+
+/* a backend that uses the software AES, its init fails on request */
+static bool _dummy_fail;
+
+static int _dummy_init(cipher_context_t *ctx, const uint8_t *key, uint8_t key_size)
+{
+    if (_dummy_fail) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+    return aes_init(ctx, key, key_size);
+}
+
+static const cipher_interface_t _dummy_interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    _dummy_init,
+    aes_encrypt,
+    aes_decrypt,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+static cipher_hw_t _dummy;
+
+static int _async_res;
+static unsigned _async_calls;
+
+static void _async_cb(void *arg, int res)
+{
+    (void)arg;
+    _async_res = res;
+    _async_calls++;
+}
+
+static void set_up(void)
+{
+    _dummy_fail = false;
+    _dummy.cipher = CIPHER_AES_128;
+    _dummy.interface = &_dummy_interface;
+    _async_res = 0;
+    _async_calls = 0;
+}
+
+static void tear_down(void)
+{
+    cipher_hw_unregister(&_dummy);
+}
+
+static void test_crypto_hw_register(void)
+{
+    cipher_t cipher;
+    uint8_t data[16];
+
+    cipher_hw_register(&_dummy);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    TEST_ASSERT(&_dummy_interface == cipher.interface);
+    TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher, TEST_INP, data));
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_ENC_AES, data, 16), "wrong ciphertext");
+
+    cipher_hw_unregister(&_dummy);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    TEST_ASSERT(&_dummy_interface != cipher.interface);
+}
+
+static void test_crypto_hw_fallback(void)
+{
+    cipher_t cipher;
+    uint8_t data[16];
+
+    _dummy_fail = true;
+    cipher_hw_register(&_dummy);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    TEST_ASSERT(&_dummy_interface != cipher.interface);
+    TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher, TEST_INP, data));
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_ENC_AES, data, 16), "wrong ciphertext");
+}
+
+static void test_crypto_hw_other_cipher(void)
+{
+    cipher_t cipher;
+    uint8_t key[24] = { 0 };
+
+    cipher_hw_register(&_dummy);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_3DES, key, sizeof(key)));
+    TEST_ASSERT(CIPHER_3DES == cipher.interface);
+}
+
+static void test_crypto_hw_async_sync_fallback(void)
+{
+    cipher_t cipher;
+    uint8_t data[16];
+
+    cipher_hw_register(&_dummy);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    TEST_ASSERT_EQUAL_INT(0, cipher_encrypt_blocks_async(&cipher, TEST_INP, data, 1,
+                                                         _async_cb, NULL));
+    /* called before the function returned */
+    TEST_ASSERT_EQUAL_INT(1, _async_calls);
+    TEST_ASSERT_EQUAL_INT(1, _async_res);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_ENC_AES, data, 16), "wrong ciphertext");
+}
+
+#ifdef MODULE_AES_MOCK
+static mutex_t _async_done = MUTEX_INIT;
+
+static void _mock_cb(void *arg, int res)
+{
+    _async_cb(arg, res);
+    mutex_unlock(&_async_done);
+}
+
+static void test_crypto_hw_mock(void)
+{
+    cipher_t cipher;
+    aes_mock_stats_t before, after;
+    uint8_t data[16];
+
+    aes_mock_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    TEST_ASSERT(CIPHER_AES_128 != cipher.interface);
+    TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher, TEST_INP, data));
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_ENC_AES, data, 16), "wrong ciphertext");
+    aes_mock_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.blocks + 1, after.blocks);
+}
+
+static void test_crypto_hw_mock_async(void)
+{
+    cipher_t cipher;
+    uint8_t data[16];
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    mutex_lock(&_async_done);
+    TEST_ASSERT_EQUAL_INT(0, cipher_decrypt_blocks_async(&cipher, TEST_ENC_AES, data, 1,
+                                                         _mock_cb, NULL));
+    /* wait for the callback */
+    mutex_lock(&_async_done);
+    mutex_unlock(&_async_done);
+    TEST_ASSERT_EQUAL_INT(1, _async_calls);
+    TEST_ASSERT_EQUAL_INT(1, _async_res);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_INP, data, 16), "wrong plaintext");
+}
+
+static void test_crypto_hw_mock_disabled(void)
+{
+    cipher_t cipher;
+
+    aes_mock_enable(false);
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_KEY, 16));
+    aes_mock_enable(true);
+    TEST_ASSERT(CIPHER_AES_128 == cipher.interface);
+}
+#endif
+
+Test* tests_crypto_hw_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_hw_register),
+        new_TestFixture(test_crypto_hw_fallback),
+        new_TestFixture(test_crypto_hw_other_cipher),
+        new_TestFixture(test_crypto_hw_async_sync_fallback),
+#ifdef MODULE_AES_MOCK
+        new_TestFixture(test_crypto_hw_mock),
+        new_TestFixture(test_crypto_hw_mock_async),
+        new_TestFixture(test_crypto_hw_mock_disabled),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_hw_tests, set_up, tear_down, fixtures);
+
+    return (Test*)&crypto_hw_tests;
+}
@@ -79,6 +79,48 @@ static uint8_t TEST_2_EXPECTED[] = {
 };
 static uint8_t TEST_2_EXPECTED_LEN = 40;
 
+/* the key, nonce and additional data of packet vector #1 with a payload of
+ * 0x00, 0x01, ... that is longer than 255 bytes, generated with OpenSSL */
+#define TEST_3_INPUT_LEN (272)
+
+static uint8_t TEST_3_EXPECTED[] = {
+    0x50, 0x84, 0x9F, 0x92, 0x69, 0xCE, 0x6B, 0xDA,
+    0xE8, 0x7E, 0xC8, 0xDA, 0xD8, 0xE1, 0x91, 0x98,
+    0x65, 0x57, 0x63, 0x69, 0xD2, 0xCB, 0x8C, 0xE8,
+    0x7C, 0x15, 0x86, 0x1D, 0xC2, 0x70, 0x13, 0x90,
+    0x3E, 0x03, 0xB7, 0x09, 0xC8, 0x1A, 0x4D, 0xAC,
+    0x9A, 0x87, 0x38, 0x74, 0xDB, 0xCE, 0xB6, 0x43,
+    0x5C, 0x85, 0xD8, 0xB9, 0x61, 0x24, 0xE4, 0x56,
+    0xED, 0xDD, 0x13, 0x30, 0xBB, 0xBE, 0xB0, 0xE6,
+    0xCF, 0x9A, 0x90, 0x95, 0x2E, 0x75, 0x22, 0x18,
+    0x13, 0xC9, 0xB7, 0xAB, 0x34, 0xE0, 0x97, 0xF6,
+    0xD0, 0x35, 0xAC, 0xA8, 0xA8, 0x2E, 0x54, 0x1A,
+    0xCB, 0xF7, 0x2D, 0xB9, 0x31, 0x45, 0x5C, 0xAC,
+    0xF9, 0x87, 0xC5, 0x10, 0x06, 0x09, 0x4E, 0x40,
+    0x6D, 0x24, 0x57, 0x65, 0x25, 0x9D, 0xD6, 0xE2,
+    0x2E, 0xC5, 0xFA, 0xA5, 0x59, 0xD8, 0xFC, 0x57,
+    0xA1, 0xA2, 0x5A, 0xFA, 0xF9, 0x13, 0x4E, 0x55,
+    0x42, 0xF2, 0x8F, 0xD9, 0x18, 0x25, 0x71, 0xE8,
+    0x54, 0xE5, 0xE6, 0x04, 0xB6, 0xAF, 0x06, 0x05,
+    0x3E, 0x1E, 0xA7, 0x36, 0xF1, 0x6F, 0x77, 0x9F,
+    0x19, 0x51, 0x46, 0x2D, 0x5B, 0x3F, 0x14, 0xFF,
+    0xBC, 0xA0, 0x0C, 0x38, 0x12, 0x66, 0xA5, 0xBC,
+    0x19, 0x95, 0xC9, 0x43, 0x4F, 0x6F, 0x65, 0x18,
+    0x21, 0xDF, 0xFB, 0x62, 0xB2, 0x8F, 0x39, 0x71,
+    0xBD, 0x14, 0x90, 0xC1, 0x8F, 0x87, 0x7E, 0x50,
+    0xCB, 0xC2, 0xB4, 0xD9, 0x0B, 0xF5, 0x7C, 0xBD,
+    0x40, 0xB3, 0x85, 0x4B, 0x04, 0x48, 0xD3, 0x22,
+    0x0C, 0xC8, 0xD8, 0xCF, 0x1F, 0x0B, 0x48, 0x2F,
+    0x96, 0x09, 0x37, 0x98, 0xAD, 0x20, 0x17, 0xAA,
+    0x0A, 0xDF, 0x74, 0xD9, 0x8F, 0x53, 0xB5, 0x34,
+    0x88, 0x75, 0xC7, 0x04, 0x0B, 0x61, 0x99, 0x97,
+    0xC4, 0x9D, 0x75, 0xB7, 0x6D, 0xD2, 0xFF, 0x5F,
+    0x07, 0x8F, 0x49, 0xA2, 0x11, 0xEB, 0x23, 0xD7,
+    0xEF, 0xB3, 0x40, 0xD9, 0x30, 0x4F, 0x8F, 0xA7,
+    0xE3, 0xC9, 0x36, 0x28, 0x09, 0x65, 0x7D, 0xEE,
+    0x04, 0xDD, 0x71, 0xCD, 0x6C, 0x45, 0x8E, 0x14
+};
+
 static void test_encrypt_op(uint8_t* key, uint8_t key_len, uint8_t* adata,
                             uint8_t adata_len, uint8_t* nonce, uint8_t nonce_len, uint8_t* plain,
                             uint8_t plain_len, uint8_t* output_expected, uint8_t output_expected_len)
@@ -148,11 +190,40 @@ static void test_crypto_modes_ccm_decrypt(void)
 }
 
 
+static void test_crypto_modes_ccm_long(void)
+{
+    cipher_t cipher;
+    uint8_t plain[TEST_3_INPUT_LEN];
+    uint8_t data[sizeof(TEST_3_EXPECTED)];
+    int len, err;
+
+    for (unsigned i = 0; i < sizeof(plain); i++) {
+        plain[i] = (uint8_t)i;
+    }
+
+    err = cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY, TEST_1_KEY_LEN);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    len = cipher_encrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                             TEST_1_NONCE, TEST_1_NONCE_LEN, plain,
+                             sizeof(plain), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_3_EXPECTED), len);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_3_EXPECTED, data, len),
+                        "wrong ciphertext");
+
+    len = cipher_decrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                             TEST_1_NONCE, TEST_1_NONCE_LEN, TEST_3_EXPECTED,
+                             sizeof(TEST_3_EXPECTED), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(plain), len);
+    TEST_ASSERT_MESSAGE(1 == compare(plain, data, len), "wrong plaintext");
+}
+
 Test* tests_crypto_modes_ccm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
-                        new_TestFixture(test_crypto_modes_ccm_decrypt)
+                        new_TestFixture(test_crypto_modes_ccm_decrypt),
+                        new_TestFixture(test_crypto_modes_ccm_long)
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
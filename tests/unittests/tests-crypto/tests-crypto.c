@@ -12,10 +12,12 @@
 void tests_crypto(void)
 {
     TESTS_RUN(tests_crypto_chacha_tests());
+    TESTS_RUN(tests_crypto_chacha20poly1305_tests());
     TESTS_RUN(tests_crypto_aes_tests());
     TESTS_RUN(tests_crypto_3des_tests());
     TESTS_RUN(tests_crypto_twofish_tests());
     TESTS_RUN(tests_crypto_cipher_tests());
+    TESTS_RUN(tests_crypto_hw_tests());
     TESTS_RUN(tests_crypto_modes_ccm_tests());
     TESTS_RUN(tests_crypto_modes_ecb_tests());
     TESTS_RUN(tests_crypto_modes_cbc_tests());
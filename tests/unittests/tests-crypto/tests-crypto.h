@@ -40,6 +40,13 @@ void tests_crypto(void);
  */
 Test *tests_crypto_chacha_tests(void);
 
+/**
+ * @brief   Generates tests for crypto/chacha20poly1305.h and crypto/poly1305.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_crypto_chacha20poly1305_tests(void);
+
 static inline int compare(uint8_t a[16], uint8_t b[16], uint8_t len)
 {
     int result = 1;
@@ -55,6 +62,7 @@ Test* tests_crypto_aes_tests(void);
 Test* tests_crypto_3des_tests(void);
 Test* tests_crypto_twofish_tests(void);
 Test* tests_crypto_cipher_tests(void);
+Test* tests_crypto_hw_tests(void);
 Test* tests_crypto_modes_ccm_tests(void);
 Test* tests_crypto_modes_ecb_tests(void);
 Test* tests_crypto_modes_cbc_tests(void);
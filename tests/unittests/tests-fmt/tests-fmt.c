@@ -245,6 +245,199 @@ static void test_rmt_s16_dfp(void)
     TEST_ASSERT_EQUAL_STRING("", (char *)out);
 }
 
+static void test_fmt_u32_dec_boundaries(void)
+{
+    static const uint32_t vals[] = {
+        9, 10, 99, 100, 999, 1000, 9999, 10000, 99999, 100000, 999999,
+        1000000, 9999999, 10000000, 99999999, 100000000, 999999999,
+        1000000000, 4294967295LU
+    };
+    static const char *strs[] = {
+        "9", "10", "99", "100", "999", "1000", "9999", "10000", "99999",
+        "100000", "999999", "1000000", "9999999", "10000000", "99999999",
+        "100000000", "999999999", "1000000000", "4294967295"
+    };
+    char out[11];
+
+    for (unsigned i = 0; i < sizeof(vals) / sizeof(vals[0]); i++) {
+        size_t len = fmt_u32_dec(out, vals[i]);
+        TEST_ASSERT_EQUAL_INT(fmt_strlen(strs[i]), len);
+        TEST_ASSERT_EQUAL_INT(len, fmt_u32_dec(NULL, vals[i]));
+        out[len] = '\0';
+        TEST_ASSERT_EQUAL_STRING(strs[i], (char *)out);
+    }
+}
+
+static void test_fmt_u64_dec_d(void)
+{
+    char out[21];
+    size_t len;
+
+    len = fmt_u64_dec(out, 18446744073709551615LLU);
+    TEST_ASSERT_EQUAL_INT(20, len);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", (char *)out);
+
+    len = fmt_u64_dec(out, 4294967296LLU);
+    TEST_ASSERT_EQUAL_INT(10, len);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("4294967296", (char *)out);
+
+    len = fmt_u64_dec(out, 10000000000000000LLU);
+    TEST_ASSERT_EQUAL_INT(17, len);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("10000000000000000", (char *)out);
+}
+
+static void test_fmt_s32_dfp(void)
+{
+    char out[13];
+    size_t len;
+
+    len = fmt_s32_dfp(out, -123456, 3);
+    TEST_ASSERT_EQUAL_INT(8, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_s32_dfp(NULL, -123456, 3));
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-123.456", (char *)out);
+
+    len = fmt_s32_dfp(out, -5, 3);
+    TEST_ASSERT_EQUAL_INT(6, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_s32_dfp(NULL, -5, 3));
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-0.005", (char *)out);
+
+    len = fmt_s32_dfp(out, INT32_MIN, 9);
+    TEST_ASSERT_EQUAL_INT(12, len);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-2.147483648", (char *)out);
+
+    len = fmt_s32_dfp(out, 42, 0);
+    TEST_ASSERT_EQUAL_INT(2, len);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("42", (char *)out);
+}
+
+static void test_fmt_float(void)
+{
+    char out[FMT_FLOAT_MAXLEN + 1];
+    size_t len;
+
+    len = fmt_float(out, 3.14159265f, 4);
+    TEST_ASSERT_EQUAL_INT(6, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_float(NULL, 3.14159265f, 4));
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("3.1416", (char *)out);
+
+    len = fmt_float(out, -0.125f, 2);
+    out[len] = '\0';
+    /* ties are rounded to even, like printf() does */
+    TEST_ASSERT_EQUAL_STRING("-0.12", (char *)out);
+
+    len = fmt_float(out, 2.5f, 0);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("2", (char *)out);
+
+    len = fmt_float(out, 99.99999f, 3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("100.000", (char *)out);
+
+    len = fmt_float(out, 16777216.0f, 7);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("16777216.0000000", (char *)out);
+
+    len = fmt_float(out, 1e-10f, 7);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0.0000000", (char *)out);
+
+    len = fmt_float(out, 3.92501097e-05f, 7);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0.0000393", (char *)out);
+
+    len = fmt_float(out, -0.000146499937f, 6);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-0.000146", (char *)out);
+
+    len = fmt_float(out, -3.64610176e+29f, 0);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-364610176028110874190458912768", (char *)out);
+
+    len = fmt_float(out, 1.0f / 0.0f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("inf", (char *)out);
+
+    len = fmt_float(out, -1.0f / 0.0f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-inf", (char *)out);
+
+    len = fmt_float(out, 0.0f / 0.0f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("nan", (char *)out);
+
+    TEST_ASSERT_EQUAL_INT(0, fmt_float(out, 1.0f, 8));
+}
+
+static void test_fmt_snprintf_integers(void)
+{
+    char out[64];
+    int len;
+
+    len = fmt_snprintf(out, sizeof(out), "%d|%5i|%-5d|%05d|%+d|% d|%.3d",
+                       -42, 42, 42, -42, 42, 42, 7);
+    TEST_ASSERT_EQUAL_STRING("-42|   42|42   |-0042|+42| 42|007", (char *)out);
+    TEST_ASSERT_EQUAL_INT(fmt_strlen(out), len);
+
+    fmt_snprintf(out, sizeof(out), "%u|%x|%X|%#x|%o|%08lx|%hhu|%hd",
+                 4294967295U, 0xbeefU, 0xbeefU, 0x1fU, 8U, 0xabcUL,
+                 0x1ff, 0x18000);
+    TEST_ASSERT_EQUAL_STRING("4294967295|beef|BEEF|0x1f|10|00000abc|255|-32768",
+                             (char *)out);
+
+    fmt_snprintf(out, sizeof(out), "%lld|%llu|%zu|%*d|%-*d|",
+                 -9223372036854775807LL - 1, 18446744073709551615LLU,
+                 (size_t)123, 4, 1, 3, 2);
+    TEST_ASSERT_EQUAL_STRING("-9223372036854775808|18446744073709551615|123|"
+                             "   1|2  |", (char *)out);
+
+    fmt_snprintf(out, sizeof(out), "%p", (void *)0x1234);
+    TEST_ASSERT_EQUAL_STRING("0x1234", (char *)out);
+}
+
+static void test_fmt_snprintf_strings_floats(void)
+{
+    char out[64];
+
+    fmt_snprintf(out, sizeof(out), "%s|%-6s|%6s|%.2s|%c|%3c|%%",
+                 "abc", "abc", "abc", "abc", 'x', 'y');
+    TEST_ASSERT_EQUAL_STRING("abc|abc   |   abc|ab|x|  y|%", (char *)out);
+
+    fmt_snprintf(out, sizeof(out), "%f|%.2f|%8.3f|%-7.1f|%07.2f|%+.0f",
+                 1.5, 2.375, -3.25, 4.25, -1.5, 2.0);
+    TEST_ASSERT_EQUAL_STRING("1.500000|2.38|  -3.250|4.2    |-001.50|+2",
+                             (char *)out);
+
+    fmt_snprintf(out, sizeof(out), "%#.0f|%#.1f|%.0f", 2.0, 2.0, 2.0);
+    TEST_ASSERT_EQUAL_STRING("2.|2.0|2", (char *)out);
+}
+
+static void test_fmt_snprintf_truncated(void)
+{
+    char out[8] = "-------";
+    const char *unsupported = "%d %e %d";
+    int len;
+
+    /* the length of the complete output is returned */
+    len = fmt_snprintf(out, 5, "%s-%d", "abc", 12345);
+    TEST_ASSERT_EQUAL_INT(9, len);
+    TEST_ASSERT_EQUAL_STRING("abc-", (char *)out);
+
+    len = fmt_snprintf(NULL, 0, "%d", 123);
+    TEST_ASSERT_EQUAL_INT(3, len);
+
+    /* the format is copied from the first unsupported conversion on */
+    fmt_snprintf(out, sizeof(out), unsupported, 1, 2.0, 3);
+    TEST_ASSERT_EQUAL_STRING("1 %e %d", (char *)out);
+}
+
 static void test_fmt_strlen(void)
 {
     const char *empty_str = "";
@@ -286,10 +479,17 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_u64_dec_a),
         new_TestFixture(test_fmt_u64_dec_b),
         new_TestFixture(test_fmt_u64_dec_c),
+        new_TestFixture(test_fmt_u32_dec_boundaries),
+        new_TestFixture(test_fmt_u64_dec_d),
         new_TestFixture(test_fmt_u16_dec),
         new_TestFixture(test_fmt_s32_dec),
         new_TestFixture(test_rmt_s16_dec),
         new_TestFixture(test_rmt_s16_dfp),
+        new_TestFixture(test_fmt_s32_dfp),
+        new_TestFixture(test_fmt_float),
+        new_TestFixture(test_fmt_snprintf_integers),
+        new_TestFixture(test_fmt_snprintf_strings_floats),
+        new_TestFixture(test_fmt_snprintf_truncated),
         new_TestFixture(test_fmt_strlen),
         new_TestFixture(test_fmt_str),
         new_TestFixture(test_scn_u32_dec),
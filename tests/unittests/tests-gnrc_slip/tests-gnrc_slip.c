@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/slip.h"
+
+#include "tests-gnrc_slip.h"
+
+#define END             (0xc0)
+#define ESC             (0xdb)
+#define END_ESC         (0xdc)
+#define ESC_ESC         (0xdd)
+
+#define ENCODE_SIZE     (32U)
+#define CANARY          (0xa5)
+
+static uint8_t _buf[ENCODE_SIZE + 4];
+static uint8_t _frame[128];
+static size_t _frame_len;
+static unsigned _parts;
+
+static void _out(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    TEST_ASSERT(len <= ENCODE_SIZE);
+    TEST_ASSERT(_frame_len + len <= sizeof(_frame));
+    memcpy(&_frame[_frame_len], data, len);
+    _frame_len += len;
+    _parts++;
+}
+
+static void set_up(void)
+{
+    memset(_buf, CANARY, sizeof(_buf));
+    _frame_len = 0;
+    _parts = 0;
+}
+
+static void _encode(const gnrc_pktsnip_t *pkt)
+{
+    gnrc_slip_encode(pkt, _buf, ENCODE_SIZE, _out, NULL);
+    for (unsigned i = ENCODE_SIZE; i < sizeof(_buf); i++) {
+        TEST_ASSERT_EQUAL_INT(CANARY, _buf[i]);
+    }
+}
+
+static void test_gnrc_slip_encode_plain(void)
+{
+    uint8_t data[] = { 0x60, 0x00, 0x01, 0x02 };
+    uint8_t exp[] = { 0x60, 0x00, 0x01, 0x02, END };
+    gnrc_pktsnip_t pkt = { .data = data, .size = sizeof(data) };
+
+    _encode(&pkt);
+    TEST_ASSERT_EQUAL_INT(1, _parts);
+    TEST_ASSERT_EQUAL_INT(sizeof(exp), _frame_len);
+    TEST_ASSERT(memcmp(exp, _frame, sizeof(exp)) == 0);
+}
+
+static void test_gnrc_slip_encode_escape(void)
+{
+    uint8_t data1[] = { END, 0x01 };
+    uint8_t data2[] = { ESC, END_ESC };
+    uint8_t exp[] = { ESC, END_ESC, 0x01, ESC, ESC_ESC, END_ESC, END };
+    gnrc_pktsnip_t pkt2 = { .data = data2, .size = sizeof(data2) };
+    gnrc_pktsnip_t pkt1 = { .next = &pkt2, .data = data1,
+                            .size = sizeof(data1) };
+
+    _encode(&pkt1);
+    TEST_ASSERT_EQUAL_INT(sizeof(exp), _frame_len);
+    TEST_ASSERT(memcmp(exp, _frame, sizeof(exp)) == 0);
+}
+
+/* ENCODE_SIZE - 1 plain bytes and one to escape: the escaped byte fills the
+ * buffer, so the END byte goes into the next part */
+static void _test_full_buffer(uint8_t last, uint8_t last_esc)
+{
+    uint8_t data[ENCODE_SIZE - 1];
+    gnrc_pktsnip_t pkt = { .data = data, .size = sizeof(data) };
+
+    memset(data, 0x42, sizeof(data));
+    data[sizeof(data) - 1] = last;
+
+    _encode(&pkt);
+    TEST_ASSERT_EQUAL_INT(2, _parts);
+    TEST_ASSERT_EQUAL_INT(ENCODE_SIZE + 1, _frame_len);
+    for (unsigned i = 0; i < (ENCODE_SIZE - 2); i++) {
+        TEST_ASSERT_EQUAL_INT(0x42, _frame[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(ESC, _frame[ENCODE_SIZE - 2]);
+    TEST_ASSERT_EQUAL_INT(last_esc, _frame[ENCODE_SIZE - 1]);
+    TEST_ASSERT_EQUAL_INT(END, _frame[ENCODE_SIZE]);
+}
+
+static void test_gnrc_slip_encode_full_buffer_end(void)
+{
+    _test_full_buffer(END, END_ESC);
+}
+
+static void test_gnrc_slip_encode_full_buffer_esc(void)
+{
+    _test_full_buffer(ESC, ESC_ESC);
+}
+
+static void test_gnrc_slip_encode_empty(void)
+{
+    gnrc_pktsnip_t pkt = { .data = NULL, .size = 0 };
+
+    _encode(&pkt);
+    TEST_ASSERT_EQUAL_INT(1, _frame_len);
+    TEST_ASSERT_EQUAL_INT(END, _frame[0]);
+}
+
+Test *tests_gnrc_slip_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_slip_encode_plain),
+        new_TestFixture(test_gnrc_slip_encode_escape),
+        new_TestFixture(test_gnrc_slip_encode_full_buffer_end),
+        new_TestFixture(test_gnrc_slip_encode_full_buffer_esc),
+        new_TestFixture(test_gnrc_slip_encode_empty),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_slip_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_slip_tests;
+}
+
+void tests_gnrc_slip(void)
+{
+    TESTS_RUN(tests_gnrc_slip_tests());
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     unittests
+ * @{
+ *
+ * @file
+ * @brief       Test cases for the MurmurHash3 implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes.h"
+
+#include "tests-hashes.h"
+
+static const char *_fox = "The quick brown fox jumps over the lazy dog";
+
+static uint32_t _murmur3(const char *str, uint32_t seed)
+{
+    return murmur3_hash((const uint8_t *)str, strlen(str), seed);
+}
+
+static void test_hashes_murmur3(void)
+{
+    TEST_ASSERT_EQUAL_INT(0x00000000, _murmur3("", 0));
+    TEST_ASSERT_EQUAL_INT(0x514e28b7, _murmur3("", 1));
+    TEST_ASSERT_EQUAL_INT(0xb3dd93fa, _murmur3("abc", 0));
+    TEST_ASSERT_EQUAL_INT(0x248bfa47, _murmur3("hello", 0));
+    TEST_ASSERT_EQUAL_INT(0x2e4ff723, _murmur3(_fox, 0));
+    TEST_ASSERT_EQUAL_INT(0x2fa826cd, _murmur3(_fox, 0x9747b28c));
+}
+
+static void test_hashes_murmur3_unaligned(void)
+{
+    uint8_t buf[sizeof("hello") + 3];
+
+    /* the words are read from odd addresses */
+    for (unsigned i = 1; i < 4; i++) {
+        memcpy(buf + i, "hello", strlen("hello"));
+        TEST_ASSERT_EQUAL_INT(0x248bfa47, murmur3_hash(buf + i, strlen("hello"), 0));
+    }
+}
+
+static void test_hashes_murmur3_x2(void)
+{
+    const uint32_t seed[2] = { 0, 0x9747b28c };
+    uint32_t hash[2];
+
+    /* all lengths of the tail */
+    for (size_t len = 0; len <= strlen(_fox); len++) {
+        murmur3_hash_x2((const uint8_t *)_fox, len, seed, hash);
+        TEST_ASSERT_EQUAL_INT(murmur3_hash((const uint8_t *)_fox, len, seed[0]), hash[0]);
+        TEST_ASSERT_EQUAL_INT(murmur3_hash((const uint8_t *)_fox, len, seed[1]), hash[1]);
+    }
+    TEST_ASSERT_EQUAL_INT(0x2e4ff723, hash[0]);
+    TEST_ASSERT_EQUAL_INT(0x2fa826cd, hash[1]);
+}
+
+Test *tests_hashes_murmur3_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_murmur3),
+        new_TestFixture(test_hashes_murmur3_unaligned),
+        new_TestFixture(test_hashes_murmur3_x2),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_murmur3_tests, NULL, NULL, fixtures);
+
+    return (Test *)&hashes_murmur3_tests;
+}
@@ -212,6 +212,32 @@ static void test_hashes_sha256_hash_long_sequence(void)
                     hlong_sequence));
 }
 
+static void test_hashes_sha256_multi(void)
+{
+    /* pairs with common full blocks, and one message left over */
+    static const size_t len[] = { 1000, 200, 64, 128, 55 };
+    static uint8_t msgs[5][1000];
+    static unsigned char digests[5][SHA256_DIGEST_LENGTH];
+    unsigned char expected[SHA256_DIGEST_LENGTH];
+    const uint8_t *data[5];
+    uint8_t *out[5];
+
+    for (unsigned i = 0; i < 5; i++) {
+        for (unsigned j = 0; j < len[i]; j++) {
+            msgs[i][j] = (uint8_t)(i * 31 + j);
+        }
+        data[i] = msgs[i];
+        out[i] = digests[i];
+    }
+
+    sha256_multi(data, len, out, 5);
+
+    for (unsigned i = 0; i < 5; i++) {
+        sha256(msgs[i], len[i], expected);
+        TEST_ASSERT(memcmp(expected, digests[i], SHA256_DIGEST_LENGTH) == 0);
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -227,6 +253,7 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
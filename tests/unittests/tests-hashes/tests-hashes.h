@@ -65,6 +65,13 @@ Test *tests_hashes_sha256_hmac_tests(void);
  */
 Test *tests_hashes_sha256_chain_tests(void);
 
+/**
+ * @brief   Generates tests for the MurmurHash3 functions of hashes.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_hashes_murmur3_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "log.h"
+#include "log_binary.h"
+#include "tests-log_binary.h"
+
+#define PUT(v)                              \
+    do {                                    \
+        __typeof__(v) _v = (v);             \
+        memcpy(&_exp[_len], &_v, sizeof(_v)); \
+        _len += sizeof(_v);                 \
+    } while (0)
+
+static uint8_t _out[LOG_BINARY_BUFSIZE + 16];
+static uint8_t _exp[LOG_BINARY_RECORD_MAX + 2];
+static size_t _len;
+
+static size_t _drain(void)
+{
+    size_t len = 0, n;
+
+    while ((n = log_binary_read(&_out[len], sizeof(_out) - len)) > 0) {
+        len += n;
+    }
+    return len;
+}
+
+static void _expect(unsigned level, const char *format)
+{
+    _exp[0] = LOG_BINARY_LOG;
+    _exp[2] = level;
+    _len = 3;
+    PUT(format);
+}
+
+static void _check(void)
+{
+    _exp[1] = _len - 2;
+    TEST_ASSERT_EQUAL_INT(_len, _drain());
+    TEST_ASSERT(memcmp(_exp, _out, _len) == 0);
+}
+
+static void test_log_binary_header(void)
+{
+    static const char fmt[] = "%d";
+    const void *anchor = log_binary_anchor;
+
+    /* the header precedes the first record, if the thread started by
+     * auto_init did not send it already */
+    if ((_drain() > 0) && (_out[0] == LOG_BINARY_HDR)) {
+        TEST_ASSERT_EQUAL_INT(11 + sizeof(void *), _out[1] + 2);
+        TEST_ASSERT_EQUAL_INT('R', _out[2]);
+        TEST_ASSERT_EQUAL_INT('L', _out[3]);
+        TEST_ASSERT_EQUAL_INT(LOG_BINARY_VERSION, _out[4]);
+        TEST_ASSERT_EQUAL_INT(sizeof(int), _out[6]);
+        TEST_ASSERT_EQUAL_INT(sizeof(long), _out[7]);
+        TEST_ASSERT_EQUAL_INT(sizeof(void *), _out[9]);
+        TEST_ASSERT(memcmp(&anchor, &_out[11], sizeof(anchor)) == 0);
+    }
+
+    /* but only once */
+    log_binary_write(LOG_INFO, fmt, 1);
+    _expect(LOG_INFO, fmt);
+    PUT((int)1);
+    _check();
+}
+
+static void test_log_binary_integers(void)
+{
+    static const char fmt[] = "%d %u %hhx %ld %lld %zu %c %%";
+
+    log_binary_write(LOG_WARNING, fmt, -5, 7u, 0x12, -70000L, -1LL,
+                     (size_t)3, 'x');
+    _expect(LOG_WARNING, fmt);
+    PUT((int)-5);
+    PUT((int)7);
+    PUT((int)0x12);
+    PUT((long)-70000L);
+    PUT((long long)-1LL);
+    PUT((size_t)3);
+    _exp[_len++] = 'x';
+    _check();
+}
+
+static void test_log_binary_strings(void)
+{
+    static const char fmt[] = "%s|%-*.*s|%s|%s";
+    static const char longer[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    /* hidden from the format checks of the compiler */
+    const char *volatile none = NULL;
+
+    log_binary_write(LOG_INFO, fmt, "abc", 4, 2, "xyz", none, longer);
+    _expect(LOG_INFO, fmt);
+    _exp[_len++] = 3;
+    memcpy(&_exp[_len], "abc", 3);
+    _len += 3;
+    PUT((int)4);
+    PUT((int)2);
+    /* the precision is applied by the host */
+    _exp[_len++] = 3;
+    memcpy(&_exp[_len], "xyz", 3);
+    _len += 3;
+    _exp[_len++] = 0xff;
+    _exp[_len++] = LOG_BINARY_STR_MAX;
+    memcpy(&_exp[_len], longer, LOG_BINARY_STR_MAX);
+    _len += LOG_BINARY_STR_MAX;
+    _check();
+}
+
+static void test_log_binary_float_pointer(void)
+{
+    static const char fmt[] = "%5.2f %p";
+
+    log_binary_write(LOG_ERROR, fmt, 1.5, (void *)_out);
+    _expect(LOG_ERROR, fmt);
+    PUT(1.5);
+    PUT((void *)_out);
+    _check();
+}
+
+static void test_log_binary_truncated(void)
+{
+    static const char fmt[] = "%s %s %s %s %d";
+    static const char str[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const char *unknown = "%d %k %d";
+    size_t args = LOG_BINARY_RECORD_MAX - 1 - sizeof(void *);
+
+    /* only complete arguments are stored */
+    log_binary_write(LOG_INFO, fmt, str, str, str, str, 1);
+    _expect(LOG_INFO | LOG_BINARY_TRUNCATED, fmt);
+    for (unsigned i = 0; i < (args / (LOG_BINARY_STR_MAX + 1)); i++) {
+        _exp[_len++] = LOG_BINARY_STR_MAX;
+        memcpy(&_exp[_len], str, LOG_BINARY_STR_MAX);
+        _len += LOG_BINARY_STR_MAX;
+    }
+    _check();
+
+    /* as well as the arguments before an unknown conversion */
+    log_binary_write(LOG_INFO, unknown, 1, 2);
+    TEST_ASSERT_EQUAL_INT(3 + sizeof(void *) + sizeof(int), _drain());
+    TEST_ASSERT_EQUAL_INT(LOG_INFO | LOG_BINARY_TRUNCATED, _out[2]);
+}
+
+static void test_log_binary_lost(void)
+{
+    static const char fmt[] = "%d";
+    size_t rec = 3 + sizeof(void *) + sizeof(int);
+    unsigned numof = LOG_BINARY_BUFSIZE / rec;
+    size_t len;
+    uint16_t lost;
+
+    for (unsigned i = 0; i < (numof + 3); i++) {
+        log_binary_write(LOG_INFO, fmt, (int)i);
+    }
+
+    len = _drain();
+    TEST_ASSERT_EQUAL_INT(4 + (numof * rec), len);
+    TEST_ASSERT_EQUAL_INT(LOG_BINARY_LOST, _out[0]);
+    TEST_ASSERT_EQUAL_INT(2, _out[1]);
+    memcpy(&lost, &_out[2], sizeof(lost));
+    TEST_ASSERT_EQUAL_INT(3, lost);
+
+    /* the oldest records are kept */
+    _expect(LOG_INFO, fmt);
+    PUT((int)0);
+    _exp[1] = _len - 2;
+    TEST_ASSERT(memcmp(_exp, &_out[4], rec) == 0);
+}
+
+static void test_log_binary_read_whole_records(void)
+{
+    static const char fmt[] = "%d";
+    size_t rec = 3 + sizeof(void *) + sizeof(int);
+
+    log_binary_write(LOG_INFO, fmt, 1);
+    log_binary_write(LOG_INFO, fmt, 2);
+    TEST_ASSERT_EQUAL_INT(0, log_binary_read(_out, rec - 1));
+    TEST_ASSERT_EQUAL_INT(rec, log_binary_read(_out, (2 * rec) - 1));
+    TEST_ASSERT_EQUAL_INT(rec, log_binary_read(_out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(0, log_binary_read(_out, sizeof(_out)));
+}
+
+static void test_log_binary_log_macro(void)
+{
+    LOG_INFO("%d\n", 42);
+    TEST_ASSERT_EQUAL_INT(3 + sizeof(void *) + sizeof(int), _drain());
+    TEST_ASSERT_EQUAL_INT(LOG_BINARY_LOG, _out[0]);
+    TEST_ASSERT_EQUAL_INT(LOG_INFO, _out[2]);
+
+#if LOG_LEVEL < LOG_DEBUG
+    LOG_DEBUG("%d\n", 42);
+    TEST_ASSERT_EQUAL_INT(0, _drain());
+#endif
+}
+
+Test *tests_log_binary_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_log_binary_header),
+        new_TestFixture(test_log_binary_integers),
+        new_TestFixture(test_log_binary_strings),
+        new_TestFixture(test_log_binary_float_pointer),
+        new_TestFixture(test_log_binary_truncated),
+        new_TestFixture(test_log_binary_lost),
+        new_TestFixture(test_log_binary_read_whole_records),
+        new_TestFixture(test_log_binary_log_macro),
+    };
+
+    EMB_UNIT_TESTCALLER(log_binary_tests, NULL, NULL, fixtures);
+
+    return (Test *)&log_binary_tests;
+}
+
+void tests_log_binary(void)
+{
+    TESTS_RUN(tests_log_binary_tests());
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "phydat_ts.h"
+#include "tests-phydat_ts.h"
+
+static uint8_t _buf[64];
+static uint8_t _nvram_mem[128];
+static phydat_ts_t _ts;
+
+static int _nvram_read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t size)
+{
+    (void)dev;
+    memcpy(dst, &_nvram_mem[src], size);
+    return size;
+}
+
+static int _nvram_write(nvram_t *dev, const uint8_t *src, uint32_t dst,
+                        size_t size)
+{
+    (void)dev;
+    memcpy(&_nvram_mem[dst], src, size);
+    return size;
+}
+
+static nvram_t _nvram = {
+    .read = _nvram_read,
+    .write = _nvram_write,
+    .size = sizeof(_nvram_mem),
+};
+
+static void _append(uint32_t time, int16_t v0, int16_t v1, int16_t v2)
+{
+    phydat_t data = { { v0, v1, v2 }, _ts.unit, _ts.scale };
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_append(&_ts, time, &data));
+}
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    phydat_ts_init(&_ts, _buf, sizeof(_buf), 1, UNIT_TEMP_C, -2);
+}
+
+static void test_phydat_ts_encode(void)
+{
+    const uint8_t expected[] = {
+        15, 0, 3, 0, 1, UNIT_TEMP_C, 0xfe,
+        0xd0, 0x0f, 0xcc, 0x21,     /* 1000, 2150 */
+        0x00, 0x02,                 /* +1000, +1 */
+        0x00, 0x03,                 /* +1000, -2 */
+    };
+
+    _append(1000, 2150, 0, 0);
+    _append(2000, 2151, 0, 0);
+    _append(3000, 2149, 0, 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(expected), _ts.len);
+    TEST_ASSERT(memcmp(expected, _buf, sizeof(expected)) == 0);
+}
+
+static void test_phydat_ts_roundtrip(void)
+{
+    /* extreme deltas, irregular and wrapping timestamps */
+    static const int16_t vals[][3] = {
+        { INT16_MIN, INT16_MAX, 0 }, { INT16_MAX, INT16_MIN, -1 },
+        { 0, 0, 1 }, { -981, 12, 3 }, { -980, 14, 2 },
+    };
+    static const uint32_t times[] = {
+        0xfffff000, 0xfffff800, 0x00000400, 0x00000400, 0x7ffffc00,
+    };
+    phydat_ts_reader_t reader;
+    phydat_t data;
+    uint32_t time;
+
+    phydat_ts_init(&_ts, _buf, sizeof(_buf), 3, UNIT_G, -3);
+    for (unsigned i = 0; i < 5; i++) {
+        _append(times[i], vals[i][0], vals[i][1], vals[i][2]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_reader_init(&reader, _buf, _ts.len));
+    for (unsigned i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT(1, phydat_ts_read(&reader, &time, &data));
+        TEST_ASSERT(time == times[i]);
+        TEST_ASSERT_EQUAL_INT(vals[i][0], data.val[0]);
+        TEST_ASSERT_EQUAL_INT(vals[i][1], data.val[1]);
+        TEST_ASSERT_EQUAL_INT(vals[i][2], data.val[2]);
+        TEST_ASSERT_EQUAL_INT(UNIT_G, data.unit);
+        TEST_ASSERT_EQUAL_INT(-3, data.scale);
+    }
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_read(&reader, &time, &data));
+}
+
+static void test_phydat_ts_errors(void)
+{
+    phydat_t data = { { 0, 0, 0 }, UNIT_TEMP_F, -2 };
+    phydat_ts_reader_t reader;
+    uint32_t time;
+    size_t len;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_ts_init(&_ts, _buf, sizeof(_buf),
+                                                  4, UNIT_G, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_ts_append(&_ts, 0, &data));
+
+    /* 4 bytes for the first sample, then 2 per sample */
+    phydat_ts_init(&_ts, _buf, PHYDAT_TS_HDR_LEN + 8, 1, UNIT_TEMP_C, -2);
+    _append(1000, 2150, 0, 0);
+    _append(2000, 2151, 0, 0);
+    len = _ts.len;
+    data.unit = UNIT_TEMP_C;
+    data.val[0] = INT16_MIN;
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, phydat_ts_append(&_ts, 3000, &data));
+    TEST_ASSERT_EQUAL_INT(len, _ts.len);
+    TEST_ASSERT_EQUAL_INT(2, _ts.count);
+    _append(3000, 2152, 0, 0);
+
+    /* truncated */
+    _buf[0]--;
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_reader_init(&reader, _buf, _ts.len));
+    TEST_ASSERT_EQUAL_INT(1, phydat_ts_read(&reader, &time, &data));
+    TEST_ASSERT_EQUAL_INT(1, phydat_ts_read(&reader, &time, &data));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, phydat_ts_read(&reader, &time, &data));
+    _buf[4] = 0;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, phydat_ts_reader_init(&reader, _buf,
+                                                          _ts.len));
+}
+
+static void test_phydat_ts_range(void)
+{
+    phydat_ts_reader_t reader;
+    phydat_t data[4];
+    uint32_t times[4];
+
+    for (unsigned i = 0; i < 10; i++) {
+        _append(i * 100, 2000 + i, 0, 0);
+    }
+
+    phydat_ts_reader_init(&reader, _buf, _ts.len);
+    TEST_ASSERT_EQUAL_INT(3, phydat_ts_read_range(&reader, 250, 500, times,
+                                                  data, 4));
+    TEST_ASSERT(times[0] == 300);
+    TEST_ASSERT_EQUAL_INT(2003, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(2005, data[2].val[0]);
+
+    /* continues with the sample behind the range */
+    TEST_ASSERT_EQUAL_INT(4, phydat_ts_read_range(&reader, 0, 2000, times,
+                                                  data, 4));
+    TEST_ASSERT(times[0] == 600);
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_read_range(&reader, 0, 999, NULL,
+                                                  data, 4));
+}
+
+static void test_phydat_ts_flush(void)
+{
+    phydat_ts_reader_t reader;
+    uint8_t buf[32];
+    phydat_t data;
+    uint32_t time;
+    size_t len;
+
+    _append(1000, 2150, 0, 0);
+    _append(2000, 2151, 0, 0);
+    len = _ts.len;
+
+    memset(_nvram_mem, 0xff, sizeof(_nvram_mem));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, phydat_ts_load(&_nvram, 16, buf,
+                                                   sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(len, phydat_ts_flush(&_ts, &_nvram, 16));
+    TEST_ASSERT_EQUAL_INT(0, _ts.count);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, phydat_ts_load(&_nvram, 16, buf,
+                                                   len - 1));
+    TEST_ASSERT_EQUAL_INT(len, phydat_ts_load(&_nvram, 16, buf, sizeof(buf)));
+
+    phydat_ts_reader_init(&reader, buf, len);
+    TEST_ASSERT_EQUAL_INT(1, phydat_ts_read(&reader, &time, &data));
+    TEST_ASSERT_EQUAL_INT(1, phydat_ts_read(&reader, &time, &data));
+    TEST_ASSERT(time == 2000);
+    TEST_ASSERT_EQUAL_INT(2151, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(0, phydat_ts_read(&reader, &time, &data));
+}
+
+Test *tests_phydat_ts_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_phydat_ts_encode),
+        new_TestFixture(test_phydat_ts_roundtrip),
+        new_TestFixture(test_phydat_ts_errors),
+        new_TestFixture(test_phydat_ts_range),
+        new_TestFixture(test_phydat_ts_flush),
+    };
+
+    EMB_UNIT_TESTCALLER(phydat_ts_tests, set_up, NULL, fixtures);
+
+    return (Test *)&phydat_ts_tests;
+}
+
+void tests_phydat_ts(void)
+{
+    TESTS_RUN(tests_phydat_ts_tests());
+}
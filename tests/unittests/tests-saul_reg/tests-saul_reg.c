@@ -171,6 +171,48 @@ static void test_reg_rm(void)
     TEST_ASSERT_EQUAL_INT(-ENODEV, res);
 
     TEST_ASSERT_EQUAL_INT(2, count());
+    TEST_ASSERT_EQUAL_INT(2, saul_reg_numof());
+}
+
+static void test_reg_rm_head(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&s0));
+    TEST_ASSERT_EQUAL_INT(1, count());
+    TEST_ASSERT_EQUAL_STRING("S2", saul_reg->name);
+    TEST_ASSERT(saul_reg_find_nth(0) == &s2);
+    TEST_ASSERT_NULL(saul_reg_find_nth(1));
+
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&s2));
+    TEST_ASSERT_NULL(saul_reg);
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_numof());
+}
+
+static void test_reg_beyond_index(void)
+{
+    static saul_reg_t regs[SAUL_REG_INDEX_NUMOF + 2];
+    const unsigned numof = sizeof(regs) / sizeof(regs[0]);
+
+    for (unsigned i = 0; i < numof; i++) {
+        regs[i].name = "M";
+        regs[i].driver = (i == numof - 1) ? &s3_dri : &s0_dri;
+        TEST_ASSERT_EQUAL_INT(0, saul_reg_add(&regs[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(numof, count());
+    TEST_ASSERT_EQUAL_INT(numof, saul_reg_numof());
+    TEST_ASSERT(last() == &regs[numof - 1]);
+    TEST_ASSERT(saul_reg_find_nth(numof - 2) == &regs[numof - 2]);
+    TEST_ASSERT(saul_reg_find_nth(numof - 1) == &regs[numof - 1]);
+    TEST_ASSERT_NULL(saul_reg_find_nth(numof));
+    TEST_ASSERT(saul_reg_find_type(SAUL_ACT_LED_RGB) == &regs[numof - 1]);
+
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&regs[1]));
+    TEST_ASSERT(saul_reg_find_nth(numof - 2) == &regs[numof - 1]);
+
+    for (unsigned i = 0; i < numof; i++) {
+        saul_reg_rm(&regs[i]);
+    }
+    TEST_ASSERT_NULL(saul_reg);
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_numof());
 }
 
 Test *tests_saul_reg_tests(void)
@@ -181,7 +223,9 @@ Test *tests_saul_reg_tests(void)
         new_TestFixture(test_reg_find_nth),
         new_TestFixture(test_reg_find_type),
         new_TestFixture(test_reg_find_name),
-        new_TestFixture(test_reg_rm)
+        new_TestFixture(test_reg_rm),
+        new_TestFixture(test_reg_rm_head),
+        new_TestFixture(test_reg_beyond_index),
     };
 
     EMB_UNIT_TESTCALLER(pkt_tests, NULL, NULL, fixtures);
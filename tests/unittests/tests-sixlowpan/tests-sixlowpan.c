@@ -12,9 +12,11 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "thread.h"
+#include "xtimer.h"
 
 #include "tests-sixlowpan.h"
 #include "embUnit.h"
@@ -22,6 +24,12 @@
 #include "unittests-constants.h"
 
 #include "net/sixlowpan.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/udp.h"
 
 #define NALP_0  (0x00) /* 00 00 00 00 */
 #define NALP_1  (0x01) /* 00 00 00 01 */
@@ -45,6 +53,26 @@
 #define FRAG1_DISP      (0xC5)  /* 11 00 01 01 */
 #define FRAGN_DISP      (0xE5)  /* 11 10 01 01 */
 
+#define TEST_CTX_ID     (1)
+#define TEST_L2SRC      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 }
+#define TEST_L2DST      { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 }
+#define TEST_PREFIX     { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 \
+        } \
+    }
+#define TEST_PAYLOAD    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+/* ports are compressed to 4 bits each by NHC */
+#define TEST_UDP_SRC    (0xf0b1)
+#define TEST_UDP_DST    (0xf0b2)
+#define TEST_UDP_CSUM   (0x1234)
+#ifdef MODULE_GNRC_UDP
+#define TEST_UDP_TYPE   (GNRC_NETTYPE_UDP)
+#else
+#define TEST_UDP_TYPE   (GNRC_NETTYPE_UNDEF)
+#endif
+#define TEST_ITERATIONS (1000U)
+
 
 /* Test with 6LoWPAN dispatch byte indicating a none-LoWPAN frame (NALP = Not a
  * LoWPAN frame)
@@ -147,6 +175,302 @@ static void test_sixlowpan_nalp_is_6lowpan_frame_12(void)
     TEST_ASSERT(!sixlowpan_nalp(FRAGN_DISP));
 }
 
+static void _build_pkt(const uint8_t *prefix, gnrc_pktsnip_t **pkt)
+{
+    uint8_t src_l2[] = TEST_L2SRC, dst_l2[] = TEST_L2DST;
+    ipv6_addr_t src = IPV6_ADDR_UNSPECIFIED, dst = IPV6_ADDR_UNSPECIFIED;
+    gnrc_pktsnip_t *netif, *ipv6, *payload;
+    ipv6_hdr_t *ipv6_hdr;
+
+    /* IIDs derived from the link-layer addresses */
+    memcpy(src.u8, prefix, 8);
+    memcpy(src.u8 + 8, src_l2, sizeof(src_l2));
+    src.u8[8] ^= 0x02;
+    memcpy(dst.u8, prefix, 8);
+    memcpy(dst.u8 + 8, dst_l2, sizeof(dst_l2));
+    dst.u8[8] ^= 0x02;
+
+    payload = gnrc_pktbuf_add(NULL, TEST_PAYLOAD, sizeof(TEST_PAYLOAD),
+                              GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(payload);
+    ipv6 = gnrc_ipv6_hdr_build(payload, &src, &dst);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->nh = PROTNUM_IPV6_NONXT;
+    ipv6_hdr->hl = 64;
+    ipv6_hdr->len = byteorder_htons((uint16_t)payload->size);
+    netif = gnrc_netif_hdr_build(src_l2, sizeof(src_l2), dst_l2, sizeof(dst_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    netif->next = ipv6;
+    *pkt = netif;
+}
+
+/* encodes a packet and copies its compressed header to iphc */
+static void _encode(const uint8_t *prefix, uint8_t *iphc, size_t *iphc_len)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+
+    _build_pkt(prefix, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, pkt->next->type);
+    TEST_ASSERT(pkt->next->size <= *iphc_len);
+    *iphc_len = pkt->next->size;
+    memcpy(iphc, pkt->next->data, *iphc_len);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _decode(uint8_t *iphc, size_t iphc_len, ipv6_hdr_t *exp)
+{
+    uint8_t src_l2[] = TEST_L2SRC, dst_l2[] = TEST_L2DST;
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src_l2, sizeof(src_l2),
+                                                 dst_l2, sizeof(dst_l2));
+    gnrc_pktsnip_t *pkt, *ipv6;
+    ipv6_hdr_t *ipv6_hdr;
+    size_t nh_len = 0;
+
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pktbuf_add(netif, iphc, iphc_len, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    TEST_ASSERT_EQUAL_INT(iphc_len, gnrc_sixlowpan_iphc_decode(&ipv6, pkt, 0, 0,
+                                                               &nh_len));
+    if (exp != NULL) {
+        ipv6_hdr = ipv6->data;
+        TEST_ASSERT(ipv6_addr_equal(&exp->src, &ipv6_hdr->src));
+        TEST_ASSERT(ipv6_addr_equal(&exp->dst, &ipv6_hdr->dst));
+        TEST_ASSERT_EQUAL_INT(exp->nh, ipv6_hdr->nh);
+        TEST_ASSERT_EQUAL_INT(exp->hl, ipv6_hdr->hl);
+    }
+    gnrc_pktbuf_release(ipv6);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void set_up_iphc(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void tear_down_iphc(void)
+{
+    gnrc_sixlowpan_ctx_reset();
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
+}
+
+static void test_sixlowpan_iphc_encode__link_local(void)
+{
+    static const uint8_t ll_prefix[] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0 };
+    gnrc_pktsnip_t *pkt = NULL;
+    ipv6_hdr_t exp;
+    uint8_t iphc[sizeof(ipv6_hdr_t)];
+    size_t iphc_len = sizeof(iphc);
+
+    _build_pkt(ll_prefix, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    memcpy(&exp, pkt->next->data, sizeof(exp));
+    gnrc_pktbuf_release(pkt);
+    _encode(ll_prefix, iphc, &iphc_len);
+    /* dispatch + TF, HL, SAM and DAM elided + inline next header */
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC_HDR_LEN + 1, iphc_len);
+    _decode(iphc, iphc_len, &exp);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__same_flow(void)
+{
+    ipv6_addr_t prefix = TEST_PREFIX;
+    uint8_t iphc1[sizeof(ipv6_hdr_t)], iphc2[sizeof(ipv6_hdr_t)];
+    size_t iphc1_len = sizeof(iphc1), iphc2_len = sizeof(iphc2);
+
+    _encode(prefix.u8, iphc1, &iphc1_len);
+    /* second packet of the flow may use cached template, but result must
+     * be the same */
+    _encode(prefix.u8, iphc2, &iphc2_len);
+    TEST_ASSERT_EQUAL_INT(iphc1_len, iphc2_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(iphc1, iphc2, iphc1_len));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__ctx_change(void)
+{
+    ipv6_addr_t prefix = TEST_PREFIX;
+    gnrc_pktsnip_t *pkt = NULL;
+    ipv6_hdr_t exp;
+    uint8_t iphc1[sizeof(ipv6_hdr_t)], iphc2[sizeof(ipv6_hdr_t)];
+    size_t iphc1_len = sizeof(iphc1), iphc2_len = sizeof(iphc2);
+
+    _build_pkt(prefix.u8, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    memcpy(&exp, pkt->next->data, sizeof(exp));
+    gnrc_pktbuf_release(pkt);
+    _encode(prefix.u8, iphc1, &iphc1_len);
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(TEST_CTX_ID, &prefix, 64,
+                                                   UINT16_MAX, true));
+    /* addresses are now compressed using the context */
+    _encode(prefix.u8, iphc2, &iphc2_len);
+    TEST_ASSERT(iphc2_len < iphc1_len);
+    _decode(iphc2, iphc2_len, &exp);
+    gnrc_sixlowpan_ctx_remove(TEST_CTX_ID);
+    /* and inline again after the context was removed */
+    iphc2_len = sizeof(iphc2);
+    _encode(prefix.u8, iphc2, &iphc2_len);
+    TEST_ASSERT_EQUAL_INT(iphc1_len, iphc2_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(iphc1, iphc2, iphc1_len));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/* inserts a UDP header between the IPv6 header and the payload */
+static void _add_udp(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = pkt->next, *udp;
+    ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    udp_hdr_t *udp_hdr;
+
+    udp = gnrc_pktbuf_add(ipv6->next, NULL, sizeof(udp_hdr_t), TEST_UDP_TYPE);
+    TEST_ASSERT_NOT_NULL(udp);
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(TEST_UDP_SRC);
+    udp_hdr->dst_port = byteorder_htons(TEST_UDP_DST);
+    udp_hdr->length = byteorder_htons(gnrc_pkt_len(udp));
+    udp_hdr->checksum = byteorder_htons(TEST_UDP_CSUM);
+    ipv6->next = udp;
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->len = udp_hdr->length;
+}
+
+/* encodes a UDP packet and copies its compressed headers, including the NHC
+ * UDP header, to iphc */
+static void _encode_udp(const uint8_t *prefix, uint8_t *iphc, size_t *iphc_len)
+{
+    gnrc_pktsnip_t *pkt = NULL, *ptr;
+    size_t len = 0;
+
+    _build_pkt(prefix, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    _add_udp(pkt);
+    TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, pkt->next->type);
+    /* everything but the payload */
+    for (ptr = pkt->next; (ptr != NULL) && (ptr->next != NULL); ptr = ptr->next) {
+        TEST_ASSERT(len + ptr->size <= *iphc_len);
+        memcpy(iphc + len, ptr->data, ptr->size);
+        len += ptr->size;
+    }
+    *iphc_len = len;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_sixlowpan_iphc_encode__udp(void)
+{
+    ipv6_addr_t prefix = TEST_PREFIX;
+    gnrc_pktsnip_t *netif, *pkt, *dec;
+    ipv6_hdr_t *ipv6_hdr;
+    udp_hdr_t *udp_hdr;
+    uint8_t iphc1[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) + sizeof(TEST_PAYLOAD)];
+    uint8_t iphc2[sizeof(iphc1)];
+    uint8_t src_l2[] = TEST_L2SRC, dst_l2[] = TEST_L2DST;
+    size_t iphc1_len = sizeof(iphc1), iphc2_len = sizeof(iphc2), nh_len = 0;
+
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(TEST_CTX_ID, &prefix, 64,
+                                                   UINT16_MAX, true));
+    _encode_udp(prefix.u8, iphc1, &iphc1_len);
+    /* the second packet of the flow may use the cached template, but the
+     * ports are not part of it */
+    _encode_udp(prefix.u8, iphc2, &iphc2_len);
+    TEST_ASSERT_EQUAL_INT(iphc1_len, iphc2_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(iphc1, iphc2, iphc1_len));
+    /* dispatch, CID extension, next header ID, 4 bit ports and checksum */
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC_HDR_LEN + SIXLOWPAN_IPHC_CID_EXT_LEN +
+                          1 + 1 + 2, iphc1_len);
+
+    /* decode with the payload, to check the UDP length */
+    memcpy(iphc1 + iphc1_len, TEST_PAYLOAD, sizeof(TEST_PAYLOAD));
+    netif = gnrc_netif_hdr_build(src_l2, sizeof(src_l2), dst_l2, sizeof(dst_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pktbuf_add(netif, iphc1, iphc1_len + sizeof(TEST_PAYLOAD),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    dec = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(dec);
+    TEST_ASSERT_EQUAL_INT(iphc1_len, gnrc_sixlowpan_iphc_decode(&dec, pkt, 0, 0,
+                                                                &nh_len));
+    TEST_ASSERT_EQUAL_INT(sizeof(udp_hdr_t), nh_len);
+    /* NHC prepends the UDP header to the IPv6 header */
+    TEST_ASSERT_NOT_NULL(dec->next);
+    udp_hdr = dec->data;
+    ipv6_hdr = dec->next->data;
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, ipv6_hdr->nh);
+    TEST_ASSERT_EQUAL_INT(sizeof(udp_hdr_t) + sizeof(TEST_PAYLOAD),
+                          byteorder_ntohs(ipv6_hdr->len));
+    TEST_ASSERT_EQUAL_INT(TEST_UDP_SRC, byteorder_ntohs(udp_hdr->src_port));
+    TEST_ASSERT_EQUAL_INT(TEST_UDP_DST, byteorder_ntohs(udp_hdr->dst_port));
+    TEST_ASSERT_EQUAL_INT(sizeof(udp_hdr_t) + sizeof(TEST_PAYLOAD),
+                          byteorder_ntohs(udp_hdr->length));
+    TEST_ASSERT_EQUAL_INT(TEST_UDP_CSUM, byteorder_ntohs(udp_hdr->checksum));
+    gnrc_pktbuf_release(dec);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void _run_throughput(const char *name, bool flush)
+{
+    ipv6_addr_t prefix = TEST_PREFIX;
+    uint8_t iphc[sizeof(ipv6_hdr_t)];
+    size_t iphc_len;
+    uint32_t start, enc_time = 0, dec_time = 0;
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+        if (flush) {
+            gnrc_sixlowpan_iphc_cache_flush();
+        }
+#else
+        (void)flush;
+#endif
+        iphc_len = sizeof(iphc);
+        start = xtimer_now();
+        _encode(prefix.u8, iphc, &iphc_len);
+        enc_time += xtimer_now() - start;
+        start = xtimer_now();
+        _decode(iphc, iphc_len, NULL);
+        dec_time += xtimer_now() - start;
+    }
+    printf("\n%s: %u packets, encode: %" PRIu32 " us, decode: %" PRIu32 " us\n",
+           name, TEST_ITERATIONS, enc_time, dec_time);
+}
+
+static void test_sixlowpan_iphc__throughput(void)
+{
+    ipv6_addr_t prefix = TEST_PREFIX;
+
+    /* includes packet building and pktbuf operations, so only the difference
+     * between the runs is meaningful */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(TEST_CTX_ID, &prefix, 64,
+                                                   UINT16_MAX, true));
+    _run_throughput("iphc uncached", true);
+    _run_throughput("iphc cached", false);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *test_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_iphc_encode__link_local),
+        new_TestFixture(test_sixlowpan_iphc_encode__same_flow),
+        new_TestFixture(test_sixlowpan_iphc_encode__ctx_change),
+        new_TestFixture(test_sixlowpan_iphc_encode__udp),
+        new_TestFixture(test_sixlowpan_iphc__throughput),
+    };
+
+    EMB_UNIT_TESTCALLER(test_sixlowpan_iphc_tests_caller, set_up_iphc, tear_down_iphc,
+                        fixtures);
+
+    return (Test *)&test_sixlowpan_iphc_tests_caller;
+}
+
 Test *test_sixlowpan_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -180,5 +504,6 @@ Test *test_sixlowpan_tests(void)
 void tests_sixlowpan(void)
 {
     TESTS_RUN(test_sixlowpan_tests());
+    TESTS_RUN(test_sixlowpan_iphc_tests());
 }
 /** @} */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "tests-ubjson.h"
+
+#define TEST_UBJSON_STRING "longer than the buffers"
+
+typedef enum {
+    BEFORE_ARRAY = __LINE__,
+    IN_ARRAY = __LINE__,
+    BEFORE_END = __LINE__,
+} test_ubjson_buffered_state_t;
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    test_ubjson_buffered_state_t state;
+} test_ubjson_buffered_receiver_cookie_t;
+
+static void test_ubjson_buffered_receiver_callback_sub(
+        ubjson_cookie_t *restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2,
+        ubjson_read_callback_result_t *result)
+{
+    *result = UBJSON_ABORTED;
+
+    (void) type2;
+
+    test_ubjson_buffered_receiver_cookie_t *state;
+    state = container_of(cookie, test_ubjson_buffered_receiver_cookie_t, cookie);
+
+    int32_t i32;
+    int64_t i64;
+    bool b;
+    char str[sizeof(TEST_UBJSON_STRING)];
+
+    switch (state->state) {
+        case BEFORE_ARRAY:
+            TEST_ASSERT_EQUAL_INT(UBJSON_ENTER_ARRAY, type1);
+            state->state = IN_ARRAY;
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY, ubjson_read_array(cookie));
+            state->state = BEFORE_END;
+            break;
+
+        case IN_ARRAY:
+            TEST_ASSERT_EQUAL_INT(UBJSON_INDEX, type1);
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY, ubjson_peek_value(cookie, &type2, &content2));
+            switch (content1) {
+                case 0:
+                case 1:
+                    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT32, type2);
+                    TEST_ASSERT(ubjson_get_i32(cookie, content2, &i32) > 0);
+                    TEST_ASSERT_EQUAL_INT(content1 ? -70000 : 300, i32);
+                    break;
+                case 2:
+                case 3:
+                    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_BOOL, type2);
+                    ubjson_get_bool(cookie, content2, &b);
+                    TEST_ASSERT(b == (content1 == 2));
+                    break;
+                case 4:
+                    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT64, type2);
+                    TEST_ASSERT(ubjson_get_i64(cookie, content2, &i64) > 0);
+                    TEST_ASSERT(i64 == INT64_MIN);
+                    break;
+                case 5:
+                    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_STRING, type2);
+                    TEST_ASSERT_EQUAL_INT(sizeof(str) - 1, content2);
+                    TEST_ASSERT_EQUAL_INT(content2, ubjson_get_string(cookie, content2, str));
+                    str[content2] = '\0';
+                    TEST_ASSERT_EQUAL_STRING(TEST_UBJSON_STRING, (char *) str);
+                    break;
+                default:
+                    TEST_FAIL("Too many elements");
+                    break;
+            }
+            break;
+
+        case BEFORE_END:
+            TEST_FAIL("Content after the end");
+            break;
+
+        default:
+            TEST_FAIL("The cookie was corrupted");
+            break;
+    }
+
+    *result = UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t test_ubjson_buffered_receiver_callback(
+        ubjson_cookie_t *restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2)
+{
+    ubjson_read_callback_result_t result;
+    test_ubjson_buffered_receiver_callback_sub(cookie, type1, content1, type2, content2, &result);
+    return result;
+}
+
+static void test_ubjson_buffered_receiver(void)
+{
+    test_ubjson_buffered_receiver_cookie_t state;
+    char buf[4];
+    state.state = BEFORE_ARRAY;
+
+    ubjson_read_init_buffered(&state.cookie, test_ubjson_read_fun,
+                              test_ubjson_buffered_receiver_callback, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(UBJSON_OKAY, ubjson_read_next(&state.cookie));
+    TEST_ASSERT_EQUAL_INT(BEFORE_END, state.state);
+}
+
+#undef EMBUNIT_ERROR_RETURN
+#define EMBUNIT_ERROR_RETURN
+
+static void test_ubjson_buffered_sender(void)
+{
+    ubjson_cookie_t cookie;
+    char buf[8];
+    ubjson_write_init_buffered(&cookie, test_ubjson_write_fun, buf, sizeof(buf));
+
+    TEST_ASSERT(ubjson_open_array(&cookie) > 0);
+    TEST_ASSERT(ubjson_write_i32(&cookie, 300) > 0);
+    TEST_ASSERT(ubjson_write_i32(&cookie, -70000) > 0);
+    TEST_ASSERT(ubjson_write_bool(&cookie, true) > 0);
+    TEST_ASSERT(ubjson_write_bool(&cookie, false) > 0);
+    TEST_ASSERT(ubjson_write_i64(&cookie, INT64_MIN) > 0);
+    TEST_ASSERT(ubjson_write_string(&cookie, TEST_UBJSON_STRING,
+                                    sizeof(TEST_UBJSON_STRING) - 1) > 0);
+    TEST_ASSERT(ubjson_close_array(&cookie) > 0);
+    TEST_ASSERT(ubjson_write_flush(&cookie) > 0);
+}
+
+void test_ubjson_buffered(void)
+{
+    test_ubjson_test(test_ubjson_buffered_sender,
+                     test_ubjson_buffered_receiver);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "tests-ubjson.h"
+
+/* zeros used to get lost as pushed back markers */
+static const int16_t test_ubjson_typed_array_values[] = { 0, -1, 0, INT16_MAX, 256 };
+
+#define TEST_UBJSON_TYPED_ARRAY_COUNT \
+    (sizeof(test_ubjson_typed_array_values) / sizeof(test_ubjson_typed_array_values[0]))
+
+typedef enum {
+    BEFORE_ARRAY_1 = __LINE__,
+    IN_ARRAY_1 = __LINE__,
+
+    BEFORE_ARRAY_2 = __LINE__,
+    BEFORE_ARRAY_3 = __LINE__,
+    BEFORE_ARRAY_4 = __LINE__,
+
+    BEFORE_END = __LINE__,
+} test_ubjson_typed_array_state_t;
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    test_ubjson_typed_array_state_t state;
+} test_ubjson_typed_array_receiver_cookie_t;
+
+static void test_ubjson_typed_array_receiver_callback_sub(
+        ubjson_cookie_t *restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2,
+        ubjson_read_callback_result_t *result)
+{
+    *result = UBJSON_ABORTED;
+
+    (void) type2;
+
+    test_ubjson_typed_array_receiver_cookie_t *state;
+    state = container_of(cookie, test_ubjson_typed_array_receiver_cookie_t, cookie);
+
+    int32_t i32[TEST_UBJSON_TYPED_ARRAY_COUNT];
+    int16_t i16[TEST_UBJSON_TYPED_ARRAY_COUNT];
+    int8_t i8[TEST_UBJSON_TYPED_ARRAY_COUNT];
+    size_t count;
+
+    switch (state->state) {
+        case BEFORE_ARRAY_1:
+            /* element by element */
+            TEST_ASSERT_EQUAL_INT(UBJSON_ENTER_ARRAY, type1);
+            state->state = IN_ARRAY_1;
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY, ubjson_read_array(cookie));
+            state->state = BEFORE_ARRAY_2;
+            break;
+
+        case IN_ARRAY_1:
+            TEST_ASSERT_EQUAL_INT(UBJSON_INDEX, type1);
+            TEST_ASSERT(content1 < (ssize_t) TEST_UBJSON_TYPED_ARRAY_COUNT);
+            TEST_ASSERT_EQUAL_INT('I', content2);
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY, ubjson_peek_value(cookie, &type2, &content2));
+            TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT32, type2);
+            TEST_ASSERT(ubjson_get_i32(cookie, content2, &i32[0]) > 0);
+            TEST_ASSERT_EQUAL_INT(test_ubjson_typed_array_values[content1], i32[0]);
+            break;
+
+        case BEFORE_ARRAY_2:
+            /* copied at once */
+            TEST_ASSERT_EQUAL_INT(UBJSON_ENTER_ARRAY, type1);
+            count = TEST_UBJSON_TYPED_ARRAY_COUNT;
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                                  ubjson_get_array(cookie, UBJSON_ARRAY_INT16, i16, &count));
+            TEST_ASSERT_EQUAL_INT(TEST_UBJSON_TYPED_ARRAY_COUNT, count);
+            for (unsigned i = 0; i < count; ++i) {
+                TEST_ASSERT_EQUAL_INT(test_ubjson_typed_array_values[i], i16[i]);
+            }
+            state->state = BEFORE_ARRAY_3;
+            break;
+
+        case BEFORE_ARRAY_3:
+            /* converted element by element */
+            TEST_ASSERT_EQUAL_INT(UBJSON_ENTER_ARRAY, type1);
+            count = TEST_UBJSON_TYPED_ARRAY_COUNT;
+            TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                                  ubjson_get_array(cookie, UBJSON_ARRAY_INT32, i32, &count));
+            TEST_ASSERT_EQUAL_INT(TEST_UBJSON_TYPED_ARRAY_COUNT, count);
+            for (unsigned i = 0; i < count; ++i) {
+                TEST_ASSERT_EQUAL_INT(test_ubjson_typed_array_values[i], i32[i]);
+            }
+            state->state = BEFORE_ARRAY_4;
+            break;
+
+        case BEFORE_ARRAY_4:
+            /* INT16_MAX does not fit */
+            TEST_ASSERT_EQUAL_INT(UBJSON_ENTER_ARRAY, type1);
+            count = TEST_UBJSON_TYPED_ARRAY_COUNT;
+            TEST_ASSERT_EQUAL_INT(UBJSON_INVALID_DATA,
+                                  ubjson_get_array(cookie, UBJSON_ARRAY_INT8, i8, &count));
+            state->state = BEFORE_END;
+            break;
+
+        case BEFORE_END:
+            TEST_FAIL("Content after the end");
+            break;
+
+        default:
+            TEST_FAIL("The cookie was corrupted");
+            break;
+    }
+
+    *result = UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t test_ubjson_typed_array_receiver_callback(
+        ubjson_cookie_t *restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2)
+{
+    ubjson_read_callback_result_t result;
+    test_ubjson_typed_array_receiver_callback_sub(cookie, type1, content1, type2, content2,
+                                                  &result);
+    return result;
+}
+
+static void test_ubjson_typed_array_receiver(void)
+{
+    test_ubjson_typed_array_receiver_cookie_t state;
+    state.state = BEFORE_ARRAY_1;
+
+    TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                          ubjson_read(&state.cookie, test_ubjson_read_fun,
+                                      test_ubjson_typed_array_receiver_callback));
+    TEST_ASSERT_EQUAL_INT(BEFORE_ARRAY_2, state.state);
+
+    TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                          ubjson_read(&state.cookie, test_ubjson_read_fun,
+                                      test_ubjson_typed_array_receiver_callback));
+    TEST_ASSERT_EQUAL_INT(BEFORE_ARRAY_3, state.state);
+
+    TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                          ubjson_read(&state.cookie, test_ubjson_read_fun,
+                                      test_ubjson_typed_array_receiver_callback));
+    TEST_ASSERT_EQUAL_INT(BEFORE_ARRAY_4, state.state);
+
+    TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                          ubjson_read(&state.cookie, test_ubjson_read_fun,
+                                      test_ubjson_typed_array_receiver_callback));
+    TEST_ASSERT_EQUAL_INT(BEFORE_END, state.state);
+}
+
+#undef EMBUNIT_ERROR_RETURN
+#define EMBUNIT_ERROR_RETURN
+
+static void test_ubjson_typed_array_sender(void)
+{
+    ubjson_cookie_t cookie;
+    ubjson_write_init(&cookie, test_ubjson_write_fun);
+
+    for (unsigned i = 0; i < 4; ++i) {
+        TEST_ASSERT(ubjson_write_array(&cookie, UBJSON_ARRAY_INT16,
+                                       test_ubjson_typed_array_values,
+                                       TEST_UBJSON_TYPED_ARRAY_COUNT) > 0);
+    }
+}
+
+void test_ubjson_typed_array(void)
+{
+    test_ubjson_test(test_ubjson_typed_array_sender,
+                     test_ubjson_typed_array_receiver);
+}
@@ -103,6 +103,8 @@ static Test *tests_ubjson_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_ubjson_empty_array),
         new_TestFixture(test_ubjson_empty_object),
+        new_TestFixture(test_ubjson_typed_array),
+        new_TestFixture(test_ubjson_buffered),
     };
 
     EMB_UNIT_TESTCALLER(ubjson_tests, ubjson_set_up, NULL, fixtures);